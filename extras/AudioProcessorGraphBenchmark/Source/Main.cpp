@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*
+  ==============================================================================
+
+   Times the AudioProcessorGraph with graphs that are too large for the unit
+   tests.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class PassThroughProcessor final : public AudioProcessor
+{
+public:
+    PassThroughProcessor()
+        : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::stereo())
+                                           .withOutput ("out", AudioChannelSet::stereo())) {}
+
+    const String getName() const override                                   { return "Pass through"; }
+    void prepareToPlay (double, int) override                               {}
+    void releaseResources() override                                        {}
+    void processBlock (AudioBuffer<float>&, MidiBuffer&) override           {}
+    using AudioProcessor::processBlock;
+    double getTailLengthSeconds() const override                            { return 0.0; }
+    bool acceptsMidi() const override                                       { return false; }
+    bool producesMidi() const override                                      { return false; }
+    AudioProcessorEditor* createEditor() override                           { return nullptr; }
+    bool hasEditor() const override                                         { return false; }
+    int getNumPrograms() override                                           { return 1; }
+    int getCurrentProgram() override                                        { return 0; }
+    void setCurrentProgram (int) override                                   {}
+    const String getProgramName (int) override                              { return {}; }
+    void changeProgramName (int, const String&) override                    {}
+    void getStateInformation (MemoryBlock&) override                        {}
+    void setStateInformation (const void*, int) override                    {}
+};
+
+//==============================================================================
+// Builds a chain of nodes, then times the rebuild after a single node is added
+// and connected to the middle of the chain.
+static double timeRebuildForSingleChange (int numNodes)
+{
+    using UK = AudioProcessorGraph::UpdateKind;
+
+    AudioProcessorGraph graph;
+    std::vector<AudioProcessorGraph::NodeID> nodeIDs;
+
+    for (int i = 0; i < numNodes; ++i)
+        nodeIDs.push_back (graph.addNode (std::make_unique<PassThroughProcessor>(), {}, UK::none)->nodeID);
+
+    for (auto it = nodeIDs.begin(); it != std::prev (nodeIDs.end()); ++it)
+        for (int channel = 0; channel < 2; ++channel)
+            graph.addConnection ({ { it[0], channel }, { it[1], channel } }, UK::none);
+
+    graph.prepareToPlay (44100.0, 512);
+
+    const auto start = Time::getHighResolutionTicks();
+
+    const auto extra = graph.addNode (std::make_unique<PassThroughProcessor>(), {}, UK::none);
+    graph.addConnection ({ { extra->nodeID, 0 }, { nodeIDs[nodeIDs.size() / 2], 0 } }, UK::none);
+    graph.rebuild();
+
+    const auto elapsed = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+
+    graph.releaseResources();
+    return elapsed * 1000.0;
+}
+
+static void benchmarkRebuild()
+{
+    std::cout << "Render sequence rebuild time for a single change" << std::endl;
+
+    for (auto numNodes : { 250, 500, 1000, 2000 })
+        std::cout << String (numNodes).paddedLeft (' ', 5) << " nodes: "
+                  << String (timeRebuildForSingleChange (numNodes), 2).paddedLeft (' ', 8) << " ms" << std::endl;
+
+    std::cout << std::endl;
+}
+
+//==============================================================================
+int main (int, char**)
+{
+    // The graph uses timers and async updates, which need a MessageManager
+    const ScopedJuceInitialiser_GUI juceInitialiser;
+
+    benchmarkRebuild();
+    return 0;
+}
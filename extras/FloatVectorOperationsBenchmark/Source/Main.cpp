@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*
+  ==============================================================================
+
+   Times the FloatVectorOperations functions with each of the instruction sets
+   that are available on the current machine, so that the runtime-dispatched
+   AVX2 and AVX-512 versions can be compared against the baseline SSE ones.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+using InstructionSet = FloatVectorOperations::InstructionSet;
+
+//==============================================================================
+static String getName (InstructionSet set)
+{
+    switch (set)
+    {
+        case InstructionSet::baseline:  return "baseline";
+        case InstructionSet::avx2:      return "AVX2";
+        case InstructionSet::avx512:    return "AVX-512";
+    }
+
+    return {};
+}
+
+// Returns the best time, in nanoseconds per sample, from a few runs of the operation
+static double timeOperation (const std::function<void()>& operation, int numSamples)
+{
+    const auto minTicksPerRun = Time::getHighResolutionTicksPerSecond() / 100;
+    auto bestNanosPerSample = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < 5; ++run)
+    {
+        int64 numCalls = 0;
+        const auto start = Time::getHighResolutionTicks();
+        auto elapsed = (int64) 0;
+
+        while (elapsed < minTicksPerRun)
+        {
+            for (int i = 0; i < 16; ++i)
+                operation();
+
+            numCalls += 16;
+            elapsed = Time::getHighResolutionTicks() - start;
+        }
+
+        const auto nanos = Time::highResolutionTicksToSeconds (elapsed) * 1.0e9;
+        bestNanosPerSample = jmin (bestNanosPerSample, nanos / (double) (numCalls * numSamples));
+    }
+
+    return bestNanosPerSample;
+}
+
+//==============================================================================
+template <typename FloatType>
+struct Benchmark
+{
+    explicit Benchmark (int size)
+        : numSamples (size),
+          dest ((size_t) size + 16),
+          src1 ((size_t) size + 16),
+          src2 ((size_t) size + 16),
+          ints ((size_t) size + 16)
+    {
+        Random random (0x1234);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            dest[i] = (FloatType) random.nextFloat();
+            src1[i] = (FloatType) random.nextFloat() - (FloatType) 0.5;
+            src2[i] = (FloatType) random.nextFloat() - (FloatType) 0.5;
+            ints[i] = random.nextInt();
+        }
+    }
+
+    void run (const String& typeName, const Array<InstructionSet>& sets)
+    {
+        auto* d  = dest.get();
+        auto* s1 = src1.get();
+        auto* s2 = src2.get();
+        const auto* i1 = ints.get();
+        const auto num = numSamples;
+
+        std::vector<std::pair<const char*, std::function<void()>>> operations
+        {
+            { "fill",                         [=] { FloatVectorOperations::fill (d, (FloatType) 0.5, num); } },
+            { "copyWithMultiply",             [=] { FloatVectorOperations::copyWithMultiply (d, s1, (FloatType) 0.5, num); } },
+            { "add (value)",                  [=] { FloatVectorOperations::add (d, (FloatType) 0.5, num); } },
+            { "add (src)",                    [=] { FloatVectorOperations::add (d, s1, num); } },
+            { "add (src1, src2)",             [=] { FloatVectorOperations::add (d, s1, s2, num); } },
+            { "subtract (src)",               [=] { FloatVectorOperations::subtract (d, s1, num); } },
+            { "addWithMultiply (value)",      [=] { FloatVectorOperations::addWithMultiply (d, s1, (FloatType) 0.5, num); } },
+            { "addWithMultiply (src1, src2)", [=] { FloatVectorOperations::addWithMultiply (d, s1, s2, num); } },
+            { "multiply (value)",             [=] { FloatVectorOperations::multiply (d, (FloatType) 0.999, num); } },
+            { "multiply (src)",               [=] { FloatVectorOperations::multiply (d, s1, num); } },
+            { "negate",                       [=] { FloatVectorOperations::negate (d, s1, num); } },
+            { "abs",                          [=] { FloatVectorOperations::abs (d, s1, num); } },
+            { "min (src1, src2)",             [=] { FloatVectorOperations::min (d, s1, s2, num); } },
+            { "clip",                         [=] { FloatVectorOperations::clip (d, s1, (FloatType) -0.25, (FloatType) 0.25, num); } },
+            { "findMinAndMax",                [=] { ignoreUnused (FloatVectorOperations::findMinAndMax (s1, num)); } },
+            { "findMaximum",                  [=] { ignoreUnused (FloatVectorOperations::findMaximum (s1, num)); } },
+            { "sum",                          [=] { ignoreUnused (FloatVectorOperations::sum (s1, num)); } },
+            { "sumOfSquares",                 [=] { ignoreUnused (FloatVectorOperations::sumOfSquares (s1, num)); } },
+            { "dotProduct",                   [=] { ignoreUnused (FloatVectorOperations::dotProduct (s1, s2, num)); } },
+            { "multiplyWithRamp",             [=] { FloatVectorOperations::multiplyWithRamp (d, (FloatType) 0.5, (FloatType) 0.5 / (FloatType) num, num); } },
+            { "interleave (stereo)",          [=] { const FloatType* src[] { s1, s2 }; FloatVectorOperations::interleave (d, src, 2, num / 2); } },
+            { "deinterleave (stereo)",        [=] { FloatType* dst[] { s1, s2 }; FloatVectorOperations::deinterleave (dst, d, 2, num / 2); } }
+        };
+
+        if constexpr (std::is_same_v<FloatType, float>)
+            operations.push_back ({ "convertFixedToFloat", [=] { FloatVectorOperations::convertFixedToFloat (d, i1, 1.0f / (float) 0x7fffffff, num); } });
+        else
+            ignoreUnused (i1);
+
+        for (const auto& [name, operation] : operations)
+        {
+            String line;
+            line << (typeName + " " + name).paddedRight (' ', 38) << String (numSamples).paddedLeft (' ', 7);
+
+            double baselineTime = 0;
+
+            for (auto set : sets)
+            {
+                FloatVectorOperations::setInstructionSet (set);
+                const auto time = timeOperation (operation, numSamples);
+
+                if (set == InstructionSet::baseline)
+                    baselineTime = time;
+
+                line << String (time, 3).paddedLeft (' ', 12);
+
+                if (set != InstructionSet::baseline)
+                    line << (" (" + String (baselineTime / time, 2) + "x)").paddedLeft (' ', 9);
+            }
+
+            std::cout << line << std::endl;
+        }
+    }
+
+    int numSamples;
+    HeapBlock<FloatType> dest, src1, src2;
+    HeapBlock<int> ints;
+};
+
+//==============================================================================
+int main (int, char**)
+{
+    ScopedNoDenormals noDenormals;
+
+    Array<InstructionSet> sets;
+
+    for (auto set : { InstructionSet::baseline, InstructionSet::avx2, InstructionSet::avx512 })
+        if (FloatVectorOperations::isInstructionSetAvailable (set))
+            sets.add (set);
+
+    const auto defaultSet = FloatVectorOperations::getInstructionSet();
+
+    std::cout << "CPU: " << SystemStats::getCpuModel() << std::endl
+              << "Default instruction set: " << getName (defaultSet) << std::endl
+              << "Times are in nanoseconds per sample" << std::endl << std::endl;
+
+    String header;
+    header << String ("Operation").paddedRight (' ', 38) << String ("Size").paddedLeft (' ', 7);
+
+    for (auto set : sets)
+        header << getName (set).paddedLeft (' ', set == InstructionSet::baseline ? 12 : 21);
+
+    for (auto size : { 64, 512, 4096, 65536 })
+    {
+        std::cout << header << std::endl;
+
+        Benchmark<float>  (size).run ("float",  sets);
+        Benchmark<double> (size).run ("double", sets);
+
+        std::cout << std::endl;
+    }
+
+    FloatVectorOperations::setInstructionSet (defaultSet);
+    return 0;
+}
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*
+  ==============================================================================
+
+   Times the MIDI classes in juce_audio_basics with large inputs, and compares
+   them against the simpler algorithms that they replaced.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//==============================================================================
+template <typename Fn>
+static double timeInMs (Fn&& fn)
+{
+    const auto start = Time::getMillisecondCounterHiRes();
+    fn();
+    return Time::getMillisecondCounterHiRes() - start;
+}
+
+static void printResult (const String& name, double ms, double linearMs = -1.0)
+{
+    String line;
+    line << name.paddedRight (' ', 48) << String (ms, 3).paddedLeft (' ', 12) << " ms";
+
+    if (linearMs >= 0.0)
+        line << " (linear search " << String (linearMs, 1) << " ms)";
+
+    std::cout << line << std::endl;
+}
+
+//==============================================================================
+static MidiMessageSequence createSequence (int numEvents)
+{
+    Random r (0x1234);
+    MidiMessageSequence sequence;
+    std::vector<double> noteOffTimes (128, -1.0);
+
+    for (double time = 0; sequence.getNumEvents() < numEvents; time += 1.0)
+    {
+        const auto note = 21 + r.nextInt (88);
+
+        if (noteOffTimes[(size_t) note] < 0.0)
+        {
+            sequence.addEvent (MidiMessage::noteOn (1, note, 0.5f), time);
+            noteOffTimes[(size_t) note] = time + 1.0 + r.nextInt (200);
+        }
+
+        for (auto& noteOffTime : noteOffTimes)
+        {
+            if (noteOffTime >= 0.0 && noteOffTime <= time)
+            {
+                sequence.addEvent (MidiMessage::noteOff (1, (int) std::distance (noteOffTimes.data(), &noteOffTime)), time);
+                noteOffTime = -1.0;
+            }
+        }
+    }
+
+    return sequence;
+}
+
+static void benchmarkMidiMessageSequence (int numEvents)
+{
+    auto sequence = createSequence (numEvents);
+    numEvents = sequence.getNumEvents();
+
+    std::cout << "MidiMessageSequence with " << numEvents << " events" << std::endl;
+
+    // The previous implementation searched forwards from every note-on
+    const auto linearPairingTime = timeInMs ([&]
+    {
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const auto& m1 = sequence.getEventPointer (i)->message;
+
+            if (m1.isNoteOn())
+            {
+                for (int j = i + 1; j < numEvents; ++j)
+                {
+                    const auto& m2 = sequence.getEventPointer (j)->message;
+
+                    if (m2.getNoteNumber() == m1.getNoteNumber() && m2.isNoteOff())
+                        break;
+                }
+            }
+        }
+    });
+
+    printResult ("updateMatchedPairs", timeInMs ([&] { sequence.updateMatchedPairs(); }), linearPairingTime);
+
+    auto total = 0;
+
+    printResult ("getIndexOfMatchingKeyUp (every event)", timeInMs ([&]
+    {
+        for (int i = 0; i < numEvents; ++i)
+            total += sequence.getIndexOfMatchingKeyUp (i);
+    }));
+
+    constexpr auto numQueries = 200;
+    const auto endTime = sequence.getEndTime();
+
+    const auto linearQueryTime = timeInMs ([&]
+    {
+        for (int q = 0; q < numQueries; ++q)
+        {
+            const auto t = endTime * q / numQueries;
+            int i = 0;
+
+            while (i < numEvents && sequence.getEventTime (i) < t)
+                ++i;
+
+            total += i;
+        }
+    });
+
+    printResult ("getNextIndexAtTime (" + String (numQueries) + " queries)", timeInMs ([&]
+    {
+        for (int q = 0; q < numQueries; ++q)
+            total += sequence.getNextIndexAtTime (endTime * q / numQueries);
+    }), linearQueryTime);
+
+    // Stops the compiler from optimising the lookups away
+    if (total == 42)
+        std::cout << std::endl;
+
+    std::cout << std::endl;
+}
+
+//==============================================================================
+static void benchmarkUmpConversion()
+{
+    using namespace universal_midi_packets;
+
+    constexpr auto numMessages = 100000;
+    constexpr auto numRepeats = 20;
+
+    MidiBuffer source;
+
+    for (int i = 0; i < numMessages; ++i)
+        source.addEvent (MidiMessage::controllerEvent (1 + (i % 16), i % 120, (i * 7) % 128), i / 100);
+
+    const auto getMessagesPerSecond = [] (auto&& fn)
+    {
+        const auto ms = timeInMs ([&]
+        {
+            for (int i = 0; i < numRepeats; ++i)
+                fn();
+        });
+
+        return String ((double) numMessages * numRepeats / (ms * 1000.0), 1).paddedLeft (' ', 12) + "M messages/s";
+    };
+
+    Packets perMessagePackets;
+    std::vector<uint32_t> words ((size_t) source.data.size() * 2);
+    std::vector<int> positions (words.size());
+    ToUMP1Converter toUmp1;
+    ToUMP2Converter toUmp2;
+
+    std::cout << "UMP conversion of " << numMessages << " controller messages" << std::endl;
+
+    const auto printRate = [] (const String& name, const String& result)
+    {
+        std::cout << name.paddedRight (' ', 48) << result << std::endl;
+    };
+
+    printRate ("MidiBuffer to MIDI 1.0 UMP (per message)", getMessagesPerSecond ([&]
+    {
+        perMessagePackets.clear();
+
+        for (const auto metadata : source)
+            toUmp1.convert (BytesOnGroup { 0, metadata.asSpan() }, [&] (const View& v) { perMessagePackets.add (v); });
+    }));
+
+    printRate ("MidiBuffer to MIDI 1.0 UMP (block)", getMessagesPerSecond ([&] { toUmp1.convert (source, 0, words, positions); }));
+
+    printRate ("MidiBuffer to MIDI 2.0 UMP (per message)", getMessagesPerSecond ([&]
+    {
+        perMessagePackets.clear();
+
+        for (const auto metadata : source)
+            toUmp2.convert (BytesOnGroup { 0, metadata.asSpan() }, [&] (const View& v) { perMessagePackets.add (v); });
+    }));
+
+    printRate ("MidiBuffer to MIDI 2.0 UMP (block)", getMessagesPerSecond ([&] { toUmp2.convert (source, 0, words, positions); }));
+
+    std::cout << std::endl;
+}
+
+//==============================================================================
+int main (int, char**)
+{
+    for (auto numEvents : { 10000, 100000, 1000000 })
+        benchmarkMidiMessageSequence (numEvents);
+
+    benchmarkUmpConversion();
+    return 0;
+}
@@ -0,0 +1,257 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*
+  ==============================================================================
+
+   Times the Synthesiser and its voices under loads that are too heavy for the
+   unit tests.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//==============================================================================
+static AudioBuffer<float> createTestSignal (int numChannels, int numSamples)
+{
+    AudioBuffer<float> buffer (numChannels, numSamples);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        for (int i = 0; i < numSamples; ++i)
+            buffer.setSample (ch, i, 0.5f * std::sin ((float) i * 0.01f * (float) (ch + 1)));
+
+    return buffer;
+}
+
+//==============================================================================
+// Paced runs render at the speed of a real audio device and count underruns.
+// Unpaced runs wait for the disk, and show how fast the voices can be streamed.
+static void benchmarkStreamingSampler (const File& wavFile, int numVoices, bool paced)
+{
+    constexpr auto sampleRate = 44100.0;
+    constexpr auto blockSize = 512;
+
+    SamplerDiskStreamer streamer (4);
+    Synthesiser synth;
+    synth.setCurrentPlaybackSampleRate (sampleRate);
+
+    for (int i = 0; i < numVoices; ++i)
+    {
+        auto* voice = new StreamingSamplerVoice (streamer);
+        voice->setNonRealtime (! paced);
+        synth.addVoice (voice);
+    }
+
+    // a sound, with its own reader, for each group of eight keys
+    for (int key = 0; key < 128; key += 8)
+    {
+        BigInteger keys;
+        keys.setRange (key, 8, true);
+        auto reader = rawToUniquePtr (WavAudioFormat().createReaderFor (wavFile.createInputStream().release(), true));
+        synth.addSound (new StreamingSamplerSound ("test", std::move (reader), keys, key + 4, 0.0, 0.1, 10.0, 0.25));
+    }
+
+    MidiBuffer midi;
+
+    for (int i = 0; i < numVoices; ++i)
+        midi.addEvent (MidiMessage::noteOn (i / 128 + 1, i % 128, 0.1f), 0);
+
+    AudioBuffer<float> output (2, blockSize);
+    const auto numBlocks = (int) (sampleRate / blockSize);
+    const auto blockDurationMs = 1000.0 * blockSize / sampleRate;
+    const auto startTime = Time::getMillisecondCounterHiRes();
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        if (paced)
+            while (Time::getMillisecondCounterHiRes() < startTime + block * blockDurationMs)
+                Thread::sleep (1);
+
+        output.clear();
+        synth.renderNextBlock (output, midi, 0, blockSize);
+        midi.clear();
+    }
+
+    const auto elapsedSeconds = (Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    const auto bytesPerSample = 2 * 2;
+    const auto megabytesPerSecond = (double) streamer.getNumSamplesRead() * bytesPerSample / (elapsedSeconds * 1024.0 * 1024.0);
+
+    String line;
+    line << String (numVoices).paddedLeft (' ', 4) << " voices, ";
+
+    if (paced)
+        line << "in realtime:          " << String (megabytesPerSecond, 1).paddedLeft (' ', 8) << " MB/s, "
+             << streamer.getNumUnderruns() << " underruns";
+    else
+        line << "waiting for the disk: " << String (megabytesPerSecond, 1).paddedLeft (' ', 8) << " MB/s, "
+             << String (1.0 / elapsedSeconds, 1) << "x realtime";
+
+    std::cout << line << std::endl;
+
+    synth.clearVoices();
+}
+
+static void benchmarkStreamingSampler()
+{
+    TemporaryFile tempFile (".wav");
+
+    {
+        const auto signal = createTestSignal (2, 44100 * 4);
+        std::unique_ptr<OutputStream> out = tempFile.getFile().createOutputStream();
+        auto writer = WavAudioFormat().createWriterFor (out, AudioFormatWriterOptions{}.withSampleRate (44100.0)
+                                                                                        .withNumChannels (2)
+                                                                                        .withBitsPerSample (16));
+
+        if (writer == nullptr || ! writer->writeFromAudioSampleBuffer (signal, 0, signal.getNumSamples()))
+        {
+            std::cout << "Couldn't write " << tempFile.getFile().getFullPathName() << std::endl;
+            return;
+        }
+    }
+
+    std::cout << "StreamingSamplerVoice disk throughput" << std::endl;
+
+    for (auto numVoices : { 16, 64, 256 })
+    {
+        benchmarkStreamingSampler (tempFile.getFile(), numVoices, true);
+        benchmarkStreamingSampler (tempFile.getFile(), numVoices, false);
+    }
+
+    std::cout << std::endl;
+}
+
+//==============================================================================
+#if JUCE_USE_SIMD
+
+// A scalar voice that sounds the same as a voice of dsp::SIMDSineVoiceBank
+class SineVoice final : public SynthesiserVoice
+{
+public:
+    bool canPlaySound (SynthesiserSound*) override    { return true; }
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+    {
+        phase = 0.0;
+        delta = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (midiNoteNumber) / getSampleRate();
+        gain = velocity;
+    }
+
+    void stopNote (float, bool) override              { clearCurrentNote(); }
+    void pitchWheelMoved (int) override {}
+    void controllerMoved (int, int) override {}
+
+    void renderNextBlock (AudioBuffer<float>& output, int startSample, int numSamples) override
+    {
+        for (int i = startSample; i < startSample + numSamples; ++i)
+        {
+            const auto sample = (float) (std::sin (phase) * gain);
+            phase += delta;
+
+            for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                output.addSample (ch, i, sample);
+        }
+    }
+
+    using SynthesiserVoice::renderNextBlock;
+
+private:
+    double phase = 0.0, delta = 0.0, gain = 0.0;
+};
+
+struct SineSound final : public SynthesiserSound
+{
+    bool appliesToNote (int) override       { return true; }
+    bool appliesToChannel (int) override    { return true; }
+};
+
+static double timeSineRendering (int numVoices, bool useBank)
+{
+    Synthesiser synth;
+    synth.addSound (new SineSound());
+    synth.setCurrentPlaybackSampleRate (44100.0);
+
+    if (useBank)
+        synth.addVoiceBank (new dsp::SIMDSineVoiceBank (numVoices));
+    else
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice (new SineVoice());
+
+    MidiBuffer midi;
+
+    for (int i = 0; i < numVoices; ++i)
+        midi.addEvent (MidiMessage::noteOn (1, 24 + i % 96, (uint8) 64), 0);
+
+    AudioBuffer<float> output (2, 512);
+    synth.renderNextBlock (output, midi, 0, 512);
+
+    const auto start = Time::getMillisecondCounterHiRes();
+
+    for (int block = 0; block < 200; ++block)
+        synth.renderNextBlock (output, MidiBuffer(), 0, 512);
+
+    return Time::getMillisecondCounterHiRes() - start;
+}
+
+static void benchmarkSIMDSineVoiceBank()
+{
+    std::cout << "SIMDSineVoiceBank against SynthesiserVoices, 200 blocks of 512 samples" << std::endl;
+
+    for (auto numVoices : { 16, 64, 256 })
+    {
+        const auto voicesTime = timeSineRendering (numVoices, false);
+        const auto bankTime = timeSineRendering (numVoices, true);
+
+        std::cout << String (numVoices).paddedLeft (' ', 4) << " voices: SynthesiserVoice "
+                  << String (voicesTime, 2).paddedLeft (' ', 8) << " ms, SIMDSineVoiceBank "
+                  << String (bankTime, 2).paddedLeft (' ', 8) << " ms ("
+                  << String (voicesTime / jmax (bankTime, 0.001), 1) << "x)" << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+#endif
+
+//==============================================================================
+int main (int, char**)
+{
+    benchmarkStreamingSampler();
+
+   #if JUCE_USE_SIMD
+    benchmarkSIMDSineVoiceBank();
+   #endif
+
+    return 0;
+}
@@ -50,6 +50,9 @@ void AudioProcessLoadMeasurer::reset (double sampleRate, int blockSize)
     cpuUsageProportion = 0;
     xruns = 0;
 
+    for (auto& count : histogramCounts)
+        count.store (0, std::memory_order_relaxed);
+
     samplesPerBlock = blockSize;
     msPerSample = (sampleRate > 0.0 && blockSize > 0) ? 1000.0 / sampleRate : 0;
 }
@@ -81,8 +84,93 @@ void AudioProcessLoadMeasurer::registerRenderTimeLocked (double milliseconds, in
     const auto proportion = cpuUsageProportion.load();
     cpuUsageProportion = proportion + filterAmount * (usedProportion - proportion);
 
+    const auto bin = jlimit (0, Histogram::numBins - 1, (int) (usedProportion / Histogram::binWidth));
+    histogramCounts[(size_t) bin].fetch_add (1, std::memory_order_relaxed);
+
     if (milliseconds > maxMilliseconds)
+    {
         ++xruns;
+
+        OverrunEvent event;
+        event.type = OverrunEvent::Type::callbackTooSlow;
+        event.timeMs = Time::getMillisecondCounterHiRes();
+        event.proportionOfDeadline = usedProportion;
+        event.numSamplesOrXRuns = numSamples;
+        pushOverrunEvent (event);
+    }
+}
+
+void AudioProcessLoadMeasurer::pushOverrunEvent (const OverrunEvent& event)
+{
+    if (overrunFifo.getFreeSpace() == 0)
+    {
+        numDroppedOverrunEvents.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto scope = overrunFifo.write (1);
+
+    if (scope.blockSize1 > 0)
+        overrunEvents[(size_t) scope.startIndex1] = event;
+    else
+        overrunEvents[(size_t) scope.startIndex2] = event;
+}
+
+std::vector<AudioProcessLoadMeasurer::OverrunEvent> AudioProcessLoadMeasurer::popOverrunEvents()
+{
+    std::vector<OverrunEvent> result;
+    const auto scope = overrunFifo.read (overrunFifo.getNumReady());
+
+    scope.forEach ([&] (int index) { result.push_back (overrunEvents[(size_t) index]); });
+    return result;
+}
+
+int AudioProcessLoadMeasurer::getNumDroppedOverrunEvents() const
+{
+    return numDroppedOverrunEvents.load (std::memory_order_relaxed);
+}
+
+AudioProcessLoadMeasurer::Histogram AudioProcessLoadMeasurer::getHistogram() const
+{
+    Histogram result;
+
+    for (size_t i = 0; i < histogramCounts.size(); ++i)
+        result.counts[i] = histogramCounts[i].load (std::memory_order_relaxed);
+
+    return result;
+}
+
+//==============================================================================
+uint64 AudioProcessLoadMeasurer::Histogram::getNumCallbacks() const noexcept
+{
+    return std::accumulate (counts.begin(), counts.end(), (uint64) 0);
+}
+
+double AudioProcessLoadMeasurer::Histogram::getPercentile (double percentage) const noexcept
+{
+    const auto total = getNumCallbacks();
+
+    if (total == 0)
+        return 0.0;
+
+    const auto target = jlimit ((uint64) 1, total, (uint64) std::ceil ((double) total * jlimit (0.0, 100.0, percentage) / 100.0));
+    uint64 runningTotal = 0;
+
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        runningTotal += counts[i];
+
+        if (runningTotal >= target)
+            return (double) (i + 1) * binWidth;
+    }
+
+    return numBins * binWidth;
+}
+
+uint64 AudioProcessLoadMeasurer::Histogram::getNumCallbacksOverDeadline() const noexcept
+{
+    const auto firstBinOverDeadline = (size_t) roundToInt (1.0 / binWidth);
+    return std::accumulate (counts.begin() + (ptrdiff_t) firstBinOverDeadline, counts.end(), (uint64) 0);
 }
 
 double AudioProcessLoadMeasurer::getLoadAsProportion() const   { return jlimit (0.0, 1.0, cpuUsageProportion.load()); }
@@ -108,4 +196,98 @@ AudioProcessLoadMeasurer::ScopedTimer::~ScopedTimer()
     owner.registerRenderTime (Time::getMillisecondCounterHiRes() - startTime, samplesInBlock);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessLoadMeasurerTests final : public UnitTest
+{
+public:
+    AudioProcessLoadMeasurerTests()
+        : UnitTest ("AudioProcessLoadMeasurer", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        // With these settings, a 100 sample block has a deadline of 100 ms
+        constexpr auto sampleRate = 1000.0;
+        constexpr auto blockSize = 100;
+
+        beginTest ("Callback durations are recorded in the histogram");
+        {
+            AudioProcessLoadMeasurer measurer;
+            measurer.reset (sampleRate, blockSize);
+
+            expectEquals (measurer.getHistogram().getNumCallbacks(), (uint64) 0);
+            expectEquals (measurer.getHistogram().getPercentile (50.0), 0.0);
+
+            for (int i = 0; i < 90; ++i)
+                measurer.registerRenderTime (10.5, blockSize);
+
+            for (int i = 0; i < 9; ++i)
+                measurer.registerRenderTime (50.5, blockSize);
+
+            measurer.registerRenderTime (150.5, blockSize);
+
+            const auto histogram = measurer.getHistogram();
+            expectEquals (histogram.getNumCallbacks(), (uint64) 100);
+            expectEquals (histogram.getNumCallbacksOverDeadline(), (uint64) 1);
+            expectWithinAbsoluteError (histogram.getPercentile (50.0), 0.11, 1.0e-9);
+            expectWithinAbsoluteError (histogram.getPercentile (90.0), 0.11, 1.0e-9);
+            expectWithinAbsoluteError (histogram.getPercentile (95.0), 0.51, 1.0e-9);
+            expectWithinAbsoluteError (histogram.getPercentile (100.0), 1.51, 1.0e-9);
+            expectEquals (measurer.getXRunCount(), 1);
+
+            measurer.registerRenderTime (10000.0, blockSize);
+            expectEquals (measurer.getHistogram().counts.back(), (uint64) 1);
+
+            measurer.reset (sampleRate, blockSize);
+            expectEquals (measurer.getHistogram().getNumCallbacks(), (uint64) 0);
+        }
+
+        beginTest ("Slow callbacks are queued as overrun events");
+        {
+            AudioProcessLoadMeasurer measurer;
+            measurer.reset (sampleRate, blockSize);
+
+            measurer.registerRenderTime (50.0, blockSize);
+            expect (measurer.popOverrunEvents().empty());
+
+            measurer.registerRenderTime (150.0, blockSize / 2);
+
+            const auto events = measurer.popOverrunEvents();
+            expectEquals ((int) events.size(), 1);
+            expect (events[0].type == OverrunEvent::Type::callbackTooSlow);
+            expectWithinAbsoluteError (events[0].proportionOfDeadline, 3.0, 1.0e-9);
+            expectEquals (events[0].numSamplesOrXRuns, blockSize / 2);
+            expect (events[0].timeMs > 0.0);
+
+            expect (measurer.popOverrunEvents().empty());
+        }
+
+        beginTest ("Overrun events are dropped when the queue is full");
+        {
+            AudioProcessLoadMeasurer measurer;
+            measurer.reset (sampleRate, blockSize);
+
+            for (int i = 0; i < 100; ++i)
+                measurer.registerRenderTime (200.0, blockSize);
+
+            const auto numQueued = (int) measurer.popOverrunEvents().size();
+            expect (numQueued > 0);
+            expectEquals (numQueued + measurer.getNumDroppedOverrunEvents(), 100);
+
+            measurer.registerRenderTime (200.0, blockSize);
+            expectEquals ((int) measurer.popOverrunEvents().size(), 1);
+        }
+    }
+
+private:
+    using OverrunEvent = AudioProcessLoadMeasurer::OverrunEvent;
+};
+
+static AudioProcessLoadMeasurerTests audioProcessLoadMeasurerTests;
+
+#endif
+
 } // namespace juce
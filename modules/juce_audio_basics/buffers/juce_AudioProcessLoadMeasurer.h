@@ -40,6 +40,11 @@ namespace juce
     Maintains an ongoing measurement of the proportion of time which is being
     spent inside an audio callback.
 
+    As well as the smoothed load, the measurer keeps a histogram of the duration of
+    every callback, relative to the time available for it, and a queue of the
+    callbacks that overran. These are recorded without locking or allocating, so that
+    they can be safely gathered on the audio thread and read on another thread.
+
     @tags{Audio}
 */
 class JUCE_API  AudioProcessLoadMeasurer
@@ -67,6 +72,88 @@ public:
     /** Returns the number of over- (or under-) runs recorded since the state was reset. */
     int getXRunCount() const;
 
+    //==============================================================================
+    /** A snapshot of the distribution of callback durations.
+
+        Each callback's duration is recorded as a proportion of its deadline, i.e. the
+        duration of the audio that it processed, so a value of 1.0 means that the callback
+        used all of the time that it had.
+
+        @see getHistogram
+    */
+    struct JUCE_API  Histogram
+    {
+        /** The number of bins in the histogram. */
+        static constexpr int numBins = 256;
+
+        /** The width of each bin, as a proportion of the deadline. The final bin also
+            counts all of the callbacks that took longer than its lower edge.
+        */
+        static constexpr double binWidth = 0.01;
+
+        /** Returns the total number of callbacks that were recorded. */
+        uint64 getNumCallbacks() const noexcept;
+
+        /** Returns the duration, as a proportion of the deadline, that the given percentage
+            (0 to 100) of callbacks didn't exceed. The result is the upper edge of the bin
+            that contains the percentile, or 0 if no callbacks have been recorded.
+        */
+        double getPercentile (double percentage) const noexcept;
+
+        /** Returns the number of callbacks that used all of their deadline, or more. */
+        uint64 getNumCallbacksOverDeadline() const noexcept;
+
+        /** The number of callbacks in each bin. */
+        std::array<uint64, (size_t) numBins> counts{};
+    };
+
+    /** Returns a snapshot of the callback durations recorded since the state was reset.
+
+        This can be called from any thread.
+    */
+    Histogram getHistogram() const;
+
+    //==============================================================================
+    /** Describes an xrun, either a callback that took longer than its deadline, or one
+        that was reported by the audio device.
+
+        @see popOverrunEvents
+    */
+    struct OverrunEvent
+    {
+        enum class Type
+        {
+            callbackTooSlow,    /**< A callback took longer than the duration of the audio that it processed. */
+            reportedByDevice    /**< The audio device reported xruns. The measurer never creates these itself,
+                                     but AudioDeviceManager uses them for the xruns that its device reports. */
+        };
+
+        Type type = Type::callbackTooSlow;
+
+        /** The value of Time::getMillisecondCounterHiRes() when the event was recorded. */
+        double timeMs = 0.0;
+
+        /** For a slow callback, its duration as a proportion of its deadline. */
+        double proportionOfDeadline = 0.0;
+
+        /** For a slow callback, the number of samples that it processed. For xruns
+            reported by the device, the number of new xruns.
+        */
+        int numSamplesOrXRuns = 0;
+    };
+
+    /** Removes the oldest overrun events from the queue and returns them.
+
+        Events are added on the audio thread, and this should be regularly called from a
+        single other thread, such as the message thread. If it isn't called often enough,
+        the queue fills up, and any further events are discarded until there is space.
+        Resetting the measurer doesn't remove the events that are waiting in the queue.
+    */
+    std::vector<OverrunEvent> popOverrunEvents();
+
+    /** Returns the number of overrun events that were discarded because the queue was full. */
+    int getNumDroppedOverrunEvents() const;
+
     //==============================================================================
     /** This class measures the time between its construction and destruction and
         adds it to an AudioProcessLoadMeasurer.
@@ -109,12 +196,20 @@ public:
 
 private:
     void registerRenderTimeLocked (double, int);
+    void pushOverrunEvent (const OverrunEvent&);
+
+    static constexpr int overrunQueueSize = 64;
 
     SpinLock mutex;
     int samplesPerBlock = 0;
     double msPerSample = 0;
     std::atomic<double> cpuUsageProportion { 0 };
     std::atomic<int> xruns { 0 };
+
+    std::array<std::atomic<uint64>, (size_t) Histogram::numBins> histogramCounts{};
+    AbstractFifo overrunFifo { overrunQueueSize };
+    std::array<OverrunEvent, (size_t) overrunQueueSize> overrunEvents;
+    std::atomic<int> numDroppedOverrunEvents { 0 };
 };
 
 
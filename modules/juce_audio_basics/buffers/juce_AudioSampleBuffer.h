@@ -759,14 +759,8 @@ public:
         if (isClear)
             return;
 
-        const auto increment = (endGain - startGain) / (float) numSamples;
-        auto* d = channels[channel] + startSample;
-
-        while (--numSamples >= 0)
-        {
-            *d++ *= startGain;
-            startGain += increment;
-        }
+        FloatVectorOperations::multiplyWithRamp (channels[channel] + startSample, startGain,
+                                                 (endGain - startGain) / (Type) numSamples, numSamples);
     }
 
     /** Applies a range of gains to a region of all channels.
@@ -1124,14 +1118,14 @@ public:
         if (numSamples <= 0 || isClear || ! isPositiveAndBelow (channel, numChannels))
             return Type (0);
 
+        // Each chunk is summed with the vectorised operation, but the chunks are added up in
+        // double precision, so that long regions of float samples don't lose precision
+        constexpr int chunkSize = 256;
         auto* data = channels[channel] + startSample;
         double sum = 0.0;
 
-        for (int i = 0; i < numSamples; ++i)
-        {
-            auto sample = data[i];
-            sum += sample * sample;
-        }
+        for (int i = 0; i < numSamples; i += chunkSize)
+            sum += (double) FloatVectorOperations::sumOfSquares (data + i, jmin (chunkSize, numSamples - i));
 
         return static_cast<Type> (std::sqrt (sum / numSamples));
     }
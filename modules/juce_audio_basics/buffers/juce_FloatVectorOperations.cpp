@@ -77,6 +77,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+        static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return (v[0] + v[1]) + (v[2] + v[3]); }
     };
 
     struct BasicOps64
@@ -109,6 +110,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1]); }
         static forcedinline Type min (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1]); }
+        static forcedinline Type sum (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return v[0] + v[1]; }
     };
 
 
@@ -242,6 +244,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+        static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return (v[0] + v[1]) + (v[2] + v[3]); }
     };
 
     struct BasicOps64
@@ -274,6 +277,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept  { return a; }
         static forcedinline Type min (ParallelType a) noexcept  { return a; }
+        static forcedinline Type sum (ParallelType a) noexcept  { return a; }
     };
 
     #define JUCE_BEGIN_VEC_OP \
@@ -501,8 +505,109 @@ namespace FloatVectorHelpers
             return Range<Type>::findMinAndMax (src, num);
         }
     };
+
+    template <typename Mode>
+    struct Reductions
+    {
+        using Type = typename Mode::Type;
+        using ParallelType = typename Mode::ParallelType;
+
+        // Keeping several partial sums hides the latency of the additions, and also
+        // reduces the rounding error compared to a single running total.
+        template <typename Size, typename VectorOp, typename ScalarOp>
+        static Type accumulate (Size num, VectorOp&& vectorOp, ScalarOp&& scalarOp) noexcept
+        {
+            constexpr auto numParallel = (Size) Mode::numParallel;
+
+            auto acc0 = Mode::load1 (0), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+            Size i = 0;
+
+            for (; i + 4 * numParallel <= num; i += 4 * numParallel)
+            {
+                acc0 = vectorOp (acc0, i);
+                acc1 = vectorOp (acc1, i + numParallel);
+                acc2 = vectorOp (acc2, i + 2 * numParallel);
+                acc3 = vectorOp (acc3, i + 3 * numParallel);
+            }
+
+            auto result = Mode::sum (Mode::add (Mode::add (acc0, acc1), Mode::add (acc2, acc3)));
+
+            for (; i < num; ++i)
+                result = scalarOp (result, i);
+
+            return result;
+        }
+
+        template <typename Size>
+        static Type sum (const Type* src, Size num) noexcept
+        {
+            return accumulate (num,
+                               [src] (ParallelType acc, Size i) { return Mode::add (acc, Mode::loadU (src + i)); },
+                               [src] (Type acc, Size i)         { return acc + src[i]; });
+        }
+
+        template <typename Size>
+        static Type sumOfSquares (const Type* src, Size num) noexcept
+        {
+            return accumulate (num,
+                               [src] (ParallelType acc, Size i) { const auto s = Mode::loadU (src + i); return Mode::add (acc, Mode::mul (s, s)); },
+                               [src] (Type acc, Size i)         { return acc + src[i] * src[i]; });
+        }
+
+        template <typename Size>
+        static Type dotProduct (const Type* src1, const Type* src2, Size num) noexcept
+        {
+            return accumulate (num,
+                               [src1, src2] (ParallelType acc, Size i) { return Mode::add (acc, Mode::mul (Mode::loadU (src1 + i), Mode::loadU (src2 + i))); },
+                               [src1, src2] (Type acc, Size i)         { return acc + src1[i] * src2[i]; });
+        }
+
+        // The gain for each sample is calculated from its index rather than by repeatedly
+        // adding the increment, so that rounding errors don't build up over long ramps.
+        template <typename Size>
+        static void multiplyWithRamp (Type* dest, Type startGain, Type increment, Size num) noexcept
+        {
+            constexpr auto numParallel = (Size) Mode::numParallel;
+
+            Type firstIndices[Mode::numParallel];
+
+            for (int i = 0; i < Mode::numParallel; ++i)
+                firstIndices[i] = (Type) i;
+
+            auto indices = Mode::loadU (firstIndices);
+            const auto start = Mode::load1 (startGain);
+            const auto inc = Mode::load1 (increment);
+            const auto step = Mode::load1 ((Type) Mode::numParallel);
+            Size i = 0;
+
+            for (; i + numParallel <= num; i += numParallel)
+            {
+                Mode::storeU (dest + i, Mode::mul (Mode::loadU (dest + i), Mode::add (start, Mode::mul (indices, inc))));
+                indices = Mode::add (indices, step);
+            }
+
+            for (; i < num; ++i)
+                dest[i] *= startGain + (Type) i * increment;
+        }
+    };
    #endif
 
+    template <typename Type, typename Size>
+    static void interleaveFrom (Size startSample, Type* dest, const Type* const* src, int numChannels, Size num) noexcept
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (auto i = startSample; i < num; ++i)
+                dest[(size_t) i * (size_t) numChannels + (size_t) ch] = src[ch][i];
+    }
+
+    template <typename Type, typename Size>
+    static void deinterleaveFrom (Size startSample, Type* const* dest, const Type* src, int numChannels, Size num) noexcept
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (auto i = startSample; i < num; ++i)
+                dest[ch][i] = src[(size_t) i * (size_t) numChannels + (size_t) ch];
+    }
+
 //==============================================================================
 namespace
 {
@@ -1180,7 +1285,317 @@ namespace
        #endif
     }
 
+    template <typename Size>
+    float sum (const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        float result = 0;
+        vDSP_sve (src, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reductions<FloatVectorHelpers::BasicOps32>::sum (src, num);
+       #else
+        return std::accumulate (src, src + jmax ((Size) 0, num), 0.0f);
+       #endif
+    }
+
+    template <typename Size>
+    double sum (const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        double result = 0;
+        vDSP_sveD (src, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reductions<FloatVectorHelpers::BasicOps64>::sum (src, num);
+       #else
+        return std::accumulate (src, src + jmax ((Size) 0, num), 0.0);
+       #endif
+    }
+
+    template <typename Size>
+    float sumOfSquares (const float* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        float result = 0;
+        vDSP_svesq (src, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reductions<FloatVectorHelpers::BasicOps32>::sumOfSquares (src, num);
+       #else
+        return std::inner_product (src, src + jmax ((Size) 0, num), src, 0.0f);
+       #endif
+    }
+
+    template <typename Size>
+    double sumOfSquares (const double* src, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        double result = 0;
+        vDSP_svesqD (src, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reductions<FloatVectorHelpers::BasicOps64>::sumOfSquares (src, num);
+       #else
+        return std::inner_product (src, src + jmax ((Size) 0, num), src, 0.0);
+       #endif
+    }
+
+    template <typename Size>
+    float dotProduct (const float* src1, const float* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        float result = 0;
+        vDSP_dotpr (src1, 1, src2, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reductions<FloatVectorHelpers::BasicOps32>::dotProduct (src1, src2, num);
+       #else
+        return std::inner_product (src1, src1 + jmax ((Size) 0, num), src2, 0.0f);
+       #endif
+    }
+
+    template <typename Size>
+    double dotProduct (const double* src1, const double* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        double result = 0;
+        vDSP_dotprD (src1, 1, src2, 1, &result, (vDSP_Length) num);
+        return result;
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        return FloatVectorHelpers::Reductions<FloatVectorHelpers::BasicOps64>::dotProduct (src1, src2, num);
+       #else
+        return std::inner_product (src1, src1 + jmax ((Size) 0, num), src2, 0.0);
+       #endif
+    }
+
+    template <typename Size>
+    void multiplyWithRamp (float* dest, float startGain, float increment, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vrampmul (dest, 1, &startGain, &increment, dest, 1, (vDSP_Length) num);
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        FloatVectorHelpers::Reductions<FloatVectorHelpers::BasicOps32>::multiplyWithRamp (dest, startGain, increment, num);
+       #else
+        for (Size i = 0; i < num; ++i)
+            dest[i] *= startGain + (float) i * increment;
+       #endif
+    }
+
+    template <typename Size>
+    void multiplyWithRamp (double* dest, double startGain, double increment, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        vDSP_vrampmulD (dest, 1, &startGain, &increment, dest, 1, (vDSP_Length) num);
+       #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        FloatVectorHelpers::Reductions<FloatVectorHelpers::BasicOps64>::multiplyWithRamp (dest, startGain, increment, num);
+       #else
+        for (Size i = 0; i < num; ++i)
+            dest[i] *= startGain + (double) i * increment;
+       #endif
+    }
+
+    template <typename Size>
+    void interleave (float* dest, const float* const* src, int numChannels, Size num) noexcept
+    {
+        Size i = 0;
+
+        if (numChannels == 2)
+        {
+           #if JUCE_USE_VDSP_FRAMEWORK
+            DSPSplitComplex split { const_cast<float*> (src[0]), const_cast<float*> (src[1]) };
+            vDSP_ztoc (&split, 1, reinterpret_cast<DSPComplex*> (dest), 2, (vDSP_Length) num);
+            return;
+           #elif JUCE_USE_SSE_INTRINSICS
+            for (; i + 4 <= num; i += 4)
+            {
+                const auto l = _mm_loadu_ps (src[0] + i), r = _mm_loadu_ps (src[1] + i);
+                _mm_storeu_ps (dest + 2 * i,     _mm_unpacklo_ps (l, r));
+                _mm_storeu_ps (dest + 2 * i + 4, _mm_unpackhi_ps (l, r));
+            }
+           #elif JUCE_USE_ARM_NEON
+            for (; i + 4 <= num; i += 4)
+                vst2q_f32 (dest + 2 * i, float32x4x2_t { { vld1q_f32 (src[0] + i), vld1q_f32 (src[1] + i) } });
+           #endif
+        }
+
+        interleaveFrom (i, dest, src, numChannels, num);
+    }
+
+    template <typename Size>
+    void interleave (double* dest, const double* const* src, int numChannels, Size num) noexcept
+    {
+        Size i = 0;
+
+        if (numChannels == 2)
+        {
+           #if JUCE_USE_VDSP_FRAMEWORK
+            DSPDoubleSplitComplex split { const_cast<double*> (src[0]), const_cast<double*> (src[1]) };
+            vDSP_ztocD (&split, 1, reinterpret_cast<DSPDoubleComplex*> (dest), 2, (vDSP_Length) num);
+            return;
+           #elif JUCE_USE_SSE_INTRINSICS
+            for (; i + 2 <= num; i += 2)
+            {
+                const auto l = _mm_loadu_pd (src[0] + i), r = _mm_loadu_pd (src[1] + i);
+                _mm_storeu_pd (dest + 2 * i,     _mm_unpacklo_pd (l, r));
+                _mm_storeu_pd (dest + 2 * i + 2, _mm_unpackhi_pd (l, r));
+            }
+           #endif
+        }
+
+        interleaveFrom (i, dest, src, numChannels, num);
+    }
+
+    template <typename Size>
+    void deinterleave (float* const* dest, const float* src, int numChannels, Size num) noexcept
+    {
+        Size i = 0;
+
+        if (numChannels == 2)
+        {
+           #if JUCE_USE_VDSP_FRAMEWORK
+            DSPSplitComplex split { dest[0], dest[1] };
+            vDSP_ctoz (reinterpret_cast<const DSPComplex*> (src), 2, &split, 1, (vDSP_Length) num);
+            return;
+           #elif JUCE_USE_SSE_INTRINSICS
+            for (; i + 4 <= num; i += 4)
+            {
+                const auto a = _mm_loadu_ps (src + 2 * i), b = _mm_loadu_ps (src + 2 * i + 4);
+                _mm_storeu_ps (dest[0] + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0)));
+                _mm_storeu_ps (dest[1] + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1)));
+            }
+           #elif JUCE_USE_ARM_NEON
+            for (; i + 4 <= num; i += 4)
+            {
+                const auto lr = vld2q_f32 (src + 2 * i);
+                vst1q_f32 (dest[0] + i, lr.val[0]);
+                vst1q_f32 (dest[1] + i, lr.val[1]);
+            }
+           #endif
+        }
+
+        deinterleaveFrom (i, dest, src, numChannels, num);
+    }
+
+    template <typename Size>
+    void deinterleave (double* const* dest, const double* src, int numChannels, Size num) noexcept
+    {
+        Size i = 0;
+
+        if (numChannels == 2)
+        {
+           #if JUCE_USE_VDSP_FRAMEWORK
+            DSPDoubleSplitComplex split { dest[0], dest[1] };
+            vDSP_ctozD (reinterpret_cast<const DSPDoubleComplex*> (src), 2, &split, 1, (vDSP_Length) num);
+            return;
+           #elif JUCE_USE_SSE_INTRINSICS
+            for (; i + 2 <= num; i += 2)
+            {
+                const auto a = _mm_loadu_pd (src + 2 * i), b = _mm_loadu_pd (src + 2 * i + 2);
+                _mm_storeu_pd (dest[0] + i, _mm_unpacklo_pd (a, b));
+                _mm_storeu_pd (dest[1] + i, _mm_unpackhi_pd (a, b));
+            }
+           #endif
+        }
+
+        deinterleaveFrom (i, dest, src, numChannels, num);
+    }
+
 } // namespace
+
+   #if JUCE_USE_AVX_DISPATCH
+    using InstructionSet = FloatVectorOperations::InstructionSet;
+
+    /*  The CPUID feature bits that SystemStats reports only say what the CPU can do. The
+        wider registers can only be used if the OS saves them on a context switch, which it
+        reports with the OSXSAVE bit and in the XCR0 register.
+    */
+    static uint64 getRegisterStatesSavedByOS() noexcept
+    {
+        constexpr uint32 osxsaveBit = 1u << 27;
+
+       #if JUCE_MSVC
+        int info[4] {};
+        __cpuid (info, 1);
+
+        if (((uint32) info[2] & osxsaveBit) == 0)
+            return 0;
+
+        return (uint64) _xgetbv (0);
+       #else
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+        if (! __get_cpuid (1, &eax, &ebx, &ecx, &edx) || (ecx & osxsaveBit) == 0)
+            return 0;
+
+        uint32 low = 0, high = 0;
+        __asm__ volatile ("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+        return ((uint64) high << 32) | low;
+       #endif
+    }
+
+    static bool isAvailable (InstructionSet set) noexcept
+    {
+        constexpr uint64 xmmAndYmmState = 0x06;                       // SSE and AVX
+        constexpr uint64 avx512State    = 0xe0 | xmmAndYmmState; // opmask, ZMM0-15 and ZMM16-31
+
+        static const auto savedStates = getRegisterStatesSavedByOS();
+
+        switch (set)
+        {
+            case InstructionSet::baseline:  return true;
+            case InstructionSet::avx2:      return SystemStats::hasAVX2() && SystemStats::hasFMA3()
+                                                && (savedStates & xmmAndYmmState) == xmmAndYmmState;
+            case InstructionSet::avx512:    return SystemStats::hasAVX512F()
+                                                && (savedStates & avx512State) == avx512State;
+        }
+
+        return false;
+    }
+
+    template <typename FloatType>
+    static const KernelTable<FloatType>* getKernels (InstructionSet set) noexcept
+    {
+        switch (set)
+        {
+            case InstructionSet::baseline:  return nullptr;
+            case InstructionSet::avx2:      return &getAVX2Kernels<FloatType>();
+            case InstructionSet::avx512:    return &getAVX512Kernels<FloatType>();
+        }
+
+        return nullptr;
+    }
+
+    static InstructionSet getBestAvailableInstructionSet() noexcept
+    {
+        for (auto set : { InstructionSet::avx512, InstructionSet::avx2 })
+            if (isAvailable (set))
+                return set;
+
+        return InstructionSet::baseline;
+    }
+
+    // A null pointer means that the baseline versions above should be used.
+    template <typename FloatType>
+    static std::atomic<const KernelTable<FloatType>*>& getCurrentKernels() noexcept
+    {
+        static std::atomic<const KernelTable<FloatType>*> kernels { getKernels<FloatType> (getBestAvailableInstructionSet()) };
+        return kernels;
+    }
+
+    template <typename CountType>
+    static size_t toKernelCount (CountType num) noexcept
+    {
+        return (size_t) jmax (CountType(), num);
+    }
+
+    #define JUCE_DISPATCH_TO_KERNEL(FloatType, function, num, ...) \
+        if (auto* kernels = FloatVectorHelpers::getCurrentKernels<FloatType>().load (std::memory_order_relaxed)) \
+            return kernels->function (__VA_ARGS__, FloatVectorHelpers::toKernelCount (num));
+   #else
+    #define JUCE_DISPATCH_TO_KERNEL(FloatType, function, num, ...)
+   #endif
+
 } // namespace FloatVectorHelpers
 
 //==============================================================================
@@ -1196,6 +1611,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::fill (FloatT
                                                                           FloatType valueToFill,
                                                                           CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, fill, numValues, dest, valueToFill)
     FloatVectorHelpers::fill (dest, valueToFill, numValues);
 }
 
@@ -1213,6 +1629,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::copyWithMult
                                                                                       FloatType multiplier,
                                                                                       CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, copyWithMultiply, numValues, dest, src, multiplier)
     FloatVectorHelpers::copyWithMultiply (dest, src, multiplier, numValues);
 }
 
@@ -1221,6 +1638,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::add (FloatTy
                                                                          FloatType amountToAdd,
                                                                          CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, addValue, numValues, dest, amountToAdd)
     FloatVectorHelpers::add (dest, amountToAdd, numValues);
 }
 
@@ -1230,6 +1648,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::add (FloatTy
                                                                          FloatType amount,
                                                                          CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, addSrcValue, numValues, dest, src, amount)
     FloatVectorHelpers::add (dest, src, amount, numValues);
 }
 
@@ -1238,6 +1657,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::add (FloatTy
                                                                          const FloatType* src,
                                                                          CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, addSrc, numValues, dest, src)
     FloatVectorHelpers::add (dest, src, numValues);
 }
 
@@ -1247,6 +1667,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::add (FloatTy
                                                                          const FloatType* src2,
                                                                          CountType num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, addSrc1Src2, num, dest, src1, src2)
     FloatVectorHelpers::add (dest, src1, src2, num);
 }
 
@@ -1255,6 +1676,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::subtract (Fl
                                                                               const FloatType* src,
                                                                               CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, subtractSrc, numValues, dest, src)
     FloatVectorHelpers::subtract (dest, src, numValues);
 }
 
@@ -1264,6 +1686,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::subtract (Fl
                                                                               const FloatType* src2,
                                                                               CountType num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, subtractSrc1Src2, num, dest, src1, src2)
     FloatVectorHelpers::subtract (dest, src1, src2, num);
 }
 
@@ -1273,6 +1696,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::addWithMulti
                                                                                      FloatType multiplier,
                                                                                      CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, addWithMultiplySrcValue, numValues, dest, src, multiplier)
     FloatVectorHelpers::addWithMultiply (dest, src, multiplier, numValues);
 }
 
@@ -1282,6 +1706,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::addWithMulti
                                                                                      const FloatType* src2,
                                                                                      CountType num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, addWithMultiplySrc1Src2, num, dest, src1, src2)
     FloatVectorHelpers::addWithMultiply (dest, src1, src2, num);
 }
 
@@ -1291,6 +1716,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::subtractWith
                                                                                           FloatType multiplier,
                                                                                           CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, subtractWithMultiplySrcValue, numValues, dest, src, multiplier)
     FloatVectorHelpers::subtractWithMultiply (dest, src, multiplier, numValues);
 }
 
@@ -1300,6 +1726,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::subtractWith
                                                                                           const FloatType* src2,
                                                                                           CountType num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, subtractWithMultiplySrc1Src2, num, dest, src1, src2)
     FloatVectorHelpers::subtractWithMultiply (dest, src1, src2, num);
 }
 
@@ -1308,6 +1735,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiply (Fl
                                                                               const FloatType* src,
                                                                               CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, multiplySrc, numValues, dest, src)
     FloatVectorHelpers::multiply (dest, src, numValues);
 }
 
@@ -1317,6 +1745,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiply (Fl
                                                                               const FloatType* src2,
                                                                               CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, multiplySrc1Src2, numValues, dest, src1, src2)
     FloatVectorHelpers::multiply (dest, src1, src2, numValues);
 }
 
@@ -1325,6 +1754,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiply (Fl
                                                                               FloatType multiplier,
                                                                               CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, multiplyValue, numValues, dest, multiplier)
     FloatVectorHelpers::multiply (dest, multiplier, numValues);
 }
 
@@ -1334,6 +1764,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiply (Fl
                                                                               FloatType multiplier,
                                                                               CountType num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, multiplySrcValue, num, dest, src, multiplier)
     FloatVectorHelpers::multiply (dest, src, multiplier, num);
 }
 
@@ -1342,6 +1773,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::negate (Floa
                                                                             const FloatType* src,
                                                                             CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, negate, numValues, dest, src)
     FloatVectorHelpers::negate (dest, src, numValues);
 }
 
@@ -1350,6 +1782,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::abs (FloatTy
                                                                          const FloatType* src,
                                                                          CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, abs, numValues, dest, src)
     FloatVectorHelpers::abs (dest, src, numValues);
 }
 
@@ -1359,6 +1792,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::min (FloatTy
                                                                          FloatType comp,
                                                                          CountType num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, minSrcValue, num, dest, src, comp)
     FloatVectorHelpers::min (dest, src, comp, num);
 }
 
@@ -1368,6 +1802,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::min (FloatTy
                                                                          const FloatType* src2,
                                                                          CountType num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, minSrc1Src2, num, dest, src1, src2)
     FloatVectorHelpers::min (dest, src1, src2, num);
 }
 
@@ -1377,6 +1812,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::max (FloatTy
                                                                          FloatType comp,
                                                                          CountType num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, maxSrcValue, num, dest, src, comp)
     FloatVectorHelpers::max (dest, src, comp, num);
 }
 
@@ -1386,6 +1822,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::max (FloatTy
                                                                          const FloatType* src2,
                                                                          CountType num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, maxSrc1Src2, num, dest, src1, src2)
     FloatVectorHelpers::max (dest, src1, src2, num);
 }
 
@@ -1396,6 +1833,7 @@ void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::clip (FloatT
                                                                           FloatType high,
                                                                           CountType num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, clip, num, dest, src, low, high)
     FloatVectorHelpers::clip (dest, src, low, high, num);
 }
 
@@ -1403,6 +1841,7 @@ template <typename FloatType, typename CountType>
 Range<FloatType> JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findMinAndMax (const FloatType* src,
                                                                                                CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, findMinAndMax, numValues, src)
     return FloatVectorHelpers::findMinAndMax (src, numValues);
 }
 
@@ -1410,6 +1849,7 @@ template <typename FloatType, typename CountType>
 FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findMinimum (const FloatType* src,
                                                                                       CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, findMinimum, numValues, src)
     return FloatVectorHelpers::findMinimum (src, numValues);
 }
 
@@ -1417,9 +1857,73 @@ template <typename FloatType, typename CountType>
 FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findMaximum (const FloatType* src,
                                                                                       CountType numValues) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (FloatType, findMaximum, numValues, src)
     return FloatVectorHelpers::findMaximum (src, numValues);
 }
 
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::sum (const FloatType* src,
+                                                                              CountType numValues) noexcept
+{
+    JUCE_DISPATCH_TO_KERNEL (FloatType, sum, numValues, src)
+    return FloatVectorHelpers::sum (src, numValues);
+}
+
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::sumOfSquares (const FloatType* src,
+                                                                                       CountType numValues) noexcept
+{
+    JUCE_DISPATCH_TO_KERNEL (FloatType, sumOfSquares, numValues, src)
+    return FloatVectorHelpers::sumOfSquares (src, numValues);
+}
+
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::dotProduct (const FloatType* src1,
+                                                                                     const FloatType* src2,
+                                                                                     CountType num) noexcept
+{
+    JUCE_DISPATCH_TO_KERNEL (FloatType, dotProduct, num, src1, src2)
+    return FloatVectorHelpers::dotProduct (src1, src2, num);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::multiplyWithRamp (FloatType* dest,
+                                                                                      FloatType startGain,
+                                                                                      FloatType gainIncrement,
+                                                                                      CountType numValues) noexcept
+{
+    JUCE_DISPATCH_TO_KERNEL (FloatType, multiplyWithRamp, numValues, dest, startGain, gainIncrement)
+    FloatVectorHelpers::multiplyWithRamp (dest, startGain, gainIncrement, numValues);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::interleave (FloatType* dest,
+                                                                                const FloatType* const* src,
+                                                                                int numChannels,
+                                                                                CountType numSamples) noexcept
+{
+    if (numChannels == 2)
+    {
+        JUCE_DISPATCH_TO_KERNEL (FloatType, interleaveStereo, numSamples, dest, src[0], src[1])
+    }
+
+    FloatVectorHelpers::interleave (dest, src, numChannels, numSamples);
+}
+
+template <typename FloatType, typename CountType>
+void JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::deinterleave (FloatType* const* dest,
+                                                                                  const FloatType* src,
+                                                                                  int numChannels,
+                                                                                  CountType numSamples) noexcept
+{
+    if (numChannels == 2)
+    {
+        JUCE_DISPATCH_TO_KERNEL (FloatType, deinterleaveStereo, numSamples, dest[0], dest[1], src)
+    }
+
+    FloatVectorHelpers::deinterleave (dest, src, numChannels, numSamples);
+}
+
 template struct FloatVectorOperationsBase<float, int>;
 template struct FloatVectorOperationsBase<float, size_t>;
 template struct FloatVectorOperationsBase<double, int>;
@@ -1427,14 +1931,54 @@ template struct FloatVectorOperationsBase<double, size_t>;
 
 void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, const int* src, float multiplier, size_t num) noexcept
 {
-   FloatVectorHelpers::convertFixedToFloat (dest, src, multiplier, num);
+    JUCE_DISPATCH_TO_KERNEL (float, convertFixedToFloat, num, dest, src, multiplier)
+    FloatVectorHelpers::convertFixedToFloat (dest, src, multiplier, num);
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, const int* src, float multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_KERNEL (float, convertFixedToFloat, num, dest, src, multiplier)
     FloatVectorHelpers::convertFixedToFloat (dest, src, multiplier, num);
 }
 
+#undef JUCE_DISPATCH_TO_KERNEL
+
+//==============================================================================
+FloatVectorOperations::InstructionSet JUCE_CALLTYPE FloatVectorOperations::getInstructionSet() noexcept
+{
+   #if JUCE_USE_AVX_DISPATCH
+    const auto* current = FloatVectorHelpers::getCurrentKernels<float>().load (std::memory_order_relaxed);
+
+    for (auto set : { InstructionSet::avx512, InstructionSet::avx2 })
+        if (current == FloatVectorHelpers::getKernels<float> (set))
+            return set;
+   #endif
+
+    return InstructionSet::baseline;
+}
+
+bool JUCE_CALLTYPE FloatVectorOperations::isInstructionSetAvailable ([[maybe_unused]] InstructionSet set) noexcept
+{
+   #if JUCE_USE_AVX_DISPATCH
+    return FloatVectorHelpers::isAvailable (set);
+   #else
+    return set == InstructionSet::baseline;
+   #endif
+}
+
+bool JUCE_CALLTYPE FloatVectorOperations::setInstructionSet (InstructionSet set) noexcept
+{
+    if (! isInstructionSetAvailable (set))
+        return false;
+
+   #if JUCE_USE_AVX_DISPATCH
+    FloatVectorHelpers::getCurrentKernels<float>() .store (FloatVectorHelpers::getKernels<float>  (set));
+    FloatVectorHelpers::getCurrentKernels<double>().store (FloatVectorHelpers::getKernels<double> (set));
+   #endif
+
+    return true;
+}
+
 intptr_t JUCE_CALLTYPE FloatVectorOperations::getFpStatusRegister() noexcept
 {
     intptr_t fpsr = 0;
@@ -1574,6 +2118,8 @@ public:
         : UnitTest ("FloatVectorOperations", UnitTestCategories::audio)
     {}
 
+    using InstructionSet = FloatVectorOperations::InstructionSet;
+
     template <typename ValueType>
     struct TestRunner
     {
@@ -1649,6 +2195,19 @@ public:
             FloatVectorOperations::abs (data2, data1, num);
             u.expect (areAllValuesEqual (data2, num, (ValueType) 256));
 
+            u.expect (exactlyEqual (FloatVectorOperations::sum (data1, num), (ValueType) (256 * num)));
+            u.expect (exactlyEqual (FloatVectorOperations::sumOfSquares (data1, num), (ValueType) (256 * 256 * num)));
+            u.expect (exactlyEqual (FloatVectorOperations::dotProduct (data1, data2, num), (ValueType) (256 * 256 * num)));
+
+            FloatVectorOperations::multiplyWithRamp (data1, (ValueType) 0.5, (ValueType) 0.25, num);
+            u.expect (exactlyEqual (data1[0], (ValueType) 128));
+            u.expect (exactlyEqual (data1[num - 1], (ValueType) 256 * ((ValueType) 0.5 + (ValueType) 0.25 * (ValueType) (num - 1))));
+
+            fillRandomly (random, data1, num);
+            fillRandomly (random, data2, num);
+            doReductionTest (u, data1, data2, num);
+            doRampTest (u, random, data1, data2, num);
+
             fillRandomly (random, int1, num);
             doConversionTest (u, data1, data2, int1, num);
 
@@ -1667,16 +2226,191 @@ public:
 
         static void doConversionTest (UnitTest&, double*, double*, int*, int) {}
 
+        static void doReductionTest (UnitTest& u, const ValueType* data1, const ValueType* data2, int num)
+        {
+            double sum = 0, sumOfSquares = 0, dotProduct = 0;
+
+            for (int i = 0; i < num; ++i)
+            {
+                sum          += (double) data1[i];
+                sumOfSquares += (double) data1[i] * (double) data1[i];
+                dotProduct   += (double) data1[i] * (double) data2[i];
+            }
+
+            // The values are all positive, so the error is bounded by the number of additions
+            const auto isClose = [num] (ValueType result, double expected)
+            {
+                return std::abs ((double) result - expected) <= expected * num * std::numeric_limits<ValueType>::epsilon();
+            };
+
+            u.expect (isClose (FloatVectorOperations::sum (data1, num), sum));
+            u.expect (isClose (FloatVectorOperations::sumOfSquares (data1, num), sumOfSquares));
+            u.expect (isClose (FloatVectorOperations::dotProduct (data1, data2, num), dotProduct));
+        }
+
+        static void doRampTest (UnitTest& u, Random& random, ValueType* data1, ValueType* data2, int num)
+        {
+            const auto startGain = (ValueType) random.nextDouble();
+            const auto increment = (ValueType) (random.nextDouble() - 0.5) / (ValueType) num;
+
+            FloatVectorOperations::copy (data2, data1, num);
+            FloatVectorOperations::multiplyWithRamp (data1, startGain, increment, num);
+
+            for (int i = 0; i < num; ++i)
+                data2[i] *= startGain + (ValueType) i * increment;
+
+            u.expect (buffersAreClose (data1, data2, num, (ValueType) 1000 * 4 * std::numeric_limits<ValueType>::epsilon()));
+        }
+
+        static void runInterleaveTest (UnitTest& u, Random random)
+        {
+            const int numChannels = random.nextInt ({ 1, 6 });
+            const int num = random.nextInt (100);
+
+            AudioBuffer<ValueType> original (numChannels, num + 16), result (numChannels, num + 16);
+            HeapBlock<ValueType> interleaved ((size_t) (numChannels * num + 16));
+
+            // The channels are offset from each other, to check unaligned data
+            HeapBlock<ValueType*> originalChannels ((size_t) numChannels), resultChannels ((size_t) numChannels);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                originalChannels[ch] = fillSigned (random, original.getWritePointer (ch, random.nextInt (16)), num);
+                resultChannels[ch] = result.getWritePointer (ch, random.nextInt (16));
+            }
+
+            auto* const dest = interleaved + random.nextInt (16);
+            FloatVectorOperations::interleave (dest, originalChannels.get(), numChannels, num);
+
+            bool allMatch = true;
+
+            for (int i = 0; i < num; ++i)
+                for (int ch = 0; ch < numChannels; ++ch)
+                    allMatch = allMatch && exactlyEqual (dest[i * numChannels + ch], originalChannels[ch][i]);
+
+            u.expect (allMatch, "Interleaved samples don't match");
+
+            FloatVectorOperations::deinterleave (resultChannels.get(), dest, numChannels, num);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                u.expect (std::equal (originalChannels[ch], originalChannels[ch] + num, resultChannels[ch]),
+                          "Deinterleaved samples don't match");
+        }
+
+        static void runInstructionSetComparison (UnitTest& u, Random random, InstructionSet set)
+        {
+            const int num = random.nextInt (100);
+
+            HeapBlock<ValueType> buffer1 (num + 16), buffer2 (num + 16), buffer3 (num + 17), buffer4 (num + 17);
+            HeapBlock<int> buffer5 (num + 16);
+
+            const ValueType* const src1 = fillSigned (random, buffer1 + random.nextInt (16), num);
+            const ValueType* const src2 = fillSigned (random, buffer2 + random.nextInt (16), num);
+            const int* const ints = fillRandomly (random, buffer5 + random.nextInt (16), num);
+            ValueType* const expected = buffer3 + random.nextInt (16);
+            ValueType* const result = buffer4 + random.nextInt (16);
+
+            // The fused multiply-adds only round once, so may differ from the baseline by up
+            // to the rounding error of the product, which can be much larger than the result.
+            const auto fmaTolerance = std::numeric_limits<ValueType>::epsilon() * (ValueType) (500 * 500);
+
+            const auto check = [&] (auto&& operation, ValueType tolerance = 0)
+            {
+                fillSigned (random, expected, num + 1);
+                std::copy (expected, expected + num + 1, result);
+
+                FloatVectorOperations::setInstructionSet (InstructionSet::baseline);
+                operation (expected);
+                FloatVectorOperations::setInstructionSet (set);
+                operation (result);
+
+                u.expect (buffersAreClose (expected, result, num, tolerance));
+                u.expect (exactlyEqual (expected[num], result[num]), "Wrote past the end of the array");
+            };
+
+            check ([&] (ValueType* d) { FloatVectorOperations::fill (d, (ValueType) 3, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::copyWithMultiply (d, src1, (ValueType) 1.5, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::add (d, (ValueType) 7, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::add (d, src1, (ValueType) 7, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::add (d, src1, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::add (d, src1, src2, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::subtract (d, src1, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::subtract (d, src1, src2, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::addWithMultiply (d, src1, (ValueType) 0.3, num); }, fmaTolerance);
+            check ([&] (ValueType* d) { FloatVectorOperations::addWithMultiply (d, src1, src2, num); }, fmaTolerance);
+            check ([&] (ValueType* d) { FloatVectorOperations::subtractWithMultiply (d, src1, (ValueType) 0.3, num); }, fmaTolerance);
+            check ([&] (ValueType* d) { FloatVectorOperations::subtractWithMultiply (d, src1, src2, num); }, fmaTolerance);
+            check ([&] (ValueType* d) { FloatVectorOperations::multiply (d, src1, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::multiply (d, src1, src2, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::multiply (d, (ValueType) 0.3, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::multiply (d, src1, (ValueType) 0.3, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::negate (d, src1, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::abs (d, src1, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::min (d, src1, (ValueType) 100, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::min (d, src1, src2, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::max (d, src1, (ValueType) -100, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::max (d, src1, src2, num); });
+            check ([&] (ValueType* d) { FloatVectorOperations::clip (d, src1, (ValueType) -200, (ValueType) 300, num); });
+
+            if constexpr (std::is_same_v<ValueType, float>)
+                check ([&] (ValueType* d) { FloatVectorOperations::convertFixedToFloat (d, ints, 1.0f / (float) 0x7fffffff, num); });
+            else
+                ignoreUnused (ints);
+
+            check ([&] (ValueType* d) { FloatVectorOperations::multiplyWithRamp (d, (ValueType) 0.3, (ValueType) 0.01, num); }, fmaTolerance);
+            check ([&] (ValueType* d) { if (num > 0) FloatVectorOperations::interleave (d, std::array<const ValueType*, 2> { src1, src2 }.data(), 2, num / 2); });
+
+            const auto checkDeinterleave = [&] (InstructionSet instructionSet, ValueType* const* dest)
+            {
+                FloatVectorOperations::setInstructionSet (instructionSet);
+                FloatVectorOperations::deinterleave (dest, src1, 2, num / 2);
+            };
+
+            checkDeinterleave (InstructionSet::baseline, std::array<ValueType*, 2> { expected, expected + num / 2 }.data());
+            checkDeinterleave (set, std::array<ValueType*, 2> { result, result + num / 2 }.data());
+            u.expect (std::equal (expected, expected + (num / 2) * 2, result));
+
+            // The reductions add the values in a different order for each instruction set
+            const auto checkReduction = [&] (auto&& operation, ValueType magnitude)
+            {
+                FloatVectorOperations::setInstructionSet (InstructionSet::baseline);
+                const auto expectedValue = operation();
+                FloatVectorOperations::setInstructionSet (set);
+                const auto resultValue = operation();
+
+                u.expect (std::abs (expectedValue - resultValue) <= magnitude * (ValueType) (num + 1) * std::numeric_limits<ValueType>::epsilon());
+            };
+
+            checkReduction ([&] { return FloatVectorOperations::sum (src1, num); }, (ValueType) 500);
+            checkReduction ([&] { return FloatVectorOperations::sumOfSquares (src1, num); }, (ValueType) (500 * 500));
+            checkReduction ([&] { return FloatVectorOperations::dotProduct (src1, src2, num); }, (ValueType) (500 * 500));
+
+            FloatVectorOperations::setInstructionSet (set);
+            u.expect (FloatVectorOperations::findMinAndMax (src1, num) == Range<ValueType>::findMinAndMax (src1, num));
+            u.expect (exactlyEqual (FloatVectorOperations::findMinimum (src1, num), num > 0 ? juce::findMinimum (src1, num) : ValueType()));
+            u.expect (exactlyEqual (FloatVectorOperations::findMaximum (src1, num), num > 0 ? juce::findMaximum (src1, num) : ValueType()));
+        }
+
         static void fillRandomly (Random& random, ValueType* d, int num)
         {
             while (--num >= 0)
                 *d++ = (ValueType) (random.nextDouble() * 1000.0);
         }
 
-        static void fillRandomly (Random& random, int* d, int num)
+        static int* fillRandomly (Random& random, int* d, int num)
         {
-            while (--num >= 0)
-                *d++ = random.nextInt();
+            for (int i = 0; i < num; ++i)
+                d[i] = random.nextInt();
+
+            return d;
+        }
+
+        static ValueType* fillSigned (Random& random, ValueType* d, int num)
+        {
+            for (int i = 0; i < num; ++i)
+                d[i] = (ValueType) ((random.nextDouble() - 0.5) * 1000.0);
+
+            return d;
         }
 
         static void convertFixed (float* d, const int* s, ValueType multiplier, int num)
@@ -1707,17 +2441,83 @@ public:
         {
             return std::abs (v1 - v2) < std::numeric_limits<ValueType>::epsilon();
         }
+
+        static bool buffersAreClose (const ValueType* d1, const ValueType* d2, int num, ValueType tolerance)
+        {
+            for (int i = 0; i < num; ++i)
+                if (std::abs (d1[i] - d2[i]) > tolerance)
+                    return false;
+
+            return true;
+        }
     };
 
+    static constexpr InstructionSet allInstructionSets[] { InstructionSet::baseline, InstructionSet::avx2, InstructionSet::avx512 };
+
+    static String getName (InstructionSet set)
+    {
+        switch (set)
+        {
+            case InstructionSet::baseline:  return "baseline";
+            case InstructionSet::avx2:      return "AVX2";
+            case InstructionSet::avx512:    return "AVX-512";
+        }
+
+        return {};
+    }
+
     void runTest() override
     {
-        beginTest ("FloatVectorOperations");
+        const auto originalSet = FloatVectorOperations::getInstructionSet();
 
-        for (int i = 1000; --i >= 0;)
+        beginTest ("Instruction set availability");
         {
-            TestRunner<float>::runTest (*this, getRandom());
-            TestRunner<double>::runTest (*this, getRandom());
+            expect (FloatVectorOperations::isInstructionSetAvailable (InstructionSet::baseline));
+            expect (FloatVectorOperations::isInstructionSetAvailable (originalSet));
+
+            for (auto set : allInstructionSets)
+            {
+                expect (FloatVectorOperations::setInstructionSet (set) == FloatVectorOperations::isInstructionSetAvailable (set));
+
+                if (FloatVectorOperations::isInstructionSetAvailable (set))
+                    expect (FloatVectorOperations::getInstructionSet() == set);
+            }
+
+            FloatVectorOperations::setInstructionSet (originalSet);
+        }
+
+        for (auto set : allInstructionSets)
+        {
+            if (! FloatVectorOperations::setInstructionSet (set))
+                continue;
+
+            beginTest ("FloatVectorOperations (" + getName (set) + ")");
+
+            for (int i = 1000; --i >= 0;)
+            {
+                TestRunner<float>::runTest (*this, getRandom());
+                TestRunner<double>::runTest (*this, getRandom());
+            }
+
+            for (int i = 100; --i >= 0;)
+            {
+                TestRunner<float>::runInterleaveTest (*this, getRandom());
+                TestRunner<double>::runInterleaveTest (*this, getRandom());
+            }
+
+            if (set != InstructionSet::baseline)
+            {
+                beginTest ("FloatVectorOperations (" + getName (set) + " matches baseline)");
+
+                for (int i = 300; --i >= 0;)
+                {
+                    TestRunner<float>::runInstructionSetComparison (*this, getRandom(), set);
+                    TestRunner<double>::runInstructionSetComparison (*this, getRandom(), set);
+                }
+            }
         }
+
+        FloatVectorOperations::setInstructionSet (originalSet);
     }
 };
 
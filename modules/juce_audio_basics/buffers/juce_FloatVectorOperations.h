@@ -148,6 +148,27 @@ struct JUCE_API FloatVectorOperationsBase
 
     /** Finds the maximum value in the given array. */
     static FloatType JUCE_CALLTYPE findMaximum (const FloatType* src, CountType numValues) noexcept;
+
+    /** Returns the sum of the values in the given array. */
+    static FloatType JUCE_CALLTYPE sum (const FloatType* src, CountType numValues) noexcept;
+
+    /** Returns the sum of the squares of the values in the given array. */
+    static FloatType JUCE_CALLTYPE sumOfSquares (const FloatType* src, CountType numValues) noexcept;
+
+    /** Returns the sum of the products of each src1 value and the corresponding src2 value. */
+    static FloatType JUCE_CALLTYPE dotProduct (const FloatType* src1, const FloatType* src2, CountType num) noexcept;
+
+    /** Multiplies each dest value by a gain that starts at startGain and increases by gainIncrement for each sample.
+
+        The gain applied to dest[i] is (startGain + i * gainIncrement), so this can be used for linear fades.
+    */
+    static void JUCE_CALLTYPE multiplyWithRamp (FloatType* dest, FloatType startGain, FloatType gainIncrement, CountType numValues) noexcept;
+
+    /** Interleaves the samples from numChannels separate src arrays into dest, which must have space for numChannels * numSamples values. */
+    static void JUCE_CALLTYPE interleave (FloatType* dest, const FloatType* const* src, int numChannels, CountType numSamples) noexcept;
+
+    /** Splits the interleaved samples in src into numChannels separate dest arrays, each of which must have space for numSamples values. */
+    static void JUCE_CALLTYPE deinterleave (FloatType* const* dest, const FloatType* src, int numChannels, CountType numSamples) noexcept;
 };
 
 /** @cond */
@@ -173,7 +194,13 @@ struct NameForwarder : public Bases...
           Bases::clip...,
           Bases::findMinAndMax...,
           Bases::findMinimum...,
-          Bases::findMaximum...;
+          Bases::findMaximum...,
+          Bases::sum...,
+          Bases::sumOfSquares...,
+          Bases::dotProduct...,
+          Bases::multiplyWithRamp...,
+          Bases::interleave...,
+          Bases::deinterleave...;
 };
 
 } // namespace detail
@@ -213,6 +240,42 @@ public:
     /** This method returns true if denormals are currently disabled. */
     static bool JUCE_CALLTYPE areDenormalsDisabled() noexcept;
 
+    //==============================================================================
+    /** The instruction sets that the vector operations can be run with. */
+    enum class InstructionSet
+    {
+        baseline,   /**< The SSE or NEON versions that the module is compiled with, or vDSP on Apple platforms. */
+        avx2,       /**< Versions using 256-bit AVX2 and FMA instructions. */
+        avx512      /**< Versions using 512-bit AVX-512F instructions. */
+    };
+
+    /** Returns the instruction set that the vector operations are currently using.
+
+        When JUCE_USE_AVX_DISPATCH is enabled, this is chosen at startup as the widest
+        instruction set that the CPU supports.
+    */
+    static InstructionSet JUCE_CALLTYPE getInstructionSet() noexcept;
+
+    /** Returns true if the vector operations can be run with the given instruction set
+        on this CPU and in this build.
+    */
+    static bool JUCE_CALLTYPE isInstructionSetAvailable (InstructionSet) noexcept;
+
+    /** Switches the vector operations over to a different instruction set.
+
+        This is mostly useful for testing and benchmarking. It's safe to call while other
+        threads are using the vector operations, although calls that are already running
+        will finish using the previous instruction set.
+
+        Note that the AVX2 and AVX-512 versions use fused multiply-add instructions for
+        addWithMultiply and subtractWithMultiply, so their results may differ from the
+        baseline versions in the last bit.
+
+        Returns false, and leaves the current instruction set unchanged, if the one
+        requested isn't available.
+    */
+    static bool JUCE_CALLTYPE setInstructionSet (InstructionSet) noexcept;
+
 private:
     friend ScopedNoDenormals;
 
@@ -66,6 +66,21 @@
  #include <arm_neon.h>
 #endif
 
+#if JUCE_USE_VDSP_FRAMEWORK
+ #undef JUCE_USE_AVX_DISPATCH
+ #define JUCE_USE_AVX_DISPATCH 0
+#endif
+
+#if JUCE_USE_AVX_DISPATCH
+ #include <immintrin.h>
+
+ #if ! JUCE_MSVC
+  #include <cpuid.h>
+ #endif
+
+ #include "native/juce_FloatVectorOperations_avx.cpp"
+#endif
+
 #include "buffers/juce_AudioDataConverters.cpp"
 #include "buffers/juce_FloatVectorOperations.cpp"
 #include "buffers/juce_AudioChannelSet.cpp"
@@ -75,8 +90,11 @@
 #include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_Interpolators.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
+#include "utilities/juce_RealtimeThreadPool.cpp"
 #include "midi/juce_MidiBuffer.cpp"
+#include "midi/juce_RealtimeMidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
+#include "midi/juce_MappedMidiFile.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
 #include "midi/juce_MidiMessage.cpp"
 #include "midi/juce_MidiMessageSequence.cpp"
@@ -88,6 +106,7 @@
 #include "mpe/juce_MPEMessages.cpp"
 #include "mpe/juce_MPESynthesiserBase.cpp"
 #include "mpe/juce_MPESynthesiserVoice.cpp"
+#include "mpe/juce_MPESynthesiserVoiceBank.cpp"
 #include "mpe/juce_MPESynthesiser.cpp"
 #include "mpe/juce_MPEUtils.cpp"
 #include "sources/juce_BufferingAudioSource.cpp"
@@ -78,6 +78,21 @@
  #undef JUCE_USE_SSE_INTRINSICS
 #endif
 
+/** Config: JUCE_USE_AVX_DISPATCH
+    Enables versions of the FloatVectorOperations functions that use AVX2/FMA or
+    AVX-512 instructions, which are selected at runtime when the CPU supports them.
+    Builds that don't use the SSE intrinsics, or that use Apple's vDSP framework,
+    never use these.
+*/
+#ifndef JUCE_USE_AVX_DISPATCH
+ #define JUCE_USE_AVX_DISPATCH 1
+#endif
+
+#if ! JUCE_USE_SSE_INTRINSICS
+ #undef JUCE_USE_AVX_DISPATCH
+ #define JUCE_USE_AVX_DISPATCH 0
+#endif
+
 #ifndef JUCE_USE_ARM_NEON
  #if (__ARM_NEON || __ARM_NEON__) && ! JUCE_USE_VDSP_FRAMEWORK
   #define JUCE_USE_ARM_NEON 1
@@ -106,10 +121,13 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "utilities/juce_SmoothedValue.h"
 #include "utilities/juce_Reverb.h"
 #include "utilities/juce_ADSR.h"
+#include "utilities/juce_RealtimeThreadPool.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
+#include "midi/juce_RealtimeMidiBuffer.h"
 #include "midi/juce_MidiMessageSequence.h"
 #include "midi/juce_MidiFile.h"
+#include "midi/juce_MappedMidiFile.h"
 #include "midi/juce_MidiKeyboardState.h"
 #include "midi/juce_MidiRPN.h"
 #include "midi/juce_MidiDataConcatenator.h"
@@ -120,6 +138,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "mpe/juce_MPEMessages.h"
 #include "mpe/juce_MPESynthesiserBase.h"
 #include "mpe/juce_MPESynthesiserVoice.h"
+#include "mpe/juce_MPESynthesiserVoiceBank.h"
 #include "mpe/juce_MPESynthesiser.h"
 #include "mpe/juce_MPEUtils.h"
 #include "sources/juce_AudioSource.h"
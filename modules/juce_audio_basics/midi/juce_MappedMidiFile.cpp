@@ -0,0 +1,465 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+// The number of events between the positions that are recorded when a track is indexed
+static constexpr int mappedMidiFileEventsPerCheckpoint = 1024;
+
+MappedMidiFile::MappedMidiFile (const File& file)
+    : mappedFile (file, MemoryMappedFile::readOnly)
+{
+    auto d = static_cast<const uint8*> (mappedFile.getData());
+    auto size = mappedFile.getSize();
+
+    if (d == nullptr)
+        return;
+
+    const auto optHeader = MidiFileHelpers::parseMidiHeader (d, size);
+
+    if (! optHeader.hasValue())
+        return;
+
+    const auto header = *optHeader;
+    timeFormat = header.timeFormat;
+    fileType = header.fileType;
+
+    d += header.bytesRead;
+    size -= header.bytesRead;
+
+    for (int i = 0; i < header.numberOfTracks; ++i)
+    {
+        const auto optChunkType = MidiFileHelpers::tryRead<uint32> (d, size);
+        const auto optChunkSize = MidiFileHelpers::tryRead<uint32> (d, size);
+
+        if (! optChunkType.hasValue() || ! optChunkSize.hasValue() || size < *optChunkSize)
+        {
+            tracks.clear();
+            return;
+        }
+
+        if (*optChunkType == ByteOrder::bigEndianInt ("MTrk"))
+            tracks.push_back ({ d, (size_t) *optChunkSize, {} });
+
+        size -= *optChunkSize;
+        d += *optChunkSize;
+    }
+
+    valid = (size == 0);
+
+    if (! valid)
+        tracks.clear();
+}
+
+MappedMidiFile::~MappedMidiFile() = default;
+
+size_t MappedMidiFile::getTrackSizeInBytes (int trackIndex) const noexcept
+{
+    if (isPositiveAndBelow (trackIndex, tracks.size()))
+        return tracks[(size_t) trackIndex].size;
+
+    return 0;
+}
+
+//==============================================================================
+MappedMidiFile::TrackIterator::TrackIterator (const uint8* d, size_t size, double t,
+                                              uint8 status, double end) noexcept
+    : data (d), remaining (size), tick (t), endTick (end), runningStatus (status)
+{
+}
+
+bool MappedMidiFile::TrackIterator::next (MidiMessage& result)
+{
+    constexpr auto maxChunkSize = (size_t) std::numeric_limits<int>::max();
+
+    if (remaining == 0)
+        return false;
+
+    const auto delay = MidiMessage::readVariableLengthValue (data, (int) jmin (remaining, maxChunkSize));
+
+    if (delay.isValid() && (size_t) delay.bytesUsed < remaining)
+    {
+        data += delay.bytesUsed;
+        remaining -= (size_t) delay.bytesUsed;
+
+        const auto eventTick = tick + delay.value;
+
+        if (eventTick < endTick)
+        {
+            int messSize = 0;
+            MidiMessage message (data, (int) jmin (remaining, maxChunkSize), messSize, runningStatus, eventTick);
+
+            if (messSize > 0)
+            {
+                data += messSize;
+                remaining -= (size_t) messSize;
+                tick = eventTick;
+
+                const auto firstByte = *message.getRawData();
+
+                if ((firstByte & 0xf0) != 0xf0)
+                    runningStatus = firstByte;
+
+                result = std::move (message);
+                return true;
+            }
+        }
+    }
+
+    remaining = 0;
+    return false;
+}
+
+MappedMidiFile::TrackIterator MappedMidiFile::createTrackIterator (int trackIndex,
+                                                                   double startTick,
+                                                                   double endTick) const
+{
+    if (! isPositiveAndBelow (trackIndex, tracks.size()))
+        return {};
+
+    auto& track = tracks[(size_t) trackIndex];
+    TrackIterator it (track.data, track.size, 0, 0, endTick);
+
+    if (startTick <= 0)
+        return it;
+
+    {
+        const ScopedLock sl (indexLock);
+        getIndexedTrack (trackIndex);
+
+        // Find the last checkpoint that's preceded only by events before the start time
+        const auto checkpoint = std::lower_bound (track.checkpoints.begin(), track.checkpoints.end(), startTick,
+                                                  [] (const Checkpoint& c, double t) { return c.tick < t; });
+
+        if (checkpoint != track.checkpoints.begin())
+        {
+            const auto& c = *std::prev (checkpoint);
+            it = TrackIterator (track.data + c.offset, track.size - c.offset, c.tick, c.runningStatus, endTick);
+        }
+    }
+
+    for (MidiMessage message;;)
+    {
+        auto previous = it;
+
+        if (! it.next (message) || message.getTimeStamp() >= startTick)
+            return previous;
+    }
+}
+
+const MappedMidiFile::Track& MappedMidiFile::getIndexedTrack (int trackIndex) const
+{
+    auto& track = tracks[(size_t) trackIndex];
+
+    if (! track.indexed)
+    {
+        TrackIterator it (track.data, track.size, 0, 0, std::numeric_limits<double>::max());
+        MidiMessage message;
+
+        for (int numEvents = 0;; ++numEvents)
+        {
+            if (numEvents % mappedMidiFileEventsPerCheckpoint == 0)
+                track.checkpoints.push_back ({ it.tick, (size_t) (it.data - track.data), it.runningStatus });
+
+            if (! it.next (message))
+                break;
+        }
+
+        track.lastTimestamp = it.tick;
+        track.indexed = true;
+    }
+
+    return track;
+}
+
+//==============================================================================
+MappedMidiFile::Iterator::Iterator (std::vector<TrackIterator> its)
+    : trackIterators (std::move (its)),
+      pendingEvents (trackIterators.size()),
+      hasPendingEvent (trackIterators.size())
+{
+    for (size_t i = 0; i < trackIterators.size(); ++i)
+        hasPendingEvent[i] = trackIterators[i].next (pendingEvents[i]);
+}
+
+bool MappedMidiFile::Iterator::next (MidiMessage& result, int* trackIndex)
+{
+    auto earliest = trackIterators.size();
+
+    for (size_t i = 0; i < trackIterators.size(); ++i)
+        if (hasPendingEvent[i]
+             && (earliest == trackIterators.size()
+                  || pendingEvents[i].getTimeStamp() < pendingEvents[earliest].getTimeStamp()))
+            earliest = i;
+
+    if (earliest == trackIterators.size())
+        return false;
+
+    std::swap (result, pendingEvents[earliest]);
+    hasPendingEvent[earliest] = trackIterators[earliest].next (pendingEvents[earliest]);
+
+    if (trackIndex != nullptr)
+        *trackIndex = (int) earliest;
+
+    return true;
+}
+
+MappedMidiFile::Iterator MappedMidiFile::createIterator (double startTick, double endTick) const
+{
+    std::vector<TrackIterator> trackIterators;
+    trackIterators.reserve (tracks.size());
+
+    for (int i = 0; i < getNumTracks(); ++i)
+        trackIterators.push_back (createTrackIterator (i, startTick, endTick));
+
+    return Iterator (std::move (trackIterators));
+}
+
+//==============================================================================
+MidiMessageSequence MappedMidiFile::readTrack (int trackIndex, double startTick, double endTick) const
+{
+    MidiMessageSequence result;
+    auto it = createTrackIterator (trackIndex, startTick, endTick);
+
+    for (MidiMessage message; it.next (message);)
+        result.addEvent (message);
+
+    return result;
+}
+
+double MappedMidiFile::getLastTimestamp() const
+{
+    const ScopedLock sl (indexLock);
+    double t = 0;
+
+    for (int i = 0; i < getNumTracks(); ++i)
+        t = jmax (t, getIndexedTrack (i).lastTimestamp);
+
+    return t;
+}
+
+double MappedMidiFile::ticksToSeconds (double tick) const
+{
+    if (timeFormat == 0)
+        return tick;
+
+    const ScopedLock sl (indexLock);
+
+    if (! tempoEventsFound)
+    {
+        auto it = createIterator();
+
+        for (MidiMessage message; it.next (message);)
+            if (message.isTempoMetaEvent() || message.isTimeSignatureMetaEvent())
+                tempoEvents.addEvent (message);
+
+        tempoEventsFound = true;
+    }
+
+    return MidiFileHelpers::convertTicksToSeconds (tick, tempoEvents, timeFormat);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MappedMidiFileTests final : public UnitTest
+{
+    MappedMidiFileTests()
+        : UnitTest ("MappedMidiFile", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Tracks are found");
+
+        TemporaryFile temp (".mid");
+        const auto midiFile = createTestFile();
+
+        {
+            FileOutputStream out (temp.getFile());
+            expect (out.openedOk() && midiFile.writeTo (out));
+        }
+
+        MidiFile reference;
+
+        {
+            FileInputStream in (temp.getFile());
+            expect (reference.readFrom (in, false));
+        }
+
+        const MappedMidiFile mapped (temp.getFile());
+
+        expect (mapped.isValid());
+        expectEquals (mapped.getNumTracks(), reference.getNumTracks());
+        expectEquals ((int) mapped.getTimeFormat(), (int) reference.getTimeFormat());
+        expectEquals (mapped.getFileType(), 1);
+
+        beginTest ("Tracks decode to the same events as MidiFile");
+        {
+            for (int i = 0; i < reference.getNumTracks(); ++i)
+                expect (sequencesMatch (mapped.readTrack (i), *reference.getTrack (i)));
+
+            expectEquals (mapped.getLastTimestamp(), reference.getLastTimestamp());
+        }
+
+        beginTest ("Ranges of time contain only the events in the range");
+        {
+            for (const auto& range : { Range<double> (0, 100), Range<double> (1000, 2500),
+                                       Range<double> (2048, 2049), Range<double> (5000, 1.0e9),
+                                       Range<double> (1.0e8, 1.0e9) })
+            {
+                for (int i = 0; i < reference.getNumTracks(); ++i)
+                {
+                    MidiMessageSequence expected;
+
+                    for (const auto* holder : *reference.getTrack (i))
+                        if (range.contains (holder->message.getTimeStamp()))
+                            expected.addEvent (holder->message);
+
+                    expect (sequencesMatch (mapped.readTrack (i, range.getStart(), range.getEnd()), expected));
+                }
+            }
+        }
+
+        beginTest ("Iterator merges tracks in time order");
+        {
+            auto it = mapped.createIterator (500, 3000);
+            MidiMessage message;
+            int trackIndex = -1, numEvents = 0, lastTrack = -1;
+            double lastTime = 500;
+
+            while (it.next (message, &trackIndex))
+            {
+                const auto t = message.getTimeStamp();
+                expect (t >= lastTime && t < 3000);
+                expect (t > lastTime || trackIndex >= lastTrack);
+
+                lastTime = t;
+                lastTrack = trackIndex;
+                ++numEvents;
+            }
+
+            int expectedNumEvents = 0;
+
+            for (const auto* track : { reference.getTrack (0), reference.getTrack (1) })
+                for (const auto* holder : *track)
+                    if (holder->message.getTimeStamp() >= 500 && holder->message.getTimeStamp() < 3000)
+                        ++expectedNumEvents;
+
+            expectEquals (numEvents, expectedNumEvents);
+        }
+
+        beginTest ("Ticks are converted to seconds using the tempo map");
+        {
+            auto converted = reference;
+            converted.convertTimestampTicksToSeconds();
+
+            for (int i = 0; i < reference.getNumTracks(); ++i)
+                for (int j = 0; j < reference.getTrack (i)->getNumEvents(); j += 97)
+                    expectWithinAbsoluteError (mapped.ticksToSeconds (reference.getTrack (i)->getEventTime (j)),
+                                               converted.getTrack (i)->getEventTime (j),
+                                               1.0e-9);
+        }
+
+        beginTest ("Invalid files are rejected");
+        {
+            TemporaryFile invalid;
+            invalid.getFile().replaceWithText ("This is not a midi file");
+
+            const MappedMidiFile invalidMapped (invalid.getFile());
+            expect (! invalidMapped.isValid());
+            expectEquals (invalidMapped.getNumTracks(), 0);
+
+            MidiMessage message;
+            expect (! invalidMapped.createIterator().next (message));
+        }
+    }
+
+    static MidiFile createTestFile()
+    {
+        MidiFile result;
+        result.setTicksPerQuarterNote (96);
+
+        MidiMessageSequence tempoTrack;
+        tempoTrack.addEvent (MidiMessage::tempoMetaEvent (500000), 0);
+        tempoTrack.addEvent (MidiMessage::timeSignatureMetaEvent (3, 4), 0);
+        tempoTrack.addEvent (MidiMessage::tempoMetaEvent (300000), 1500);
+        tempoTrack.addEvent (MidiMessage::textMetaEvent (1, "A long enough text event to need an allocation"), 2000);
+        tempoTrack.addEvent (MidiMessage::tempoMetaEvent (750000), 4000);
+        result.addTrack (tempoTrack);
+
+        // Enough events to need several checkpoints, with runs that use running status
+        MidiMessageSequence noteTrack;
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            const auto note = 36 + (i % 48);
+            noteTrack.addEvent (MidiMessage::noteOn (1, note, (uint8) 100), i * 2);
+            noteTrack.addEvent (MidiMessage::noteOff (1, note), i * 2 + 1);
+
+            if (i % 500 == 0)
+                noteTrack.addEvent (MidiMessage::controllerEvent (2, 7, i % 128), i * 2 + 1);
+        }
+
+        result.addTrack (noteTrack);
+        return result;
+    }
+
+    static bool sequencesMatch (const MidiMessageSequence& a, const MidiMessageSequence& b)
+    {
+        if (a.getNumEvents() != b.getNumEvents())
+            return false;
+
+        for (int i = 0; i < a.getNumEvents(); ++i)
+        {
+            const auto& m1 = a.getEventPointer (i)->message;
+            const auto& m2 = b.getEventPointer (i)->message;
+
+            if (! exactlyEqual (m1.getTimeStamp(), m2.getTimeStamp())
+                || m1.getDescription() != m2.getDescription())
+                return false;
+        }
+
+        return true;
+    }
+};
+
+static MappedMidiFileTests mappedMidiFileTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads a standard midi file directly from a memory-mapped file, without loading it.
+
+    A MidiFile parses every track into a MidiMessageSequence when it's read, which
+    needs a lot of time and memory for files that contain millions of events. A
+    MappedMidiFile instead maps the file into memory and only finds the positions of
+    its track chunks when it's opened. Events are decoded when they're asked for,
+    either one at a time using an Iterator or TrackIterator, or for a range of time
+    using readTrack().
+
+    The iterators hold pointers into the mapped file, so they must not be used after
+    the MappedMidiFile that created them has been deleted.
+
+    All timestamps are in midi ticks, as they are in the file. Use getTimeFormat()
+    to interpret them, or ticksToSeconds() to convert them to seconds.
+
+    Unlike MidiFile::readFrom(), events are returned in the order in which they
+    appear in each track, and no matching note-offs are created.
+
+    @code
+    MappedMidiFile midiFile (file);
+
+    if (midiFile.isValid())
+    {
+        auto it = midiFile.createIterator (startTick, endTick);
+        MidiMessage message;
+
+        while (it.next (message))
+            handleMessage (message, midiFile.ticksToSeconds (message.getTimeStamp()));
+    }
+    @endcode
+
+    @see MidiFile, MemoryMappedFile
+
+    @tags{Audio}
+*/
+class JUCE_API  MappedMidiFile
+{
+public:
+    //==============================================================================
+    /** Opens and maps a midi file.
+        If the file can't be opened or isn't a valid midi file, isValid() will return false.
+    */
+    explicit MappedMidiFile (const File& file);
+
+    /** Destructor. */
+    ~MappedMidiFile();
+
+    //==============================================================================
+    /** Returns true if the file was mapped and its header and track chunks could be read. */
+    bool isValid() const noexcept                   { return valid; }
+
+    /** Returns the number of tracks in the file. */
+    int getNumTracks() const noexcept               { return (int) tracks.size(); }
+
+    /** Returns the file's type (0, 1 or 2) as given in its header. */
+    int getFileType() const noexcept                { return fileType; }
+
+    /** Returns the raw time format code from the file's header.
+        @see MidiFile::getTimeFormat
+    */
+    short getTimeFormat() const noexcept            { return timeFormat; }
+
+    /** Returns the number of bytes in one of the track chunks. */
+    size_t getTrackSizeInBytes (int trackIndex) const noexcept;
+
+    //==============================================================================
+    /**
+        Decodes the events of a single track, one at a time.
+
+        Iterators are created by MappedMidiFile::createTrackIterator().
+    */
+    class JUCE_API  TrackIterator
+    {
+    public:
+        /** Creates an iterator that doesn't return any events. */
+        TrackIterator() = default;
+
+        /** Decodes the next event in the track.
+
+            If there is one, this replaces the contents of result with it, sets its timestamp
+            to its time in ticks, and returns true. At the end of the track or of the range
+            of time that the iterator was created for, this returns false.
+
+            A MidiMessage can hold short messages without allocating, so only sysex and
+            meta events will cause this to allocate.
+        */
+        bool next (MidiMessage& result);
+
+        /** Returns the time in ticks of the last event returned by next(). */
+        double getCurrentTick() const noexcept      { return tick; }
+
+    private:
+        friend class MappedMidiFile;
+
+        TrackIterator (const uint8* data, size_t size, double tick, uint8 runningStatus, double endTick) noexcept;
+
+        const uint8* data = nullptr;
+        size_t remaining = 0;
+        double tick = 0, endTick = 0;
+        uint8 runningStatus = 0;
+    };
+
+    /** Returns an iterator that decodes the events in one track, starting with the first
+        event whose time is at or after startTick, and stopping before the first event whose
+        time is at or after endTick.
+
+        Starting from anywhere but the beginning of a track makes the file build an index
+        of that track the first time it's needed, which means reading the whole track once.
+    */
+    TrackIterator createTrackIterator (int trackIndex,
+                                       double startTick = 0,
+                                       double endTick = std::numeric_limits<double>::max()) const;
+
+    //==============================================================================
+    /**
+        Decodes the events of all the tracks in a file, merged into time order.
+
+        Iterators are created by MappedMidiFile::createIterator().
+    */
+    class JUCE_API  Iterator
+    {
+    public:
+        /** Decodes the next event in the file.
+
+            This returns the earliest of the next events in each track. When events in
+            different tracks happen at the same time, the one in the lowest-numbered track
+            is returned first. If trackIndex isn't nullptr, it's set to the index of the
+            track that the event came from.
+
+            @returns false if there are no more events in the iterator's range
+            @see TrackIterator::next
+        */
+        bool next (MidiMessage& result, int* trackIndex = nullptr);
+
+    private:
+        friend class MappedMidiFile;
+
+        explicit Iterator (std::vector<TrackIterator>);
+
+        std::vector<TrackIterator> trackIterators;
+        std::vector<MidiMessage> pendingEvents;
+        std::vector<bool> hasPendingEvent;
+    };
+
+    /** Returns an iterator that decodes the events of all the tracks in a range of time.
+        @see createTrackIterator
+    */
+    Iterator createIterator (double startTick = 0,
+                             double endTick = std::numeric_limits<double>::max()) const;
+
+    //==============================================================================
+    /** Decodes the events from one track that lie within a range of time into a
+        MidiMessageSequence.
+    */
+    MidiMessageSequence readTrack (int trackIndex,
+                                   double startTick = 0,
+                                   double endTick = std::numeric_limits<double>::max()) const;
+
+    /** Returns the latest timestamp in any of the tracks.
+        This reads the whole file the first time it's called.
+    */
+    double getLastTimestamp() const;
+
+    /** Converts a time in ticks to a time in seconds, using the tempo events in the file.
+
+        The tempo events are collected the first time this is called, which means reading
+        the whole file once.
+
+        @see MidiFile::convertTimestampTicksToSeconds
+    */
+    double ticksToSeconds (double tick) const;
+
+private:
+    //==============================================================================
+    struct Checkpoint
+    {
+        double tick;
+        size_t offset;
+        uint8 runningStatus;
+    };
+
+    struct Track
+    {
+        const uint8* data;
+        size_t size;
+        std::vector<Checkpoint> checkpoints;
+        double lastTimestamp = 0;
+        bool indexed = false;
+    };
+
+    const Track& getIndexedTrack (int trackIndex) const;
+
+    MemoryMappedFile mappedFile;
+    mutable std::vector<Track> tracks;
+    mutable MidiMessageSequence tempoEvents;
+    mutable bool tempoEventsFound = false;
+    CriticalSection indexLock;
+    short timeFormat = 0;
+    int fileType = 0;
+    bool valid = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MappedMidiFile)
+};
+
+} // namespace juce
@@ -114,6 +114,16 @@ int MidiMessageSequence::getIndexOfMatchingKeyUp (int index) const noexcept
     {
         if (auto* noteOff = meh->noteOffObject)
         {
+            // The note-off can't be earlier than the note-on, so start looking for it at its timestamp
+            const auto time = noteOff->message.getTimeStamp();
+            const auto start = std::lower_bound (list.begin() + index, list.end(), time,
+                                                 [] (const MidiEventHolder* e, double t) { return e->message.getTimeStamp() < t; });
+
+            for (auto it = start; it != list.end() && exactlyEqual ((*it)->message.getTimeStamp(), time); ++it)
+                if (*it == noteOff)
+                    return (int) std::distance (list.begin(), it);
+
+            // If the sequence hasn't been sorted since some timestamps were changed, fall back to a linear search
             for (int i = index; i < list.size(); ++i)
                 if (list.getUnchecked (i) == noteOff)
                     return i;
@@ -132,14 +142,10 @@ int MidiMessageSequence::getIndexOf (const MidiEventHolder* event) const noexcep
 
 int MidiMessageSequence::getNextIndexAtTime (double timeStamp) const noexcept
 {
-    auto numEvents = list.size();
-    int i;
-
-    for (i = 0; i < numEvents; ++i)
-        if (list.getUnchecked (i)->message.getTimeStamp() >= timeStamp)
-            break;
+    const auto it = std::lower_bound (list.begin(), list.end(), timeStamp,
+                                      [] (const MidiEventHolder* e, double t) { return e->message.getTimeStamp() < t; });
 
-    return i;
+    return (int) std::distance (list.begin(), it);
 }
 
 //==============================================================================
@@ -166,13 +172,18 @@ MidiMessageSequence::MidiEventHolder* MidiMessageSequence::addEvent (MidiEventHo
 {
     newEvent->message.addToTimeStamp (timeAdjustment);
     auto time = newEvent->message.getTimeStamp();
-    int i;
 
-    for (i = list.size(); --i >= 0;)
-        if (list.getUnchecked (i)->message.getTimeStamp() <= time)
-            break;
+    if (list.isEmpty() || list.getLast()->message.getTimeStamp() <= time)
+    {
+        list.add (newEvent);
+        return newEvent;
+    }
+
+    // This relies on the sequence being sorted, as documented for addEvent()
+    const auto it = std::upper_bound (list.begin(), list.end(), time,
+                                      [] (double t, const MidiEventHolder* e) { return t < e->message.getTimeStamp(); });
 
-    list.insert (i + 1, newEvent);
+    list.insert ((int) std::distance (list.begin(), it), newEvent);
     return newEvent;
 }
 
@@ -237,43 +248,70 @@ void MidiMessageSequence::sort() noexcept
 
 void MidiMessageSequence::updateMatchedPairs() noexcept
 {
+    // For each channel and note, the most recent note-on that hasn't yet been followed by
+    // another note-on or note-off for the same note
+    std::array<std::array<MidiEventHolder*, 128>, 16> unmatchedNoteOns {};
+
+    // A note-on that's followed by another note-on for the same note gets a new note-off,
+    // which is inserted just before the second note-on
+    std::vector<std::pair<int, MidiEventHolder*>> noteOffsToInsert;
+
     for (int i = 0; i < list.size(); ++i)
     {
         auto* meh = list.getUnchecked (i);
-        auto& m1 = meh->message;
+        auto& m = meh->message;
+        const auto isNoteOff = m.isNoteOff();
+
+        if (! isNoteOff && ! m.isNoteOn())
+            continue;
+
+        const auto chan = m.getChannel();
+        const auto note = m.getNoteNumber();
+        auto& unmatched = unmatchedNoteOns[(size_t) chan - 1][(size_t) note];
+
+        if (unmatched != nullptr)
+        {
+            if (isNoteOff)
+            {
+                unmatched->noteOffObject = meh;
+            }
+            else
+            {
+                auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
+                newEvent->message.setTimeStamp (m.getTimeStamp());
+                unmatched->noteOffObject = newEvent;
+                noteOffsToInsert.emplace_back (i, newEvent);
+            }
+        }
 
-        if (m1.isNoteOn())
+        if (isNoteOff)
+        {
+            unmatched = nullptr;
+        }
+        else
         {
             meh->noteOffObject = nullptr;
-            auto note = m1.getNoteNumber();
-            auto chan = m1.getChannel();
-            auto len = list.size();
+            unmatched = meh;
+        }
+    }
 
-            for (int j = i + 1; j < len; ++j)
-            {
-                auto* meh2 = list.getUnchecked (j);
-                auto& m = meh2->message;
+    if (noteOffsToInsert.empty())
+        return;
 
-                if (m.getNoteNumber() == note && m.getChannel() == chan)
-                {
-                    if (m.isNoteOff())
-                    {
-                        meh->noteOffObject = meh2;
-                        break;
-                    }
+    OwnedArray<MidiEventHolder> newList;
+    newList.ensureStorageAllocated (list.size() + (int) noteOffsToInsert.size());
+    auto nextInsertion = noteOffsToInsert.cbegin();
 
-                    if (m.isNoteOn())
-                    {
-                        auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
-                        list.insert (j, newEvent);
-                        newEvent->message.setTimeStamp (m.getTimeStamp());
-                        meh->noteOffObject = newEvent;
-                        break;
-                    }
-                }
-            }
-        }
+    for (int i = 0; i < list.size(); ++i)
+    {
+        if (nextInsertion != noteOffsToInsert.cend() && nextInsertion->first == i)
+            newList.add ((nextInsertion++)->second);
+
+        newList.add (list.getUnchecked (i));
     }
+
+    list.clearQuick (false);
+    list.swapWith (newList);
 }
 
 void MidiMessageSequence::addTimeToMessages (double delta) noexcept
@@ -541,6 +579,109 @@ struct MidiMessageSequenceTest final : public UnitTest
         expectEquals (s.getIndexOfMatchingKeyUp (0), -1); // Truncated note, should be no note off
         expectEquals (s.getTimeOfMatchingKeyUp (1), 5.0);
 
+        beginTest ("Repeated note-ons get note-offs");
+        {
+            MidiMessageSequence repeated;
+            repeated.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (0.0));
+            repeated.addEvent (MidiMessage::noteOn  (2, 60, 0.5f).withTimeStamp (1.0));
+            repeated.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (2.0));
+            repeated.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (3.0));
+            repeated.addEvent (MidiMessage::noteOff (1, 60, 0.5f).withTimeStamp (4.0));
+            repeated.addEvent (MidiMessage::noteOff (2, 60, 0.5f).withTimeStamp (5.0));
+            repeated.updateMatchedPairs();
+
+            expectEquals (repeated.getNumEvents(), 8);
+            expect (repeated.getEventPointer (2)->message.isNoteOff());
+            expectEquals (repeated.getEventTime (2), 2.0);
+            expect (repeated.getEventPointer (4)->message.isNoteOff());
+            expectEquals (repeated.getEventTime (4), 3.0);
+
+            expectEquals (repeated.getIndexOfMatchingKeyUp (0), 2);
+            expectEquals (repeated.getIndexOfMatchingKeyUp (1), 7);
+            expectEquals (repeated.getIndexOfMatchingKeyUp (3), 4);
+            expectEquals (repeated.getIndexOfMatchingKeyUp (5), 6);
+
+            // Running it again shouldn't add any more events
+            repeated.updateMatchedPairs();
+            expectEquals (repeated.getNumEvents(), 8);
+            expectEquals (repeated.getIndexOfMatchingKeyUp (0), 2);
+        }
+
+        beginTest ("Pairing and time queries match a linear search");
+        {
+            constexpr auto numEvents = 2000;
+
+            Random r (0x1234);
+            MidiMessageSequence sequence;
+            std::vector<double> noteOffTimes (128, -1.0);
+
+            for (double time = 0; sequence.getNumEvents() < numEvents; time += 1.0)
+            {
+                const auto note = 21 + r.nextInt (88);
+
+                if (noteOffTimes[(size_t) note] < 0.0)
+                {
+                    sequence.addEvent (MidiMessage::noteOn (1, note, 0.5f), time);
+                    noteOffTimes[(size_t) note] = time + 1.0 + r.nextInt (200);
+                }
+
+                for (auto& noteOffTime : noteOffTimes)
+                {
+                    if (noteOffTime >= 0.0 && noteOffTime <= time)
+                    {
+                        sequence.addEvent (MidiMessage::noteOff (1, (int) std::distance (noteOffTimes.data(), &noteOffTime)), time);
+                        noteOffTime = -1.0;
+                    }
+                }
+            }
+
+            // The previous implementation searched forwards from every note-on
+            std::vector<int> expectedMatches ((size_t) numEvents, -1);
+
+            for (int i = 0; i < numEvents; ++i)
+            {
+                const auto& m1 = sequence.getEventPointer (i)->message;
+
+                if (m1.isNoteOn())
+                {
+                    for (int j = i + 1; j < numEvents; ++j)
+                    {
+                        const auto& m2 = sequence.getEventPointer (j)->message;
+
+                        if (m2.getNoteNumber() == m1.getNoteNumber() && m2.isNoteOff())
+                        {
+                            expectedMatches[(size_t) i] = j;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            sequence.updateMatchedPairs();
+
+            std::vector<int> matches ((size_t) numEvents);
+
+            for (int i = 0; i < numEvents; ++i)
+                matches[(size_t) i] = sequence.getIndexOfMatchingKeyUp (i);
+
+            expectEquals (sequence.getNumEvents(), numEvents);
+            expect (matches == expectedMatches);
+
+            constexpr auto numQueries = 200;
+            const auto endTime = sequence.getEndTime();
+
+            for (int q = 0; q <= numQueries; ++q)
+            {
+                const auto t = endTime * q / numQueries;
+                int i = 0;
+
+                while (i < numEvents && sequence.getEventTime (i) < t)
+                    ++i;
+
+                expectEquals (sequence.getNextIndexAtTime (t), i);
+            }
+        }
+
         struct ControlValue { int control, value; };
 
         struct DataEntry
@@ -138,6 +138,9 @@ public:
     /** Returns the index of the first event on or after the given timestamp.
         If the time is beyond the end of the sequence, this will return the
         number of events.
+
+        This does a binary search, so if you've changed the timestamps of any
+        events, call sort() before using it.
     */
     int getNextIndexAtTime (double timeStamp) const noexcept;
 
@@ -161,7 +164,8 @@ public:
     /** Inserts a midi message into the sequence.
 
         The index at which the new message gets inserted will depend on its timestamp,
-        because the sequence is kept sorted.
+        because the sequence is kept sorted. The position is found with a binary search,
+        so if you've changed the timestamps of any events, call sort() before adding more.
 
         Remember to call updateMatchedPairs() after adding note-on events.
 
@@ -175,7 +179,8 @@ public:
     /** Inserts a midi message into the sequence.
 
         The index at which the new message gets inserted will depend on its timestamp,
-        because the sequence is kept sorted.
+        because the sequence is kept sorted. The position is found with a binary search,
+        so if you've changed the timestamps of any events, call sort() before adding more.
 
         Remember to call updateMatchedPairs() after adding note-on events.
 
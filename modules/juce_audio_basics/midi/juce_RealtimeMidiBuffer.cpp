@@ -0,0 +1,298 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+RealtimeMidiBuffer::RealtimeMidiBuffer (size_t capacityInBytes)
+    : data (capacityInBytes), capacity (capacityInBytes)
+{
+}
+
+RealtimeMidiBuffer::~RealtimeMidiBuffer() = default;
+
+//==============================================================================
+void RealtimeMidiBuffer::clear() noexcept
+{
+    numBytesUsed = 0;
+    numEvents = 0;
+    lastEventTime = 0;
+    numDroppedEvents = 0;
+}
+
+void RealtimeMidiBuffer::clear (int startSample, int numSamples) noexcept
+{
+    auto* dataEnd = data.get() + numBytesUsed;
+    auto* start = MidiBufferHelpers::findEventAfter (data.get(), dataEnd, startSample - 1);
+    auto* end   = MidiBufferHelpers::findEventAfter (start,      dataEnd, startSample + numSamples - 1);
+
+    if (start == end)
+        return;
+
+    for (auto* d = start; d < end; d += MidiBufferHelpers::getEventTotalSize (d))
+        --numEvents;
+
+    memmove (start, end, (size_t) (dataEnd - end));
+    numBytesUsed -= (size_t) (end - start);
+
+    // If the last event was removed, the new last event is the one before the removed range
+    if (end == dataEnd && start != data.get())
+    {
+        auto* d = data.get();
+
+        while (d + MidiBufferHelpers::getEventTotalSize (d) < start)
+            d += MidiBufferHelpers::getEventTotalSize (d);
+
+        lastEventTime = MidiBufferHelpers::getEventTime (d);
+    }
+}
+
+bool RealtimeMidiBuffer::addEvent (const MidiMessage& m, int sampleNumber) noexcept
+{
+    return addEvent (m.getRawData(), m.getRawDataSize(), sampleNumber);
+}
+
+bool RealtimeMidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber) noexcept
+{
+    const auto numBytes = MidiBufferHelpers::findActualEventLength (static_cast<const uint8*> (newData), maxBytes);
+
+    if (numBytes <= 0)
+        return true;
+
+    const auto newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
+
+    if (std::numeric_limits<uint16>::max() < numBytes || capacity - numBytesUsed < newItemSize)
+    {
+        ++numDroppedEvents;
+        return false;
+    }
+
+    auto* dataEnd = data.get() + numBytesUsed;
+    const auto isLast = isEmpty() || sampleNumber >= lastEventTime;
+    auto* d = isLast ? dataEnd : MidiBufferHelpers::findEventAfter (data.get(), dataEnd, sampleNumber);
+
+    memmove (d + newItemSize, d, (size_t) (dataEnd - d));
+
+    writeUnaligned<int32>  (d, sampleNumber);
+    d += sizeof (int32);
+    writeUnaligned<uint16> (d, static_cast<uint16> (numBytes));
+    d += sizeof (uint16);
+    memcpy (d, newData, (size_t) numBytes);
+
+    numBytesUsed += newItemSize;
+    ++numEvents;
+
+    if (isLast)
+        lastEventTime = sampleNumber;
+
+    return true;
+}
+
+template <typename Buffer>
+int RealtimeMidiBuffer::addEventsFrom (const Buffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept
+{
+    int numDropped = 0;
+
+    for (auto i = otherBuffer.findNextSamplePosition (startSample); i != otherBuffer.cend(); ++i)
+    {
+        const auto metadata = *i;
+
+        if (metadata.samplePosition >= startSample + numSamples && numSamples >= 0)
+            break;
+
+        if (! addEvent (metadata.data, metadata.numBytes, metadata.samplePosition + sampleDeltaToAdd))
+            ++numDropped;
+    }
+
+    return numDropped;
+}
+
+int RealtimeMidiBuffer::addEvents (const MidiBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept
+{
+    return addEventsFrom (otherBuffer, startSample, numSamples, sampleDeltaToAdd);
+}
+
+int RealtimeMidiBuffer::addEvents (const RealtimeMidiBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept
+{
+    // Adding a buffer to itself would invalidate the iterator
+    jassert (&otherBuffer != this);
+
+    return addEventsFrom (otherBuffer, startSample, numSamples, sampleDeltaToAdd);
+}
+
+void RealtimeMidiBuffer::addToMidiBuffer (MidiBuffer& destBuffer) const
+{
+    for (const auto metadata : *this)
+        destBuffer.addEvent (metadata.data, metadata.numBytes, metadata.samplePosition);
+}
+
+int RealtimeMidiBuffer::getFirstEventTime() const noexcept
+{
+    return isEmpty() ? 0 : MidiBufferHelpers::getEventTime (data.get());
+}
+
+void RealtimeMidiBuffer::swapWith (RealtimeMidiBuffer& other) noexcept
+{
+    data.swapWith (other.data);
+    std::swap (capacity, other.capacity);
+    std::swap (numBytesUsed, other.numBytesUsed);
+    std::swap (numEvents, other.numEvents);
+    std::swap (lastEventTime, other.lastEventTime);
+    std::swap (numDroppedEvents, other.numDroppedEvents);
+}
+
+MidiBufferIterator RealtimeMidiBuffer::findNextSamplePosition (int samplePosition) const noexcept
+{
+    return std::find_if (cbegin(), cend(), [&] (const MidiMessageMetadata& metadata) noexcept
+    {
+        return metadata.samplePosition >= samplePosition;
+    });
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct RealtimeMidiBufferTest final : public UnitTest
+{
+    RealtimeMidiBufferTest()
+        : UnitTest ("RealtimeMidiBuffer", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        const auto message = MidiMessage::noteOn (1, 64, 0.5f);
+
+        const auto getPositions = [] (const auto& buffer)
+        {
+            std::vector<int> result;
+
+            for (const auto metadata : buffer)
+                result.push_back (metadata.samplePosition);
+
+            return result;
+        };
+
+        beginTest ("Events are kept in the same order as a MidiBuffer");
+        {
+            RealtimeMidiBuffer buffer;
+            MidiBuffer reference;
+
+            for (const auto position : { 0, 10, 10, 5, 30, 20, 30, 0 })
+            {
+                expect (buffer.addEvent (MidiMessage::noteOn (1, position, 0.5f), position));
+                reference.addEvent (MidiMessage::noteOn (1, position, 0.5f), position);
+            }
+
+            expectEquals (buffer.getNumEvents(), reference.getNumEvents());
+            expectEquals (buffer.getFirstEventTime(), reference.getFirstEventTime());
+            expectEquals (buffer.getLastEventTime(), reference.getLastEventTime());
+            expect (getPositions (buffer) == getPositions (reference));
+            expect (std::equal (buffer.begin(), buffer.end(), reference.begin(), reference.end(),
+                                [] (const MidiMessageMetadata& a, const MidiMessageMetadata& b)
+                                {
+                                    return a.samplePosition == b.samplePosition
+                                        && a.numBytes == b.numBytes
+                                        && std::equal (a.data, a.data + a.numBytes, b.data);
+                                }));
+        }
+
+        beginTest ("Events that don't fit are dropped");
+        {
+            // Each note-on takes 9 bytes
+            RealtimeMidiBuffer buffer (30);
+
+            expect (buffer.addEvent (message, 0));
+            expect (buffer.addEvent (message, 1));
+            expect (buffer.addEvent (message, 2));
+            expect (! buffer.addEvent (message, 3));
+            expect (! buffer.addEvent (message, 0));
+
+            expectEquals (buffer.getNumEvents(), 3);
+            expectEquals (buffer.getNumDroppedEvents(), 2);
+            expectEquals ((int) buffer.getNumBytesUsed(), 27);
+            expect (getPositions (buffer) == std::vector<int> { 0, 1, 2 });
+
+            buffer.clear();
+            expect (buffer.isEmpty());
+            expectEquals (buffer.getNumDroppedEvents(), 0);
+        }
+
+        beginTest ("Clear a range of events");
+        {
+            RealtimeMidiBuffer buffer;
+
+            for (const auto position : { 0, 10, 20, 30 })
+                buffer.addEvent (message, position);
+
+            buffer.clear (10, 0);
+            expectEquals (buffer.getNumEvents(), 4);
+
+            buffer.clear (10, 10);
+            expect (getPositions (buffer) == std::vector<int> { 0, 20, 30 });
+
+            buffer.clear (25, 100);
+            expect (getPositions (buffer) == std::vector<int> { 0, 20 });
+            expectEquals (buffer.getLastEventTime(), 20);
+
+            // The last event time must be correct, so that this goes after the event at 20
+            buffer.addEvent (message, 25);
+            buffer.addEvent (message, 15);
+            expect (getPositions (buffer) == std::vector<int> { 0, 15, 20, 25 });
+        }
+
+        beginTest ("Events can be copied to and from a MidiBuffer");
+        {
+            MidiBuffer source;
+
+            for (const auto position : { 0, 10, 20, 30 })
+                source.addEvent (message, position);
+
+            RealtimeMidiBuffer buffer;
+            expectEquals (buffer.addEvents (source, 10, 15, 5), 0);
+            expect (getPositions (buffer) == std::vector<int> { 15, 25 });
+
+            MidiBuffer dest;
+            buffer.addToMidiBuffer (dest);
+            expect (getPositions (dest) == std::vector<int> { 15, 25 });
+        }
+    }
+};
+
+static RealtimeMidiBufferTest realtimeMidiBufferTest;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A MIDI buffer with a fixed capacity, which never allocates after it has been
+    created.
+
+    A MidiBuffer grows as events are added to it, so a burst of incoming MIDI can
+    cause it to allocate memory on the audio thread. A RealtimeMidiBuffer allocates
+    all of its storage in its constructor instead. If an event won't fit, addEvent()
+    returns false and the event is counted as dropped, so that you can find out that
+    the buffer needs to be larger.
+
+    Events are stored in the same format as a MidiBuffer, so the buffer can be iterated
+    with a MidiBufferIterator, and code that loops over a MidiBuffer will work with a
+    RealtimeMidiBuffer without any changes:
+
+    @code
+    for (const auto metadata : realtimeMidiBuffer)
+        if (metadata.numBytes == 3)
+            handleShortMessage (metadata.data, metadata.samplePosition);
+    @endcode
+
+    Adding an event whose sample position is the same as, or later than, the last event
+    in the buffer is a constant-time operation. Adding an earlier event has to move the
+    events after it.
+
+    @see MidiBuffer, MidiBufferIterator
+
+    @tags{Audio}
+*/
+class JUCE_API  RealtimeMidiBuffer
+{
+public:
+    //==============================================================================
+    /** Creates an empty buffer that can hold the given number of bytes.
+
+        Each event uses 6 bytes as well as the size of its MIDI data, so a buffer of
+        4096 bytes can hold about 450 three-byte messages.
+    */
+    explicit RealtimeMidiBuffer (size_t capacityInBytes = 4096);
+
+    /** Destructor. */
+    ~RealtimeMidiBuffer();
+
+    //==============================================================================
+    /** Removes all events from the buffer, and resets the count of dropped events. */
+    void clear() noexcept;
+
+    /** Removes all events between two times from the buffer.
+
+        All events for which (start <= event position < start + numSamples) will
+        be removed.
+    */
+    void clear (int start, int numSamples) noexcept;
+
+    /** Returns true if the buffer is empty. */
+    bool isEmpty() const noexcept                       { return numBytesUsed == 0; }
+
+    /** Returns the number of events in the buffer. */
+    int getNumEvents() const noexcept                   { return numEvents; }
+
+    /** Adds an event to the buffer.
+
+        The sample number is used to determine the position of the event in the buffer,
+        which is always kept sorted. If an event is added whose sample position is the
+        same as one or more events already in the buffer, the new event will be placed
+        after the existing ones.
+
+        Returns false if there wasn't room for the event, in which case it's counted as
+        a dropped event.
+    */
+    bool addEvent (const MidiMessage& midiMessage, int sampleNumber) noexcept;
+
+    /** Adds an event to the buffer from raw midi data.
+
+        As with MidiBuffer::addEvent(), the data is inspected to find the length of the
+        event, which may be shorter than maxBytesOfMidiData.
+
+        Returns false if there wasn't room for the event, in which case it's counted as
+        a dropped event.
+    */
+    bool addEvent (const void* rawMidiData, int maxBytesOfMidiData, int sampleNumber) noexcept;
+
+    /** Adds some events from a MidiBuffer to this one.
+
+        The arguments have the same meanings as in MidiBuffer::addEvents().
+
+        Returns the number of events that were dropped because there wasn't room for them.
+    */
+    int addEvents (const MidiBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept;
+
+    /** Adds some events from another RealtimeMidiBuffer to this one.
+
+        The arguments have the same meanings as in MidiBuffer::addEvents().
+
+        Returns the number of events that were dropped because there wasn't room for them.
+    */
+    int addEvents (const RealtimeMidiBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept;
+
+    /** Adds all of the events in this buffer to a MidiBuffer.
+
+        The MidiBuffer may need to allocate, unless enough space has been reserved in it
+        with MidiBuffer::ensureSize().
+    */
+    void addToMidiBuffer (MidiBuffer& destBuffer) const;
+
+    /** Returns the sample number of the first event in the buffer, or 0 if it's empty. */
+    int getFirstEventTime() const noexcept;
+
+    /** Returns the sample number of the last event in the buffer, or 0 if it's empty. */
+    int getLastEventTime() const noexcept               { return isEmpty() ? 0 : lastEventTime; }
+
+    //==============================================================================
+    /** Returns the number of bytes that the buffer can hold. */
+    size_t getCapacity() const noexcept                 { return capacity; }
+
+    /** Returns the number of bytes that are currently in use. */
+    size_t getNumBytesUsed() const noexcept             { return numBytesUsed; }
+
+    /** Returns the number of events that couldn't be added since the buffer was last
+        cleared, because there wasn't enough room for them.
+    */
+    int getNumDroppedEvents() const noexcept            { return numDroppedEvents; }
+
+    /** Exchanges the contents of this buffer with another one, without allocating or
+        copying any events.
+    */
+    void swapWith (RealtimeMidiBuffer&) noexcept;
+
+    //==============================================================================
+    /** Get a read-only iterator pointing to the beginning of this buffer. */
+    MidiBufferIterator begin()  const noexcept          { return cbegin(); }
+
+    /** Get a read-only iterator pointing one past the end of this buffer. */
+    MidiBufferIterator end()    const noexcept          { return cend(); }
+
+    /** Get a read-only iterator pointing to the beginning of this buffer. */
+    MidiBufferIterator cbegin() const noexcept          { return MidiBufferIterator (data.get()); }
+
+    /** Get a read-only iterator pointing one past the end of this buffer. */
+    MidiBufferIterator cend()   const noexcept          { return MidiBufferIterator (data.get() + numBytesUsed); }
+
+    /** Get an iterator pointing to the first event with a timestamp greater-than or
+        equal-to `samplePosition`.
+    */
+    MidiBufferIterator findNextSamplePosition (int samplePosition) const noexcept;
+
+private:
+    //==============================================================================
+    template <typename Buffer>
+    int addEventsFrom (const Buffer&, int startSample, int numSamples, int sampleDeltaToAdd) noexcept;
+
+    HeapBlock<uint8> data;
+    size_t capacity = 0, numBytesUsed = 0;
+    int numEvents = 0, lastEventTime = 0, numDroppedEvents = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeMidiBuffer)
+};
+
+} // namespace juce
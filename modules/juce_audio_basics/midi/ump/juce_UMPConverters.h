@@ -35,6 +35,78 @@
 /** @cond */
 namespace juce::universal_midi_packets
 {
+    /**
+        Describes how much of a block of messages was converted by one of the
+        block conversion functions of the UMP converters.
+
+        @tags{Audio}
+    */
+    struct BlockConversionResult
+    {
+        /** The number of source items that were converted. When converting from a
+            MidiBuffer this counts events, and when converting from a span of
+            Universal MIDI Packets it counts 32-bit words.
+        */
+        size_t numSourceItemsRead = 0;
+
+        /** The number of 32-bit words that were written to the destination. */
+        size_t numWordsWritten = 0;
+
+        /** The number of packets that were written to the destination. */
+        size_t numPacketsWritten = 0;
+    };
+
+    /**
+        Writes packets into caller-provided storage during a block conversion.
+
+        A block conversion checks hasSpaceFor() before converting each source message,
+        so that a message is either converted completely or not at all.
+
+        @tags{Audio}
+    */
+    class BlockPacketWriter
+    {
+    public:
+        BlockPacketWriter (Span<uint32_t> destWords, Span<int> destPacketSamplePositions)
+            : words (destWords), samplePositions (destPacketSamplePositions) {}
+
+        /** Returns true if up to numWords words (and so up to numWords packets) can be written. */
+        bool hasSpaceFor (size_t numWords) const noexcept
+        {
+            return result.numWordsWritten + numWords <= words.size()
+                && (samplePositions.empty() || result.numPacketsWritten + numWords <= samplePositions.size());
+        }
+
+        void write (uint32_t word, int samplePosition) noexcept
+        {
+            jassert (hasSpaceFor (1));
+
+            if (! samplePositions.empty())
+                samplePositions[result.numPacketsWritten] = samplePosition;
+
+            words[result.numWordsWritten++] = word;
+            ++result.numPacketsWritten;
+        }
+
+        void write (const View& v, int samplePosition) noexcept
+        {
+            jassert (hasSpaceFor (v.size()));
+
+            if (! samplePositions.empty())
+                samplePositions[result.numPacketsWritten] = samplePosition;
+
+            std::copy (v.cbegin(), v.cend(), words.begin() + result.numWordsWritten);
+            result.numWordsWritten += v.size();
+            ++result.numPacketsWritten;
+        }
+
+        BlockConversionResult result;
+
+    private:
+        Span<uint32_t> words;
+        Span<int> samplePositions;
+    };
+
     /**
         Allows conversion from bytestream- or Universal MIDI Packet-formatted
         messages to MIDI 1.0 messages in UMP format.
@@ -55,6 +127,110 @@ namespace juce::universal_midi_packets
             Conversion::midi2ToMidi1DefaultTranslation (v, std::forward<Fn> (fn));
         }
 
+        /** Converts all the messages in a MidiBuffer in a single pass, writing the
+            packets into destWords.
+
+            If packetSamplePositions isn't empty, the sample position of each packet is
+            written to it at the packet's index. Nothing is allocated, so this can be
+            called on the audio thread.
+
+            Conversion stops before the first message that won't fit in the destination.
+            A destination with at least as many words as there are bytes in source.data
+            will always be big enough.
+        */
+        BlockConversionResult convert (const MidiBuffer& source,
+                                       uint8_t group,
+                                       Span<uint32_t> destWords,
+                                       Span<int> packetSamplePositions = {})
+        {
+            BlockPacketWriter writer (destWords, packetSamplePositions);
+
+            for (const auto metadata : source)
+            {
+                const auto bytes = metadata.asSpan();
+
+                if (! writer.hasSpaceFor (getNumWordsForBytestreamMessage (bytes)))
+                    break;
+
+                if (isShortBytestreamMessage (bytes))
+                    writer.write (shortBytestreamMessageToWord (group, bytes), metadata.samplePosition);
+                else
+                    Conversion::toMidi1 ({ group, bytes }, [&] (const View& v) { writer.write (v, metadata.samplePosition); });
+
+                ++writer.result.numSourceItemsRead;
+            }
+
+            return writer.result;
+        }
+
+        /** Converts a span of Universal MIDI Packets, which may contain MIDI 2.0 channel
+            voice messages, to MIDI 1.0 packets in a single pass.
+
+            The source must only contain complete packets. Conversion stops before the first
+            packet whose translation won't fit in destWords.
+
+            @see Conversion::midi2ToMidi1DefaultTranslation
+        */
+        BlockConversionResult convert (Span<const uint32_t> sourceWords, Span<uint32_t> destWords)
+        {
+            BlockPacketWriter writer (destWords, {});
+
+            for (auto& numRead = writer.result.numSourceItemsRead; numRead < sourceWords.size();)
+            {
+                const auto firstWord = sourceWords[numRead];
+                const auto numWords = (size_t) Utils::getNumWordsForMessageType (firstWord);
+
+                // An RPN or NRPN becomes four MIDI 1.0 packets
+                const auto maxWordsOut = Utils::getMessageType (firstWord) == Utils::MessageKind::channelVoice2 ? 4 : numWords;
+
+                if (numRead + numWords > sourceWords.size() || ! writer.hasSpaceFor (maxWordsOut))
+                    break;
+
+                Conversion::midi2ToMidi1DefaultTranslation (View (sourceWords.data() + numRead),
+                                                            [&] (const View& v) { writer.write (v, 0); });
+                numRead += numWords;
+            }
+
+            return writer.result;
+        }
+
+        /** Returns the number of words in the MIDI 1.0 packets that a bytestream message converts to. */
+        static size_t getNumWordsForBytestreamMessage (Span<const std::byte> bytes)
+        {
+            if (bytes.empty())
+                return 0;
+
+            if (bytes[0] != std::byte { 0xf0 })
+                return 1;
+
+            // Each SysEx7 packet holds 6 bytes, not counting the 0xf0 and 0xf7
+            const auto numDataBytes = bytes.size() >= 2 ? bytes.size() - 2 : 0;
+            return 2 * jmax ((size_t) 1, (numDataBytes + 5) / 6);
+        }
+
+        /** Returns true if a bytestream message fits in a single MIDI 1.0 packet. */
+        static bool isShortBytestreamMessage (Span<const std::byte> bytes)
+        {
+            return ! bytes.empty() && bytes.size() <= 3 && bytes[0] != std::byte { 0xf0 };
+        }
+
+        /** Converts a bytestream message that isShortBytestreamMessage() to a MIDI 1.0 packet.
+
+            This gives the same result as Conversion::toMidi1(), without the callback.
+        */
+        static uint32_t shortBytestreamMessageToWord (uint8_t group, Span<const std::byte> bytes)
+        {
+            jassert (isShortBytestreamMessage (bytes));
+
+            const auto type = (bytes[0] & std::byte { 0xf0 }) == std::byte { 0xf0 } ? 0x1u : 0x2u;
+            auto word = (type << 0x1c) | ((uint32_t) (group & 0xf) << 0x18) | ((uint32_t) bytes[0] << 0x10);
+
+            if (bytes.size() > 1)   word |= (uint32_t) bytes[1] << 0x08;
+            if (bytes.size() > 2)   word |= (uint32_t) bytes[2];
+
+            return word;
+        }
+
         void reset() {}
     };
 
@@ -81,6 +257,70 @@ namespace juce::universal_midi_packets
             translator.dispatch (v, std::forward<Fn> (fn));
         }
 
+        /** Converts all the messages in a MidiBuffer to MIDI 2.0 packets in a single pass.
+
+            This works in the same way as ToUMP1Converter::convert(), except that each MIDI 1.0
+            packet can become a packet of up to two words, so a destination should have at
+            least twice as many words as there are bytes in source.data to always be big enough.
+
+            @see ToUMP1Converter::convert
+        */
+        BlockConversionResult convert (const MidiBuffer& source,
+                                       uint8_t group,
+                                       Span<uint32_t> destWords,
+                                       Span<int> packetSamplePositions = {})
+        {
+            BlockPacketWriter writer (destWords, packetSamplePositions);
+
+            for (const auto metadata : source)
+            {
+                const auto bytes = metadata.asSpan();
+
+                if (! writer.hasSpaceFor (2 * ToUMP1Converter::getNumWordsForBytestreamMessage (bytes)))
+                    break;
+
+                const auto writePacket = [&] (const View& v) { writer.write (v, metadata.samplePosition); };
+
+                if (ToUMP1Converter::isShortBytestreamMessage (bytes))
+                {
+                    const auto word = ToUMP1Converter::shortBytestreamMessageToWord (group, bytes);
+                    translator.dispatch (View (&word), writePacket);
+                }
+                else
+                {
+                    Conversion::toMidi1 ({ group, bytes }, [&] (const View& midi1) { translator.dispatch (midi1, writePacket); });
+                }
+
+                ++writer.result.numSourceItemsRead;
+            }
+
+            return writer.result;
+        }
+
+        /** Converts a span of MIDI 1.0 Universal MIDI Packets to MIDI 2.0 packets in a
+            single pass.
+
+            The source must only contain complete packets. Conversion stops before the first
+            packet whose translation won't fit in destWords.
+        */
+        BlockConversionResult convert (Span<const uint32_t> sourceWords, Span<uint32_t> destWords)
+        {
+            BlockPacketWriter writer (destWords, {});
+
+            for (auto& numRead = writer.result.numSourceItemsRead; numRead < sourceWords.size();)
+            {
+                const auto numWords = (size_t) Utils::getNumWordsForMessageType (sourceWords[numRead]);
+
+                if (numRead + numWords > sourceWords.size() || ! writer.hasSpaceFor (jmax ((size_t) 2, numWords)))
+                    break;
+
+                translator.dispatch (View (sourceWords.data() + numRead), [&] (const View& v) { writer.write (v, 0); });
+                numRead += numWords;
+            }
+
+            return writer.result;
+        }
+
         void reset()
         {
             translator.reset();
@@ -206,6 +446,42 @@ namespace juce::universal_midi_packets
             });
         }
 
+        /** Converts a span of Universal MIDI Packets, using either protocol, and adds the
+            resulting messages to a MidiBuffer in a single pass.
+
+            If packetSamplePositions isn't empty, it must hold the sample position of each
+            packet in the source, by packet index. Otherwise, the messages are added at sample 0.
+            The source must only contain complete packets.
+
+            As long as the MidiBuffer has had enough space reserved with MidiBuffer::ensureSize(),
+            and no SysEx message is longer than the storage size this converter was created with,
+            this won't allocate.
+        */
+        void convert (Span<const uint32_t> sourceWords, Span<const int> packetSamplePositions, MidiBuffer& dest)
+        {
+            size_t packetIndex = 0;
+
+            for (size_t numRead = 0; numRead < sourceWords.size(); ++packetIndex)
+            {
+                const auto numWords = (size_t) Utils::getNumWordsForMessageType (sourceWords[numRead]);
+
+                if (numRead + numWords > sourceWords.size())
+                {
+                    jassertfalse; // The source contained a truncated packet!
+                    break;
+                }
+
+                const auto time = packetIndex < packetSamplePositions.size() ? packetSamplePositions[packetIndex] : 0;
+
+                convert (View (sourceWords.data() + numRead), (double) time, [&] (const BytesOnGroup& b, double t)
+                {
+                    dest.addEvent (b.bytes.data(), (int) b.bytes.size(), (int) t);
+                });
+
+                numRead += numWords;
+            }
+        }
+
         void reset() { translator.reset(); }
 
         SingleGroupMidi1ToBytestreamTranslator translator;
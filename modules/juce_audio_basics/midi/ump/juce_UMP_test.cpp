@@ -853,6 +853,86 @@ public:
 
             checkMidi1ToMidi2Conversion (midi1, midi2);
         }
+
+        beginTest ("Block conversions match per-message conversions");
+        {
+            MidiBuffer source;
+            int time = 0;
+
+            forEachNonSysExTestMessage (random, [&] (const MidiMessage& m) { source.addEvent (m, time++); });
+
+            for (size_t numBytes = 1; numBytes < 20; ++numBytes)
+                source.addEvent (createRandomSysEx (random, numBytes), time++);
+
+            Packets expectedMidi1;
+            std::vector<int> expectedPositions;
+
+            for (const auto metadata : source)
+            {
+                Conversion::toMidi1 ({ 3, metadata.asSpan() }, [&] (const View& v)
+                {
+                    expectedMidi1.add (v);
+                    expectedPositions.push_back (metadata.samplePosition);
+                });
+            }
+
+            std::vector<uint32_t> words ((size_t) source.data.size());
+            std::vector<int> positions (words.size());
+
+            const auto result = ToUMP1Converter{}.convert (source, 3, words, positions);
+            words.resize (result.numWordsWritten);
+            positions.resize (result.numPacketsWritten);
+
+            expectEquals ((int) result.numSourceItemsRead, source.getNumEvents());
+            expect (std::equal (words.begin(), words.end(), expectedMidi1.data(), expectedMidi1.data() + expectedMidi1.size()));
+            expect (positions == expectedPositions);
+
+            {
+                // Conversion stops at a message boundary if the destination is full
+                std::vector<uint32_t> shortDest (expectedMidi1.size() - 3);
+                const auto partial = ToUMP1Converter{}.convert (source, 3, shortDest);
+
+                // The last SysEx needs eight words, so it won't fit
+                expectEquals ((int) partial.numSourceItemsRead, source.getNumEvents() - 1);
+                expectEquals (partial.numWordsWritten, expectedMidi1.size() - 8);
+                expect (std::equal (shortDest.begin(), shortDest.begin() + (ptrdiff_t) partial.numWordsWritten, expectedMidi1.data()));
+            }
+
+            const auto expectedMidi2 = convertMidi1ToMidi2 (expectedMidi1);
+
+            {
+                std::vector<uint32_t> midi2 (2 * expectedMidi1.size());
+                const auto midi2Result = ToUMP2Converter{}.convert (Span<const uint32_t> (words), midi2);
+                midi2.resize (midi2Result.numWordsWritten);
+
+                expectEquals (midi2Result.numSourceItemsRead, words.size());
+                expect (std::equal (midi2.begin(), midi2.end(), expectedMidi2.data(), expectedMidi2.data() + expectedMidi2.size()));
+            }
+
+            {
+                std::vector<uint32_t> midi2 (2 * (size_t) source.data.size());
+                const auto midi2Result = ToUMP2Converter{}.convert (source, 3, midi2);
+                midi2.resize (midi2Result.numWordsWritten);
+
+                expect (std::equal (midi2.begin(), midi2.end(), expectedMidi2.data(), expectedMidi2.data() + expectedMidi2.size()));
+            }
+
+            {
+                const auto expectedBackToMidi1 = convertMidi2ToMidi1 (expectedMidi2);
+                std::vector<uint32_t> midi1 (4 * expectedMidi2.size());
+                const auto midi1Result = ToUMP1Converter{}.convert (Span (expectedMidi2.data(), expectedMidi2.size()), midi1);
+                midi1.resize (midi1Result.numWordsWritten);
+
+                expect (std::equal (midi1.begin(), midi1.end(), expectedBackToMidi1.data(), expectedBackToMidi1.data() + expectedBackToMidi1.size()));
+            }
+
+            {
+                MidiBuffer roundTripped;
+                ToBytestreamConverter (4096).convert (Span<const uint32_t> (words), Span<const int> (positions), roundTripped);
+
+                expect (equal (roundTripped, source));
+            }
+        }
     }
 
 private:
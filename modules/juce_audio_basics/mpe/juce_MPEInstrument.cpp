@@ -49,6 +49,7 @@ namespace
 
 //==============================================================================
 MPEInstrument::MPEInstrument() noexcept
+    : noteSlots ((size_t) numNoteSlots)
 {
     mpeInstrumentFill (lastPressureLowerBitReceivedOnChannel, noLSBValueReceived);
     mpeInstrumentFill (lastTimbreLowerBitReceivedOnChannel, noLSBValueReceived);
@@ -277,16 +278,16 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
 
     if (legacyMode.isEnabled && legacyMode.channelRange.contains (message.getChannel()))
     {
-        for (int i = notes.size(); --i >= 0;)
+        for (int i = numNotes; --i >= 0;)
         {
-            auto& note = notes.getReference (i);
+            auto& note = getNoteAt (i);
 
             if (note.midiChannel == message.getChannel())
             {
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNoteAt (i);
             }
         }
     }
@@ -295,16 +296,16 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
         auto zone = (message.getChannel() == 1 ? zoneLayout.getLowerZone()
                                                : zoneLayout.getUpperZone());
 
-        for (int i = notes.size(); --i >= 0;)
+        for (int i = numNotes; --i >= 0;)
         {
-            auto& note = notes.getReference (i);
+            auto& note = getNoteAt (i);
 
             if (zone.isUsing (note.midiChannel))
             {
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNoteAt (i);
             }
         }
     }
@@ -354,6 +355,12 @@ void MPEInstrument::noteOn (int midiChannel,
     if (! isUsingChannel (midiChannel))
         return;
 
+    if (! isPositiveAndBelow (midiNoteNumber, 128))
+    {
+        jassertfalse;
+        return;
+    }
+
     MPENote newNote (midiChannel,
                      midiNoteNumber,
                      midiNoteOnVelocity,
@@ -371,10 +378,10 @@ void MPEInstrument::noteOn (int midiChannel,
         alreadyPlayingNote->keyState = MPENote::off;
         alreadyPlayingNote->noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
         listeners.call ([=] (Listener& l) { l.noteReleased (*alreadyPlayingNote); });
-        notes.remove (alreadyPlayingNote);
+        removeNote (*alreadyPlayingNote);
     }
 
-    notes.add (newNote);
+    addNote (newNote);
     listeners.call ([&] (Listener& l) { l.noteAdded (newNote); });
 }
 
@@ -385,7 +392,7 @@ void MPEInstrument::noteOff (int midiChannel,
 {
     const ScopedLock sl (lock);
 
-    if (notes.isEmpty() || ! isUsingChannel (midiChannel))
+    if (numNotes == 0 || ! isUsingChannel (midiChannel))
         return;
 
     if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
@@ -404,7 +411,7 @@ void MPEInstrument::noteOff (int midiChannel,
         if (note->keyState == MPENote::off)
         {
             listeners.call ([=] (Listener& l) { l.noteReleased (*note); });
-            notes.remove (note);
+            removeNote (*note);
         }
         else
         {
@@ -436,16 +443,12 @@ void MPEInstrument::polyAftertouch (int midiChannel, int midiNoteNumber, MPEValu
 {
     const ScopedLock sl (lock);
 
-    for (int i = notes.size(); --i >= 0;)
+    if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
     {
-        auto& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel
-            && note.initialNote == midiNoteNumber
-            && pressureDimension.getValue (note) != value)
+        if (pressureDimension.getValue (*note) != value)
         {
-            pressureDimension.getValue (note) = value;
-            callListenersDimensionChanged (note, pressureDimension);
+            pressureDimension.getValue (*note) = value;
+            callListenersDimensionChanged (*note, pressureDimension);
         }
     }
 }
@@ -463,20 +466,17 @@ void MPEInstrument::updateDimension (int midiChannel, MPEDimension& dimension, M
 {
     dimension.lastValueReceivedOnChannel[midiChannel - 1] = value;
 
-    if (notes.isEmpty())
+    if (numNotes == 0)
         return;
 
     if (isMemberChannel (midiChannel))
     {
         if (dimension.trackingMode == allNotesOnChannel)
         {
-            for (int i = notes.size(); --i >= 0;)
-            {
-                auto& note = notes.getReference (i);
+            const auto& channelNotes = channelNoteOrder[(size_t) midiChannel - 1];
 
-                if (note.midiChannel == midiChannel)
-                    updateDimensionForNote (note, dimension, value);
-            }
+            for (int i = numNotesOnChannel[(size_t) midiChannel - 1]; --i >= 0;)
+                updateDimensionForNote (*getNotePtr (midiChannel, channelNotes[(size_t) i]), dimension, value);
         }
         else
         {
@@ -499,9 +499,9 @@ void MPEInstrument::updateDimensionMaster (bool isLowerZone, MPEDimension& dimen
     if (! zone.isActive())
         return;
 
-    for (int i = notes.size(); --i >= 0;)
+    for (int i = numNotes; --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = getNoteAt (i);
 
         if (! zone.isUsing (note.midiChannel))
             continue;
@@ -608,9 +608,9 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
     auto zone = (midiChannel == 1 ? zoneLayout.getLowerZone()
                                   : zoneLayout.getUpperZone());
 
-    for (int i = notes.size(); --i >= 0;)
+    for (int i = numNotes; --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = getNoteAt (i);
 
         if (legacyMode.isEnabled ? (note.midiChannel == midiChannel) : zone.isUsing (note.midiChannel))
         {
@@ -624,7 +624,7 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
             if (note.keyState == MPENote::off)
             {
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNoteAt (i);
             }
             else
             {
@@ -687,7 +687,7 @@ bool MPEInstrument::isUsingChannel (int midiChannel) const noexcept
 //==============================================================================
 int MPEInstrument::getNumPlayingNotes() const noexcept
 {
-    return notes.size();
+    return numNotes;
 }
 
 MPENote MPEInstrument::getNote (int midiChannel, int midiNoteNumber) const noexcept
@@ -700,16 +700,19 @@ MPENote MPEInstrument::getNote (int midiChannel, int midiNoteNumber) const noexc
 
 MPENote MPEInstrument::getNote (int index) const noexcept
 {
-    return notes[index];
+    if (isPositiveAndBelow (index, numNotes))
+        return getNoteAt (index);
+
+    return {};
 }
 
 MPENote MPEInstrument::getNoteWithID (uint16 noteID) const noexcept
 {
     const ScopedLock sl (lock);
 
-    for (auto& note : notes)
-        if (note.noteID == noteID)
-            return note;
+    for (int i = 0; i < numNotes; ++i)
+        if (getNoteAt (i).noteID == noteID)
+            return getNoteAt (i);
 
     return {};
 }
@@ -725,9 +728,9 @@ MPENote MPEInstrument::getMostRecentNote (int midiChannel) const noexcept
 
 MPENote MPEInstrument::getMostRecentNoteOtherThan (MPENote otherThanThisNote) const noexcept
 {
-    for (auto i = notes.size(); --i >= 0;)
+    for (auto i = numNotes; --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = getNoteAt (i);
 
         if (note != otherThanThisNote)
             return note;
@@ -739,15 +742,11 @@ MPENote MPEInstrument::getMostRecentNoteOtherThan (MPENote otherThanThisNote) co
 //==============================================================================
 const MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) const noexcept
 {
-    for (int i = 0; i < notes.size(); ++i)
-    {
-        auto& note = notes.getReference (i);
+    if (! isPositiveAndBelow (midiChannel - 1, 16) || ! isPositiveAndBelow (midiNoteNumber, 128))
+        return nullptr;
 
-        if (note.midiChannel == midiChannel && note.initialNote == midiNoteNumber)
-            return &note;
-    }
-
-    return nullptr;
+    auto& note = noteSlots[(size_t) ((midiChannel - 1) * 128 + midiNoteNumber)];
+    return note.isValid() ? &note : nullptr;
 }
 
 MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) noexcept
@@ -779,13 +778,17 @@ const MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) const noexc
 {
     const ScopedLock sl (lock);
 
-    for (auto i = notes.size(); --i >= 0;)
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
+
+    const auto& channelNotes = channelNoteOrder[(size_t) midiChannel - 1];
+
+    for (int i = numNotesOnChannel[(size_t) midiChannel - 1]; --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto* note = getNotePtr (midiChannel, channelNotes[(size_t) i]);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
-            return &note;
+        if (note->keyState == MPENote::keyDown || note->keyState == MPENote::keyDownAndSustained)
+            return note;
     }
 
     return nullptr;
@@ -802,12 +805,16 @@ const MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) const noexcept
     int initialNoteMax = -1;
     const MPENote* result = nullptr;
 
-    for (auto i = notes.size(); --i >= 0;)
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
+
+    const auto& channelNotes = channelNoteOrder[(size_t) midiChannel - 1];
+
+    for (int i = numNotesOnChannel[(size_t) midiChannel - 1]; --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = *getNotePtr (midiChannel, channelNotes[(size_t) i]);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
              && note.initialNote > initialNoteMax)
         {
             result = &note;
@@ -828,12 +835,16 @@ const MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) const noexcept
     int initialNoteMin = 128;
     const MPENote* result = nullptr;
 
-    for (auto i = notes.size(); --i >= 0;)
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
+
+    const auto& channelNotes = channelNoteOrder[(size_t) midiChannel - 1];
+
+    for (int i = numNotesOnChannel[(size_t) midiChannel - 1]; --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = *getNotePtr (midiChannel, channelNotes[(size_t) i]);
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
              && note.initialNote < initialNoteMin)
         {
             result = &note;
@@ -854,15 +865,60 @@ void MPEInstrument::releaseAllNotes()
 {
     const ScopedLock sl (lock);
 
-    for (auto i = notes.size(); --i >= 0;)
+    for (auto i = numNotes; --i >= 0;)
     {
-        auto& note = notes.getReference (i);
+        auto& note = getNoteAt (i);
         note.keyState = MPENote::off;
         note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
         listeners.call ([&] (Listener& l) { l.noteReleased (note); });
     }
 
-    notes.clear();
+    for (auto i = numNotes; --i >= 0;)
+        removeNoteAt (i);
+}
+
+//==============================================================================
+void MPEInstrument::addNote (const MPENote& note) noexcept
+{
+    jassert (note.isValid() && getNotePtr (note.midiChannel, note.initialNote) == nullptr);
+
+    const auto channelIndex = (size_t) note.midiChannel - 1;
+    const auto slot = channelIndex * 128 + note.initialNote;
+
+    noteSlots[slot] = note;
+    noteOrder[(size_t) numNotes++] = (uint16) slot;
+    channelNoteOrder[channelIndex][numNotesOnChannel[channelIndex]++] = note.initialNote;
+}
+
+void MPEInstrument::removeNote (const MPENote& note) noexcept
+{
+    const auto slot = (uint16) (&note - noteSlots.data());
+    const auto end = noteOrder.begin() + numNotes;
+    const auto it = std::find (noteOrder.begin(), end, slot);
+
+    if (it != end)
+        removeNoteAt ((int) std::distance (noteOrder.begin(), it));
+    else
+        jassertfalse;
+}
+
+void MPEInstrument::removeNoteAt (int index) noexcept
+{
+    jassert (isPositiveAndBelow (index, numNotes));
+
+    auto& note = getNoteAt (index);
+    const auto channelIndex = (size_t) note.midiChannel - 1;
+    auto& channelNotes = channelNoteOrder[channelIndex];
+    const auto channelEnd = channelNotes.begin() + numNotesOnChannel[channelIndex];
+
+    std::move (std::find (channelNotes.begin(), channelEnd, note.initialNote) + 1, channelEnd,
+               std::find (channelNotes.begin(), channelEnd, note.initialNote));
+    --numNotesOnChannel[channelIndex];
+
+    std::move (noteOrder.begin() + index + 1, noteOrder.begin() + numNotes, noteOrder.begin() + index);
+    --numNotes;
+
+    note = {};
 }
 
 //==============================================================================
@@ -2205,6 +2261,86 @@ public:
                 expectEquals (test.getNumPlayingNotes(), 0);
             }
         }
+
+        beginTest ("many notes");
+        {
+            MPEInstrument test;
+            test.setZoneLayout (testLayout);
+
+            // every note number on one channel, and a few on the other member channels
+            for (int i = 0; i < 128; ++i)
+                test.noteOn (3, (i * 37) % 128, MPEValue::from7BitInt (100));
+
+            for (int channel = 10; channel <= 15; ++channel)
+                test.noteOn (channel, 60, MPEValue::from7BitInt (100));
+
+            expectEquals (test.getNumPlayingNotes(), 134);
+
+            for (int i = 0; i < 128; ++i)
+            {
+                expectEquals ((int) test.getNote (i).initialNote, (i * 37) % 128);
+                expect (test.getNote (3, i).isValid());
+            }
+
+            // release every other note, and check that the order of the rest is unchanged
+            for (int i = 0; i < 128; i += 2)
+                test.noteOff (3, (i * 37) % 128, MPEValue::from7BitInt (0));
+
+            expectEquals (test.getNumPlayingNotes(), 70);
+
+            for (int i = 0; i < 64; ++i)
+                expectEquals ((int) test.getNote (i).initialNote, ((i * 2 + 1) * 37) % 128);
+
+            expect (! test.getNote (3, 0).isValid());
+            expectEquals ((int) test.getMostRecentNote (3).initialNote, (127 * 37) % 128);
+            expectEquals ((int) test.getMostRecentNote (15).initialNote, 60);
+            expectEquals ((int) test.getNote (69).midiChannel, 15);
+
+            // tracking modes only look at the notes on the message's channel
+            test.setPressureTrackingMode (MPEInstrument::highestNoteOnChannel);
+            test.pressure (3, MPEValue::from7BitInt (50));
+            expectEquals (test.getNote (3, 127).pressure.as7BitInt(), 50);
+
+            test.setPressureTrackingMode (MPEInstrument::lowestNoteOnChannel);
+            test.pressure (3, MPEValue::from7BitInt (60));
+            expectEquals (test.getNote (3, 1).pressure.as7BitInt(), 60);
+
+            test.setPressureTrackingMode (MPEInstrument::allNotesOnChannel);
+            test.pressure (3, MPEValue::from7BitInt (70));
+
+            for (int i = 0; i < 64; ++i)
+                expectEquals (test.getNote (i).pressure.as7BitInt(), 70);
+
+            expectEquals (test.getNote (10, 60).pressure.as7BitInt(), 0);
+
+            test.releaseAllNotes();
+            expectEquals (test.getNumPlayingNotes(), 0);
+            expect (! test.getNote (3, 1).isValid());
+        }
+
+       #if JUCE_ENABLE_ALLOCATION_HOOKS
+        beginTest ("processNextMidiEvent doesn't allocate");
+        {
+            MPEInstrument test;
+            test.setZoneLayout (testLayout);
+
+            const UnitTestAllocationChecker checker (*this);
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                const auto channel = 2 + (i % 4);
+                const auto note = (i * 7) % 128;
+
+                test.processNextMidiEvent (MidiMessage::noteOn (channel, note, (uint8) 100));
+                test.processNextMidiEvent (MidiMessage::pitchWheel (channel, (i * 100) % 16384));
+                test.processNextMidiEvent (MidiMessage::channelPressureChange (channel, i % 128));
+                test.processNextMidiEvent (MidiMessage::controllerEvent (channel, 74, i % 128));
+
+                if (i % 3 == 0)
+                    test.processNextMidiEvent (MidiMessage::noteOff (channel, note));
+            }
+        }
+       #endif
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 
@@ -373,7 +373,18 @@ protected:
 
 private:
     //==============================================================================
-    Array<MPENote> notes;
+    // Each channel and note number has its own slot, so that a note can be found without
+    // searching. The order in which the playing notes were added is kept separately, both
+    // for the whole instrument and for each channel. All of this is allocated up-front, so
+    // adding and removing notes never allocates.
+    static constexpr int numNoteSlots = 16 * 128;
+
+    std::vector<MPENote> noteSlots;
+    std::array<uint16, numNoteSlots> noteOrder;
+    std::array<std::array<uint8, 128>, 16> channelNoteOrder;
+    std::array<uint8, 16> numNotesOnChannel {};
+    int numNotes = 0;
+
     MPEZoneLayout zoneLayout;
     ListenerList<Listener> listeners;
 
@@ -432,6 +443,12 @@ private:
     MPENote* getLowestNotePtr (int midiChannel) noexcept;
     void updateNoteTotalPitchbend (MPENote&);
 
+    MPENote& getNoteAt (int index) noexcept                 { return noteSlots[noteOrder[(size_t) index]]; }
+    const MPENote& getNoteAt (int index) const noexcept     { return noteSlots[noteOrder[(size_t) index]]; }
+    void addNote (const MPENote&) noexcept;
+    void removeNote (const MPENote&) noexcept;
+    void removeNoteAt (int index) noexcept;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPEInstrument)
 };
 
@@ -46,6 +46,8 @@ MPESynthesiser::MPESynthesiser (MPEInstrument& mpeInstrument)
 
 MPESynthesiser::~MPESynthesiser()
 {
+    // The voices of any banks refer to them, so must be deleted first
+    voices.clear();
 }
 
 //==============================================================================
@@ -154,6 +156,9 @@ void MPESynthesiser::setCurrentPlaybackSampleRate (const double newRate)
 
     for (auto i = voices.size(); --i >= 0;)
         voices.getUnchecked (i)->setCurrentSampleRate (newRate);
+
+    for (auto* bank : voiceBanks)
+        bank->setCurrentSampleRate (newRate);
 }
 
 void MPESynthesiser::handleMidiEvent (const MidiMessage& m)
@@ -284,10 +289,36 @@ void MPESynthesiser::addVoice (MPESynthesiserVoice* const newVoice)
     }
 }
 
+void MPESynthesiser::addVoiceBank (MPESynthesiserVoiceBank* const newBank)
+{
+    jassert (newBank != nullptr && ! voiceBanks.contains (newBank));
+
+    {
+        const ScopedLock sl (voicesLock);
+        newBank->setCurrentSampleRate (getSampleRate());
+
+        voices.ensureStorageAllocated (voices.size() + newBank->getNumVoices());
+
+        for (int i = 0; i < newBank->getNumVoices(); ++i)
+        {
+            auto* voice = voices.add (new MPESynthesiserVoiceBank::Voice (*newBank, i));
+            voice->setCurrentSampleRate (getSampleRate());
+        }
+
+        voiceBanks.add (newBank);
+    }
+
+    {
+        const ScopedLock sl (stealLock);
+        usableVoicesToStealArray.ensureStorageAllocated (voices.size() + 1);
+    }
+}
+
 void MPESynthesiser::clearVoices()
 {
     const ScopedLock sl (voicesLock);
     voices.clear();
+    voiceBanks.clear();
 }
 
 MPESynthesiserVoice* MPESynthesiser::getVoice (const int index) const
@@ -343,6 +374,9 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSa
 {
     const ScopedLock sl (voicesLock);
 
+    for (auto* bank : voiceBanks)
+        bank->renderNextBlock (buffer, startSample, numSamples);
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -354,6 +388,9 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startS
 {
     const ScopedLock sl (voicesLock);
 
+    for (auto* bank : voiceBanks)
+        bank->renderNextBlock (buffer, startSample, numSamples);
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -108,6 +108,19 @@ public:
     /** Deletes one of the voices. */
     void removeVoice (int index);
 
+    /** Adds a bank of voices to the synth.
+
+        A voice is added to the synth for each of the bank's voices, so that they can be
+        found with getVoice() and are allocated to notes like any other voices. The bank is
+        asked to render all of its voices at once, in renderNextSubBlock().
+
+        The object passed in will be managed by the synthesiser, which will delete
+        it later on when no longer needed. Banks are deleted by clearVoices().
+
+        @see MPESynthesiserVoiceBank
+    */
+    void addVoiceBank (MPESynthesiserVoiceBank* newBank);
+
     /** Reduces the number of voices to newNumVoices.
 
         This will repeatedly call findVoiceToSteal() and remove that voice, until
@@ -318,6 +331,7 @@ private:
     uint32 lastNoteOnCounter = 0;
     mutable CriticalSection stealLock;
     mutable Array<MPESynthesiserVoice*> usableVoicesToStealArray;
+    OwnedArray<MPESynthesiserVoiceBank> voiceBanks;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiser)
 };
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  The voice that an MPESynthesiser allocates for each slot of an MPESynthesiserVoiceBank.
+    It forwards the note callbacks to its bank, and renders nothing itself.
+*/
+class MPESynthesiserVoiceBank::Voice final : public MPESynthesiserVoice
+{
+public:
+    Voice (MPESynthesiserVoiceBank& b, int index)
+        : bank (b), voiceIndex (index)
+    {
+        jassert (bank.bankVoices[(size_t) voiceIndex] == nullptr);
+        bank.bankVoices[(size_t) voiceIndex] = this;
+    }
+
+    ~Voice() override
+    {
+        bank.bankVoices[(size_t) voiceIndex] = nullptr;
+    }
+
+    void noteStarted() override                     { bank.noteStarted (voiceIndex); }
+    void noteStopped (bool allowTailOff) override   { bank.noteStopped (voiceIndex, allowTailOff); }
+    void notePressureChanged() override             { bank.notePressureChanged (voiceIndex); }
+    void notePitchbendChanged() override            { bank.notePitchbendChanged (voiceIndex); }
+    void noteTimbreChanged() override               { bank.noteTimbreChanged (voiceIndex); }
+    void noteKeyStateChanged() override             { bank.noteKeyStateChanged (voiceIndex); }
+
+    // The bank renders all of its voices at once, in MPESynthesiser::renderNextSubBlock()
+    void renderNextBlock (AudioBuffer<float>&, int, int) override {}
+    void renderNextBlock (AudioBuffer<double>&, int, int) override {}
+
+    void clearNote() noexcept    { clearCurrentNote(); }
+
+private:
+    MPESynthesiserVoiceBank& bank;
+    const int voiceIndex;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Voice)
+};
+
+//==============================================================================
+MPESynthesiserVoiceBank::MPESynthesiserVoiceBank (int numVoicesToUse)
+    : numVoices (numVoicesToUse),
+      bankVoices ((size_t) jmax (0, numVoicesToUse), nullptr)
+{
+    jassert (numVoices > 0);
+}
+
+MPESynthesiserVoiceBank::~MPESynthesiserVoiceBank()
+{
+    // The MPESynthesiser must delete the voices that refer to this bank before deleting the bank!
+    jassert (std::all_of (bankVoices.begin(), bankVoices.end(), [] (auto* v) { return v == nullptr; }));
+}
+
+//==============================================================================
+MPENote MPESynthesiserVoiceBank::getCurrentlyPlayingNote (int voiceIndex) const noexcept
+{
+    if (auto* voice = bankVoices[(size_t) voiceIndex])
+        return voice->getCurrentlyPlayingNote();
+
+    return {};
+}
+
+void MPESynthesiserVoiceBank::clearCurrentNote (int voiceIndex) noexcept
+{
+    if (auto* voice = bankVoices[(size_t) voiceIndex])
+        voice->clearNote();
+}
+
+} // namespace juce
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders a fixed number of MPE voices at once, for an MPESynthesiser.
+
+    This is the MPE counterpart of SynthesiserVoiceBank. The bank receives the note
+    callbacks of an MPESynthesiserVoice for each of its voices, identified by index,
+    and renders all of them in a single call to renderNextBlock(), so that the voices
+    can be processed together with SIMD instructions.
+
+    When a bank is added with MPESynthesiser::addVoiceBank(), the synth creates an
+    MPESynthesiserVoice for each of the bank's voices, which are allocated and stolen
+    just like other voices.
+
+    @see MPESynthesiser::addVoiceBank, MPESynthesiserVoice, SynthesiserVoiceBank
+
+    @tags{Audio}
+*/
+class JUCE_API  MPESynthesiserVoiceBank
+{
+public:
+    //==============================================================================
+    /** Creates a bank with space for the given number of voices. */
+    explicit MPESynthesiserVoiceBank (int numVoices);
+
+    /** Destructor. */
+    virtual ~MPESynthesiserVoiceBank();
+
+    //==============================================================================
+    /** Returns the number of voices in this bank. */
+    int getNumVoices() const noexcept                       { return numVoices; }
+
+    /** Returns the MPENote that one of the voices is currently playing.
+        Returns an invalid MPENote if no note is playing.
+    */
+    MPENote getCurrentlyPlayingNote (int voiceIndex) const noexcept;
+
+    /** Returns true if one of the voices is currently playing a note. */
+    bool isActive (int voiceIndex) const noexcept           { return getCurrentlyPlayingNote (voiceIndex).isValid(); }
+
+    /** Returns the current target sample rate at which rendering is being done. */
+    double getSampleRate() const noexcept                   { return currentSampleRate; }
+
+    //==============================================================================
+    /** Called by the MPESynthesiser to let one of the voices know that a new note has
+        started on it. Use getCurrentlyPlayingNote() to find out about the note.
+        @see MPESynthesiserVoice::noteStarted
+    */
+    virtual void noteStarted (int voiceIndex) = 0;
+
+    /** Called by the MPESynthesiser to let one of the voices know that its currently
+        playing note has stopped.
+
+        If allowTailOff is false, the voice must stop immediately and call
+        clearCurrentNote(). Otherwise, it may fade out, and must call clearCurrentNote()
+        from renderNextBlock() when it has finished.
+
+        @see MPESynthesiserVoice::noteStopped
+    */
+    virtual void noteStopped (int voiceIndex, bool allowTailOff) = 0;
+
+    /** Called when the pressure of one of the voices' notes has changed. */
+    virtual void notePressureChanged (int voiceIndex) = 0;
+
+    /** Called when the pitchbend of one of the voices' notes has changed. */
+    virtual void notePitchbendChanged (int voiceIndex) = 0;
+
+    /** Called when the timbre of one of the voices' notes has changed. */
+    virtual void noteTimbreChanged (int voiceIndex) = 0;
+
+    /** Called when the key state of one of the voices' notes has changed. */
+    virtual void noteKeyStateChanged (int voiceIndex) = 0;
+
+    //==============================================================================
+    /** Renders the next block of data for all of the voices in this bank.
+
+        The output must be added to the current contents of the buffer, between
+        startSample and (startSample + numSamples).
+
+        @see MPESynthesiserVoice::renderNextBlock
+    */
+    virtual void renderNextBlock (AudioBuffer<float>& outputBuffer,
+                                  int startSample,
+                                  int numSamples) = 0;
+
+    /** Renders the next block of 64-bit data for all of the voices in this bank.
+
+        Implement this method if you want to support 64-bit audio processing.
+        The default implementation simply does nothing.
+    */
+    virtual void renderNextBlock (AudioBuffer<double>& /*outputBuffer*/,
+                                  int /*startSample*/,
+                                  int /*numSamples*/) {}
+
+    /** Changes the bank's reference sample rate. */
+    virtual void setCurrentSampleRate (double newRate)    { currentSampleRate = newRate; }
+
+protected:
+    /** Resets the state of one of the voices after its sound has finished playing.
+        @see MPESynthesiserVoice::clearCurrentNote
+    */
+    void clearCurrentNote (int voiceIndex) noexcept;
+
+private:
+    //==============================================================================
+    friend class MPESynthesiser;
+    class Voice;
+
+    const int numVoices;
+    std::vector<Voice*> bankVoices;
+    double currentSampleRate = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiserVoiceBank)
+};
+
+} // namespace juce
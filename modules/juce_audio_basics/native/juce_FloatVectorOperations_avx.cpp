@@ -0,0 +1,394 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+// GCC warns about vectors being passed to the lambdas in the kernels, and about the
+// undefined values used inside its own AVX-512 intrinsics.
+JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wpsabi", "-Wuninitialized", "-Wmaybe-uninitialized")
+
+namespace juce::FloatVectorHelpers
+{
+
+/*  The vector operations that can be swapped at runtime for versions compiled for a
+    newer instruction set than the one the rest of the module is built for.
+
+    All of the counts are in elements, and are never negative.
+*/
+template <typename Type>
+struct KernelTable
+{
+    void (*fill) (Type*, Type, size_t) noexcept;
+    void (*copyWithMultiply) (Type*, const Type*, Type, size_t) noexcept;
+    void (*addValue) (Type*, Type, size_t) noexcept;
+    void (*addSrcValue) (Type*, const Type*, Type, size_t) noexcept;
+    void (*addSrc) (Type*, const Type*, size_t) noexcept;
+    void (*addSrc1Src2) (Type*, const Type*, const Type*, size_t) noexcept;
+    void (*subtractSrc) (Type*, const Type*, size_t) noexcept;
+    void (*subtractSrc1Src2) (Type*, const Type*, const Type*, size_t) noexcept;
+    void (*addWithMultiplySrcValue) (Type*, const Type*, Type, size_t) noexcept;
+    void (*addWithMultiplySrc1Src2) (Type*, const Type*, const Type*, size_t) noexcept;
+    void (*subtractWithMultiplySrcValue) (Type*, const Type*, Type, size_t) noexcept;
+    void (*subtractWithMultiplySrc1Src2) (Type*, const Type*, const Type*, size_t) noexcept;
+    void (*multiplySrc) (Type*, const Type*, size_t) noexcept;
+    void (*multiplySrc1Src2) (Type*, const Type*, const Type*, size_t) noexcept;
+    void (*multiplyValue) (Type*, Type, size_t) noexcept;
+    void (*multiplySrcValue) (Type*, const Type*, Type, size_t) noexcept;
+    void (*negate) (Type*, const Type*, size_t) noexcept;
+    void (*abs) (Type*, const Type*, size_t) noexcept;
+    void (*minSrcValue) (Type*, const Type*, Type, size_t) noexcept;
+    void (*minSrc1Src2) (Type*, const Type*, const Type*, size_t) noexcept;
+    void (*maxSrcValue) (Type*, const Type*, Type, size_t) noexcept;
+    void (*maxSrc1Src2) (Type*, const Type*, const Type*, size_t) noexcept;
+    void (*clip) (Type*, const Type*, Type, Type, size_t) noexcept;
+    Range<Type> (*findMinAndMax) (const Type*, size_t) noexcept;
+    Type (*findMinimum) (const Type*, size_t) noexcept;
+    Type (*findMaximum) (const Type*, size_t) noexcept;
+    Type (*sum) (const Type*, size_t) noexcept;
+    Type (*sumOfSquares) (const Type*, size_t) noexcept;
+    Type (*dotProduct) (const Type*, const Type*, size_t) noexcept;
+    void (*multiplyWithRamp) (Type*, Type, Type, size_t) noexcept;
+    void (*interleaveStereo) (Type*, const Type*, const Type*, size_t) noexcept;
+    void (*deinterleaveStereo) (Type*, Type*, const Type*, size_t) noexcept;
+    void (*convertFixedToFloat) (Type*, const int*, Type, size_t) noexcept;
+};
+
+//==============================================================================
+// GCC and Clang will only emit these instructions inside functions that are
+// explicitly compiled for them, and a template picks up its target from the place
+// where it's defined rather than where it's instantiated. That's why the generic
+// kernels are included separately inside each of the regions below. MSVC can
+// always use the instructions.
+#if JUCE_CLANG
+ #define JUCE_BEGIN_TARGET_ISA(isa)    _Pragma (JUCE_STRINGIFY (clang attribute push (__attribute__ ((target (isa))), apply_to = function)))
+ #define JUCE_END_TARGET_ISA           _Pragma ("clang attribute pop")
+#elif JUCE_GCC
+ #define JUCE_BEGIN_TARGET_ISA(isa)    _Pragma ("GCC push_options") _Pragma (JUCE_STRINGIFY (GCC target (isa)))
+ #define JUCE_END_TARGET_ISA           _Pragma ("GCC pop_options")
+#else
+ #define JUCE_BEGIN_TARGET_ISA(isa)
+ #define JUCE_END_TARGET_ISA
+#endif
+
+//==============================================================================
+JUCE_BEGIN_TARGET_ISA ("avx2,fma")
+
+namespace AVX2
+{
+ #include "juce_FloatVectorOperations_kernels.h"
+}
+
+struct AVX2Ops32
+{
+    using Type = float;
+    using ParallelType = __m256;
+    using MaskType = __m256i;
+    static constexpr size_t numParallel = 8;
+
+    static forcedinline ParallelType load1 (Type v) noexcept                                 { return _mm256_set1_ps (v); }
+    static forcedinline ParallelType loadU (const Type* v) noexcept                          { return _mm256_loadu_ps (v); }
+    static forcedinline void storeU (Type* dest, ParallelType a) noexcept                    { _mm256_storeu_ps (dest, a); }
+    static forcedinline ParallelType loadIntsU (const int* v) noexcept                       { return _mm256_cvtepi32_ps (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (v))); }
+
+    static forcedinline MaskType getTailMask (size_t num) noexcept
+    {
+        return _mm256_cmpgt_epi32 (_mm256_set1_epi32 ((int) num), _mm256_setr_epi32 (0, 1, 2, 3, 4, 5, 6, 7));
+    }
+
+    static forcedinline ParallelType loadMasked (const Type* v, MaskType m) noexcept         { return _mm256_maskload_ps (v, m); }
+    static forcedinline void storeMasked (Type* dest, MaskType m, ParallelType a) noexcept   { _mm256_maskstore_ps (dest, m, a); }
+
+    static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept           { return _mm256_add_ps (a, b); }
+    static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept           { return _mm256_sub_ps (a, b); }
+    static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept           { return _mm256_mul_ps (a, b); }
+    static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept           { return _mm256_max_ps (a, b); }
+    static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept           { return _mm256_min_ps (a, b); }
+
+    static forcedinline ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept          { return _mm256_fmadd_ps (a, b, c); }
+    static forcedinline ParallelType negativeMultiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fnmadd_ps (a, b, c); }
+
+    static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept       { return _mm256_andnot_ps (a, b); }
+    static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept       { return _mm256_xor_ps (a, b); }
+
+    static forcedinline Type max (ParallelType a) noexcept
+    {
+        auto v = _mm_max_ps (_mm256_castps256_ps128 (a), _mm256_extractf128_ps (a, 1));
+        v = _mm_max_ps (v, _mm_movehl_ps (v, v));
+        return _mm_cvtss_f32 (_mm_max_ss (v, _mm_shuffle_ps (v, v, 1)));
+    }
+
+    static forcedinline Type min (ParallelType a) noexcept
+    {
+        auto v = _mm_min_ps (_mm256_castps256_ps128 (a), _mm256_extractf128_ps (a, 1));
+        v = _mm_min_ps (v, _mm_movehl_ps (v, v));
+        return _mm_cvtss_f32 (_mm_min_ss (v, _mm_shuffle_ps (v, v, 1)));
+    }
+
+    static forcedinline Type sum (ParallelType a) noexcept
+    {
+        auto v = _mm_add_ps (_mm256_castps256_ps128 (a), _mm256_extractf128_ps (a, 1));
+        v = _mm_add_ps (v, _mm_movehl_ps (v, v));
+        return _mm_cvtss_f32 (_mm_add_ss (v, _mm_shuffle_ps (v, v, 1)));
+    }
+
+    static forcedinline ParallelType iota() noexcept                                         { return _mm256_setr_ps (0, 1, 2, 3, 4, 5, 6, 7); }
+
+    static forcedinline void interleave (ParallelType a, ParallelType b, ParallelType& lo, ParallelType& hi) noexcept
+    {
+        const auto l = _mm256_unpacklo_ps (a, b), h = _mm256_unpackhi_ps (a, b);
+        lo = _mm256_permute2f128_ps (l, h, 0x20);
+        hi = _mm256_permute2f128_ps (l, h, 0x31);
+    }
+
+    static forcedinline void deinterleave (ParallelType lo, ParallelType hi, ParallelType& a, ParallelType& b) noexcept
+    {
+        const auto l = _mm256_permute2f128_ps (lo, hi, 0x20), h = _mm256_permute2f128_ps (lo, hi, 0x31);
+        a = _mm256_shuffle_ps (l, h, _MM_SHUFFLE (2, 0, 2, 0));
+        b = _mm256_shuffle_ps (l, h, _MM_SHUFFLE (3, 1, 3, 1));
+    }
+};
+
+struct AVX2Ops64
+{
+    using Type = double;
+    using ParallelType = __m256d;
+    using MaskType = __m256i;
+    static constexpr size_t numParallel = 4;
+
+    static forcedinline ParallelType load1 (Type v) noexcept                                 { return _mm256_set1_pd (v); }
+    static forcedinline ParallelType loadU (const Type* v) noexcept                          { return _mm256_loadu_pd (v); }
+    static forcedinline void storeU (Type* dest, ParallelType a) noexcept                    { _mm256_storeu_pd (dest, a); }
+    static forcedinline ParallelType loadIntsU (const int* v) noexcept                       { return _mm256_cvtepi32_pd (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (v))); }
+
+    static forcedinline MaskType getTailMask (size_t num) noexcept
+    {
+        return _mm256_cmpgt_epi64 (_mm256_set1_epi64x ((int64) num), _mm256_setr_epi64x (0, 1, 2, 3));
+    }
+
+    static forcedinline ParallelType loadMasked (const Type* v, MaskType m) noexcept         { return _mm256_maskload_pd (v, m); }
+    static forcedinline void storeMasked (Type* dest, MaskType m, ParallelType a) noexcept   { _mm256_maskstore_pd (dest, m, a); }
+
+    static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept           { return _mm256_add_pd (a, b); }
+    static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept           { return _mm256_sub_pd (a, b); }
+    static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept           { return _mm256_mul_pd (a, b); }
+    static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept           { return _mm256_max_pd (a, b); }
+    static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept           { return _mm256_min_pd (a, b); }
+
+    static forcedinline ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept          { return _mm256_fmadd_pd (a, b, c); }
+    static forcedinline ParallelType negativeMultiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fnmadd_pd (a, b, c); }
+
+    static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept       { return _mm256_andnot_pd (a, b); }
+    static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept       { return _mm256_xor_pd (a, b); }
+
+    static forcedinline Type max (ParallelType a) noexcept
+    {
+        const auto v = _mm_max_pd (_mm256_castpd256_pd128 (a), _mm256_extractf128_pd (a, 1));
+        return _mm_cvtsd_f64 (_mm_max_sd (v, _mm_unpackhi_pd (v, v)));
+    }
+
+    static forcedinline Type min (ParallelType a) noexcept
+    {
+        const auto v = _mm_min_pd (_mm256_castpd256_pd128 (a), _mm256_extractf128_pd (a, 1));
+        return _mm_cvtsd_f64 (_mm_min_sd (v, _mm_unpackhi_pd (v, v)));
+    }
+
+    static forcedinline Type sum (ParallelType a) noexcept
+    {
+        const auto v = _mm_add_pd (_mm256_castpd256_pd128 (a), _mm256_extractf128_pd (a, 1));
+        return _mm_cvtsd_f64 (_mm_add_sd (v, _mm_unpackhi_pd (v, v)));
+    }
+
+    static forcedinline ParallelType iota() noexcept                                         { return _mm256_setr_pd (0, 1, 2, 3); }
+
+    static forcedinline void interleave (ParallelType a, ParallelType b, ParallelType& lo, ParallelType& hi) noexcept
+    {
+        const auto l = _mm256_unpacklo_pd (a, b), h = _mm256_unpackhi_pd (a, b);
+        lo = _mm256_permute2f128_pd (l, h, 0x20);
+        hi = _mm256_permute2f128_pd (l, h, 0x31);
+    }
+
+    static forcedinline void deinterleave (ParallelType lo, ParallelType hi, ParallelType& a, ParallelType& b) noexcept
+    {
+        const auto l = _mm256_permute2f128_pd (lo, hi, 0x20), h = _mm256_permute2f128_pd (lo, hi, 0x31);
+        a = _mm256_unpacklo_pd (l, h);
+        b = _mm256_unpackhi_pd (l, h);
+    }
+};
+
+template <typename Type>
+const KernelTable<Type>& getAVX2Kernels() noexcept
+{
+    if constexpr (std::is_same_v<Type, float>)
+        return AVX2::Kernels<AVX2Ops32>::table;
+    else
+        return AVX2::Kernels<AVX2Ops64>::table;
+}
+
+JUCE_END_TARGET_ISA
+
+//==============================================================================
+JUCE_BEGIN_TARGET_ISA ("avx512f")
+
+namespace AVX512
+{
+ #include "juce_FloatVectorOperations_kernels.h"
+}
+
+struct AVX512Ops32
+{
+    using Type = float;
+    using ParallelType = __m512;
+    using MaskType = __mmask16;
+    static constexpr size_t numParallel = 16;
+
+    static forcedinline ParallelType load1 (Type v) noexcept                                 { return _mm512_set1_ps (v); }
+    static forcedinline ParallelType loadU (const Type* v) noexcept                          { return _mm512_loadu_ps (v); }
+    static forcedinline void storeU (Type* dest, ParallelType a) noexcept                    { _mm512_storeu_ps (dest, a); }
+    static forcedinline ParallelType loadIntsU (const int* v) noexcept                       { return _mm512_cvtepi32_ps (_mm512_loadu_si512 (v)); }
+
+    static forcedinline MaskType getTailMask (size_t num) noexcept                           { return (MaskType) ((1u << num) - 1); }
+    static forcedinline ParallelType loadMasked (const Type* v, MaskType m) noexcept         { return _mm512_maskz_loadu_ps (m, v); }
+    static forcedinline void storeMasked (Type* dest, MaskType m, ParallelType a) noexcept   { _mm512_mask_storeu_ps (dest, m, a); }
+
+    static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept           { return _mm512_add_ps (a, b); }
+    static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept           { return _mm512_sub_ps (a, b); }
+    static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept           { return _mm512_mul_ps (a, b); }
+    static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept           { return _mm512_max_ps (a, b); }
+    static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept           { return _mm512_min_ps (a, b); }
+
+    static forcedinline ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept          { return _mm512_fmadd_ps (a, b, c); }
+    static forcedinline ParallelType negativeMultiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fnmadd_ps (a, b, c); }
+
+    // The floating point bitwise operations need AVX512DQ, so use the integer ones instead
+    static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept
+    {
+        return _mm512_castsi512_ps (_mm512_andnot_si512 (_mm512_castps_si512 (a), _mm512_castps_si512 (b)));
+    }
+
+    static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept
+    {
+        return _mm512_castsi512_ps (_mm512_xor_si512 (_mm512_castps_si512 (a), _mm512_castps_si512 (b)));
+    }
+
+    static forcedinline Type max (ParallelType a) noexcept                                   { return _mm512_reduce_max_ps (a); }
+    static forcedinline Type min (ParallelType a) noexcept                                   { return _mm512_reduce_min_ps (a); }
+    static forcedinline Type sum (ParallelType a) noexcept                                   { return _mm512_reduce_add_ps (a); }
+
+    static forcedinline ParallelType iota() noexcept
+    {
+        return _mm512_set_ps (15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    }
+
+    static forcedinline void interleave (ParallelType a, ParallelType b, ParallelType& lo, ParallelType& hi) noexcept
+    {
+        lo = _mm512_permutex2var_ps (a, _mm512_set_epi32 (23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0), b);
+        hi = _mm512_permutex2var_ps (a, _mm512_set_epi32 (31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8), b);
+    }
+
+    static forcedinline void deinterleave (ParallelType lo, ParallelType hi, ParallelType& a, ParallelType& b) noexcept
+    {
+        a = _mm512_permutex2var_ps (lo, _mm512_set_epi32 (30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0), hi);
+        b = _mm512_permutex2var_ps (lo, _mm512_set_epi32 (31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1), hi);
+    }
+};
+
+struct AVX512Ops64
+{
+    using Type = double;
+    using ParallelType = __m512d;
+    using MaskType = __mmask8;
+    static constexpr size_t numParallel = 8;
+
+    static forcedinline ParallelType load1 (Type v) noexcept                                 { return _mm512_set1_pd (v); }
+    static forcedinline ParallelType loadU (const Type* v) noexcept                          { return _mm512_loadu_pd (v); }
+    static forcedinline void storeU (Type* dest, ParallelType a) noexcept                    { _mm512_storeu_pd (dest, a); }
+    static forcedinline ParallelType loadIntsU (const int* v) noexcept                       { return _mm512_cvtepi32_pd (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (v))); }
+
+    static forcedinline MaskType getTailMask (size_t num) noexcept                           { return (MaskType) ((1u << num) - 1); }
+    static forcedinline ParallelType loadMasked (const Type* v, MaskType m) noexcept         { return _mm512_maskz_loadu_pd (m, v); }
+    static forcedinline void storeMasked (Type* dest, MaskType m, ParallelType a) noexcept   { _mm512_mask_storeu_pd (dest, m, a); }
+
+    static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept           { return _mm512_add_pd (a, b); }
+    static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept           { return _mm512_sub_pd (a, b); }
+    static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept           { return _mm512_mul_pd (a, b); }
+    static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept           { return _mm512_max_pd (a, b); }
+    static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept           { return _mm512_min_pd (a, b); }
+
+    static forcedinline ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept          { return _mm512_fmadd_pd (a, b, c); }
+    static forcedinline ParallelType negativeMultiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fnmadd_pd (a, b, c); }
+
+    static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept
+    {
+        return _mm512_castsi512_pd (_mm512_andnot_si512 (_mm512_castpd_si512 (a), _mm512_castpd_si512 (b)));
+    }
+
+    static forcedinline ParallelType bit_xor (ParallelType a, ParallelType b) noexcept
+    {
+        return _mm512_castsi512_pd (_mm512_xor_si512 (_mm512_castpd_si512 (a), _mm512_castpd_si512 (b)));
+    }
+
+    static forcedinline Type max (ParallelType a) noexcept                                   { return _mm512_reduce_max_pd (a); }
+    static forcedinline Type min (ParallelType a) noexcept                                   { return _mm512_reduce_min_pd (a); }
+    static forcedinline Type sum (ParallelType a) noexcept                                   { return _mm512_reduce_add_pd (a); }
+
+    static forcedinline ParallelType iota() noexcept                                         { return _mm512_set_pd (7, 6, 5, 4, 3, 2, 1, 0); }
+
+    static forcedinline void interleave (ParallelType a, ParallelType b, ParallelType& lo, ParallelType& hi) noexcept
+    {
+        lo = _mm512_permutex2var_pd (a, _mm512_set_epi64 (11, 3, 10, 2, 9, 1, 8, 0), b);
+        hi = _mm512_permutex2var_pd (a, _mm512_set_epi64 (15, 7, 14, 6, 13, 5, 12, 4), b);
+    }
+
+    static forcedinline void deinterleave (ParallelType lo, ParallelType hi, ParallelType& a, ParallelType& b) noexcept
+    {
+        a = _mm512_permutex2var_pd (lo, _mm512_set_epi64 (14, 12, 10, 8, 6, 4, 2, 0), hi);
+        b = _mm512_permutex2var_pd (lo, _mm512_set_epi64 (15, 13, 11, 9, 7, 5, 3, 1), hi);
+    }
+};
+
+template <typename Type>
+const KernelTable<Type>& getAVX512Kernels() noexcept
+{
+    if constexpr (std::is_same_v<Type, float>)
+        return AVX512::Kernels<AVX512Ops32>::table;
+    else
+        return AVX512::Kernels<AVX512Ops64>::table;
+}
+
+JUCE_END_TARGET_ISA
+
+#undef JUCE_BEGIN_TARGET_ISA
+#undef JUCE_END_TARGET_ISA
+
+} // namespace juce::FloatVectorHelpers
+
+JUCE_END_IGNORE_WARNINGS_GCC_LIKE
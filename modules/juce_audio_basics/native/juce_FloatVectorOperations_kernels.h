@@ -0,0 +1,435 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+// This file is included once for each instruction set by juce_FloatVectorOperations_avx.cpp,
+// so deliberately has no include guard.
+
+/*  The kernels for a particular instruction set. Ops supplies the register type and
+    primitive operations, in the same way as the BasicOps structs do for SSE and NEON.
+
+    Whole registers are loaded and stored unaligned, which costs nothing extra on the
+    CPUs that support these instruction sets, and the last partial register of each
+    array is handled with masked loads and stores rather than a scalar loop.
+*/
+template <typename Ops>
+struct Kernels
+{
+    using Type = typename Ops::Type;
+    using V = typename Ops::ParallelType;
+    static constexpr size_t numParallel = Ops::numParallel;
+
+    //==============================================================================
+    template <bool loadDest, typename Fn>
+    static forcedinline void apply (Type* dest, size_t num, Fn&& fn) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + numParallel <= num; i += numParallel)
+        {
+            if constexpr (loadDest)
+                Ops::storeU (dest + i, fn (Ops::loadU (dest + i)));
+            else
+                Ops::storeU (dest + i, fn (V{}));
+        }
+
+        if (i < num)
+        {
+            const auto mask = Ops::getTailMask (num - i);
+
+            if constexpr (loadDest)
+                Ops::storeMasked (dest + i, mask, fn (Ops::loadMasked (dest + i, mask)));
+            else
+                Ops::storeMasked (dest + i, mask, fn (V{}));
+        }
+    }
+
+    template <bool loadDest, typename Fn>
+    static forcedinline void apply (Type* dest, const Type* src, size_t num, Fn&& fn) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + numParallel <= num; i += numParallel)
+        {
+            if constexpr (loadDest)
+                Ops::storeU (dest + i, fn (Ops::loadU (dest + i), Ops::loadU (src + i)));
+            else
+                Ops::storeU (dest + i, fn (V{}, Ops::loadU (src + i)));
+        }
+
+        if (i < num)
+        {
+            const auto mask = Ops::getTailMask (num - i);
+
+            if constexpr (loadDest)
+                Ops::storeMasked (dest + i, mask, fn (Ops::loadMasked (dest + i, mask), Ops::loadMasked (src + i, mask)));
+            else
+                Ops::storeMasked (dest + i, mask, fn (V{}, Ops::loadMasked (src + i, mask)));
+        }
+    }
+
+    template <bool loadDest, typename Fn>
+    static forcedinline void apply (Type* dest, const Type* src1, const Type* src2, size_t num, Fn&& fn) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + numParallel <= num; i += numParallel)
+        {
+            const auto d = loadDest ? Ops::loadU (dest + i) : V{};
+            Ops::storeU (dest + i, fn (d, Ops::loadU (src1 + i), Ops::loadU (src2 + i)));
+        }
+
+        if (i < num)
+        {
+            const auto mask = Ops::getTailMask (num - i);
+            const auto d = loadDest ? Ops::loadMasked (dest + i, mask) : V{};
+            Ops::storeMasked (dest + i, mask, fn (d, Ops::loadMasked (src1 + i, mask), Ops::loadMasked (src2 + i, mask)));
+        }
+    }
+
+    //==============================================================================
+    static void fill (Type* dest, Type value, size_t num) noexcept
+    {
+        const auto v = Ops::load1 (value);
+        apply<false> (dest, num, [v] (V) { return v; });
+    }
+
+    static void copyWithMultiply (Type* dest, const Type* src, Type multiplier, size_t num) noexcept
+    {
+        const auto m = Ops::load1 (multiplier);
+        apply<false> (dest, src, num, [m] (V, V s) { return Ops::mul (s, m); });
+    }
+
+    static void addValue (Type* dest, Type amount, size_t num) noexcept
+    {
+        const auto a = Ops::load1 (amount);
+        apply<true> (dest, num, [a] (V d) { return Ops::add (d, a); });
+    }
+
+    static void addSrcValue (Type* dest, const Type* src, Type amount, size_t num) noexcept
+    {
+        const auto a = Ops::load1 (amount);
+        apply<false> (dest, src, num, [a] (V, V s) { return Ops::add (s, a); });
+    }
+
+    static void addSrc (Type* dest, const Type* src, size_t num) noexcept
+    {
+        apply<true> (dest, src, num, [] (V d, V s) { return Ops::add (d, s); });
+    }
+
+    static void addSrc1Src2 (Type* dest, const Type* src1, const Type* src2, size_t num) noexcept
+    {
+        apply<false> (dest, src1, src2, num, [] (V, V s1, V s2) { return Ops::add (s1, s2); });
+    }
+
+    static void subtractSrc (Type* dest, const Type* src, size_t num) noexcept
+    {
+        apply<true> (dest, src, num, [] (V d, V s) { return Ops::sub (d, s); });
+    }
+
+    static void subtractSrc1Src2 (Type* dest, const Type* src1, const Type* src2, size_t num) noexcept
+    {
+        apply<false> (dest, src1, src2, num, [] (V, V s1, V s2) { return Ops::sub (s1, s2); });
+    }
+
+    static void addWithMultiplySrcValue (Type* dest, const Type* src, Type multiplier, size_t num) noexcept
+    {
+        const auto m = Ops::load1 (multiplier);
+        apply<true> (dest, src, num, [m] (V d, V s) { return Ops::multiplyAdd (s, m, d); });
+    }
+
+    static void addWithMultiplySrc1Src2 (Type* dest, const Type* src1, const Type* src2, size_t num) noexcept
+    {
+        apply<true> (dest, src1, src2, num, [] (V d, V s1, V s2) { return Ops::multiplyAdd (s1, s2, d); });
+    }
+
+    static void subtractWithMultiplySrcValue (Type* dest, const Type* src, Type multiplier, size_t num) noexcept
+    {
+        const auto m = Ops::load1 (multiplier);
+        apply<true> (dest, src, num, [m] (V d, V s) { return Ops::negativeMultiplyAdd (s, m, d); });
+    }
+
+    static void subtractWithMultiplySrc1Src2 (Type* dest, const Type* src1, const Type* src2, size_t num) noexcept
+    {
+        apply<true> (dest, src1, src2, num, [] (V d, V s1, V s2) { return Ops::negativeMultiplyAdd (s1, s2, d); });
+    }
+
+    static void multiplySrc (Type* dest, const Type* src, size_t num) noexcept
+    {
+        apply<true> (dest, src, num, [] (V d, V s) { return Ops::mul (d, s); });
+    }
+
+    static void multiplySrc1Src2 (Type* dest, const Type* src1, const Type* src2, size_t num) noexcept
+    {
+        apply<false> (dest, src1, src2, num, [] (V, V s1, V s2) { return Ops::mul (s1, s2); });
+    }
+
+    static void multiplyValue (Type* dest, Type multiplier, size_t num) noexcept
+    {
+        const auto m = Ops::load1 (multiplier);
+        apply<true> (dest, num, [m] (V d) { return Ops::mul (d, m); });
+    }
+
+    static void multiplySrcValue (Type* dest, const Type* src, Type multiplier, size_t num) noexcept
+    {
+        copyWithMultiply (dest, src, multiplier, num);
+    }
+
+    static void negate (Type* dest, const Type* src, size_t num) noexcept
+    {
+        const auto signBit = Ops::load1 ((Type) -0.0);
+        apply<false> (dest, src, num, [signBit] (V, V s) { return Ops::bit_xor (s, signBit); });
+    }
+
+    static void abs (Type* dest, const Type* src, size_t num) noexcept
+    {
+        const auto signBit = Ops::load1 ((Type) -0.0);
+        apply<false> (dest, src, num, [signBit] (V, V s) { return Ops::bit_not (signBit, s); });
+    }
+
+    static void minSrcValue (Type* dest, const Type* src, Type comp, size_t num) noexcept
+    {
+        const auto c = Ops::load1 (comp);
+        apply<false> (dest, src, num, [c] (V, V s) { return Ops::min (s, c); });
+    }
+
+    static void minSrc1Src2 (Type* dest, const Type* src1, const Type* src2, size_t num) noexcept
+    {
+        apply<false> (dest, src1, src2, num, [] (V, V s1, V s2) { return Ops::min (s1, s2); });
+    }
+
+    static void maxSrcValue (Type* dest, const Type* src, Type comp, size_t num) noexcept
+    {
+        const auto c = Ops::load1 (comp);
+        apply<false> (dest, src, num, [c] (V, V s) { return Ops::max (s, c); });
+    }
+
+    static void maxSrc1Src2 (Type* dest, const Type* src1, const Type* src2, size_t num) noexcept
+    {
+        apply<false> (dest, src1, src2, num, [] (V, V s1, V s2) { return Ops::max (s1, s2); });
+    }
+
+    static void clip (Type* dest, const Type* src, Type low, Type high, size_t num) noexcept
+    {
+        jassert (high >= low);
+
+        const auto lo = Ops::load1 (low);
+        const auto hi = Ops::load1 (high);
+        apply<false> (dest, src, num, [lo, hi] (V, V s) { return Ops::max (Ops::min (s, hi), lo); });
+    }
+
+    //==============================================================================
+    static Range<Type> findMinAndMax (const Type* src, size_t num) noexcept
+    {
+        if (num < numParallel)
+            return Range<Type>::findMinAndMax (src, (int) num);
+
+        auto mn = Ops::loadU (src);
+        auto mx = mn;
+        size_t i = numParallel;
+
+        for (; i + numParallel <= num; i += numParallel)
+        {
+            const auto v = Ops::loadU (src + i);
+            mn = Ops::min (mn, v);
+            mx = Ops::max (mx, v);
+        }
+
+        auto result = Range<Type> (Ops::min (mn), Ops::max (mx));
+
+        for (; i < num; ++i)
+            result = result.getUnionWith (src[i]);
+
+        return result;
+    }
+
+    template <bool isMinimum>
+    static Type findMinOrMax (const Type* src, size_t num) noexcept
+    {
+        if (num < numParallel)
+        {
+            if (num == 0)
+                return 0;
+
+            return isMinimum ? *std::min_element (src, src + num)
+                             : *std::max_element (src, src + num);
+        }
+
+        auto val = Ops::loadU (src);
+        size_t i = numParallel;
+
+        for (; i + numParallel <= num; i += numParallel)
+            val = isMinimum ? Ops::min (val, Ops::loadU (src + i))
+                            : Ops::max (val, Ops::loadU (src + i));
+
+        auto result = isMinimum ? Ops::min (val) : Ops::max (val);
+
+        for (; i < num; ++i)
+            result = isMinimum ? jmin (result, src[i]) : jmax (result, src[i]);
+
+        return result;
+    }
+
+    static Type findMinimum (const Type* src, size_t num) noexcept      { return findMinOrMax<true>  (src, num); }
+    static Type findMaximum (const Type* src, size_t num) noexcept      { return findMinOrMax<false> (src, num); }
+
+    //==============================================================================
+    // Keeping several partial sums hides the latency of the fused multiply-adds.
+    template <typename VectorOp, typename ScalarOp>
+    static forcedinline Type accumulate (size_t num, VectorOp&& vectorOp, ScalarOp&& scalarOp) noexcept
+    {
+        auto acc0 = Ops::load1 (0), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+        size_t i = 0;
+
+        for (; i + 4 * numParallel <= num; i += 4 * numParallel)
+        {
+            acc0 = vectorOp (acc0, i);
+            acc1 = vectorOp (acc1, i + numParallel);
+            acc2 = vectorOp (acc2, i + 2 * numParallel);
+            acc3 = vectorOp (acc3, i + 3 * numParallel);
+        }
+
+        for (; i + numParallel <= num; i += numParallel)
+            acc0 = vectorOp (acc0, i);
+
+        auto result = Ops::sum (Ops::add (Ops::add (acc0, acc1), Ops::add (acc2, acc3)));
+
+        for (; i < num; ++i)
+            result = scalarOp (result, i);
+
+        return result;
+    }
+
+    static Type sum (const Type* src, size_t num) noexcept
+    {
+        return accumulate (num,
+                           [src] (V acc, size_t i) { return Ops::add (acc, Ops::loadU (src + i)); },
+                           [src] (Type acc, size_t i) { return acc + src[i]; });
+    }
+
+    static Type sumOfSquares (const Type* src, size_t num) noexcept
+    {
+        return accumulate (num,
+                           [src] (V acc, size_t i) { const auto s = Ops::loadU (src + i); return Ops::multiplyAdd (s, s, acc); },
+                           [src] (Type acc, size_t i) { return acc + src[i] * src[i]; });
+    }
+
+    static Type dotProduct (const Type* src1, const Type* src2, size_t num) noexcept
+    {
+        return accumulate (num,
+                           [src1, src2] (V acc, size_t i) { return Ops::multiplyAdd (Ops::loadU (src1 + i), Ops::loadU (src2 + i), acc); },
+                           [src1, src2] (Type acc, size_t i) { return acc + src1[i] * src2[i]; });
+    }
+
+    static void multiplyWithRamp (Type* dest, Type startGain, Type increment, size_t num) noexcept
+    {
+        const auto start = Ops::load1 (startGain);
+        const auto inc = Ops::load1 (increment);
+        const auto step = Ops::load1 ((Type) numParallel);
+        auto indices = Ops::iota();
+
+        apply<true> (dest, num, [&] (V d)
+        {
+            const auto gain = Ops::multiplyAdd (indices, inc, start);
+            indices = Ops::add (indices, step);
+            return Ops::mul (d, gain);
+        });
+    }
+
+    static void interleaveStereo (Type* dest, const Type* left, const Type* right, size_t num) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + numParallel <= num; i += numParallel)
+        {
+            V lo, hi;
+            Ops::interleave (Ops::loadU (left + i), Ops::loadU (right + i), lo, hi);
+            Ops::storeU (dest + 2 * i, lo);
+            Ops::storeU (dest + 2 * i + numParallel, hi);
+        }
+
+        for (; i < num; ++i)
+        {
+            dest[2 * i]     = left[i];
+            dest[2 * i + 1] = right[i];
+        }
+    }
+
+    static void deinterleaveStereo (Type* left, Type* right, const Type* src, size_t num) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + numParallel <= num; i += numParallel)
+        {
+            V l, r;
+            Ops::deinterleave (Ops::loadU (src + 2 * i), Ops::loadU (src + 2 * i + numParallel), l, r);
+            Ops::storeU (left + i, l);
+            Ops::storeU (right + i, r);
+        }
+
+        for (; i < num; ++i)
+        {
+            left[i]  = src[2 * i];
+            right[i] = src[2 * i + 1];
+        }
+    }
+
+    static void convertFixedToFloat (Type* dest, const int* src, Type multiplier, size_t num) noexcept
+    {
+        const auto m = Ops::load1 (multiplier);
+        size_t i = 0;
+
+        for (; i + numParallel <= num; i += numParallel)
+            Ops::storeU (dest + i, Ops::mul (Ops::loadIntsU (src + i), m));
+
+        for (; i < num; ++i)
+            dest[i] = (Type) src[i] * multiplier;
+    }
+
+    //==============================================================================
+    static constexpr KernelTable<Type> table
+    {
+        &fill, &copyWithMultiply,
+        &addValue, &addSrcValue, &addSrc, &addSrc1Src2,
+        &subtractSrc, &subtractSrc1Src2,
+        &addWithMultiplySrcValue, &addWithMultiplySrc1Src2,
+        &subtractWithMultiplySrcValue, &subtractWithMultiplySrc1Src2,
+        &multiplySrc, &multiplySrc1Src2, &multiplyValue, &multiplySrcValue,
+        &negate, &abs,
+        &minSrcValue, &minSrc1Src2, &maxSrcValue, &maxSrc1Src2, &clip,
+        &findMinAndMax, &findMinimum, &findMaximum,
+        &sum, &sumOfSquares, &dotProduct, &multiplyWithRamp,
+        &interleaveStereo, &deinterleaveStereo,
+        std::is_same_v<Type, float> ? &convertFixedToFloat : nullptr
+    };
+};
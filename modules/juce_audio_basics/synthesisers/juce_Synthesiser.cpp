@@ -84,6 +84,269 @@ void SynthesiserVoice::renderNextBlock (AudioBuffer<double>& outputBuffer,
     subBuffer.makeCopyOf (tempBuffer, true);
 }
 
+//==============================================================================
+/*  The voice that a Synthesiser allocates for each slot of a SynthesiserVoiceBank.
+    It forwards the note events to its bank, and renders nothing itself.
+*/
+class SynthesiserVoiceBank::Voice final : public SynthesiserVoice
+{
+public:
+    Voice (SynthesiserVoiceBank& b, int index)
+        : bank (b), voiceIndex (index)
+    {
+        jassert (bank.bankVoices[(size_t) voiceIndex] == nullptr);
+        bank.bankVoices[(size_t) voiceIndex] = this;
+    }
+
+    ~Voice() override
+    {
+        bank.bankVoices[(size_t) voiceIndex] = nullptr;
+    }
+
+    bool canPlaySound (SynthesiserSound* sound) override
+    {
+        return bank.canPlaySound (sound);
+    }
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound* sound, int currentPitchWheelPosition) override
+    {
+        bank.startNote (voiceIndex, midiNoteNumber, velocity, sound, currentPitchWheelPosition);
+    }
+
+    void stopNote (float velocity, bool allowTailOff) override          { bank.stopNote (voiceIndex, velocity, allowTailOff); }
+    void pitchWheelMoved (int newValue) override                        { bank.pitchWheelMoved (voiceIndex, newValue); }
+    void controllerMoved (int controllerNumber, int newValue) override  { bank.controllerMoved (voiceIndex, controllerNumber, newValue); }
+    void aftertouchChanged (int newValue) override                      { bank.aftertouchChanged (voiceIndex, newValue); }
+    void channelPressureChanged (int newValue) override                 { bank.channelPressureChanged (voiceIndex, newValue); }
+
+    // The bank renders all of its voices at once, in Synthesiser::renderVoices()
+    void renderNextBlock (AudioBuffer<float>&, int, int) override {}
+    void renderNextBlock (AudioBuffer<double>&, int, int) override {}
+
+    void clearNote()    { clearCurrentNote(); }
+
+private:
+    SynthesiserVoiceBank& bank;
+    const int voiceIndex;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Voice)
+};
+
+SynthesiserVoiceBank::SynthesiserVoiceBank (int numVoicesToUse)
+    : numVoices (numVoicesToUse),
+      bankVoices ((size_t) jmax (0, numVoicesToUse), nullptr)
+{
+    jassert (numVoices > 0);
+}
+
+SynthesiserVoiceBank::~SynthesiserVoiceBank()
+{
+    // The Synthesiser must delete the voices that refer to this bank before deleting the bank!
+    jassert (std::all_of (bankVoices.begin(), bankVoices.end(), [] (auto* v) { return v == nullptr; }));
+}
+
+int SynthesiserVoiceBank::getCurrentlyPlayingNote (int voiceIndex) const noexcept
+{
+    if (auto* voice = bankVoices[(size_t) voiceIndex])
+        return voice->getCurrentlyPlayingNote();
+
+    return -1;
+}
+
+void SynthesiserVoiceBank::clearCurrentNote (int voiceIndex)
+{
+    if (auto* voice = bankVoices[(size_t) voiceIndex])
+        voice->clearNote();
+}
+
+void SynthesiserVoiceBank::aftertouchChanged (int, int) {}
+void SynthesiserVoiceBank::channelPressureChanged (int, int) {}
+
+void SynthesiserVoiceBank::setCurrentPlaybackSampleRate (const double newRate)
+{
+    currentSampleRate = newRate;
+}
+
+void SynthesiserVoiceBank::renderNextBlock (AudioBuffer<double>& outputBuffer,
+                                            int startSample, int numSamples)
+{
+    AudioBuffer<double> subBuffer (outputBuffer.getArrayOfWritePointers(),
+                                   outputBuffer.getNumChannels(),
+                                   startSample, numSamples);
+
+    tempBuffer.makeCopyOf (subBuffer, true);
+    renderNextBlock (tempBuffer, 0, numSamples);
+    subBuffer.makeCopyOf (tempBuffer, true);
+}
+
+//==============================================================================
+/*  Shares the voices of a sub-block between the audio thread and the workers of the shared
+    RealtimeThreadPool.
+
+    The voices are divided into a fixed number of groups, with each group taking every
+    numGroups'th voice so that the active voices are spread evenly. Each group is rendered
+    into its own scratch buffer by whichever thread claims it first, and the audio thread
+    claims groups too, so it never waits for a worker to wake up. Once every group is done,
+    the scratch buffers are added to the output in group order.
+
+    A group is claimed by tagging it with the number of the block, so a worker that picks
+    up the job late can't claim anything from a later block. That means the audio thread
+    only has to wait for groups that a worker is actually rendering, and not for workers
+    that have been descheduled before getting round to claiming anything.
+
+    All storage is allocated on the message thread, when this object is created.
+*/
+class Synthesiser::RenderThreadPool
+{
+public:
+    RenderThreadPool (int numGroups, int maxNumWorkers, int maxChannels, int maxBlockSize)
+        : pool (RealtimeThreadPool::getSharedInstance()),
+          numWorkers (jmin (maxNumWorkers, pool->getNumWorkers())),
+          floatJob  (numGroups, numWorkers, maxChannels, maxBlockSize),
+          doubleJob (numGroups, numWorkers, maxChannels, maxBlockSize)
+    {
+    }
+
+    ~RenderThreadPool()
+    {
+        // The jobs are only withdrawn after each block, so a worker may still be inside one
+        pool->endJob (floatJob);
+        pool->endJob (doubleJob);
+    }
+
+    int getNumWorkers() const noexcept    { return numWorkers; }
+
+    /*  Call from the audio thread only. Returns false if the block doesn't fit in the
+        scratch buffers, in which case nothing has been rendered.
+    */
+    template <typename FloatType>
+    bool render (const OwnedArray<SynthesiserVoice>& voices, AudioBuffer<FloatType>& output, int startSample, int numSamples)
+    {
+        auto& job = getJob<FloatType>();
+
+        if (! job.canRender (output.getNumChannels(), numSamples))
+            return false;
+
+        job.prepare (voices, output.getNumChannels(), numSamples);
+
+        pool->beginJob (job);
+        job.help (0);
+        pool->withdrawJob (job);
+
+        // Every group has been claimed, but a worker may still be rendering one
+        RealtimeThreadPool::waitUntil ([&] { return job.isFinished(); });
+
+        job.addTo (output, startSample);
+        return true;
+    }
+
+private:
+    //==============================================================================
+    template <typename FloatType>
+    class RenderJob final : public RealtimeThreadPool::Job
+    {
+    public:
+        RenderJob (int numGroupsToUse, int numWorkersToUse, int maxChannels, int maxBlockSize)
+            : groupStates ((size_t) numGroupsToUse),
+              numWorkers (numWorkersToUse)
+        {
+            for (int i = 0; i < numGroupsToUse; ++i)
+                scratchBuffers.emplace_back (maxChannels, maxBlockSize);
+
+            for (auto& state : groupStates)
+                state.store (finishedIn (0), std::memory_order_relaxed);
+        }
+
+        bool canRender (int channels, int samples) const noexcept
+        {
+            return channels <= scratchBuffers.front().getNumChannels()
+                && samples <= scratchBuffers.front().getNumSamples();
+        }
+
+        void prepare (const OwnedArray<SynthesiserVoice>& voicesToRender, int channels, int samples) noexcept
+        {
+            voices = voicesToRender.begin();
+            numVoices = voicesToRender.size();
+            numChannels = channels;
+            numSamples = samples;
+            blockNumber.store (blockNumber.load (std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        void help (int threadIndex) override
+        {
+            // The pool is shared, and may have more workers than the synth should use
+            if (threadIndex > numWorkers)
+                return;
+
+            const auto block = blockNumber.load (std::memory_order_acquire);
+            const auto numGroups = (int) scratchBuffers.size();
+
+            for (int group = 0; group < numGroups; ++group)
+            {
+                // A group that's unclaimed in this block was finished in the previous one
+                auto& state = groupStates[(size_t) group];
+                auto expected = finishedIn (block - 1);
+
+                if (! state.compare_exchange_strong (expected, renderingIn (block), std::memory_order_acquire))
+                    continue;
+
+                auto& scratch = scratchBuffers[(size_t) group];
+                AudioBuffer<FloatType> buffer (scratch.getArrayOfWritePointers(), numChannels, numSamples);
+                buffer.clear();
+
+                for (auto i = group; i < numVoices; i += numGroups)
+                    voices[i]->renderNextBlock (buffer, 0, numSamples);
+
+                state.store (finishedIn (block), std::memory_order_release);
+            }
+        }
+
+        bool isFinished() const noexcept
+        {
+            const auto finished = finishedIn (blockNumber.load (std::memory_order_relaxed));
+
+            return std::all_of (groupStates.begin(), groupStates.end(),
+                                [finished] (auto& state) { return state.load (std::memory_order_acquire) == finished; });
+        }
+
+        void addTo (AudioBuffer<FloatType>& output, int startSample) const noexcept
+        {
+            for (const auto& scratch : scratchBuffers)
+                for (int ch = 0; ch < numChannels; ++ch)
+                    output.addFrom (ch, startSample, scratch, ch, 0, numSamples);
+        }
+
+    private:
+        // The block numbers wrap around, but a worker would have to be stalled for billions
+        // of blocks before it could mistake one block for another
+        static constexpr uint32 renderingIn (uint32 block) noexcept   { return block * 2; }
+        static constexpr uint32 finishedIn  (uint32 block) noexcept   { return block * 2 + 1; }
+
+        std::vector<AudioBuffer<FloatType>> scratchBuffers;
+        std::vector<std::atomic<uint32>> groupStates;
+        SynthesiserVoice* const* voices = nullptr;
+        const int numWorkers;
+        int numVoices = 0, numChannels = 0, numSamples = 0;
+        std::atomic<uint32> blockNumber { 0 };
+    };
+
+    template <typename FloatType>
+    RenderJob<FloatType>& getJob() noexcept
+    {
+        if constexpr (std::is_same_v<FloatType, float>)
+            return floatJob;
+        else
+            return doubleJob;
+    }
+
+    std::shared_ptr<RealtimeThreadPool> pool;
+    const int numWorkers;
+    RenderJob<float> floatJob;
+    RenderJob<double> doubleJob;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderThreadPool)
+};
+
 //==============================================================================
 Synthesiser::Synthesiser()
 {
@@ -93,6 +356,8 @@ Synthesiser::Synthesiser()
 
 Synthesiser::~Synthesiser()
 {
+    // The voices of any banks refer to them, so must be deleted first
+    voices.clear();
 }
 
 //==============================================================================
@@ -106,6 +371,7 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    voiceBanks.clear();
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
@@ -126,6 +392,33 @@ SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
     return voice;
 }
 
+SynthesiserVoiceBank* Synthesiser::addVoiceBank (SynthesiserVoiceBank* const newBank)
+{
+    jassert (newBank != nullptr && ! voiceBanks.contains (newBank));
+
+    {
+        const ScopedLock sl (lock);
+        newBank->setCurrentPlaybackSampleRate (sampleRate);
+
+        voices.ensureStorageAllocated (voices.size() + newBank->getNumVoices());
+
+        for (int i = 0; i < newBank->getNumVoices(); ++i)
+        {
+            auto* voice = voices.add (new SynthesiserVoiceBank::Voice (*newBank, i));
+            voice->setCurrentPlaybackSampleRate (sampleRate);
+        }
+
+        voiceBanks.add (newBank);
+    }
+
+    {
+        const ScopedLock sl (stealLock);
+        usableVoicesToStealArray.ensureStorageAllocated (voices.size() + 1);
+    }
+
+    return newBank;
+}
+
 void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
@@ -162,6 +455,29 @@ void Synthesiser::setMinimumRenderingSubdivisionSize (int numSamples, bool shoul
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void Synthesiser::setNumRenderThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    jassert (numWorkerThreads >= 0 && maximumNumChannels > 0 && maximumBlockSize > 0);
+
+    std::unique_ptr<RenderThreadPool> newPool;
+
+    // The number of groups doesn't depend on the number of workers in the shared pool, so that
+    // the result is the same on every machine
+    if (numWorkerThreads > 0)
+        newPool = std::make_unique<RenderThreadPool> (numWorkerThreads + 1, numWorkerThreads,
+                                                      maximumNumChannels, maximumBlockSize);
+
+    {
+        const ScopedLock sl (lock);
+        std::swap (renderThreadPool, newPool);
+    }
+}
+
+int Synthesiser::getNumRenderThreads() const noexcept
+{
+    return renderThreadPool != nullptr ? renderThreadPool->getNumWorkers() : 0;
+}
+
 //==============================================================================
 void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 {
@@ -173,6 +489,9 @@ void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 
         for (auto* voice : voices)
             voice->setCurrentPlaybackSampleRate (newRate);
+
+        for (auto* bank : voiceBanks)
+            bank->setCurrentPlaybackSampleRate (newRate);
     }
 }
 
@@ -253,12 +572,26 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
+    for (auto* bank : voiceBanks)
+        bank->renderNextBlock (buffer, startSample, numSamples);
+
+    if (renderThreadPool != nullptr && voices.size() > 1
+         && renderThreadPool->render (voices, buffer, startSample, numSamples))
+        return;
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    for (auto* bank : voiceBanks)
+        bank->renderNextBlock (buffer, startSample, numSamples);
+
+    if (renderThreadPool != nullptr && voices.size() > 1
+         && renderThreadPool->render (voices, buffer, startSample, numSamples))
+        return;
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
@@ -608,4 +941,252 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     return low;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SynthesiserTests final : public UnitTest
+{
+public:
+    SynthesiserTests()  : UnitTest ("Synthesiser", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr auto blockSize = 512;
+        constexpr auto numVoices = 64;
+
+        // note events that split each block into uneven sub-blocks
+        MidiBuffer midi;
+
+        for (int i = 0; i < numVoices; ++i)
+            midi.addEvent (MidiMessage::noteOn (1, 30 + i, (uint8) (20 + i)), (i * 37) % blockSize);
+
+        for (int i = 0; i < numVoices; i += 3)
+            midi.addEvent (MidiMessage::noteOff (1, 30 + i), (i * 53) % blockSize);
+
+        beginTest ("Parallel rendering matches serial rendering");
+        {
+            TestSynth serial (numVoices), parallel (numVoices);
+            parallel.setNumRenderThreads (3, 2, blockSize);
+            expectEquals (parallel.getNumRenderThreads(), jmin (3, RealtimeThreadPool::getMaxNumUsefulWorkers()));
+
+            AudioBuffer<float> serialOutput (2, blockSize), parallelOutput (2, blockSize);
+
+            for (int block = 0; block < 8; ++block)
+            {
+                const auto& blockMidi = block % 2 == 0 ? midi : MidiBuffer();
+
+                serialOutput.clear();
+                parallelOutput.clear();
+                serial.renderNextBlock (serialOutput, blockMidi, 0, blockSize);
+                parallel.renderNextBlock (parallelOutput, blockMidi, 0, blockSize);
+
+                expect (serialOutput.getMagnitude (0, blockSize) > 0.0f);
+                expect (buffersMatch (serialOutput, parallelOutput, 1.0e-5f));
+            }
+
+            // the voices were called with the same sub-block sizes
+            for (int i = 0; i < numVoices; ++i)
+                expect (serial.getTestVoice (i).blockSizes == parallel.getTestVoice (i).blockSizes);
+        }
+
+        beginTest ("Parallel rendering is deterministic");
+        {
+            TestSynth first (numVoices), second (numVoices);
+            first.setNumRenderThreads (3, 2, blockSize);
+            second.setNumRenderThreads (3, 2, blockSize);
+
+            AudioBuffer<double> firstOutput (2, blockSize), secondOutput (2, blockSize);
+
+            for (int block = 0; block < 8; ++block)
+            {
+                const auto& blockMidi = block % 2 == 0 ? midi : MidiBuffer();
+
+                firstOutput.clear();
+                secondOutput.clear();
+                first.renderNextBlock (firstOutput, blockMidi, 0, blockSize);
+                second.renderNextBlock (secondOutput, blockMidi, 0, blockSize);
+
+                expect (buffersMatch (firstOutput, secondOutput, 0.0));
+            }
+        }
+
+        beginTest ("Blocks that are too large for the scratch buffers are rendered serially");
+        {
+            TestSynth serial (numVoices), parallel (numVoices);
+            parallel.setNumRenderThreads (2, 1, blockSize / 4);
+
+            AudioBuffer<float> serialOutput (2, blockSize), parallelOutput (2, blockSize);
+            serialOutput.clear();
+            parallelOutput.clear();
+            serial.renderNextBlock (serialOutput, midi, 0, blockSize);
+            parallel.renderNextBlock (parallelOutput, midi, 0, blockSize);
+
+            expect (buffersMatch (serialOutput, parallelOutput, 0.0f));
+
+            parallel.setNumRenderThreads (0, 1, blockSize);
+            expectEquals (parallel.getNumRenderThreads(), 0);
+        }
+
+        beginTest ("Voice banks render like the equivalent voices");
+        {
+            TestSynth voicesSynth (numVoices), bankSynth (0);
+            auto* bank = bankSynth.addVoiceBank (new TestVoiceBank (numVoices));
+            expectEquals (bankSynth.getNumVoices(), numVoices);
+            expectEquals (bankSynth.getNumVoiceBanks(), 1);
+
+            AudioBuffer<double> voicesOutput (2, blockSize), bankOutput (2, blockSize);
+
+            for (int block = 0; block < 4; ++block)
+            {
+                const auto& blockMidi = block % 2 == 0 ? midi : MidiBuffer();
+
+                voicesOutput.clear();
+                bankOutput.clear();
+                voicesSynth.renderNextBlock (voicesOutput, blockMidi, 0, blockSize);
+                bankSynth.renderNextBlock (bankOutput, blockMidi, 0, blockSize);
+
+                expect (bankOutput.getMagnitude (0, blockSize) > 0.0);
+                expect (buffersMatch (voicesOutput, bankOutput, 0.0));
+            }
+
+            for (int i = 0; i < numVoices; ++i)
+            {
+                expect (bankSynth.getVoice (i)->isVoiceActive() == voicesSynth.getVoice (i)->isVoiceActive());
+                expect (bank->isVoiceActive (i) == voicesSynth.getVoice (i)->isVoiceActive());
+            }
+
+            bankSynth.clearVoices();
+            expectEquals (bankSynth.getNumVoices(), 0);
+            expectEquals (bankSynth.getNumVoiceBanks(), 0);
+        }
+    }
+
+private:
+    struct TestSound final : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    struct TestVoice final : public SynthesiserVoice
+    {
+        TestVoice()  { blockSizes.reserve (1024); }
+
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+        {
+            level = velocity;
+            phase = 0.0;
+            phaseDelta = MidiMessage::getMidiNoteInHertz (midiNoteNumber) * MathConstants<double>::twoPi / getSampleRate();
+        }
+
+        void stopNote (float, bool) override    { clearCurrentNote(); }
+        void pitchWheelMoved (int) override     {}
+        void controllerMoved (int, int) override {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override    { render (buffer, startSample, numSamples); }
+        void renderNextBlock (AudioBuffer<double>& buffer, int startSample, int numSamples) override   { render (buffer, startSample, numSamples); }
+
+        template <typename FloatType>
+        void render (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+        {
+            blockSizes.push_back (numSamples);
+
+            if (! isVoiceActive())
+                return;
+
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                const auto sample = (FloatType) (level * std::sin (phase));
+                phase += phaseDelta;
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    buffer.addSample (ch, i, sample * (FloatType) (ch + 1));
+            }
+        }
+
+        std::vector<int> blockSizes;
+        double level = 0.0, phase = 0.0, phaseDelta = 0.0;
+    };
+
+    // Renders the same sound as a TestVoice for each of its voices
+    struct TestVoiceBank final : public SynthesiserVoiceBank
+    {
+        explicit TestVoiceBank (int numVoicesToUse)
+            : SynthesiserVoiceBank (numVoicesToUse),
+              levels ((size_t) numVoicesToUse),
+              phases ((size_t) numVoicesToUse),
+              phaseDeltas ((size_t) numVoicesToUse)
+        {}
+
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int voiceIndex, int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+        {
+            levels[(size_t) voiceIndex] = velocity;
+            phases[(size_t) voiceIndex] = 0.0;
+            phaseDeltas[(size_t) voiceIndex] = MidiMessage::getMidiNoteInHertz (midiNoteNumber) * MathConstants<double>::twoPi / getSampleRate();
+        }
+
+        void stopNote (int voiceIndex, float, bool) override    { clearCurrentNote (voiceIndex); }
+        void pitchWheelMoved (int, int) override                {}
+        void controllerMoved (int, int, int) override           {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override    { render (buffer, startSample, numSamples); }
+        void renderNextBlock (AudioBuffer<double>& buffer, int startSample, int numSamples) override   { render (buffer, startSample, numSamples); }
+
+        template <typename FloatType>
+        void render (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+        {
+            for (size_t v = 0; v < levels.size(); ++v)
+            {
+                if (! isVoiceActive ((int) v))
+                    continue;
+
+                for (int i = startSample; i < startSample + numSamples; ++i)
+                {
+                    const auto sample = (FloatType) (levels[v] * std::sin (phases[v]));
+                    phases[v] += phaseDeltas[v];
+
+                    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                        buffer.addSample (ch, i, sample * (FloatType) (ch + 1));
+                }
+            }
+        }
+
+        std::vector<double> levels, phases, phaseDeltas;
+    };
+
+    struct TestSynth final : public Synthesiser
+    {
+        explicit TestSynth (int numVoices)
+        {
+            for (int i = 0; i < numVoices; ++i)
+                addVoice (new TestVoice());
+
+            addSound (new TestSound());
+            setCurrentPlaybackSampleRate (44100.0);
+        }
+
+        TestVoice& getTestVoice (int index)     { return *static_cast<TestVoice*> (getVoice (index)); }
+    };
+
+    template <typename FloatType>
+    static bool buffersMatch (const AudioBuffer<FloatType>& a, const AudioBuffer<FloatType>& b, FloatType tolerance)
+    {
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                if (std::abs (a.getSample (ch, i) - b.getSample (ch, i)) > tolerance)
+                    return false;
+
+        return true;
+    }
+};
+
+static SynthesiserTests synthesiserTests;
+
+#endif
+
 } // namespace juce
@@ -289,6 +289,128 @@ private:
     JUCE_LEAK_DETECTOR (SynthesiserVoice)
 };
 
+//==============================================================================
+/**
+    Renders a fixed number of voices at once, for a Synthesiser.
+
+    A SynthesiserVoice is rendered with one virtual call per voice, which makes it
+    impossible to process several voices together. A voice bank instead receives the
+    note events for each of its voices, identified by index, and renders all of them
+    in a single call to renderNextBlock(). This allows the voices' state to be kept in
+    a structure-of-arrays layout and processed with SIMD instructions.
+
+    When a bank is added to a Synthesiser with Synthesiser::addVoiceBank(), the synth
+    creates a SynthesiserVoice for each of the bank's voices. These take part in voice
+    allocation, stealing and pedal handling just like other voices, and can be mixed
+    with ordinary SynthesiserVoice objects in the same synth.
+
+    @see Synthesiser::addVoiceBank, SynthesiserVoice
+
+    @tags{Audio}
+*/
+class JUCE_API  SynthesiserVoiceBank
+{
+public:
+    //==============================================================================
+    /** Creates a bank with space for the given number of voices. */
+    explicit SynthesiserVoiceBank (int numVoices);
+
+    /** Destructor. */
+    virtual ~SynthesiserVoiceBank();
+
+    //==============================================================================
+    /** Returns the number of voices in this bank. */
+    int getNumVoices() const noexcept                           { return numVoices; }
+
+    /** Returns the midi note that one of the voices is currently playing.
+        Returns a value less than 0 if no note is playing.
+    */
+    int getCurrentlyPlayingNote (int voiceIndex) const noexcept;
+
+    /** Returns true if one of the voices is currently playing a note. */
+    bool isVoiceActive (int voiceIndex) const noexcept          { return getCurrentlyPlayingNote (voiceIndex) >= 0; }
+
+    /** Returns the current target sample rate at which rendering is being done. */
+    double getSampleRate() const noexcept                       { return currentSampleRate; }
+
+    //==============================================================================
+    /** Must return true if the voices in this bank can play the given sound.
+        @see SynthesiserVoice::canPlaySound
+    */
+    virtual bool canPlaySound (SynthesiserSound*) = 0;
+
+    /** Called to start one of the voices playing a new note.
+        @see SynthesiserVoice::startNote
+    */
+    virtual void startNote (int voiceIndex,
+                            int midiNoteNumber,
+                            float velocity,
+                            SynthesiserSound* sound,
+                            int currentPitchWheelPosition) = 0;
+
+    /** Called to stop a note.
+
+        If allowTailOff is false, the voice must stop immediately and call
+        clearCurrentNote(). Otherwise, it may fade out, and must call clearCurrentNote()
+        from renderNextBlock() when it has finished.
+
+        @see SynthesiserVoice::stopNote
+    */
+    virtual void stopNote (int voiceIndex, float velocity, bool allowTailOff) = 0;
+
+    /** Called to let one of the voices know that the pitch wheel has been moved. */
+    virtual void pitchWheelMoved (int voiceIndex, int newPitchWheelValue) = 0;
+
+    /** Called to let one of the voices know that a midi controller has been moved. */
+    virtual void controllerMoved (int voiceIndex, int controllerNumber, int newControllerValue) = 0;
+
+    /** Called to let one of the voices know that the aftertouch has changed. */
+    virtual void aftertouchChanged (int voiceIndex, int newAftertouchValue);
+
+    /** Called to let one of the voices know that the channel pressure has changed. */
+    virtual void channelPressureChanged (int voiceIndex, int newChannelPressureValue);
+
+    //==============================================================================
+    /** Renders the next block of data for all of the voices in this bank.
+
+        The output must be added to the current contents of the buffer, between
+        startSample and (startSample + numSamples). Voices whose notes finish during the
+        block must call clearCurrentNote().
+
+        @see SynthesiserVoice::renderNextBlock
+    */
+    virtual void renderNextBlock (AudioBuffer<float>& outputBuffer,
+                                  int startSample,
+                                  int numSamples) = 0;
+
+    /** A double-precision version of renderNextBlock() */
+    virtual void renderNextBlock (AudioBuffer<double>& outputBuffer,
+                                  int startSample,
+                                  int numSamples);
+
+    /** Changes the bank's reference sample rate. */
+    virtual void setCurrentPlaybackSampleRate (double newRate);
+
+protected:
+    /** Resets the state of one of the voices after its sound has finished playing.
+        @see SynthesiserVoice::clearCurrentNote
+    */
+    void clearCurrentNote (int voiceIndex);
+
+private:
+    //==============================================================================
+    friend class Synthesiser;
+    class Voice;
+
+    const int numVoices;
+    std::vector<Voice*> bankVoices;
+    double currentSampleRate = 44100.0;
+
+    AudioBuffer<float> tempBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SynthesiserVoiceBank)
+};
+
 
 //==============================================================================
 /**
@@ -351,6 +473,25 @@ public:
     /** Deletes one of the voices. */
     void removeVoice (int index);
 
+    /** Adds a bank of voices to the synth.
+
+        A voice is added to the synth for each of the bank's voices, so that they can be
+        found with getVoice() and are allocated to notes like any other voices. The bank is
+        asked to render all of its voices at once, each time renderVoices() is called.
+
+        The object passed in will be managed by the synthesiser, which will delete
+        it later on when no longer needed. Banks are deleted by clearVoices().
+
+        @see SynthesiserVoiceBank
+    */
+    SynthesiserVoiceBank* addVoiceBank (SynthesiserVoiceBank* newBank);
+
+    /** Returns the number of voice banks that have been added. */
+    int getNumVoiceBanks() const noexcept                           { return voiceBanks.size(); }
+
+    /** Returns one of the voice banks that have been added. */
+    SynthesiserVoiceBank* getVoiceBank (int index) const noexcept   { return voiceBanks[index]; }
+
     //==============================================================================
     /** Deletes all sounds. */
     void clearSounds();
@@ -569,6 +710,45 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    /** Allows the voices to be rendered on several threads at once.
+
+        By default, renderVoices() renders the voices one after another on the thread that
+        calls renderNextBlock(). If numWorkerThreads is greater than zero, the synthesiser will
+        use up to that many worker threads, and the voices for each sub-block will be shared
+        out between the workers and the calling thread. No more workers are used than there
+        are other CPUs to run them. The way that the blocks are split up around midi
+        events doesn't change.
+
+        The voices are divided into a fixed set of groups, and each group is rendered into its
+        own scratch buffer. The scratch buffers are then added to the output in order, so the
+        result doesn't depend on which thread rendered which group. There is one group for each
+        requested thread, so the result is the same every time for a given value of
+        numWorkerThreads, however many workers are running. Because the voices are summed in
+        groups, it may differ very slightly from that of serial rendering.
+
+        Voices that are rendered in parallel mustn't modify any state that they share with other
+        voices. The calling thread never waits on a lock or allocates in order to share work with
+        the workers. The workers come from RealtimeThreadPool::getSharedInstance(), so they're
+        shared with any other synths, graphs and devices that render in parallel. This is only
+        worthwhile for synths with enough active voices to keep several cores busy.
+
+        The scratch buffers are allocated here, with space for the given number of channels and
+        samples. Any larger blocks will be rendered on the calling thread.
+
+        Pass zero to return to rendering everything on the calling thread. This should be called
+        on the message thread.
+
+        @see getNumRenderThreads
+    */
+    void setNumRenderThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of shared workers that will help to render each block.
+
+        This may be fewer than the number requested by setNumRenderThreads(), on machines with
+        only a few CPUs.
+    */
+    int getNumRenderThreads() const noexcept;
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -642,6 +822,11 @@ private:
     mutable CriticalSection stealLock;
     mutable Array<SynthesiserVoice*> usableVoicesToStealArray;
 
+    OwnedArray<SynthesiserVoiceBank> voiceBanks;
+
+    class RenderThreadPool;
+    std::unique_ptr<RenderThreadPool> renderThreadPool;
+
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
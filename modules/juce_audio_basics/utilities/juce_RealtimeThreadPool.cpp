@@ -0,0 +1,378 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class RealtimeThreadPool::Worker final : public Thread
+{
+public:
+    Worker (RealtimeThreadPool& o, const String& name, int index)
+        : Thread (name + " " + String (index)), owner (o), threadIndex (index) {}
+
+    void run() override
+    {
+        std::array<uint32, maxNumJobs> lastJobNumbers {};
+
+        while (! threadShouldExit())
+        {
+            if (owner.helpWithAnyJob (threadIndex, lastJobNumbers.data()) || spinUntilJobArrives (lastJobNumbers.data()))
+                continue;
+
+            // The flag is set before checking for a job one last time, so that beginJob()
+            // either sees it and wakes this thread, or publishes its job before the check
+            sleeping.store (true);
+
+            if (! owner.hasUnseenJob (lastJobNumbers.data()))
+                wait (-1);
+
+            sleeping.store (false);
+        }
+    }
+
+    void wake()
+    {
+        if (sleeping.exchange (false))
+            notify();
+    }
+
+private:
+    // Long enough to catch a job that follows straight after another one, but much
+    // shorter than an audio callback
+    static constexpr double spinSeconds = 50.0e-6;
+
+    bool spinUntilJobArrives (const uint32* lastJobNumbers) const noexcept
+    {
+        const auto endTime = Time::getHighResolutionTicks() + Time::secondsToHighResolutionTicks (spinSeconds);
+
+        for (Backoff backoff; Time::getHighResolutionTicks() < endTime; backoff.pause())
+            if (owner.hasUnseenJob (lastJobNumbers))
+                return true;
+
+        return false;
+    }
+
+    RealtimeThreadPool& owner;
+    const int threadIndex;
+    std::atomic<bool> sleeping { false };
+};
+
+//==============================================================================
+RealtimeThreadPool::RealtimeThreadPool (const String& threadName, int numWorkers)
+{
+    for (auto i = 0; i < numWorkers; ++i)
+        workers.push_back (std::make_unique<Worker> (*this, threadName, i + 1));
+
+    for (auto& worker : workers)
+        if (! worker->startRealtimeThread (Thread::RealtimeOptions{}.withPriority (9)))
+            worker->startThread (Thread::Priority::highest);
+}
+
+RealtimeThreadPool::~RealtimeThreadPool()
+{
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    for (auto& worker : workers)
+        worker->stopThread (-1);
+}
+
+std::shared_ptr<RealtimeThreadPool> RealtimeThreadPool::getSharedInstance()
+{
+    static CriticalSection lock;
+    static std::weak_ptr<RealtimeThreadPool> instance;
+
+    const ScopedLock sl (lock);
+
+    if (auto existing = instance.lock())
+        return existing;
+
+    auto pool = std::make_shared<RealtimeThreadPool> ("Realtime worker", getMaxNumUsefulWorkers());
+    instance = pool;
+    return pool;
+}
+
+int RealtimeThreadPool::getMaxNumUsefulWorkers()
+{
+    return jmax (0, SystemStats::getNumCpus() - 1);
+}
+
+bool RealtimeThreadPool::beginJob (Job& job) noexcept
+{
+    jassert (job.numHelpers.load() == 0); // has endJob() been called since this job last ran?
+
+    for (auto i = 0; i < maxNumJobs; ++i)
+    {
+        auto& slot = slots[(size_t) i];
+        auto expected = false;
+
+        if (! slot.inUse.compare_exchange_strong (expected, true))
+            continue;
+
+        // The number changes before the job is published, so that a worker that finds the
+        // job can't mistake it for the one that was previously in this slot
+        job.slot = i;
+        ++slot.jobNumber;
+        slot.job.store (&job);
+
+        for (auto& worker : workers)
+            worker->wake();
+
+        return true;
+    }
+
+    job.slot = -1;
+    return false;
+}
+
+void RealtimeThreadPool::endJob (Job& job) noexcept
+{
+    withdrawJob (job);
+
+    // A worker may still be on its way in or out of the job
+    if (job.slot >= 0)
+    {
+        auto& slot = slots[(size_t) job.slot];
+        waitUntil ([&] { return slot.numArrivingHelpers.load() == 0; });
+    }
+
+    waitUntil ([&] { return job.numHelpers.load() == 0; });
+}
+
+void RealtimeThreadPool::withdrawJob (Job& job) noexcept
+{
+    if (job.slot < 0)
+        return;
+
+    auto& slot = slots[(size_t) job.slot];
+    auto* expected = &job;
+
+    if (slot.job.compare_exchange_strong (expected, nullptr))
+        slot.inUse.store (false);
+}
+
+bool RealtimeThreadPool::hasUnseenJob (const uint32* lastJobNumbers) const noexcept
+{
+    for (auto i = 0; i < maxNumJobs; ++i)
+    {
+        const auto& slot = slots[(size_t) i];
+
+        if (slot.jobNumber.load() != lastJobNumbers[i] && slot.job.load() != nullptr)
+            return true;
+    }
+
+    return false;
+}
+
+bool RealtimeThreadPool::helpWithAnyJob (int threadIndex, uint32* lastJobNumbers)
+{
+    for (auto i = 0; i < maxNumJobs; ++i)
+    {
+        // Workers that are just polling, or that have already helped with this job, mustn't
+        // register as helpers, otherwise endJob() could end up waiting for a worker that has
+        // been descheduled without having done anything.
+        auto& slot = slots[(size_t) i];
+        const auto number = slot.jobNumber.load();
+
+        if (number == lastJobNumbers[i] || slot.job.load() == nullptr)
+            continue;
+
+        // The arriving count must be incremented before loading the job again, so that
+        // endJob() can't return while this thread holds a pointer to the job that it hasn't
+        // yet registered with
+        ++slot.numArrivingHelpers;
+        auto* job = slot.job.load();
+        const auto isCurrent = job != nullptr && slot.jobNumber.load() == number;
+
+        if (isCurrent)
+            ++job->numHelpers;
+
+        --slot.numArrivingHelpers;
+
+        if (! isCurrent)
+            continue;
+
+        lastJobNumbers[i] = number;
+        job->help (threadIndex);
+        --job->numHelpers;
+        return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+void RealtimeThreadPool::Backoff::pause() noexcept
+{
+    // Roughly a microsecond of spinning, after which another thread may be needed to
+    // finish the work
+    constexpr auto numSpinsBeforeYielding = 64;
+
+    if (numPauses < numSpinsBeforeYielding)
+    {
+        ++numPauses;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        _mm_pause();
+       #elif JUCE_ARM && (JUCE_GCC || JUCE_CLANG)
+        __asm__ __volatile__ ("yield");
+       #endif
+
+        return;
+    }
+
+    Thread::yield();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class RealtimeThreadPoolTests final : public UnitTest
+{
+public:
+    RealtimeThreadPoolTests()
+        : UnitTest ("RealtimeThreadPool", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Every task is run exactly once");
+        {
+            RealtimeThreadPool pool ("Test worker", 3);
+            CountingJob job;
+
+            for (auto block = 0; block < 1000; ++block)
+            {
+                runJob (pool, job);
+
+                expect (std::all_of (job.runCounts.begin(), job.runCounts.end(), [] (auto& c) { return c.load() == 1; }));
+                expect (job.badThreadIndex.load() == false);
+            }
+        }
+
+        beginTest ("A job can be completed without any workers");
+        {
+            RealtimeThreadPool pool ("Test worker", 0);
+            expectEquals (pool.getNumWorkers(), 0);
+
+            CountingJob job;
+            runJob (pool, job);
+
+            expectEquals ((int) job.numFinished.load(), numTasks);
+        }
+
+        beginTest ("Several threads can run jobs at once");
+        {
+            RealtimeThreadPool pool ("Test worker", 3);
+            std::atomic<bool> allRunOnce { true };
+
+            const auto runJobs = [&]
+            {
+                CountingJob job;
+
+                for (auto block = 0; block < 300; ++block)
+                {
+                    runJob (pool, job);
+
+                    if (! std::all_of (job.runCounts.begin(), job.runCounts.end(), [] (auto& c) { return c.load() == 1; }))
+                        allRunOnce = false;
+                }
+            };
+
+            std::thread other (runJobs);
+            runJobs();
+            other.join();
+
+            expect (allRunOnce.load());
+        }
+
+        beginTest ("Workers sleep when there's no work");
+        {
+            RealtimeThreadPool pool ("Test worker", 2);
+            CountingJob job;
+            runJob (pool, job);
+
+            // Once they've stopped spinning, a new job has to wake them
+            Thread::sleep (20);
+            runJob (pool, job);
+            expectEquals ((int) job.numFinished.load(), numTasks);
+        }
+    }
+
+private:
+    static constexpr int numTasks = 16;
+
+    struct CountingJob final : public RealtimeThreadPool::Job
+    {
+        void reset()
+        {
+            nextTask = 0;
+            numFinished = 0;
+
+            for (auto& c : runCounts)
+                c = 0;
+        }
+
+        void help (int threadIndex) override
+        {
+            if (threadIndex < 0 || threadIndex > 3)
+                badThreadIndex = true;
+
+            for (auto task = nextTask.fetch_add (1); task < numTasks; task = nextTask.fetch_add (1))
+            {
+                ++runCounts[(size_t) task];
+                ++numFinished;
+            }
+        }
+
+        std::array<std::atomic<int>, numTasks> runCounts{};
+        std::atomic<int> nextTask { 0 }, numFinished { 0 };
+        std::atomic<bool> badThreadIndex { false };
+    };
+
+    static void runJob (RealtimeThreadPool& pool, CountingJob& job)
+    {
+        job.reset();
+        pool.beginJob (job);
+        job.help (0);
+        RealtimeThreadPool::waitUntil ([&] { return job.numFinished.load() == numTasks; });
+        pool.endJob (job);
+    }
+};
+
+static RealtimeThreadPoolTests realtimeThreadPoolTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A set of realtime worker threads that can help audio threads to get through a block
+    of work.
+
+    An audio thread publishes a Job with beginJob(), does its own share of the work by
+    calling Job::help(), and then calls endJob(), which returns once no worker is still
+    touching the job. None of these calls will allocate or wait for a worker, so they can
+    be used in an audio callback. Several audio threads can run jobs on the same pool at
+    once, and a job can be started from inside another job's Job::help() call.
+
+    After finishing a job, a worker spins for a few microseconds in case another job
+    follows straight away, and then sleeps until beginJob() wakes it. Waking a worker
+    signals a WaitableEvent, which can involve a system call. The audio thread never has
+    to wait for a worker to wake up, so a worker that arrives late will just find less
+    work to do. This means that a Job must be written so that the audio thread can
+    complete all of it on its own.
+
+    Rather than creating a pool of their own, classes that render audio in parallel should
+    use getSharedInstance(), so that the process only has one set of workers.
+
+    @tags{Audio}
+*/
+class JUCE_API  RealtimeThreadPool
+{
+public:
+    //==============================================================================
+    /** The work to be shared out for one block. */
+    struct JUCE_API  Job
+    {
+        Job() = default;
+        virtual ~Job() = default;
+
+        /** Called concurrently on the audio thread (with index 0) and on the worker threads
+            (with indices 1 to getNumWorkers()).
+
+            This should keep claiming and running tasks until there are none left to claim.
+        */
+        virtual void help (int threadIndex) = 0;
+
+    private:
+        friend class RealtimeThreadPool;
+        std::atomic<int> numHelpers { 0 };
+        int slot = -1;
+
+        JUCE_DECLARE_NON_COPYABLE (Job)
+    };
+
+    //==============================================================================
+    /** Creates and starts some worker threads, which will be named after threadName. */
+    RealtimeThreadPool (const String& threadName, int numWorkers);
+
+    /** Destructor. Stops the worker threads. */
+    ~RealtimeThreadPool();
+
+    /** Returns a pool that's shared by everything in the process that uses it, with
+        getMaxNumUsefulWorkers() workers.
+
+        The pool is created the first time that this is called, and deleted when the last
+        of the pointers returned by this method is released. This may allocate and start
+        threads, so don't call it on an audio thread.
+    */
+    static std::shared_ptr<RealtimeThreadPool> getSharedInstance();
+
+    /** Returns the number of worker threads, not including the audio thread. */
+    int getNumWorkers() const noexcept                  { return (int) workers.size(); }
+
+    /** Returns the largest number of workers that can run alongside the audio thread
+        without having to compete with it for a CPU, which is one fewer than the number
+        of CPUs.
+    */
+    static int getMaxNumUsefulWorkers();
+
+    //==============================================================================
+    /** Makes a job available to the workers, and wakes any that are sleeping.
+
+        Returns false if too many jobs are already running, in which case the calling
+        thread will have to do all of the work itself. endJob() must be called either way.
+    */
+    bool beginJob (Job& job) noexcept;
+
+    /** Withdraws a job, and returns once no worker is still using it.
+
+        Call this from the thread that called beginJob(), once the job's work has been
+        completed. This can also be called for a job that has already been withdrawn, to
+        wait for any workers that were late to leave it.
+    */
+    void endJob (Job& job) noexcept;
+
+    /** Withdraws a job without waiting for the workers to leave it.
+
+        A worker that picked up the job may still call Job::help() after this returns, even
+        once the next job has begun. This can only be used for a job that can tell when a
+        late worker is trying to claim work from an earlier block, and endJob() must still
+        be called before the job is deleted.
+    */
+    void withdrawJob (Job& job) noexcept;
+
+    //==============================================================================
+    /** Used in loops that wait for another thread to finish some work.
+
+        At first, pause() just tells the CPU that the thread is spinning. If the wait goes
+        on, it yields to other threads, so that a waiting thread can't starve a thread that
+        it's waiting for when they have to share a CPU.
+    */
+    class JUCE_API  Backoff
+    {
+    public:
+        /** Call this each time round the waiting loop. */
+        void pause() noexcept;
+
+    private:
+        int numPauses = 0;
+    };
+
+    /** Waits until the condition returns true, pausing in between checks. */
+    template <typename Condition>
+    static void waitUntil (Condition&& condition) noexcept
+    {
+        for (Backoff backoff; ! condition();)
+            backoff.pause();
+    }
+
+private:
+    //==============================================================================
+    class Worker;
+
+    // The most jobs that can be running at once, across all of the threads using the pool
+    static constexpr int maxNumJobs = 16;
+
+    struct Slot
+    {
+        std::atomic<bool> inUse { false };
+        std::atomic<Job*> job { nullptr };
+        std::atomic<uint32> jobNumber { 0 };
+        std::atomic<int> numArrivingHelpers { 0 };
+    };
+
+    bool helpWithAnyJob (int threadIndex, uint32* lastJobNumbers);
+    bool hasUnseenJob (const uint32* lastJobNumbers) const noexcept;
+
+    std::array<Slot, maxNumJobs> slots;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeThreadPool)
+};
+
+} // namespace juce
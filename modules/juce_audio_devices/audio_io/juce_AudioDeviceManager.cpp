@@ -1047,10 +1047,186 @@ void AudioDeviceManager::updateXml()
 }
 
 //==============================================================================
+/*  An immutable snapshot of the registered callbacks, along with the scratch buffers that the
+    audio thread needs to mix their outputs.
+
+    A new list is built on the message thread whenever the callbacks change, and is then handed to
+    the audio thread with an atomic pointer swap. Only the audio thread and the thread pool's
+    workers ever write to the scratch buffers.
+*/
+class AudioDeviceManager::CallbackList
+{
+public:
+    CallbackList (const Array<AudioIODeviceCallback*>& callbacksIn,
+                  int numOutputChannels,
+                  int bufferSize,
+                  RealtimeThreadPool* poolIn,
+                  int maxNumWorkersToUse)
+        : callbacks (callbacksIn.begin(), callbacksIn.end()),
+          pool (maxNumWorkersToUse > 0 ? poolIn : nullptr),
+          maxNumWorkers (maxNumWorkersToUse)
+    {
+        // Running in serial, all of the extra callbacks can share one buffer
+        const auto numBuffers = callbacks.size() > 1 ? (pool != nullptr ? callbacks.size() - 1 : 1) : 0;
+        buffers.resize (numBuffers);
+
+        for (auto& buffer : buffers)
+            buffer.setSize (jmax (1, numOutputChannels), jmax (1, bufferSize));
+    }
+
+    bool isEmpty() const noexcept       { return callbacks.empty(); }
+
+    /*  Call from the audio thread only. */
+    void process (const float* const* inputChannelData,
+                  int numInputChannels,
+                  float* const* outputChannelData,
+                  int numOutputChannels,
+                  int numSamples,
+                  const AudioIODeviceCallbackContext& context)
+    {
+        const Block block { inputChannelData, numInputChannels, outputChannelData, numOutputChannels, numSamples, context };
+
+        if (pool == nullptr || callbacks.size() < 2)
+        {
+            render (block, 0, outputChannelData);
+
+            for (auto i = callbacks.size(); --i > 0;)
+            {
+                auto* const* tempChans = getBufferChannels (block, buffers.front());
+                render (block, i, tempChans);
+                addToOutput (block, tempChans);
+            }
+
+            return;
+        }
+
+        RenderJob job (*this, block);
+        pool->beginJob (job);
+        job.help (0);
+
+        // Another thread may still be running a callback
+        RealtimeThreadPool::waitUntil ([&] { return job.numFinished.load() == callbacks.size(); });
+
+        pool->endJob (job);
+
+        // Mix in the same order as the serial case, so that the results are identical
+        for (auto i = callbacks.size(); --i > 0;)
+            addToOutput (block, buffers[i - 1].getArrayOfReadPointers());
+    }
+
+private:
+    struct Block
+    {
+        const float* const* inputChannelData;
+        int numInputChannels;
+        float* const* outputChannelData;
+        int numOutputChannels;
+        int numSamples;
+        const AudioIODeviceCallbackContext& context;
+    };
+
+    struct RenderJob final : public RealtimeThreadPool::Job
+    {
+        RenderJob (CallbackList& o, const Block& b) : owner (o), block (b) {}
+
+        void help (int threadIndex) override
+        {
+            // The pool is shared, and may have more workers than this device manager should use
+            if (threadIndex > owner.maxNumWorkers)
+                return;
+
+            for (;;)
+            {
+                const auto index = nextCallback.fetch_add (1);
+
+                if (index >= owner.callbacks.size())
+                    return;
+
+                owner.render (block, index, index == 0 ? block.outputChannelData
+                                                       : owner.getBufferChannels (block, owner.buffers[index - 1]));
+                ++numFinished;
+            }
+        }
+
+        CallbackList& owner;
+        const Block& block;
+        std::atomic<size_t> nextCallback { 0 }, numFinished { 0 };
+    };
+
+    void render (const Block& block, size_t index, float* const* outputs) const
+    {
+        callbacks[index]->audioDeviceIOCallbackWithContext (block.inputChannelData,
+                                                            block.numInputChannels,
+                                                            outputs,
+                                                            block.numOutputChannels,
+                                                            block.numSamples,
+                                                            block.context);
+    }
+
+    static float* const* getBufferChannels (const Block& block, AudioBuffer<float>& buffer)
+    {
+        // The buffers are allocated when the device starts, so this will only reallocate if the
+        // device passes more channels or samples than it said it would.
+        buffer.setSize (jmax (1, block.numOutputChannels), jmax (1, block.numSamples), false, false, true);
+        return buffer.getArrayOfWritePointers();
+    }
+
+    static void addToOutput (const Block& block, const float* const* src)
+    {
+        for (int chan = 0; chan < block.numOutputChannels; ++chan)
+            if (auto* dst = block.outputChannelData [chan])
+                for (int j = 0; j < block.numSamples; ++j)
+                    dst[j] += src[chan][j];
+    }
+
+    const std::vector<AudioIODeviceCallback*> callbacks;
+    std::vector<AudioBuffer<float>> buffers;
+    RealtimeThreadPool* const pool;
+    const int maxNumWorkers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackList)
+};
+
+//==============================================================================
+void AudioDeviceManager::publishCallbackList()
+{
+    // callbackListLock must be held when calling this
+    auto newList = std::make_unique<CallbackList> (callbacks,
+                                                   preparedNumOutputChannels,
+                                                   preparedBufferSize,
+                                                   callbackThreadPool.get(),
+                                                   callbackThreadPool != nullptr ? jmin (numParallelCallbackThreads, callbackThreadPool->getNumWorkers())
+                                                                                 : 0);
+
+    audioThreadCallbackList.store (newList.get());
+
+    if (currentCallbackList != nullptr)
+        retiredCallbackLists.push_back (std::move (currentCallbackList));
+
+    currentCallbackList = std::move (newList);
+
+    // If this is happening inside an audio callback, the old lists can't be deleted yet, because
+    // the audio thread is still using one of them. They'll be cleaned up next time.
+    if (audioCallbackThreadID.load() == Thread::getCurrentThreadId())
+    {
+        jassertfalse;
+        return;
+    }
+
+    // The epoch is odd while the audio thread is inside a callback. If a callback was in progress
+    // when the new list was published, wait for it to finish, as it may be using an old list.
+    // Any callback that starts afterwards is guaranteed to see the new one.
+    if (const auto epoch = audioCallbackEpoch.load(); (epoch & 1) != 0)
+        while (audioCallbackEpoch.load() == epoch)
+            std::this_thread::yield();
+
+    retiredCallbackLists.clear();
+}
+
 void AudioDeviceManager::addAudioCallback (AudioIODeviceCallback* newCallback)
 {
     {
-        const ScopedLock sl (audioCallbackLock);
+        const ScopedLock sl (callbackListLock);
 
         if (callbacks.contains (newCallback))
             return;
@@ -1059,8 +1235,9 @@ void AudioDeviceManager::addAudioCallback (AudioIODeviceCallback* newCallback)
     if (currentAudioDevice != nullptr && newCallback != nullptr)
         newCallback->audioDeviceAboutToStart (currentAudioDevice.get());
 
-    const ScopedLock sl (audioCallbackLock);
+    const ScopedLock sl (callbackListLock);
     callbacks.add (newCallback);
+    publishCallbackList();
 }
 
 void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToRemove)
@@ -1070,10 +1247,11 @@ void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToR
         bool needsDeinitialising = currentAudioDevice != nullptr;
 
         {
-            const ScopedLock sl (audioCallbackLock);
+            const ScopedLock sl (callbackListLock);
 
             needsDeinitialising = needsDeinitialising && callbacks.contains (callbackToRemove);
             callbacks.removeFirstMatchingValue (callbackToRemove);
+            publishCallbackList();
         }
 
         if (needsDeinitialising)
@@ -1081,6 +1259,28 @@ void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToR
     }
 }
 
+void AudioDeviceManager::setNumParallelCallbackThreads (int numThreads)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    numThreads = jmax (0, numThreads);
+
+    std::shared_ptr<RealtimeThreadPool> oldPool;
+
+    {
+        const ScopedLock sl (callbackListLock);
+
+        if (numThreads == numParallelCallbackThreads)
+            return;
+
+        numParallelCallbackThreads = numThreads;
+        oldPool = std::exchange (callbackThreadPool, numThreads > 0 ? RealtimeThreadPool::getSharedInstance() : nullptr);
+
+        // Once this returns, the audio thread has stopped using the old pool
+        publishCallbackList();
+    }
+}
+
 void AudioDeviceManager::audioDeviceIOCallbackInt (const float* const* inputChannelData,
                                                    int numInputChannels,
                                                    float* const* outputChannelData,
@@ -1090,40 +1290,29 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float* const* inputChan
 {
     const ScopedLock sl (audioCallbackLock);
 
-    inputLevelGetter->updateLevel (inputChannelData, numInputChannels, numSamples);
+    ++audioCallbackEpoch;
+    audioCallbackThreadID = Thread::getCurrentThreadId();
 
-    if (callbacks.size() > 0)
+    const ScopeGuard endOfCallback { [this]
     {
-        AudioProcessLoadMeasurer::ScopedTimer timer (loadMeasurer, numSamples);
-
-        tempBuffer.setSize (jmax (1, numOutputChannels), jmax (1, numSamples), false, false, true);
+        audioCallbackThreadID = nullptr;
+        ++audioCallbackEpoch;
+    } };
 
-        callbacks.getUnchecked (0)->audioDeviceIOCallbackWithContext (inputChannelData,
-                                                                      numInputChannels,
-                                                                      outputChannelData,
-                                                                      numOutputChannels,
-                                                                      numSamples,
-                                                                      context);
+    inputLevelGetter->updateLevel (inputChannelData, numInputChannels, numSamples);
 
-        auto* const* tempChans = tempBuffer.getArrayOfWritePointers();
+    auto* callbackList = audioThreadCallbackList.load();
 
-        for (int i = callbacks.size(); --i > 0;)
-        {
-            callbacks.getUnchecked (i)->audioDeviceIOCallbackWithContext (inputChannelData,
-                                                                          numInputChannels,
-                                                                          tempChans,
-                                                                          numOutputChannels,
-                                                                          numSamples,
-                                                                          context);
+    if (callbackList != nullptr && ! callbackList->isEmpty())
+    {
+        AudioProcessLoadMeasurer::ScopedTimer timer (loadMeasurer, numSamples);
 
-            for (int chan = 0; chan < numOutputChannels; ++chan)
-            {
-                if (auto* src = tempChans [chan])
-                    if (auto* dst = outputChannelData [chan])
-                        for (int j = 0; j < numSamples; ++j)
-                            dst[j] += src[j];
-            }
-        }
+        callbackList->process (inputChannelData,
+                               numInputChannels,
+                               outputChannelData,
+                               numOutputChannels,
+                               numSamples,
+                               context);
     }
     else
     {
@@ -1159,6 +1348,11 @@ void AudioDeviceManager::audioDeviceAboutToStartInt (AudioIODevice* const device
 
     {
         const ScopedLock sl (audioCallbackLock);
+        const ScopedLock listLock (callbackListLock);
+
+        preparedNumOutputChannels = device->getActiveOutputChannels().countNumberOfSetBits();
+        preparedBufferSize = device->getCurrentBufferSizeSamples();
+        publishCallbackList();
 
         for (int i = callbacks.size(); --i >= 0;)
             callbacks.getUnchecked (i)->audioDeviceAboutToStart (device);
@@ -1172,6 +1366,7 @@ void AudioDeviceManager::audioDeviceStoppedInt()
     sendChangeMessage();
 
     const ScopedLock sl (audioCallbackLock);
+    const ScopedLock listLock (callbackListLock);
 
     loadMeasurer.reset();
 
@@ -1182,6 +1377,7 @@ void AudioDeviceManager::audioDeviceStoppedInt()
 void AudioDeviceManager::audioDeviceErrorInt (const String& message)
 {
     const ScopedLock sl (audioCallbackLock);
+    const ScopedLock listLock (callbackListLock);
 
     for (int i = callbacks.size(); --i >= 0;)
         callbacks.getUnchecked (i)->audioDeviceError (message);
@@ -1192,6 +1388,46 @@ double AudioDeviceManager::getCpuUsage() const
     return loadMeasurer.getLoadAsProportion();
 }
 
+AudioDeviceManager::CallbackStatistics AudioDeviceManager::getCallbackStatistics() const
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    CallbackStatistics stats;
+    stats.callbackDurations = loadMeasurer.getHistogram();
+    stats.numSlowCallbacks = loadMeasurer.getXRunCount();
+    stats.numDeviceXRuns = currentAudioDevice != nullptr ? currentAudioDevice->getXRunCount() : -1;
+    return stats;
+}
+
+std::vector<AudioProcessLoadMeasurer::OverrunEvent> AudioDeviceManager::popOverrunEvents()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto events = loadMeasurer.popOverrunEvents();
+
+    auto* device = currentAudioDevice.get();
+    const auto deviceXRuns = device != nullptr ? device->getXRunCount() : -1;
+
+    if (device != lastPolledXRunDevice || deviceXRuns < lastPolledDeviceXRunCount)
+    {
+        lastPolledXRunDevice = device;
+        lastPolledDeviceXRunCount = 0;
+    }
+
+    if (deviceXRuns > lastPolledDeviceXRunCount)
+    {
+        AudioProcessLoadMeasurer::OverrunEvent event;
+        event.type = AudioProcessLoadMeasurer::OverrunEvent::Type::reportedByDevice;
+        event.timeMs = Time::getMillisecondCounterHiRes();
+        event.numSamplesOrXRuns = deviceXRuns - lastPolledDeviceXRunCount;
+        events.push_back (event);
+
+        lastPolledDeviceXRunCount = deviceXRuns;
+    }
+
+    return events;
+}
+
 //==============================================================================
 void AudioDeviceManager::setMidiInputDeviceEnabled (const String& identifier, bool enabled)
 {
@@ -1272,8 +1508,9 @@ void AudioDeviceManager::setDefaultMidiOutputDevice (const String& identifier)
         Array<AudioIODeviceCallback*> oldCallbacks;
 
         {
-            const ScopedLock sl (audioCallbackLock);
+            const ScopedLock sl (callbackListLock);
             oldCallbacks.swapWith (callbacks);
+            publishCallbackList();
         }
 
         if (currentAudioDevice != nullptr)
@@ -1295,8 +1532,9 @@ void AudioDeviceManager::setDefaultMidiOutputDevice (const String& identifier)
                 c->audioDeviceAboutToStart (currentAudioDevice.get());
 
         {
-            const ScopedLock sl (audioCallbackLock);
+            const ScopedLock sl (callbackListLock);
             oldCallbacks.swapWith (callbacks);
+            publishCallbackList();
         }
 
         updateXml();
@@ -1680,6 +1918,109 @@ public:
             ptr->restartDevices (newSr, newBs);
             expectEquals (numCalls, 1);
         }
+
+        beginTest ("Xruns reported by the device are returned as overrun events");
+        {
+            AudioDeviceManager manager;
+            manager.addAudioDeviceType (std::make_unique<MockDeviceType> ("foo"));
+
+            AudioDeviceManager::AudioDeviceSetup setup;
+            setup.outputDeviceName = "x";
+            setup.useDefaultOutputChannels = true;
+            expect (manager.setAudioDeviceSetup (setup, true).isEmpty());
+
+            auto* device = dynamic_cast<MockDevice*> (manager.getCurrentAudioDevice());
+            expect (device != nullptr);
+
+            expect (manager.popOverrunEvents().empty());
+            expectEquals (manager.getCallbackStatistics().numDeviceXRuns, 0);
+
+            device->xruns = 3;
+
+            auto events = manager.popOverrunEvents();
+            expectEquals ((int) events.size(), 1);
+            expect (events[0].type == AudioProcessLoadMeasurer::OverrunEvent::Type::reportedByDevice);
+            expectEquals (events[0].numSamplesOrXRuns, 3);
+            expectEquals (manager.getCallbackStatistics().numDeviceXRuns, 3);
+
+            expect (manager.popOverrunEvents().empty());
+
+            device->xruns = 5;
+            events = manager.popOverrunEvents();
+            expectEquals ((int) events.size(), 1);
+            expectEquals (events[0].numSamplesOrXRuns, 2);
+        }
+
+        beginTest ("Callbacks can be added and removed while the device is running, in serial and in parallel");
+        {
+            AudioDeviceManager manager;
+
+            VirtualAudioIODevice::Options options;
+            options.numInputChannels = 0;
+            options.timing = VirtualAudioIODevice::Timing::freeRunning;
+            options.maxNumOutputSamplesToCapture = 2048;
+
+            auto type = std::make_unique<VirtualAudioIODeviceType>();
+            type->addDevice (options);
+            manager.addAudioDeviceType (std::move (type));
+            manager.setCurrentAudioDeviceType (VirtualAudioIODeviceType::defaultTypeName, true);
+
+            AudioDeviceManager::AudioDeviceSetup setup;
+            setup.outputDeviceName = options.name;
+            setup.useDefaultOutputChannels = true;
+            setup.bufferSize = 64;
+            expect (manager.setAudioDeviceSetup (setup, true).isEmpty());
+
+            auto* device = dynamic_cast<VirtualAudioIODevice*> (manager.getCurrentAudioDevice());
+            expect (device != nullptr);
+
+            const auto expectOutput = [&] (float expected)
+            {
+                // The block that was in progress when the callbacks changed may still be
+                // captured, so wait until it has definitely finished
+                const auto numSamplesAtStart = device->getNumSamplesProcessed();
+
+                while (device->getNumSamplesProcessed() < numSamplesAtStart + 2 * setup.bufferSize)
+                    Thread::yield();
+
+                device->clearCapturedOutput();
+
+                for (auto i = 0; i < 5000 && device->getCapturedOutput().getNumSamples() < options.maxNumOutputSamplesToCapture; ++i)
+                    Thread::sleep (1);
+
+                const auto output = device->getCapturedOutput();
+                expectEquals (output.getNumSamples(), options.maxNumOutputSamplesToCapture);
+
+                for (auto channel = 0; channel < output.getNumChannels(); ++channel)
+                    expect (output.findMinMax (channel, 0, output.getNumSamples()) == Range<float> (expected, expected));
+            };
+
+            ConstantCallback a (1.0f), b (2.0f), c (4.0f);
+
+            for (const auto numThreads : { 0, 2 })
+            {
+                manager.setNumParallelCallbackThreads (numThreads);
+                expectEquals (manager.getNumParallelCallbackThreads(), numThreads);
+
+                manager.addAudioCallback (&a);
+                manager.addAudioCallback (&b);
+                manager.addAudioCallback (&c);
+                expectOutput (7.0f);
+
+                manager.removeAudioCallback (&b);
+                expectOutput (5.0f);
+
+                manager.addAudioCallback (&b);
+                expectOutput (7.0f);
+
+                manager.removeAudioCallback (&a);
+                manager.removeAudioCallback (&b);
+                manager.removeAudioCallback (&c);
+                expectOutput (0.0f);
+            }
+
+            expect (a.numCallbacks > 0 && b.numCallbacks > 0 && c.numCallbacks > 0);
+        }
     }
 
 private:
@@ -1911,6 +2252,10 @@ private:
         int getOutputLatencyInSamples() override { return 0; }
         int getInputLatencyInSamples() override { return 0; }
 
+        int getXRunCount() const noexcept override { return xruns; }
+
+        int xruns = 0;
+
     private:
         void restart (double newSr, int newBs) override
         {
@@ -1984,6 +2329,33 @@ private:
         ListenerList<Restartable> listeners;
     };
 
+    class ConstantCallback final : public AudioIODeviceCallback
+    {
+    public:
+        explicit ConstantCallback (float valueIn) : value (valueIn) {}
+
+        void audioDeviceIOCallbackWithContext (const float* const*,
+                                               int,
+                                               float* const* outputChannelData,
+                                               int numOutputChannels,
+                                               int numSamples,
+                                               const AudioIODeviceCallbackContext&) override
+        {
+            for (auto channel = 0; channel < numOutputChannels; ++channel)
+                std::fill (outputChannelData[channel], outputChannelData[channel] + numSamples, value);
+
+            ++numCallbacks;
+        }
+
+        void audioDeviceAboutToStart (AudioIODevice*) override {}
+        void audioDeviceStopped() override {}
+
+        std::atomic<int> numCallbacks { 0 };
+
+    private:
+        const float value;
+    };
+
     class MockCallback final : public AudioIODeviceCallback
     {
     public:
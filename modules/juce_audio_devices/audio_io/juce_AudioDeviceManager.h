@@ -304,6 +304,9 @@ public:
         If necessary, this method will invoke audioDeviceAboutToStart() on the callback
         object before returning.
 
+        Adding or removing a callback never blocks the audio thread. The audio thread
+        switches to the new list of callbacks at the start of its next callback.
+
         To remove a callback, use removeAudioCallback().
     */
     void addAudioCallback (AudioIODeviceCallback* newCallback);
@@ -311,12 +314,34 @@ public:
     /** Deregisters a previously added callback.
 
         If necessary, this method will invoke audioDeviceStopped() on the callback
-        object before returning.
+        object before returning. Once this method has returned, the callback won't be
+        called by the audio thread again, so it's safe to delete it.
+
+        This mustn't be called from inside one of the audio callbacks.
 
         @see addAudioCallback
     */
     void removeAudioCallback (AudioIODeviceCallback* callback);
 
+    /** Sets the number of worker threads that are used to run the audio callbacks in
+        parallel.
+
+        By default, the callbacks that were registered with addAudioCallback() are called
+        one after the other on the audio device's thread. If this is greater than zero,
+        the callbacks are shared between the device's thread and up to this many workers
+        from RealtimeThreadPool::getSharedInstance(). Each callback still renders into its
+        own buffer, and their outputs are summed in the same order as they would be otherwise.
+
+        Only use this if your callbacks don't depend on each other, because different
+        callbacks may be called at the same time on different threads.
+
+        This must be called from the message thread.
+    */
+    void setNumParallelCallbackThreads (int numThreads);
+
+    /** Returns the number of worker threads set by setNumParallelCallbackThreads(). */
+    int getNumParallelCallbackThreads() const noexcept      { return numParallelCallbackThreads; }
+
     //==============================================================================
     /** Returns the average proportion of available CPU being spent inside the audio callbacks.
         @returns  A value between 0 and 1.0 to indicate the approximate proportion of CPU
@@ -485,6 +510,48 @@ public:
     */
     int getXRunCount() const noexcept;
 
+    /** Statistics about the timing of the audio callbacks.
+
+        @see getCallbackStatistics
+    */
+    struct CallbackStatistics
+    {
+        /** The durations of the callbacks since the device was started, relative to the
+            duration of the audio that each callback processed.
+        */
+        AudioProcessLoadMeasurer::Histogram callbackDurations;
+
+        /** The number of callbacks that took longer than the audio that they processed. */
+        int numSlowCallbacks = 0;
+
+        /** The number of xruns reported by the device, or -1 if the device doesn't report
+            its xruns.
+        */
+        int numDeviceXRuns = -1;
+    };
+
+    /** Returns statistics about the timing of the audio callbacks.
+
+        The histogram is recorded on the audio thread without locking, so this can be
+        called as often as you like, e.g. from a timer that updates a display.
+
+        This must only be called from the message thread, because it asks the current
+        device for its xrun count, and the device can only be changed on that thread.
+    */
+    CallbackStatistics getCallbackStatistics() const;
+
+    /** Returns the xruns that have happened since this was last called.
+
+        This includes any callbacks that took longer than the audio that they processed,
+        and any new xruns that the device has reported, such as those counted by the ALSA
+        and JACK devices. Xruns reported by the device are found by polling its
+        AudioIODevice::getXRunCount() method, so their time is the time at which they
+        were noticed by this method.
+
+        This must only be called from the message thread.
+    */
+    std::vector<AudioProcessLoadMeasurer::OverrunEvent> popOverrunEvents();
+
     //==============================================================================
     /** @cond */
     [[deprecated ("Use setMidiInputDeviceEnabled instead.")]]
@@ -508,12 +575,10 @@ private:
 
     AudioDeviceSetup currentSetup;
     std::unique_ptr<AudioIODevice> currentAudioDevice;
-    Array<AudioIODeviceCallback*> callbacks;
     int numInputChansNeeded = 0, numOutputChansNeeded = 2;
     String preferredDeviceName, currentDeviceType;
     std::unique_ptr<XmlElement> lastExplicitSettings;
     mutable bool listNeedsScanning = true;
-    AudioBuffer<float> tempBuffer;
     MidiDeviceListConnection midiDeviceListConnection = MidiDeviceListConnection::make ([this]
     {
         midiDeviceListChanged();
@@ -537,10 +602,31 @@ private:
     int testSoundPosition = 0;
 
     AudioProcessLoadMeasurer loadMeasurer;
+    AudioIODevice* lastPolledXRunDevice = nullptr;
+    int lastPolledDeviceXRunCount = 0;
 
     LevelMeter::Ptr inputLevelGetter   { new LevelMeter() },
                     outputLevelGetter  { new LevelMeter() };
 
+    //==============================================================================
+    class CallbackList;
+
+    // The callbacks array and everything below it are only modified while holding the
+    // callbackListLock. The audio thread never takes that lock, and only ever sees the
+    // immutable CallbackList that was most recently published.
+    CriticalSection callbackListLock;
+    Array<AudioIODeviceCallback*> callbacks;
+    std::unique_ptr<CallbackList> currentCallbackList;
+    std::vector<std::unique_ptr<CallbackList>> retiredCallbackLists;
+    std::shared_ptr<RealtimeThreadPool> callbackThreadPool;
+    int numParallelCallbackThreads = 0, preparedNumOutputChannels = 0, preparedBufferSize = 0;
+
+    std::atomic<CallbackList*> audioThreadCallbackList { nullptr };
+    std::atomic<uint32> audioCallbackEpoch { 0 };
+    std::atomic<Thread::ThreadID> audioCallbackThreadID { nullptr };
+
+    void publishCallbackList();
+
     //==============================================================================
     class CallbackHandler;
     std::unique_ptr<CallbackHandler> callbackHandler;
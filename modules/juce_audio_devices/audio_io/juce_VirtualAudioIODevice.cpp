@@ -0,0 +1,494 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static StringArray getVirtualChannelNames (const String& prefix, int numChannels)
+{
+    StringArray names;
+
+    for (int i = 0; i < numChannels; ++i)
+        names.add (prefix + " " + String (i + 1));
+
+    return names;
+}
+
+static BigInteger limitToNumChannels (BigInteger channels, int numChannels)
+{
+    channels.setRange (numChannels, jmax (0, channels.getHighestBit() + 1 - numChannels), false);
+    return channels;
+}
+
+//==============================================================================
+VirtualAudioIODevice::VirtualAudioIODevice (const Options& o)
+    : AudioIODevice (o.name, VirtualAudioIODeviceType::defaultTypeName),
+      Thread (SystemStats::getJUCEVersion() + ": Virtual Audio Device"),
+      options (o)
+{
+}
+
+VirtualAudioIODevice::~VirtualAudioIODevice()
+{
+    close();
+}
+
+StringArray VirtualAudioIODevice::getOutputChannelNames()
+{
+    return getVirtualChannelNames ("Output", options.numOutputChannels);
+}
+
+StringArray VirtualAudioIODevice::getInputChannelNames()
+{
+    return getVirtualChannelNames ("Input", options.numInputChannels);
+}
+
+String VirtualAudioIODevice::open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                                   double sampleRate, int bufferSizeSamples)
+{
+    close();
+
+    lastError.clear();
+    currentSampleRate = sampleRate > 0.0 ? sampleRate : options.sampleRates[0];
+    currentBufferSize = bufferSizeSamples > 0 ? bufferSizeSamples : options.defaultBufferSize;
+
+    if (currentSampleRate <= 0.0 || currentBufferSize <= 0)
+    {
+        lastError = "Invalid sample rate or buffer size";
+        return lastError;
+    }
+
+    activeInputChannels  = limitToNumChannels (inputChannels,  options.numInputChannels);
+    activeOutputChannels = limitToNumChannels (outputChannels, options.numOutputChannels);
+
+    const auto numIns  = activeInputChannels.countNumberOfSetBits();
+    const auto numOuts = activeOutputChannels.countNumberOfSetBits();
+
+    inputBuffer.setSize (numIns, currentBufferSize);
+    inputBuffer.clear();
+    outputBuffer.setSize (numOuts, currentBufferSize);
+    outputBuffer.clear();
+
+    inputPointers.clear();
+    outputPointers.clear();
+
+    for (int i = 0; i < numIns; ++i)
+        inputPointers.push_back (inputBuffer.getReadPointer (i));
+
+    for (int i = 0; i < numOuts; ++i)
+        outputPointers.push_back (outputBuffer.getWritePointer (i));
+
+    capturedOutput.setSize (numOuts, jmax (0, options.maxNumOutputSamplesToCapture));
+    numSamplesCaptured = 0;
+    clearCaptureRequested = false;
+
+    if (options.inputSource != nullptr)
+        options.inputSource->prepareToPlay (currentBufferSize, currentSampleRate);
+
+    deviceIsOpen = true;
+    return {};
+}
+
+void VirtualAudioIODevice::close()
+{
+    stop();
+
+    if (deviceIsOpen && options.inputSource != nullptr)
+        options.inputSource->releaseResources();
+
+    deviceIsOpen = false;
+}
+
+void VirtualAudioIODevice::start (AudioIODeviceCallback* newCallback)
+{
+    stop();
+
+    if (! deviceIsOpen || newCallback == nullptr)
+        return;
+
+    newCallback->audioDeviceAboutToStart (this);
+
+    {
+        const ScopedLock sl (callbackLock);
+        callback = newCallback;
+    }
+
+    numSamplesProcessed = 0;
+    startThread (options.timing == Timing::realtime ? Priority::highest : Priority::normal);
+}
+
+void VirtualAudioIODevice::stop()
+{
+    stopThread (4000);
+
+    AudioIODeviceCallback* lastCallback = nullptr;
+
+    {
+        const ScopedLock sl (callbackLock);
+        lastCallback = std::exchange (callback, nullptr);
+    }
+
+    if (lastCallback != nullptr)
+        lastCallback->audioDeviceStopped();
+}
+
+//==============================================================================
+AudioBuffer<float> VirtualAudioIODevice::getCapturedOutput() const
+{
+    const auto numSamples = clearCaptureRequested.load() ? 0 : numSamplesCaptured.load (std::memory_order_acquire);
+
+    AudioBuffer<float> result (capturedOutput.getNumChannels(), numSamples);
+
+    for (int i = 0; i < result.getNumChannels(); ++i)
+        result.copyFrom (i, 0, capturedOutput, i, 0, numSamples);
+
+    return result;
+}
+
+void VirtualAudioIODevice::clearCapturedOutput()
+{
+    // The recording belongs to the device's thread while it's running, so it's asked to
+    // start again rather than being reset from here
+    if (isThreadRunning())
+        clearCaptureRequested = true;
+    else
+        numSamplesCaptured = 0;
+}
+
+//==============================================================================
+void VirtualAudioIODevice::run()
+{
+    const auto ticksPerSecond = (double) Time::getHighResolutionTicksPerSecond();
+    const auto ticksPerBlock = ticksPerSecond * currentBufferSize / currentSampleRate;
+
+    auto startTicks = Time::getHighResolutionTicks();
+    int64 numBlocksSinceStart = 0;
+
+    while (! threadShouldExit())
+    {
+        if (options.timing == Timing::freeRunning)
+        {
+            // Free-running devices use the sample position as their clock, so that runs are repeatable
+            processNextBlock ((uint64_t) ((double) numSamplesProcessed.load() * 1.0e9 / currentSampleRate));
+            continue;
+        }
+
+        const auto deadline = startTicks + (int64) ((double) numBlocksSinceStart * ticksPerBlock);
+        auto now = Time::getHighResolutionTicks();
+
+        if ((double) (now - deadline) > ticksPerBlock)
+        {
+            // The callback took so long that a real device would have glitched
+            ++xrunCount;
+            startTicks = now;
+            numBlocksSinceStart = 0;
+        }
+        else
+        {
+            for (;;)
+            {
+                const auto msToWait = (int) ((double) (deadline - now) * 1000.0 / ticksPerSecond);
+
+                if (msToWait > 1)
+                    wait (msToWait - 1);
+                else if (deadline > now)
+                    Thread::yield();
+                else
+                    break;
+
+                if (threadShouldExit())
+                    return;
+
+                now = Time::getHighResolutionTicks();
+            }
+        }
+
+        processNextBlock ((uint64_t) (Time::highResolutionTicksToSeconds (now) * 1.0e9));
+        ++numBlocksSinceStart;
+    }
+}
+
+void VirtualAudioIODevice::processNextBlock (uint64_t hostTimeNs)
+{
+    const auto numSamples = currentBufferSize;
+
+    if (options.inputSource != nullptr && inputBuffer.getNumChannels() > 0)
+        options.inputSource->getNextAudioBlock (AudioSourceChannelInfo (&inputBuffer, 0, numSamples));
+
+    {
+        const ScopedLock sl (callbackLock);
+
+        if (callback != nullptr)
+        {
+            AudioIODeviceCallbackContext context;
+            context.hostTimeNs = &hostTimeNs;
+
+            callback->audioDeviceIOCallbackWithContext (inputPointers.data(), (int) inputPointers.size(),
+                                                        outputPointers.data(), (int) outputPointers.size(),
+                                                        numSamples, context);
+        }
+        else
+        {
+            outputBuffer.clear();
+        }
+    }
+
+    if (clearCaptureRequested.exchange (false))
+        numSamplesCaptured.store (0, std::memory_order_relaxed);
+
+    const auto numCaptured = numSamplesCaptured.load (std::memory_order_relaxed);
+    const auto numToCapture = jmin (numSamples, capturedOutput.getNumSamples() - numCaptured);
+
+    if (numToCapture > 0)
+    {
+        for (int i = 0; i < capturedOutput.getNumChannels(); ++i)
+            capturedOutput.copyFrom (i, numCaptured, outputBuffer, i, 0, numToCapture);
+
+        numSamplesCaptured.store (numCaptured + numToCapture, std::memory_order_release);
+    }
+
+    numSamplesProcessed += numSamples;
+}
+
+//==============================================================================
+VirtualAudioIODeviceType::VirtualAudioIODeviceType (const String& name)
+    : AudioIODeviceType (name)
+{
+}
+
+VirtualAudioIODeviceType::~VirtualAudioIODeviceType() = default;
+
+void VirtualAudioIODeviceType::addDevice (const VirtualAudioIODevice::Options& options)
+{
+    const auto iter = std::find_if (devices.begin(), devices.end(), [&] (const auto& d) { return d.name == options.name; });
+
+    if (iter != devices.end())
+        *iter = options;
+    else
+        devices.push_back (options);
+
+    callDeviceChangeListeners();
+}
+
+void VirtualAudioIODeviceType::removeDevice (const String& deviceName)
+{
+    devices.erase (std::remove_if (devices.begin(), devices.end(), [&] (const auto& d) { return d.name == deviceName; }),
+                   devices.end());
+
+    callDeviceChangeListeners();
+}
+
+StringArray VirtualAudioIODeviceType::getDeviceNames (bool wantInputNames) const
+{
+    StringArray names;
+
+    for (const auto& d : devices)
+        if ((wantInputNames ? d.numInputChannels : d.numOutputChannels) > 0)
+            names.add (d.name);
+
+    return names;
+}
+
+int VirtualAudioIODeviceType::getDefaultDeviceIndex (bool) const
+{
+    return 0;
+}
+
+int VirtualAudioIODeviceType::getIndexOfDevice (AudioIODevice* device, bool asInput) const
+{
+    if (auto* d = dynamic_cast<VirtualAudioIODevice*> (device))
+        return getDeviceNames (asInput).indexOf (d->getName());
+
+    return -1;
+}
+
+AudioIODevice* VirtualAudioIODeviceType::createDevice (const String& outputDeviceName, const String& inputDeviceName)
+{
+    const auto& name = outputDeviceName.isNotEmpty() ? outputDeviceName : inputDeviceName;
+
+    for (const auto& d : devices)
+        if (d.name == name)
+            return new VirtualAudioIODevice (d);
+
+    return nullptr;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class VirtualAudioIODeviceTests final : public UnitTest
+{
+public:
+    VirtualAudioIODeviceTests()
+        : UnitTest ("VirtualAudioIODevice", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI libraryInitialiser;
+
+        beginTest ("A free-running device passes its input source through the callback and records the output");
+        {
+            auto options = getOptions (VirtualAudioIODevice::Timing::freeRunning);
+            options.maxNumOutputSamplesToCapture = 1000;
+
+            VirtualAudioIODevice device (options);
+            expect (device.open (1, 1, 48000.0, 64).isEmpty());
+
+            InvertingCallback callback;
+            device.start (&callback);
+
+            while (device.getNumSamplesProcessed() < 2000)
+                Thread::yield();
+
+            device.stop();
+
+            expect (callback.wasStarted && callback.wasStopped);
+            expect (device.getNumSamplesProcessed() % 64 == 0);
+
+            const auto captured = device.getCapturedOutput();
+            expectEquals (captured.getNumSamples(), 1000);
+            expect (isInvertedRamp (captured));
+
+            device.clearCapturedOutput();
+            expectEquals (device.getCapturedOutput().getNumSamples(), 0);
+        }
+
+        beginTest ("A realtime device doesn't call back faster than a real device would");
+        {
+            VirtualAudioIODevice device (getOptions (VirtualAudioIODevice::Timing::realtime));
+            expect (device.open (1, 1, 44100.0, 441).isEmpty());
+
+            InvertingCallback callback;
+            const auto startTime = Time::getMillisecondCounterHiRes();
+            device.start (&callback);
+            Thread::sleep (100);
+            device.stop();
+            const auto elapsedSeconds = (Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+            expect (device.getNumSamplesProcessed() > 0);
+            expect ((double) device.getNumSamplesProcessed() <= (elapsedSeconds + 0.01) * 44100.0 + 441.0);
+        }
+
+        beginTest ("Devices can be opened through an AudioDeviceManager");
+        {
+            auto options = getOptions (VirtualAudioIODevice::Timing::freeRunning);
+            options.maxNumOutputSamplesToCapture = 256;
+
+            auto type = std::make_unique<VirtualAudioIODeviceType>();
+            type->addDevice (options);
+            expect (type->getDeviceNames (false) == StringArray { options.name });
+
+            AudioDeviceManager manager;
+            manager.addAudioDeviceType (std::move (type));
+            manager.setCurrentAudioDeviceType (VirtualAudioIODeviceType::defaultTypeName, false);
+
+            InvertingCallback callback;
+            manager.addAudioCallback (&callback);
+            AudioDeviceManager::AudioDeviceSetup setup;
+            setup.outputDeviceName = setup.inputDeviceName = options.name;
+            expect (manager.initialise (1, 1, nullptr, false, {}, &setup).isEmpty());
+
+            auto* device = dynamic_cast<VirtualAudioIODevice*> (manager.getCurrentAudioDevice());
+            expect (device != nullptr);
+
+            if (device != nullptr)
+            {
+                while (device->getCapturedOutput().getNumSamples() < 256)
+                    Thread::yield();
+
+                expect (isInvertedRamp (device->getCapturedOutput()));
+            }
+
+            manager.closeAudioDevice();
+            manager.removeAudioCallback (&callback);
+        }
+    }
+
+private:
+    static VirtualAudioIODevice::Options getOptions (VirtualAudioIODevice::Timing timing)
+    {
+        VirtualAudioIODevice::Options options;
+        options.numInputChannels = 1;
+        options.numOutputChannels = 1;
+        options.timing = timing;
+        options.inputSource = std::make_shared<RampSource>();
+        return options;
+    }
+
+    static bool isInvertedRamp (const AudioBuffer<float>& buffer)
+    {
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            if (! exactlyEqual (buffer.getSample (0, i), -(float) i))
+                return false;
+
+        return true;
+    }
+
+    struct RampSource final : public AudioSource
+    {
+        void prepareToPlay (int, double) override       { position = 0; }
+        void releaseResources() override                {}
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            for (int i = 0; i < info.numSamples; ++i)
+                info.buffer->setSample (0, info.startSample + i, (float) position++);
+        }
+
+        int position = 0;
+    };
+
+    struct InvertingCallback final : public AudioIODeviceCallback
+    {
+        void audioDeviceIOCallbackWithContext (const float* const* ins, int numIns,
+                                               float* const* outs, int numOuts,
+                                               int numSamples, const AudioIODeviceCallbackContext&) override
+        {
+            if (numIns > 0 && numOuts > 0)
+                FloatVectorOperations::negate (outs[0], ins[0], numSamples);
+        }
+
+        void audioDeviceAboutToStart (AudioIODevice*) override   { wasStarted = true; }
+        void audioDeviceStopped() override                       { wasStopped = true; }
+
+        bool wasStarted = false, wasStopped = false;
+    };
+};
+
+static VirtualAudioIODeviceTests virtualAudioIODeviceTests;
+
+#endif
+
+} // namespace juce
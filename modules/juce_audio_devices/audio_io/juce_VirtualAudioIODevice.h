@@ -0,0 +1,267 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An audio device that isn't connected to any hardware.
+
+    A virtual device runs its own thread, which calls the AudioIODeviceCallback in the
+    same way as a real device would. This makes it possible to run an AudioDeviceManager,
+    and everything connected to it, on machines that don't have a sound card.
+
+    The device's input channels are filled from an AudioSource, which could be an
+    AudioFormatReaderSource that plays a file, or a ToneGeneratorAudioSource. The audio
+    that the callback writes to the output channels can be recorded into memory and
+    retrieved with getCapturedOutput().
+
+    Devices are usually created by a VirtualAudioIODeviceType that has been added to
+    an AudioDeviceManager.
+
+    @see VirtualAudioIODeviceType
+
+    @tags{Audio}
+*/
+class JUCE_API  VirtualAudioIODevice  : public AudioIODevice,
+                                        private Thread
+{
+public:
+    //==============================================================================
+    /** Determines how quickly a virtual device calls its callback. */
+    enum class Timing
+    {
+        realtime,   /**< Each callback happens when a real device's would, based on the sample rate and buffer size. */
+        freeRunning /**< The next callback happens as soon as the previous one has returned. */
+    };
+
+    /** Describes a virtual device. */
+    struct Options
+    {
+        /** The device's name. */
+        String name = "Virtual Audio Device";
+
+        /** The number of input channels that the device has. */
+        int numInputChannels = 2;
+
+        /** The number of output channels that the device has. */
+        int numOutputChannels = 2;
+
+        /** The sample rates that the device can be opened with. */
+        Array<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0 };
+
+        /** The buffer sizes that the device can be opened with. */
+        Array<int> bufferSizes { 16, 32, 64, 128, 256, 512, 1024, 2048 };
+
+        /** The buffer size that's used if none is specified when the device is opened. */
+        int defaultBufferSize = 512;
+
+        /** Whether the device's callbacks are paced by the clock, or happen as fast as possible. */
+        Timing timing = Timing::realtime;
+
+        /** A source that's used to fill the input channels, or nullptr to leave them silent.
+
+            The source will be prepared when the device is opened, and then called from the
+            device's thread. It's shared, so that it can outlive any device that uses it,
+            but it shouldn't be used by more than one device at once.
+        */
+        std::shared_ptr<AudioSource> inputSource;
+
+        /** The maximum number of samples of output to record, or 0 to not record the output.
+            The memory for the recording is allocated when the device is opened.
+        */
+        int maxNumOutputSamplesToCapture = 0;
+    };
+
+    //==============================================================================
+    /** Creates a device. */
+    explicit VirtualAudioIODevice (const Options& options);
+
+    /** Destructor. */
+    ~VirtualAudioIODevice() override;
+
+    //==============================================================================
+    /** Returns the options that the device was created with. */
+    const Options& getOptions() const noexcept                      { return options; }
+
+    /** Returns the number of samples that have been passed to the callback since the
+        device was started.
+    */
+    int64 getNumSamplesProcessed() const noexcept                   { return numSamplesProcessed.load(); }
+
+    /** Returns a copy of the output that has been recorded since the device was opened.
+
+        This can be called while the device is running, in which case it returns the output
+        that has been recorded so far. Recording stops when the buffer is full.
+    */
+    AudioBuffer<float> getCapturedOutput() const;
+
+    /** Throws away the output that has been recorded, so that recording starts again. */
+    void clearCapturedOutput();
+
+    //==============================================================================
+    /** @internal */
+    StringArray getOutputChannelNames() override;
+    /** @internal */
+    StringArray getInputChannelNames() override;
+    /** @internal */
+    Array<double> getAvailableSampleRates() override                { return options.sampleRates; }
+    /** @internal */
+    Array<int> getAvailableBufferSizes() override                   { return options.bufferSizes; }
+    /** @internal */
+    int getDefaultBufferSize() override                             { return options.defaultBufferSize; }
+    /** @internal */
+    String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                 double sampleRate, int bufferSizeSamples) override;
+    /** @internal */
+    void close() override;
+    /** @internal */
+    bool isOpen() override                                          { return deviceIsOpen; }
+    /** @internal */
+    void start (AudioIODeviceCallback*) override;
+    /** @internal */
+    void stop() override;
+    /** @internal */
+    bool isPlaying() override                                       { return isThreadRunning(); }
+    /** @internal */
+    String getLastError() override                                  { return lastError; }
+    /** @internal */
+    int getCurrentBufferSizeSamples() override                      { return currentBufferSize; }
+    /** @internal */
+    double getCurrentSampleRate() override                          { return currentSampleRate; }
+    /** @internal */
+    int getCurrentBitDepth() override                               { return 32; }
+    /** @internal */
+    BigInteger getActiveOutputChannels() const override             { return activeOutputChannels; }
+    /** @internal */
+    BigInteger getActiveInputChannels() const override              { return activeInputChannels; }
+    /** @internal */
+    int getOutputLatencyInSamples() override                        { return 0; }
+    /** @internal */
+    int getInputLatencyInSamples() override                         { return 0; }
+    /** @internal */
+    int getXRunCount() const noexcept override                      { return xrunCount.load(); }
+
+private:
+    //==============================================================================
+    void run() override;
+    void processNextBlock (uint64_t hostTimeNs);
+
+    Options options;
+    String lastError;
+    bool deviceIsOpen = false;
+    double currentSampleRate = 0.0;
+    int currentBufferSize = 0;
+    BigInteger activeInputChannels, activeOutputChannels;
+
+    AudioBuffer<float> inputBuffer, outputBuffer, capturedOutput;
+    std::vector<const float*> inputPointers;
+    std::vector<float*> outputPointers;
+    std::atomic<int> numSamplesCaptured { 0 };
+    std::atomic<bool> clearCaptureRequested { false };
+    std::atomic<int64> numSamplesProcessed { 0 };
+    std::atomic<int> xrunCount { 0 };
+
+    CriticalSection callbackLock;
+    AudioIODeviceCallback* callback = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VirtualAudioIODevice)
+};
+
+//==============================================================================
+/**
+    An AudioIODeviceType that creates VirtualAudioIODevice objects.
+
+    None of the standard device types are virtual, so to use a virtual device, add a
+    VirtualAudioIODeviceType to your AudioDeviceManager:
+
+    @code
+    VirtualAudioIODevice::Options options;
+    options.timing = VirtualAudioIODevice::Timing::freeRunning;
+    options.inputSource = std::make_shared<ToneGeneratorAudioSource>();
+
+    auto type = std::make_unique<VirtualAudioIODeviceType>();
+    type->addDevice (options);
+
+    deviceManager.addAudioDeviceType (std::move (type));
+    deviceManager.setCurrentAudioDeviceType (VirtualAudioIODeviceType::defaultTypeName, true);
+    @endcode
+
+    @see VirtualAudioIODevice
+
+    @tags{Audio}
+*/
+class JUCE_API  VirtualAudioIODeviceType  : public AudioIODeviceType
+{
+public:
+    //==============================================================================
+    /** The name that's given to the device type if no other name is specified. */
+    static constexpr const char* defaultTypeName = "Virtual";
+
+    /** Creates a device type with no devices. */
+    explicit VirtualAudioIODeviceType (const String& name = defaultTypeName);
+
+    /** Destructor. */
+    ~VirtualAudioIODeviceType() override;
+
+    //==============================================================================
+    /** Adds a device, or replaces an existing one with the same name. */
+    void addDevice (const VirtualAudioIODevice::Options& options);
+
+    /** Removes the device with the given name. */
+    void removeDevice (const String& deviceName);
+
+    //==============================================================================
+    /** @internal */
+    void scanForDevices() override {}
+    /** @internal */
+    StringArray getDeviceNames (bool wantInputNames) const override;
+    /** @internal */
+    int getDefaultDeviceIndex (bool forInput) const override;
+    /** @internal */
+    int getIndexOfDevice (AudioIODevice* device, bool asInput) const override;
+    /** @internal */
+    bool hasSeparateInputsAndOutputs() const override               { return false; }
+    /** @internal */
+    AudioIODevice* createDevice (const String& outputDeviceName, const String& inputDeviceName) override;
+
+private:
+    //==============================================================================
+    std::vector<VirtualAudioIODevice::Options> devices;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VirtualAudioIODeviceType)
+};
+
+} // namespace juce
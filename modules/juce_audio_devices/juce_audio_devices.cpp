@@ -250,7 +250,9 @@ namespace juce
 #include "audio_io/juce_AudioDeviceManager.cpp"
 #include "audio_io/juce_AudioIODevice.cpp"
 #include "audio_io/juce_AudioIODeviceType.cpp"
+#include "audio_io/juce_VirtualAudioIODevice.cpp"
 #include "midi_io/juce_MidiMessageCollector.cpp"
+#include "midi_io/juce_MidiInputFifo.cpp"
 #include "sources/juce_AudioSourcePlayer.cpp"
 #include "sources/juce_AudioTransportSource.cpp"
 
@@ -169,6 +169,15 @@
  #define JUCE_ALSA 1
 #endif
 
+/** Config: JUCE_ALSA_MMAP
+    Makes ALSA devices convert samples directly into and out of the device's buffer using
+    mmap access, on devices that support it. If this is disabled, or a device doesn't
+    support mmap access, snd_pcm_readi/writei are used instead.
+*/
+#ifndef JUCE_ALSA_MMAP
+ #define JUCE_ALSA_MMAP 1
+#endif
+
 /** Config: JUCE_JACK
     Enables JACK audio devices.
 */
@@ -228,6 +237,7 @@
 #include "midi_io/ump/juce_UMPEndpoints.h"
 #include "midi_io/juce_MidiDevices.h"
 #include "midi_io/juce_MidiMessageCollector.h"
+#include "midi_io/juce_MidiInputFifo.h"
 
 namespace juce
 {
@@ -246,6 +256,7 @@ namespace juce
 
 #include "audio_io/juce_AudioIODevice.h"
 #include "audio_io/juce_AudioIODeviceType.h"
+#include "audio_io/juce_VirtualAudioIODevice.h"
 #include "audio_io/juce_SystemAudioVolume.h"
 #include "sources/juce_AudioSourcePlayer.h"
 #include "sources/juce_AudioTransportSource.h"
@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+MidiInputFifo::MidiInputFifo (int capacityInBytes)
+    : storage ((size_t) jmax (64, capacityInBytes) + 1),
+      wrappedMessage ((size_t) jmax (64, capacityInBytes)),
+      fifo (jmax (64, capacityInBytes) + 1)
+{
+}
+
+MidiInputFifo::~MidiInputFifo() = default;
+
+//==============================================================================
+void MidiInputFifo::reset (double newSampleRate)
+{
+    jassert (newSampleRate > 0);
+
+    const SpinLock::ScopedLockType sl (writerLock);
+    sampleRate = newSampleRate;
+    fifo.reset();
+}
+
+void MidiInputFifo::addMessageToQueue (const MidiMessage& message)
+{
+    const auto numBytes = message.getRawDataSize();
+
+    // The messages that come in here need to be timestamped correctly - see MidiInput
+    // for details of what the number should be.
+    jassert (! approximatelyEqual (message.getTimeStamp(), 0.0));
+
+    const Header header { message.getTimeStamp(), numBytes };
+    const auto totalSize = (int) sizeof (Header) + numBytes;
+
+    const SpinLock::ScopedLockType sl (writerLock);
+
+    if (fifo.getFreeSpace() < totalSize)
+    {
+        ++numDroppedMessages;
+        return;
+    }
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (totalSize, start1, size1, start2, size2);
+
+    copyToStorage (start1, &header, (int) sizeof (Header));
+    copyToStorage ((start1 + (int) sizeof (Header)) % fifo.getTotalSize(), message.getRawData(), numBytes);
+
+    fifo.finishedWrite (totalSize);
+}
+
+void MidiInputFifo::removeNextBlockOfMessages (MidiBuffer& destBuffer, int numSamples)
+{
+    jassert (numSamples > 0);
+
+    const auto timeNow = Time::getMillisecondCounterHiRes() * 0.001;
+    const auto rate = sampleRate.load();
+
+    // Only the messages that are already in the queue are removed, so that a stream of new
+    // messages can't keep the audio thread here
+    auto numReady = fifo.getNumReady();
+
+    while (numReady >= (int) sizeof (Header))
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (numReady, start1, size1, start2, size2);
+
+        Header header;
+        copyFromStorage (start1, &header, (int) sizeof (Header));
+
+        const auto dataStart = (start1 + (int) sizeof (Header)) % fifo.getTotalSize();
+        const auto totalSize = (int) sizeof (Header) + header.numBytes;
+        const auto position = jlimit (0, numSamples - 1, numSamples - roundToInt ((timeNow - header.timeStampSeconds) * rate));
+
+        if (dataStart + header.numBytes <= fifo.getTotalSize())
+        {
+            destBuffer.addEvent (storage + dataStart, header.numBytes, position);
+        }
+        else
+        {
+            // The message wraps around the end of the storage
+            copyFromStorage (dataStart, wrappedMessage, header.numBytes);
+            destBuffer.addEvent (wrappedMessage, header.numBytes, position);
+        }
+
+        fifo.finishedRead (totalSize);
+        numReady -= totalSize;
+    }
+}
+
+void MidiInputFifo::handleIncomingMidiMessage (MidiInput*, const MidiMessage& message)
+{
+    addMessageToQueue (message);
+}
+
+//==============================================================================
+void MidiInputFifo::copyToStorage (int index, const void* source, int numBytes) noexcept
+{
+    const auto firstPart = jmin (numBytes, fifo.getTotalSize() - index);
+    memcpy (storage + index, source, (size_t) firstPart);
+    memcpy (storage, static_cast<const uint8*> (source) + firstPart, (size_t) (numBytes - firstPart));
+}
+
+void MidiInputFifo::copyFromStorage (int index, void* dest, int numBytes) const noexcept
+{
+    const auto firstPart = jmin (numBytes, fifo.getTotalSize() - index);
+    memcpy (dest, storage + index, (size_t) firstPart);
+    memcpy (static_cast<uint8*> (dest) + firstPart, storage, (size_t) (numBytes - firstPart));
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiInputFifoTests final : public UnitTest
+{
+public:
+    MidiInputFifoTests()
+        : UnitTest ("MidiInputFifo", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        // At this sample rate, each sample lasts for a millisecond
+        constexpr auto sampleRate = 1000.0;
+        constexpr auto blockSize = 100;
+
+        const auto makeMessage = [] (int controllerValue, double secondsAgo)
+        {
+            return MidiMessage::controllerEvent (1, 1, controllerValue)
+                       .withTimeStamp (Time::getMillisecondCounterHiRes() * 0.001 - secondsAgo);
+        };
+
+        beginTest ("Messages are positioned according to their timestamps");
+        {
+            MidiInputFifo fifo;
+            fifo.reset (sampleRate);
+
+            fifo.addMessageToQueue (makeMessage (1, 10.0));
+            fifo.addMessageToQueue (makeMessage (2, 0.05));
+            fifo.addMessageToQueue (makeMessage (3, 0.0));
+
+            MidiBuffer buffer;
+            fifo.removeNextBlockOfMessages (buffer, blockSize);
+
+            std::vector<std::pair<int, int>> positions;
+
+            for (const auto metadata : buffer)
+                positions.emplace_back (metadata.getMessage().getControllerValue(), metadata.samplePosition);
+
+            expectEquals ((int) positions.size(), 3);
+            expectEquals (positions[0].first, 1);
+            expectEquals (positions[0].second, 0);
+            expectEquals (positions[1].first, 2);
+            expect (positions[1].second >= 45 && positions[1].second <= 50);
+            expectEquals (positions[2].first, 3);
+            expect (positions[2].second >= 95 && positions[2].second <= blockSize - 1);
+
+            buffer.clear();
+            fifo.removeNextBlockOfMessages (buffer, blockSize);
+            expect (buffer.isEmpty());
+        }
+
+        beginTest ("Long messages survive wrapping around the end of the storage");
+        {
+            MidiInputFifo fifo (200);
+            fifo.reset (sampleRate);
+
+            std::vector<uint8> sysexData (100);
+            std::iota (sysexData.begin(), sysexData.end(), (uint8) 0);
+
+            for (auto i = 0; i < 5; ++i)
+            {
+                auto message = MidiMessage::createSysExMessage (sysexData.data(), (int) sysexData.size());
+                message.setTimeStamp (Time::getMillisecondCounterHiRes() * 0.001);
+                fifo.addMessageToQueue (message);
+
+                MidiBuffer buffer;
+                fifo.removeNextBlockOfMessages (buffer, blockSize);
+
+                expectEquals (buffer.getNumEvents(), 1);
+
+                const auto received = (*buffer.begin()).getMessage();
+                expect (received.isSysEx());
+                expect (std::equal (sysexData.begin(), sysexData.end(), received.getSysExData()));
+            }
+
+            expectEquals (fifo.getNumDroppedMessages(), 0);
+        }
+
+        beginTest ("Messages are dropped when the queue is full");
+        {
+            MidiInputFifo fifo (256);
+            fifo.reset (sampleRate);
+
+            constexpr auto numMessages = 100;
+
+            for (auto i = 0; i < numMessages; ++i)
+                fifo.addMessageToQueue (makeMessage (i, 0.0));
+
+            MidiBuffer buffer;
+            fifo.removeNextBlockOfMessages (buffer, blockSize);
+
+            expect (fifo.getNumDroppedMessages() > 0);
+            expectEquals (buffer.getNumEvents() + fifo.getNumDroppedMessages(), numMessages);
+        }
+
+        beginTest ("Messages can be added from another thread while the queue is being read");
+        {
+            MidiInputFifo fifo;
+            fifo.reset (sampleRate);
+
+            constexpr auto numMessages = 10000;
+            std::atomic<bool> finished { false };
+
+            std::thread writer ([&]
+            {
+                for (auto i = 0; i < numMessages; ++i)
+                {
+                    auto message = MidiMessage::controllerEvent (1, (i / 128) % 128, i % 128);
+                    message.setTimeStamp (Time::getMillisecondCounterHiRes() * 0.001);
+                    fifo.addMessageToQueue (message);
+
+                    if (i % 64 == 0)
+                        std::this_thread::yield();
+                }
+
+                finished = true;
+            });
+
+            auto numReceived = 0;
+            auto lastIndex = -1;
+            auto inOrder = true;
+
+            for (;;)
+            {
+                const auto isFinished = finished.load();
+
+                MidiBuffer buffer;
+                fifo.removeNextBlockOfMessages (buffer, blockSize);
+
+                for (const auto metadata : buffer)
+                {
+                    const auto message = metadata.getMessage();
+                    const auto index = message.getControllerNumber() * 128 + message.getControllerValue();
+                    inOrder = inOrder && index > lastIndex;
+                    lastIndex = index;
+                    ++numReceived;
+                }
+
+                if (isFinished && buffer.isEmpty())
+                    break;
+            }
+
+            writer.join();
+
+            expect (inOrder);
+            expectEquals (numReceived + fifo.getNumDroppedMessages(), numMessages);
+        }
+    }
+};
+
+static MidiInputFifoTests midiInputFifoTests;
+
+#endif
+
+} // namespace juce
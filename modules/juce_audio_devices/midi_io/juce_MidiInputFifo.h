@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A lock-free queue that carries incoming MIDI messages to an audio callback.
+
+    Like a MidiMessageCollector, this can be used as a MidiInputCallback, and an audio
+    callback can then call removeNextBlockOfMessages() to receive the messages that
+    have arrived since its last block. The difference is that the audio thread never
+    waits for a lock, so a dense stream of controller messages can't hold it up, and
+    the input thread never allocates.
+
+    Each message is placed in the block according to its own timestamp, so it should
+    have been timestamped when it was received, as MidiInput does. On Linux, this
+    timestamp comes from the ALSA sequencer queue rather than the time at which the
+    message was delivered. The messages are delayed by one block, so that the spacing
+    between them is preserved.
+
+    @code
+    void audioDeviceAboutToStart (AudioIODevice* device) override
+    {
+        midiFifo.reset (device->getCurrentSampleRate());
+        midiBuffer.ensureSize (4096);
+    }
+
+    void audioDeviceIOCallbackWithContext (...) override
+    {
+        midiBuffer.clear();
+        midiFifo.removeNextBlockOfMessages (midiBuffer, numSamples);
+        ...
+    }
+    @endcode
+
+    @see MidiMessageCollector, MidiInput
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiInputFifo  : public MidiInputCallback
+{
+public:
+    //==============================================================================
+    /** Creates a queue that can hold the given number of bytes of messages.
+
+        Each message uses 16 bytes as well as its own size.
+    */
+    explicit MidiInputFifo (int capacityInBytes = 32768);
+
+    /** Destructor. */
+    ~MidiInputFifo() override;
+
+    //==============================================================================
+    /** Removes any messages from the queue, and sets the sample rate that's used to
+        position them in each block.
+
+        This must be called before starting to use the queue, and mustn't be called
+        at the same time as removeNextBlockOfMessages().
+    */
+    void reset (double sampleRate);
+
+    /** Adds a message to the queue.
+
+        This can be called from any number of threads. It will only wait for other
+        threads that are adding messages, and never for the audio thread. If the queue
+        is full, the message is discarded.
+    */
+    void addMessageToQueue (const MidiMessage& message);
+
+    /** Removes all of the messages that are waiting in the queue, and adds them to a
+        buffer at positions from 0 to numSamples - 1.
+
+        This should be called once per block by the audio callback, which must be the
+        only thread that calls it. It doesn't lock, and the destination buffer will only
+        allocate if it hasn't had enough space reserved with MidiBuffer::ensureSize().
+    */
+    void removeNextBlockOfMessages (MidiBuffer& destBuffer, int numSamples);
+
+    /** Returns the number of messages that have been discarded because the queue was full. */
+    int getNumDroppedMessages() const noexcept          { return numDroppedMessages.load(); }
+
+    //==============================================================================
+    /** @internal */
+    void handleIncomingMidiMessage (MidiInput*, const MidiMessage&) override;
+
+private:
+    //==============================================================================
+    struct Header
+    {
+        double timeStampSeconds;
+        int numBytes;
+    };
+
+    void copyToStorage (int index, const void* source, int numBytes) noexcept;
+    void copyFromStorage (int index, void* dest, int numBytes) const noexcept;
+
+    HeapBlock<uint8> storage, wrappedMessage;
+    AbstractFifo fifo;
+    SpinLock writerLock;
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<int> numDroppedMessages { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiInputFifo)
+};
+
+} // namespace juce
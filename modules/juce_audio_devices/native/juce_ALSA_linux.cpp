@@ -166,7 +166,8 @@ public:
           latency (0),
           deviceID (devID),
           isInput (forInput),
-          isInterleaved (true)
+          isInterleaved (true),
+          isMemoryMapped (false)
     {
         JUCE_ALSA_LOG ("snd_pcm_open (" << deviceID.toUTF8().getAddress() << ", forInput=" << (int) forInput << ")");
 
@@ -220,11 +221,7 @@ public:
             return false;
         }
 
-        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw
-            isInterleaved = true;
-        else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
-            isInterleaved = false;
-        else
+        if (! setAccess (hwParams))
         {
             jassertfalse;
             return false;
@@ -316,6 +313,9 @@ public:
 
         numChannelsRunning = numChannels;
 
+        if (isInterleaved && ! isMemoryMapped)
+            scratch.ensureSize ((size_t) ((int) sizeof (float) * bufferSize * numChannelsRunning), false);
+
         return true;
     }
 
@@ -326,6 +326,9 @@ public:
         float* const* const data = outputChannelBuffer.getArrayOfWritePointers();
         snd_pcm_sframes_t numDone = 0;
 
+        if (isMemoryMapped)
+            return writeToMappedBuffer (data, numSamples);
+
         if (isInterleaved)
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
@@ -363,6 +366,9 @@ public:
         jassert (numChannelsRunning <= inputChannelBuffer.getNumChannels());
         float* const* const data = inputChannelBuffer.getArrayOfWritePointers();
 
+        if (isMemoryMapped)
+            return readFromMappedBuffer (data, numSamples);
+
         if (isInterleaved)
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
@@ -413,13 +419,13 @@ public:
     snd_pcm_t* handle;
     String error;
     int bitDepth, numChannelsRunning, latency;
-    int underrunCount = 0, overrunCount = 0;
+    std::atomic<int> underrunCount { 0 }, overrunCount { 0 };
 
 private:
     //==============================================================================
     String deviceID;
     const bool isInput;
-    bool isInterleaved;
+    bool isInterleaved, isMemoryMapped;
     MemoryBlock scratch;
     std::unique_ptr<AudioData::Converter> converter;
 
@@ -478,6 +484,186 @@ private:
         return ConverterHelper <AudioData::Int32>::createConverter (forInput, isLittleEndian, numInterleavedChannels, interleaved);
     }
 
+    //==============================================================================
+    bool setAccess (snd_pcm_hw_params_t* hwParams)
+    {
+        struct AccessType
+        {
+            snd_pcm_access_t access;
+            bool interleaved, memoryMapped;
+        };
+
+        const AccessType accessTypes[] { { SND_PCM_ACCESS_MMAP_INTERLEAVED,    true,  true },
+                                         { SND_PCM_ACCESS_MMAP_NONINTERLEAVED, false, true },
+                                         { SND_PCM_ACCESS_RW_INTERLEAVED,      true,  false }, // works better for plughw
+                                         { SND_PCM_ACCESS_RW_NONINTERLEAVED,   false, false } };
+
+        for (const auto& type : accessTypes)
+        {
+           #if ! JUCE_ALSA_MMAP
+            if (type.memoryMapped)
+                continue;
+           #endif
+
+            if (snd_pcm_hw_params_set_access (handle, hwParams, type.access) >= 0)
+            {
+                JUCE_ALSA_LOG ("access: interleaved=" << (int) type.interleaved << ", mmap=" << (int) type.memoryMapped);
+                isInterleaved = type.interleaved;
+                isMemoryMapped = type.memoryMapped;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    //==============================================================================
+    /*  With mmap access, each channel's samples are converted straight into or out of the
+        device's ring buffer. An area describes where a channel lives in that buffer, and the
+        converter's stride already matches the layout, so the same code handles interleaved
+        and non-interleaved buffers.
+    */
+    static void* getAreaAddress (const snd_pcm_channel_area_t& area, snd_pcm_uframes_t offset) noexcept
+    {
+        return static_cast<char*> (area.addr) + (area.first + offset * area.step) / 8;
+    }
+
+    /*  Returns the number of frames that can be transferred, waiting for the device if
+        necessary, or a negative number if the stream couldn't be recovered after an xrun.
+    */
+    snd_pcm_sframes_t waitForMappedFrames (std::atomic<int>& xrunCount)
+    {
+        for (int attempt = 0; attempt < 2; ++attempt)
+        {
+            if (isInput && snd_pcm_state (handle) == SND_PCM_STATE_PREPARED)
+                if (JUCE_ALSA_FAILED (snd_pcm_start (handle)))
+                    return -1;
+
+            auto avail = snd_pcm_avail_update (handle);
+
+            if (avail == 0)
+            {
+                // A full playback buffer will never drain if the stream hasn't been started
+                if (! startPlaybackIfPrepared())
+                    return -1;
+
+                const auto waitResult = snd_pcm_wait (handle, 1000);
+                avail = waitResult < 0 ? waitResult : snd_pcm_avail_update (handle);
+            }
+
+            if (avail > 0)
+                return avail;
+
+            if (avail == 0)
+                return 0;
+
+            if (avail == -(EPIPE))
+                ++xrunCount;
+
+            if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, (int) avail, 1 /* silent */)))
+                return -1;
+        }
+
+        return 0;
+    }
+
+    bool writeToMappedBuffer (float* const* data, int numSamples)
+    {
+        for (int position = 0; position < numSamples;)
+        {
+            const auto avail = waitForMappedFrames (underrunCount);
+
+            if (avail < 0)
+                return false;
+
+            if (avail == 0)
+            {
+                JUCE_ALSA_LOG ("Did not write all samples: numDone: " << position << ", numSamples: " << numSamples);
+                return true;
+            }
+
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0;
+            auto frames = (snd_pcm_uframes_t) jmin ((snd_pcm_sframes_t) (numSamples - position), avail);
+
+            if (JUCE_ALSA_FAILED (snd_pcm_mmap_begin (handle, &areas, &offset, &frames)))
+                return false;
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+                converter->convertSamples (getAreaAddress (areas[i], offset), 0, data[i] + position, 0, (int) frames);
+
+            const auto committed = snd_pcm_mmap_commit (handle, offset, frames);
+
+            if (committed < 0 || (snd_pcm_uframes_t) committed != frames)
+            {
+                if (committed == -(EPIPE))
+                    ++underrunCount;
+
+                if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, committed < 0 ? (int) committed : -(EPIPE), 1 /* silent */)))
+                    return false;
+            }
+
+            position += (int) frames;
+        }
+
+        return startPlaybackIfPrepared();
+    }
+
+    /*  Committing frames to the mmap buffer doesn't start a playback stream in the way that
+        snd_pcm_writei() does once the start threshold is reached, so the stream has to be
+        started once the first period has been written, and again after recovering from an xrun.
+    */
+    bool startPlaybackIfPrepared()
+    {
+        if (isInput || snd_pcm_state (handle) != SND_PCM_STATE_PREPARED)
+            return true;
+
+        return ! JUCE_ALSA_FAILED (snd_pcm_start (handle));
+    }
+
+    bool readFromMappedBuffer (float* const* data, int numSamples)
+    {
+        for (int position = 0; position < numSamples;)
+        {
+            const auto avail = waitForMappedFrames (overrunCount);
+
+            if (avail <= 0)
+            {
+                JUCE_ALSA_LOG ("Did not read all samples: num: " << position << ", numSamples: " << numSamples);
+
+                for (int i = 0; i < numChannelsRunning; ++i)
+                    FloatVectorOperations::clear (data[i] + position, numSamples - position);
+
+                return avail == 0;
+            }
+
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0;
+            auto frames = (snd_pcm_uframes_t) jmin ((snd_pcm_sframes_t) (numSamples - position), avail);
+
+            if (JUCE_ALSA_FAILED (snd_pcm_mmap_begin (handle, &areas, &offset, &frames)))
+                return false;
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+                converter->convertSamples (data[i] + position, 0, getAreaAddress (areas[i], offset), 0, (int) frames);
+
+            const auto committed = snd_pcm_mmap_commit (handle, offset, frames);
+
+            if (committed < 0 || (snd_pcm_uframes_t) committed != frames)
+            {
+                if (committed == -(EPIPE))
+                    ++overrunCount;
+
+                if (JUCE_ALSA_FAILED (snd_pcm_recover (handle, committed < 0 ? (int) committed : -(EPIPE), 1 /* silent */)))
+                    return false;
+            }
+
+            position += (int) frames;
+        }
+
+        return true;
+    }
+
     //==============================================================================
     bool failed (const int errorNum)
     {
@@ -699,6 +885,9 @@ public:
 
                     auto avail = snd_pcm_avail_update (inputDevice->handle);
 
+                    if (avail == -(EPIPE))
+                        ++inputDevice->overrunCount;
+
                     if (avail < 0)
                         JUCE_ALSA_FAILED (snd_pcm_recover (inputDevice->handle, (int) avail, 0));
                 }
@@ -746,6 +935,9 @@ public:
 
                 auto avail = snd_pcm_avail_update (outputDevice->handle);
 
+                if (avail == -(EPIPE))
+                    ++outputDevice->underrunCount;
+
                 if (avail < 0)
                     JUCE_ALSA_FAILED (snd_pcm_recover (outputDevice->handle, (int) avail, 0));
 
@@ -1297,6 +1489,62 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ALSAAudioIODeviceType)
 };
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ALSADeviceTests final : public UnitTest
+{
+public:
+    ALSADeviceTests() : UnitTest ("ALSADevice", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        beginTest ("Playback starts once the first block has been written");
+        {
+            // The null plugin accepts any access type, so this uses mmap access when
+            // JUCE_ALSA_MMAP is enabled
+            ALSADevice device ("null", false);
+            expect (device.error.isEmpty());
+            expect (device.setParameters (44100, 2, blockSize));
+
+            AudioBuffer<float> buffer (2, blockSize);
+            buffer.clear();
+
+            expect (snd_pcm_state (device.handle) == SND_PCM_STATE_PREPARED);
+            expect (device.writeToOutputDevice (buffer, blockSize));
+            expect (snd_pcm_state (device.handle) == SND_PCM_STATE_RUNNING);
+
+            for (int i = 0; i < 16; ++i)
+                expect (device.writeToOutputDevice (buffer, blockSize));
+
+            expect (snd_pcm_state (device.handle) == SND_PCM_STATE_RUNNING);
+        }
+
+        beginTest ("Playback restarts after an underrun");
+        {
+            ALSADevice device ("null", false);
+            expect (device.setParameters (44100, 2, blockSize));
+
+            AudioBuffer<float> buffer (2, blockSize);
+            buffer.clear();
+
+            expect (device.writeToOutputDevice (buffer, blockSize));
+            expect (snd_pcm_drop (device.handle) == 0);
+            expect (snd_pcm_prepare (device.handle) == 0);
+
+            expect (device.writeToOutputDevice (buffer, blockSize));
+            expect (snd_pcm_state (device.handle) == SND_PCM_STATE_RUNNING);
+        }
+    }
+
+private:
+    static constexpr int blockSize = 256;
+};
+
+static ALSADeviceTests alsaDeviceTests;
+
+#endif
+
 }
 
 //==============================================================================
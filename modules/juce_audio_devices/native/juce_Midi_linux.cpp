@@ -105,7 +105,7 @@ struct AlsaMidiHelpers
             // We asked for wallclock timestamps - if the incoming event doesn't comply, then
             // we'll have to approximate a timestamp ourselves.
             if (snd_seq_ev_is_direct (ev) || ! snd_seq_ev_is_real (ev))
-                return Time::getMillisecondCounter() * 0.001;
+                return Time::getMillisecondCounterHiRes() * 0.001;
 
             const auto nativeTime = ev->time.time;
             const auto initialNanos = (double) startTimeNative.tv_sec * 1e9 + (double) startTimeNative.tv_nsec;
@@ -116,9 +116,9 @@ struct AlsaMidiHelpers
             // Perhaps this could happen if creating the queue failed, or if the event timestamp isn't
             // populated for some other reason.
             if (elapsedMillis <= 0)
-                return Time::getMillisecondCounter() * 0.001;
+                return Time::getMillisecondCounterHiRes() * 0.001;
 
-            return ((double) startTimeMillis + elapsedMillis) * 0.001;
+            return (startTimeMillis + elapsedMillis) * 0.001;
         }
 
         void processEvent (Span<std::byte> buffer, snd_midi_event_t* midiParser)
@@ -227,7 +227,9 @@ struct AlsaMidiHelpers
             return *snd_seq_queue_status_get_real_time (queueStatus);
         });
 
-        const uint32_t startTimeMillis = Time::getMillisecondCounter();
+        // This uses the high-resolution counter so that the converted timestamps can be compared
+        // with times taken on the audio thread, without an error of up to a millisecond
+        const double startTimeMillis = Time::getMillisecondCounterHiRes();
 
         std::thread thread { [this]
         {
@@ -265,6 +265,12 @@ public:
         return true;
     }
 
+    int getMaxNumSamplesPerWrite() const noexcept
+    {
+        // An AbstractFifo always keeps one slot free
+        return fifo.getTotalSize() - 1;
+    }
+
     int useTimeSlice() override
     {
         return writePendingData();
@@ -358,6 +364,11 @@ bool AudioFormatWriter::ThreadedWriter::write (const float* const* data, int num
     return buffer->write (data, numSamples);
 }
 
+int AudioFormatWriter::ThreadedWriter::getMaxNumSamplesPerWrite() const noexcept
+{
+    return buffer->getMaxNumSamplesPerWrite();
+}
+
 void AudioFormatWriter::ThreadedWriter::setDataReceiver (AudioFormatWriter::ThreadedWriter::IncomingDataReceiver* receiver)
 {
     buffer->setDataReceiver (receiver);
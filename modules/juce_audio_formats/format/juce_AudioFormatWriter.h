@@ -222,6 +222,11 @@ public:
         */
         bool write (const float* const* data, int numSamples);
 
+        /** Returns the largest number of samples that write() can accept at once, when the
+            FIFO is empty.
+        */
+        int getMaxNumSamplesPerWrite() const noexcept;
+
         /** Receiver for incoming data. */
         class JUCE_API  IncomingDataReceiver
         {
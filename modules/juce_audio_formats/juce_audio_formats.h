@@ -138,6 +138,7 @@
 #include "codecs/juce_WavAudioFormat.h"
 #include "codecs/juce_WindowsMediaAudioFormat.h"
 #include "sampler/juce_Sampler.h"
+#include "sampler/juce_StreamingSampler.h"
 
 #if JucePlugin_Enable_ARA
  #include <juce_audio_processors/juce_audio_processors.h>
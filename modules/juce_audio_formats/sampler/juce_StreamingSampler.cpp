@@ -0,0 +1,709 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+SamplerDiskStreamer::SamplerDiskStreamer (int numThreads, int bufferSize, int blockSize)
+    : bufferSizePerVoice (bufferSize),
+      readBlockSize (blockSize)
+{
+    // the buffer needs to hold at least one block
+    jassert (numThreads > 0 && readBlockSize > 0 && readBlockSize < bufferSizePerVoice);
+
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+    {
+        auto* thread = threads.add (new TimeSliceThread ("Sampler Disk Streamer " + String (i + 1)));
+        thread->startThread (Thread::Priority::high);
+    }
+}
+
+SamplerDiskStreamer::~SamplerDiskStreamer()
+{
+    // all of the voices that use this streamer must be deleted first!
+    for (auto* thread : threads)
+        jassert (thread->getNumClients() == 0);
+
+    threads.clear();
+}
+
+void SamplerDiskStreamer::addClient (TimeSliceClient& client)
+{
+    auto* leastBusy = threads.getFirst();
+
+    for (auto* thread : threads)
+        if (thread->getNumClients() < leastBusy->getNumClients())
+            leastBusy = thread;
+
+    leastBusy->addTimeSliceClient (&client);
+}
+
+void SamplerDiskStreamer::removeClient (TimeSliceClient& client)
+{
+    for (auto* thread : threads)
+        if (thread->contains (&client))
+            thread->removeTimeSliceClient (&client);
+}
+
+//==============================================================================
+StreamingSamplerSound::StreamingSamplerSound (const String& soundName,
+                                              std::unique_ptr<AudioFormatReader> source,
+                                              const BigInteger& notes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs,
+                                              double maxSampleLengthSeconds,
+                                              double preloadLengthSeconds)
+    : name (soundName),
+      reader (std::move (source)),
+      sourceSampleRate (reader != nullptr ? reader->sampleRate : 0.0),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    if (sourceSampleRate > 0 && reader->lengthInSamples > 0)
+    {
+        length = jmin (reader->lengthInSamples,
+                       (int64) (maxSampleLengthSeconds * sourceSampleRate));
+
+        // like SamplerSound, a few extra samples are read past the end for the interpolator
+        streamEnd = length + 4;
+        preloadLength = (int) jlimit ((int64) 1, streamEnd, (int64) (preloadLengthSeconds * sourceSampleRate));
+
+        preloadedData.reset (new AudioBuffer<float> (jmin (2, (int) reader->numChannels), preloadLength));
+
+        reader->read (preloadedData.get(), 0, preloadLength, 0, true, true);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+bool StreamingSamplerSound::readFromSource (AudioBuffer<float>& buffer, int startSample, int numSamples, int64 sourceStartSample)
+{
+    // several voices may be streaming this sound on different threads
+    const ScopedLock sl (readerLock);
+    return reader->read (&buffer, startSample, numSamples, sourceStartSample, true, true);
+}
+
+//==============================================================================
+/*  A voice's buffer, and the state shared between the audio thread and the streamer
+    thread that fills it.
+
+    The audio thread asks for a sound to be streamed by posting a request with a new
+    generation number. The streamer thread resets the FIFO when it sees the request,
+    and acknowledges it; until then the audio thread doesn't touch the FIFO. Only one
+    request can be waiting to be acknowledged at a time, and the audio thread keeps a
+    reference to the sounds that the streamer thread might still be reading, so that
+    the streamer never needs to take a reference of its own.
+*/
+class StreamingSamplerVoice::Stream final : public TimeSliceClient
+{
+public:
+    explicit Stream (SamplerDiskStreamer& s)
+        : owner (s),
+          fifo (s.getBufferSizePerVoice()),
+          buffer (2, s.getBufferSizePerVoice())
+    {
+    }
+
+    //==============================================================================
+    // Called on the audio thread. The stream will start at startSample, or at the end of the
+    // preloaded data if that's later.
+    void request (StreamingSamplerSound* soundToStream, int64 startSample = 0) noexcept
+    {
+        pendingSound = soundToStream;
+        pendingStart = startSample;
+        hasPendingRequest = true;
+        update();
+    }
+
+    // Called on the audio thread: posts a pending request once the previous one has been picked up
+    void update() noexcept
+    {
+        if (acknowledgedGeneration.load (std::memory_order_acquire) != postedGeneration)
+            return;
+
+        previousSound = nullptr;
+
+        if (! hasPendingRequest)
+            return;
+
+        previousSound = std::move (postedSound);
+        postedSound = std::move (pendingSound);
+        hasPendingRequest = false;
+
+        firstBufferedSample = postedSound != nullptr ? jmax ((int64) postedSound->preloadLength, pendingStart) : 0;
+        readIndex = numReadable = 0;
+
+        requestedSound.store (postedSound.get(), std::memory_order_relaxed);
+        requestedStart.store (firstBufferedSample, std::memory_order_relaxed);
+        requestedGeneration.store (++postedGeneration, std::memory_order_release);
+    }
+
+    bool isStreaming (const StreamingSamplerSound& s) const noexcept
+    {
+        return ! hasPendingRequest
+                && postedSound.get() == &s
+                && acknowledgedGeneration.load (std::memory_order_acquire) == postedGeneration;
+    }
+
+    void prepareToRead() noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (fifo.getTotalSize(), start1, size1, start2, size2);
+
+        readIndex = start1;
+        numReadable = size1 + size2;
+    }
+
+    bool isAvailable (int64 sourceSample) const noexcept
+    {
+        return sourceSample - firstBufferedSample < numReadable;
+    }
+
+    float getSample (int channel, int64 sourceSample) const noexcept
+    {
+        auto index = readIndex + (int) (sourceSample - firstBufferedSample);
+
+        if (index >= buffer.getNumSamples())
+            index -= buffer.getNumSamples();
+
+        return buffer.getReadPointer (channel)[index];
+    }
+
+    void releaseSamplesBefore (int64 sourceSample) noexcept
+    {
+        const auto numToRelease = (int) jlimit ((int64) 0, (int64) numReadable, sourceSample - firstBufferedSample);
+
+        fifo.finishedRead (numToRelease);
+        firstBufferedSample += numToRelease;
+        numReadable -= numToRelease;
+        readIndex = (readIndex + numToRelease) % buffer.getNumSamples();
+    }
+
+    bool waitForData (int timeoutMilliseconds)
+    {
+        return dataWritten.wait (timeoutMilliseconds);
+    }
+
+    //==============================================================================
+    // Called on the streamer thread
+    int useTimeSlice() override
+    {
+        const auto generation = requestedGeneration.load (std::memory_order_acquire);
+
+        if (generation != activeGeneration)
+        {
+            sound = requestedSound.load (std::memory_order_relaxed);
+            fifo.reset();
+            nextReadPosition = requestedStart.load (std::memory_order_relaxed);
+            activeGeneration = generation;
+
+            acknowledgedGeneration.store (generation, std::memory_order_release);
+            dataWritten.signal();
+        }
+
+        if (sound == nullptr || nextReadPosition >= sound->streamEnd)
+            return idleIntervalMs;
+
+        const auto numToRead = (int) jmin ((int64) owner.getReadBlockSize(), sound->streamEnd - nextReadPosition);
+
+        if (fifo.getFreeSpace() < numToRead)
+            return idleIntervalMs;
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numToRead, start1, size1, start2, size2);
+
+        if (size1 > 0)  sound->readFromSource (buffer, start1, size1, nextReadPosition);
+        if (size2 > 0)  sound->readFromSource (buffer, start2, size2, nextReadPosition + size1);
+
+        fifo.finishedWrite (size1 + size2);
+        nextReadPosition += size1 + size2;
+        owner.numSamplesRead.fetch_add (size1 + size2, std::memory_order_relaxed);
+
+        dataWritten.signal();
+        return 0;
+    }
+
+private:
+    static constexpr int idleIntervalMs = 5;
+
+    SamplerDiskStreamer& owner;
+    AbstractFifo fifo;
+    AudioBuffer<float> buffer;
+    WaitableEvent dataWritten;
+
+    std::atomic<StreamingSamplerSound*> requestedSound { nullptr };
+    std::atomic<int64> requestedStart { 0 };
+    std::atomic<int> requestedGeneration { 0 }, acknowledgedGeneration { 0 };
+
+    // audio thread only
+    ReferenceCountedObjectPtr<StreamingSamplerSound> pendingSound, postedSound, previousSound;
+    bool hasPendingRequest = false;
+    int postedGeneration = 0;
+    int64 pendingStart = 0, firstBufferedSample = 0;
+    int readIndex = 0, numReadable = 0;
+
+    // streamer thread only
+    StreamingSamplerSound* sound = nullptr;
+    int activeGeneration = 0;
+    int64 nextReadPosition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (Stream)
+};
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice (SamplerDiskStreamer& s)
+    : streamer (s),
+      stream (std::make_unique<Stream> (s))
+{
+    streamer.addClient (*stream);
+}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+    streamer.removeClient (*stream);
+}
+
+bool StreamingSamplerVoice::canPlaySound (SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
+{
+    if (auto* sound = dynamic_cast<StreamingSamplerSound*> (s))
+    {
+        pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
+                        * sound->sourceSampleRate / getSampleRate();
+
+        sourceSamplePosition = 0.0;
+        lgain = velocity;
+        rgain = velocity;
+
+        adsr.setSampleRate (sound->sourceSampleRate);
+        adsr.setParameters (sound->params);
+
+        adsr.noteOn();
+
+        stream->request (sound);
+    }
+    else
+    {
+        jassertfalse; // this object can only play StreamingSamplerSounds!
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        adsr.noteOff();
+    }
+    else
+    {
+        clearCurrentNote();
+        adsr.reset();
+        stream->request (nullptr);
+    }
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (int /*newValue*/) {}
+void StreamingSamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
+
+void StreamingSamplerVoice::addUnderrun() noexcept
+{
+    numUnderruns.fetch_add (1, std::memory_order_relaxed);
+    streamer.numUnderruns.fetch_add (1, std::memory_order_relaxed);
+}
+
+bool StreamingSamplerVoice::waitForStream (const StreamingSamplerSound& sound, int64 sourceSample)
+{
+    if (! nonRealtime)
+        return false;
+
+    // gives up eventually, in case the disk has stopped responding
+    for (int attempts = 0; attempts < 500; ++attempts)
+    {
+        stream->waitForData (10);
+        stream->update();
+
+        if (stream->isStreaming (sound))
+        {
+            stream->prepareToRead();
+
+            if (stream->isAvailable (sourceSample))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+//==============================================================================
+void StreamingSamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    stream->update();
+
+    if (auto* playingSound = static_cast<StreamingSamplerSound*> (getCurrentlyPlayingSound().get()))
+    {
+        auto& data = *playingSound->preloadedData;
+        const float* const inL = data.getReadPointer (0);
+        const float* const inR = data.getNumChannels() > 1 ? data.getReadPointer (1) : nullptr;
+        const auto preloadLength = (int64) playingSound->preloadLength;
+
+        const auto getSample = [&] (const float* preloaded, int channel, int64 index)
+        {
+            return index < preloadLength ? preloaded[index] : stream->getSample (channel, index);
+        };
+
+        auto isStreaming = stream->isStreaming (*playingSound);
+
+        if (isStreaming)
+            stream->prepareToRead();
+
+        float* outL = outputBuffer.getWritePointer (0, startSample);
+        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+        bool finished = false, underrun = false;
+
+        while (--numSamples >= 0)
+        {
+            auto pos = (int64) sourceSamplePosition;
+            auto alpha = (float) (sourceSamplePosition - (double) pos);
+            auto invAlpha = 1.0f - alpha;
+
+            if (pos + 1 >= preloadLength && ! (isStreaming && stream->isAvailable (pos + 1)))
+            {
+                if (! waitForStream (*playingSound, pos + 1))
+                {
+                    addUnderrun();
+                    underrun = true;
+                    break;
+                }
+
+                isStreaming = true;
+            }
+
+            // just using a very simple linear interpolation here
+            float l = (getSample (inL, 0, pos) * invAlpha + getSample (inL, 0, pos + 1) * alpha);
+            float r = (inR != nullptr) ? (getSample (inR, 1, pos) * invAlpha + getSample (inR, 1, pos + 1) * alpha)
+                                       : l;
+
+            auto envelopeValue = adsr.getNextSample();
+
+            l *= lgain * envelopeValue;
+            r *= rgain * envelopeValue;
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > (double) playingSound->length || ! adsr.isActive())
+            {
+                finished = true;
+                break;
+            }
+        }
+
+        if (underrun)
+        {
+            // Skip the audio that couldn't be played, so that the voice stays in time, and restart
+            // the stream from there
+            const auto numSkipped = numSamples + 1;
+            sourceSamplePosition += pitchRatio * numSkipped;
+
+            for (int i = 0; i < numSkipped; ++i)
+                adsr.getNextSample();
+
+            finished = sourceSamplePosition > (double) playingSound->length || ! adsr.isActive();
+        }
+
+        // the buffer has to be released before stopNote() or request() asks for a new stream
+        if (isStreaming)
+            stream->releaseSamplesBefore ((int64) sourceSamplePosition);
+
+        if (finished)
+            stopNote (0.0f, false);
+        else if (underrun && isStreaming) // (unless a new stream is already on its way)
+            stream->request (playingSound, (int64) sourceSamplePosition);
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StreamingSamplerTests final : public UnitTest
+{
+public:
+    StreamingSamplerTests()  : UnitTest ("StreamingSampler", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr auto sampleRate = 44100.0;
+        constexpr auto blockSize = 512;
+
+        BigInteger allKeys;
+        allKeys.setRange (0, 128, true);
+
+        beginTest ("Streamed playback matches playback from memory");
+        {
+            const auto wav = createWav (createTestSignal (2, 20000), sampleRate);
+
+            Synthesiser inMemory;
+            inMemory.addVoice (new SamplerVoice());
+            inMemory.addSound (new SamplerSound ("test", *createReader (wav), allKeys, 60, 0.0, 0.1, 10.0));
+            inMemory.setCurrentPlaybackSampleRate (sampleRate);
+
+            // a small buffer, so that it wraps around many times
+            SamplerDiskStreamer streamer (1, 4096, 1024);
+
+            {
+                Synthesiser streamed;
+                auto* voice = new StreamingSamplerVoice (streamer);
+                voice->setNonRealtime (true);
+                streamed.addVoice (voice);
+                streamed.addSound (new StreamingSamplerSound ("test", createReader (wav), allKeys, 60, 0.0, 0.1, 10.0, 0.02));
+                streamed.setCurrentPlaybackSampleRate (sampleRate);
+
+                MidiBuffer midi;
+                midi.addEvent (MidiMessage::noteOn (1, 67, 1.0f), 0);
+
+                AudioBuffer<float> expected (2, blockSize), actual (2, blockSize);
+                bool allMatch = true;
+
+                for (int block = 0; block < 40; ++block)
+                {
+                    expected.clear();
+                    actual.clear();
+                    inMemory.renderNextBlock (expected, midi, 0, blockSize);
+                    streamed.renderNextBlock (actual, midi, 0, blockSize);
+                    midi.clear();
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < blockSize; ++i)
+                            allMatch = allMatch && approximatelyEqual (expected.getSample (ch, i), actual.getSample (ch, i));
+                }
+
+                expect (allMatch);
+                expect (! voice->isVoiceActive());
+                expectEquals (voice->getNumUnderruns(), (int64) 0);
+                expect (streamer.getNumSamplesRead() > 0);
+            }
+        }
+
+        beginTest ("Underruns are counted when the disk can't keep up");
+        {
+            const auto wav = createWav (createTestSignal (1, 20000), sampleRate);
+            auto blockingReader = std::make_unique<BlockingReader> (createReader (wav));
+            auto& unblock = blockingReader->unblock;
+
+            SamplerDiskStreamer streamer (1, 4096, 1024);
+
+            {
+                Synthesiser synth;
+                auto* voice = new StreamingSamplerVoice (streamer);
+                synth.addVoice (voice);
+                synth.addSound (new StreamingSamplerSound ("test", std::move (blockingReader), allKeys, 60, 0.0, 0.1, 10.0, 0.02));
+                synth.setCurrentPlaybackSampleRate (sampleRate);
+
+                MidiBuffer midi;
+                midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 0);
+
+                AudioBuffer<float> output (1, blockSize);
+                output.clear();
+                synth.renderNextBlock (output, midi, 0, blockSize);
+                expect (output.getMagnitude (0, blockSize) > 0.0f);
+                expectEquals (voice->getNumUnderruns(), (int64) 0);
+
+                // the preloaded part has run out, and nothing can be read yet
+                output.clear();
+                synth.renderNextBlock (output, {}, 0, blockSize);
+                expectEquals (voice->getNumUnderruns(), (int64) 1);
+                expect (voice->isVoiceActive());
+
+                output.clear();
+                synth.renderNextBlock (output, {}, 0, blockSize);
+                expect (exactlyEqual (output.getMagnitude (0, blockSize), 0.0f));
+                expectEquals (voice->getNumUnderruns(), (int64) 2);
+                expectEquals (streamer.getNumUnderruns(), (int64) 2);
+
+                unblock.signal();
+            }
+        }
+
+        beginTest ("Voices stay in time after an underrun");
+        {
+            const auto wav = createWav (createTestSignal (1, 60000), sampleRate);
+            auto blockingReader = std::make_unique<BlockingReader> (createReader (wav));
+            auto& unblock = blockingReader->unblock;
+
+            Synthesiser inMemory;
+            inMemory.addVoice (new SamplerVoice());
+            inMemory.addSound (new SamplerSound ("test", *createReader (wav), allKeys, 60, 0.0, 0.1, 10.0));
+            inMemory.setCurrentPlaybackSampleRate (sampleRate);
+
+            SamplerDiskStreamer streamer (1, 8192, 1024);
+
+            {
+                Synthesiser streamed;
+                auto* voice = new StreamingSamplerVoice (streamer);
+                streamed.addVoice (voice);
+                streamed.addSound (new StreamingSamplerSound ("test", std::move (blockingReader), allKeys, 60, 0.0, 0.1, 10.0, 0.02));
+                streamed.setCurrentPlaybackSampleRate (sampleRate);
+
+                MidiBuffer midi;
+                midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 0);
+
+                AudioBuffer<float> expected (1, blockSize), actual (1, blockSize);
+                bool lastBlocksMatch = true;
+
+                for (int block = 0; block < 30; ++block)
+                {
+                    // The disk stalls for a few blocks, and then gets a chance to catch up
+                    // before each of the remaining ones
+                    if (block == 4)
+                        unblock.signal();
+
+                    if (block >= 4)
+                        Thread::sleep (10);
+
+                    expected.clear();
+                    actual.clear();
+                    inMemory.renderNextBlock (expected, midi, 0, blockSize);
+                    streamed.renderNextBlock (actual, midi, 0, blockSize);
+                    midi.clear();
+
+                    if (block >= 20)
+                        for (int i = 0; i < blockSize; ++i)
+                            lastBlocksMatch = lastBlocksMatch && approximatelyEqual (expected.getSample (0, i), actual.getSample (0, i));
+                }
+
+                expect (voice->getNumUnderruns() > 0);
+                expect (lastBlocksMatch);
+                expect (voice->isVoiceActive());
+
+                unblock.signal();
+            }
+        }
+    }
+
+private:
+    struct BlockingReader final : public AudioFormatReader
+    {
+        explicit BlockingReader (std::unique_ptr<AudioFormatReader> r)
+            : AudioFormatReader (nullptr, r->getFormatName()),
+              source (std::move (r))
+        {
+            sampleRate            = source->sampleRate;
+            bitsPerSample         = source->bitsPerSample;
+            usesFloatingPointData = source->usesFloatingPointData;
+            lengthInSamples       = source->lengthInSamples;
+            numChannels           = source->numChannels;
+        }
+
+        bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            // the preloaded part is read on the constructing thread; anything after that waits
+            if (startSampleInFile > 0)
+                unblock.wait();
+
+            return source->readSamples (destChannels, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+        }
+
+        std::unique_ptr<AudioFormatReader> source;
+        WaitableEvent unblock { true };
+    };
+
+    static AudioBuffer<float> createTestSignal (int numChannels, int numSamples)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (ch, i, 0.5f * std::sin ((float) i * 0.01f * (float) (ch + 1)));
+
+        return buffer;
+    }
+
+    static MemoryBlock createWav (const AudioBuffer<float>& signal, double sampleRate)
+    {
+        MemoryBlock block;
+
+        {
+            std::unique_ptr<OutputStream> stream = std::make_unique<MemoryOutputStream> (block, false);
+            auto writer = WavAudioFormat().createWriterFor (stream, AudioFormatWriterOptions{}.withSampleRate (sampleRate)
+                                                                                               .withNumChannels (signal.getNumChannels())
+                                                                                               .withBitsPerSample (16));
+            writer->writeFromAudioSampleBuffer (signal, 0, signal.getNumSamples());
+        }
+
+        return block;
+    }
+
+    static std::unique_ptr<AudioFormatReader> createReader (const MemoryBlock& wav)
+    {
+        return rawToUniquePtr (WavAudioFormat().createReaderFor (new MemoryInputStream (wav, false), true));
+    }
+};
+
+static StreamingSamplerTests streamingSamplerTests;
+
+#endif
+
+} // namespace juce
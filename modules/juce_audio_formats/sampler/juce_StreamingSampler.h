@@ -0,0 +1,283 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A pool of background threads that read audio from disk for a set of
+    StreamingSamplerVoice objects.
+
+    Each voice that is created with a SamplerDiskStreamer is given a fixed-size
+    buffer, and one of the streamer's threads keeps that buffer topped up from the
+    AudioFormatReader of the sound that the voice is playing. The buffers are
+    lock-free FIFOs, so the audio thread never waits for the disk.
+
+    The streamer must outlive all of the voices that use it.
+
+    @see StreamingSamplerVoice, StreamingSamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  SamplerDiskStreamer
+{
+public:
+    //==============================================================================
+    /** Creates a streamer and starts its threads.
+
+        @param numThreads           the number of background threads to read with. Voices
+                                    are shared out between the threads
+        @param bufferSizePerVoice   the size, in samples, of each voice's buffer. This needs
+                                    to hold enough audio to cover the longest time that a
+                                    read might take, at the fastest rate that a voice can
+                                    play back
+        @param readBlockSize        the number of samples to read from a reader at once
+    */
+    explicit SamplerDiskStreamer (int numThreads = 2,
+                                  int bufferSizePerVoice = 32768,
+                                  int readBlockSize = 4096);
+
+    /** Destructor. */
+    ~SamplerDiskStreamer();
+
+    //==============================================================================
+    /** Returns the number of threads that this streamer reads with. */
+    int getNumThreads() const noexcept                  { return threads.size(); }
+
+    /** Returns the size, in samples, of each voice's buffer. */
+    int getBufferSizePerVoice() const noexcept          { return bufferSizePerVoice; }
+
+    /** Returns the number of samples that are read from a reader at once. */
+    int getReadBlockSize() const noexcept               { return readBlockSize; }
+
+    //==============================================================================
+    /** Returns the total number of samples that have been read from disk by all of
+        this streamer's threads.
+    */
+    int64 getNumSamplesRead() const noexcept            { return numSamplesRead.load (std::memory_order_relaxed); }
+
+    /** Returns the total number of underruns in all of the voices that use this
+        streamer.
+
+        An underrun happens when a voice needs audio that hasn't been read from disk
+        yet. The rest of that voice's block is silent, and the voice skips ahead by the
+        same amount.
+
+        @see StreamingSamplerVoice::getNumUnderruns
+    */
+    int64 getNumUnderruns() const noexcept              { return numUnderruns.load (std::memory_order_relaxed); }
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    void addClient (TimeSliceClient&);
+    void removeClient (TimeSliceClient&);
+
+    OwnedArray<TimeSliceThread> threads;
+    const int bufferSizePerVoice, readBlockSize;
+    std::atomic<int64> numSamplesRead { 0 }, numUnderruns { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplerDiskStreamer)
+};
+
+//==============================================================================
+/**
+    A subclass of SynthesiserSound that represents a sampled audio clip which is
+    streamed from disk.
+
+    Unlike SamplerSound, only the first part of the audio is loaded into memory when
+    the sound is created. The rest is read from the AudioFormatReader while the sound
+    plays, by a SamplerDiskStreamer. The preloaded part must be long enough to cover
+    the time it takes to start streaming.
+
+    To use it, create a Synthesiser, add some StreamingSamplerVoice objects to it,
+    then give it some StreamingSamplerSound objects to play.
+
+    @see StreamingSamplerVoice, SamplerDiskStreamer, SamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerSound    : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Creates a streamed sound from an audio reader.
+
+        @param name         a name for the sample
+        @param source       the audio to play. The sound takes ownership of the reader,
+                            which will be used from the streamer's background threads
+        @param midiNotes    the set of midi keys that this sound should be played on. This
+                            is used by the SynthesiserSound::appliesToNote() method
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate. All other notes will be pitched
+                                        up or down relative to this one
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param maxSampleLengthSeconds   a maximum length of audio to play from the audio
+                                        source, in seconds
+        @param preloadLengthSeconds     the length of audio to load into memory from the
+                                        start of the source, in seconds
+    */
+    StreamingSamplerSound (const String& name,
+                           std::unique_ptr<AudioFormatReader> source,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           double maxSampleLengthSeconds,
+                           double preloadLengthSeconds);
+
+    /** Destructor. */
+    ~StreamingSamplerSound() override;
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                  { return name; }
+
+    /** Returns the part of the audio that has been loaded into memory.
+        This could return nullptr if there was a problem loading the data.
+    */
+    AudioBuffer<float>* getPreloadedData() const noexcept   { return preloadedData.get(); }
+
+    /** Returns the length of the sound, in source samples. */
+    int64 getLengthInSamples() const noexcept               { return length; }
+
+    /** Returns the number of samples that have been loaded into memory. */
+    int getPreloadLengthInSamples() const noexcept          { return preloadLength; }
+
+    //==============================================================================
+    /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
+    void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    bool readFromSource (AudioBuffer<float>&, int startSample, int numSamples, int64 sourceStartSample);
+
+    String name;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
+    std::unique_ptr<AudioBuffer<float>> preloadedData;
+    double sourceSampleRate;
+    BigInteger midiNotes;
+    int64 length = 0, streamEnd = 0;
+    int preloadLength = 0, midiRootNote = 0;
+
+    ADSR::Parameters params;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+//==============================================================================
+/**
+    A subclass of SynthesiserVoice that can play a StreamingSamplerSound.
+
+    Each voice has a buffer that a SamplerDiskStreamer fills from the sound's reader
+    while the voice plays. If the disk can't keep up, the voice is silent until the
+    audio it needs has arrived, and an underrun is counted. The voice skips over the
+    audio that it missed, so that it stays in time.
+
+    @see StreamingSamplerSound, SamplerDiskStreamer, Synthesiser
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerVoice    : public SynthesiserVoice
+{
+public:
+    //==============================================================================
+    /** Creates a voice which streams using the given streamer.
+        The streamer must outlive the voice.
+    */
+    explicit StreamingSamplerVoice (SamplerDiskStreamer& streamer);
+
+    /** Destructor. */
+    ~StreamingSamplerVoice() override;
+
+    //==============================================================================
+    /** In non-realtime mode, the voice waits for audio to be read from disk rather
+        than dropping out. Use this when rendering offline.
+    */
+    void setNonRealtime (bool shouldBeNonRealtime) noexcept     { nonRealtime = shouldBeNonRealtime; }
+
+    /** Returns true if the voice is in non-realtime mode.
+        @see setNonRealtime
+    */
+    bool isNonRealtime() const noexcept                         { return nonRealtime; }
+
+    /** Returns the number of times that this voice has run out of streamed audio.
+        @see SamplerDiskStreamer::getNumUnderruns
+    */
+    int64 getNumUnderruns() const noexcept                      { return numUnderruns.load (std::memory_order_relaxed); }
+
+    //==============================================================================
+    bool canPlaySound (SynthesiserSound*) override;
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
+    using SynthesiserVoice::renderNextBlock;
+
+private:
+    //==============================================================================
+    class Stream;
+
+    SamplerDiskStreamer& streamer;
+    std::unique_ptr<Stream> stream;
+
+    double pitchRatio = 0;
+    double sourceSamplePosition = 0;
+    float lgain = 0, rgain = 0;
+    bool nonRealtime = false;
+    std::atomic<int64> numUnderruns { 0 };
+
+    ADSR adsr;
+
+    void addUnderrun() noexcept;
+    bool waitForStream (const StreamingSamplerSound&, int64 sourceSample);
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerVoice)
+};
+
+} // namespace juce
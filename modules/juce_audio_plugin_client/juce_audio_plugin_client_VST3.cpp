@@ -2906,7 +2906,13 @@ public:
 
     void getStateInformation (MemoryBlock& destData)
     {
-        pluginInstance->getStateInformation (destData);
+        MemoryOutputStream out (destData, false);
+        writeStateInformation (out);
+    }
+
+    void writeStateInformation (OutputStream& out)
+    {
+        pluginInstance->writeStateInformation (out);
 
         // With bypass support, JUCE now needs to store private state data.
         // Put this at the end of the plug-in state and add a few null characters
@@ -2923,7 +2929,7 @@ public:
         extraData << kJucePrivateDataIdentifier;
 
         // write magic string
-        destData.append (extraData.getData(), extraData.getDataSize());
+        out.write (extraData.getData(), extraData.getDataSize());
     }
 
     void setStateInformation (const void* data, int sizeAsInt)
@@ -2965,7 +2971,10 @@ public:
         }
 
         if (size > 0)
-            pluginInstance->setStateInformation (data, static_cast<int> (size));
+        {
+            MemoryInputStream in (data, (size_t) size, false);
+            pluginInstance->readStateInformation (in);
+        }
     }
 
     //==============================================================================
@@ -3107,21 +3116,64 @@ public:
         return kResultFalse;
     }
 
+    /*  Lets the processor write its state straight into the host's stream. */
+    class StateOutputStream final : public OutputStream
+    {
+    public:
+        explicit StateOutputStream (IBStream& s) : stream (s) {}
+
+        int64 getPosition() override        { return position; }
+        bool setPosition (int64) override   { return false; }
+        void flush() override               {}
+
+        bool write (const void* data, size_t numBytes) override
+        {
+            while (numBytes > 0)
+            {
+                const auto numToWrite = (Steinberg::int32) jmin (numBytes, (size_t) std::numeric_limits<Steinberg::int32>::max());
+                Steinberg::int32 numWritten = 0;
+
+                if (stream.write (const_cast<void*> (data), numToWrite, &numWritten) != kResultOk || numWritten <= 0)
+                {
+                    failed = true;
+                    return false;
+                }
+
+                data = addBytesToPointer (data, numWritten);
+                numBytes -= (size_t) numWritten;
+                position += numWritten;
+            }
+
+            return true;
+        }
+
+        bool failed = false;
+
+    private:
+        IBStream& stream;
+        int64 position = 0;
+    };
+
     tresult PLUGIN_API getState (IBStream* state) override
     {
        if (state == nullptr)
            return kInvalidArgument;
 
-        MemoryBlock mem;
-        getStateInformation (mem);
+        if (shouldWriteStateWithVst2Compatibility())
+        {
+            MemoryBlock mem;
+            getStateInformation (mem);
 
-        if (mem.isEmpty())
-            return kResultFalse;
+            if (mem.isEmpty())
+                return kResultFalse;
 
-        if (shouldWriteStateWithVst2Compatibility())
             return getStateWithVst2Compatibility (mem, *state);
+        }
+
+        StateOutputStream out (*state);
+        writeStateInformation (out);
 
-        return state->write (mem.getData(), (Steinberg::int32) mem.getSize());
+        return out.failed ? kResultFalse : kResultOk;
     }
 
     //==============================================================================
@@ -3717,10 +3769,25 @@ public:
                 }
                 else
                #endif
-                if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
+                if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
                 {
-                    if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+                    auto& eventQueue = pluginInstance->getParameterEventQueue();
+
+                    if (eventQueue.isEnabled())
+                    {
+                        // Pass every point on to the processor, rather than just the last one
+                        for (Steinberg::int32 point = 0; point < numPoints; ++point)
+                        {
+                            if (const auto change = getPointFromQueue (paramQueue, point))
+                                eventQueue.push ({ param->getParameterIndex(), (int) change->offsetSamples, (float) change->value });
+                        }
+                    }
+
+                    if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
+                    {
+                        const AudioProcessorParameterEventQueue::ScopedIgnoreNotifiedChanges ignoreChanges;
                         setValueAndNotifyIfChanged (*param, (float) change->value);
+                    }
                 }
             }
         }
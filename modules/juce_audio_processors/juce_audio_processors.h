@@ -82,6 +82,7 @@
 #include "format_types/juce_LV2PluginFormat.h"
 #include "format_types/juce_VST3PluginFormat.h"
 #include "format_types/juce_VSTPluginFormat.h"
+#include "scanning/juce_PluginScannerWorker.h"
 #include "scanning/juce_PluginDirectoryScanner.h"
 #include "scanning/juce_PluginListComponent.h"
 #include "utilities/juce_ParameterAttachments.h"
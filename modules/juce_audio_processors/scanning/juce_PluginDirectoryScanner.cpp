@@ -131,6 +131,318 @@ bool PluginDirectoryScanner::skipNextFile()
     return --nextIndex > 0;
 }
 
+//==============================================================================
+/*  A worker that scans one plugin at a time on behalf of scanRemainingFilesInChildProcesses().
+    When a scan finishes or fails, the worker signals the event that it was created with.
+*/
+class PluginScanWorkerProcess
+{
+public:
+    virtual ~PluginScanWorkerProcess() = default;
+
+    enum class State
+    {
+        scanning,
+        finished,
+        failed
+    };
+
+    virtual bool launch (const File& executable, const String& commandLineUID) = 0;
+    virtual bool startScan (const String& formatName, const String& fileOrIdentifier) = 0;
+    virtual State getState() const = 0;
+    virtual uint32 getMillisecondsSinceStart() const = 0;
+    virtual void getResults (OwnedArray<PluginDescription>& results) = 0;
+};
+
+//==============================================================================
+/*  Talks to one PluginScannerWorker process, which scans one plugin at a time. */
+class PluginScannerProcess final : public PluginScanWorkerProcess,
+                                   private ChildProcessCoordinator
+{
+public:
+    explicit PluginScannerProcess (WaitableEvent& event) : resultEvent (event) {}
+
+    ~PluginScannerProcess() override
+    {
+        killWorkerProcess();
+    }
+
+    bool launch (const File& executable, const String& commandLineUID) override
+    {
+        return launchWorkerProcess (executable, commandLineUID, 0, 0);
+    }
+
+    bool startScan (const String& formatName, const String& fileOrIdentifier) override
+    {
+        {
+            const ScopedLock sl (lock);
+            state = State::scanning;
+            response.reset();
+        }
+
+        MemoryBlock block;
+
+        {
+            MemoryOutputStream stream (block, false);
+            stream.writeString (formatName);
+            stream.writeString (fileOrIdentifier);
+        }
+
+        startTime = Time::getMillisecondCounter();
+        return sendMessageToWorker (block);
+    }
+
+    State getState() const override
+    {
+        const ScopedLock sl (lock);
+        return state;
+    }
+
+    uint32 getMillisecondsSinceStart() const override
+    {
+        return Time::getMillisecondCounter() - startTime;
+    }
+
+    void getResults (OwnedArray<PluginDescription>& results) override
+    {
+        const ScopedLock sl (lock);
+
+        if (response == nullptr)
+            return;
+
+        for (const auto* item : response->getChildIterator())
+        {
+            auto desc = std::make_unique<PluginDescription>();
+
+            if (desc->loadFromXml (*item))
+                results.add (std::move (desc));
+        }
+    }
+
+private:
+    void handleMessageFromWorker (const MemoryBlock& mb) override
+    {
+        {
+            const ScopedLock sl (lock);
+            response = parseXML (mb.toString());
+            state = State::finished;
+        }
+
+        resultEvent.signal();
+    }
+
+    void handleConnectionLost() override
+    {
+        {
+            const ScopedLock sl (lock);
+            state = State::failed;
+        }
+
+        resultEvent.signal();
+    }
+
+    WaitableEvent& resultEvent;
+    CriticalSection lock;
+    State state = State::finished;
+    std::unique_ptr<XmlElement> response;
+    uint32 startTime = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScannerProcess)
+};
+
+//==============================================================================
+/*  Creates the workers for scanRemainingFilesInChildProcesses(). Normally each one is a
+    PluginScannerProcess, but the tests can replace them with workers that don't launch a
+    child process.
+*/
+struct PluginScanWorkerFactory
+{
+    using Function = std::function<std::unique_ptr<PluginScanWorkerProcess> (WaitableEvent&)>;
+
+    static Function get()
+    {
+        if (auto& replacement = getReplacement(); replacement != nullptr)
+            return replacement;
+
+        return [] (WaitableEvent& resultEvent) { return std::make_unique<PluginScannerProcess> (resultEvent); };
+    }
+
+    /*  Replaces the workers for any scans that start while this object exists. */
+    struct ScopedReplacement
+    {
+        explicit ScopedReplacement (Function f)
+            : previous (std::exchange (getReplacement(), std::move (f))) {}
+
+        ~ScopedReplacement()    { getReplacement() = std::move (previous); }
+
+        Function previous;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedReplacement)
+    };
+
+private:
+    static Function& getReplacement()
+    {
+        static Function replacement;
+        return replacement;
+    }
+};
+
+//==============================================================================
+bool PluginDirectoryScanner::scanRemainingFilesInChildProcesses (bool dontRescanIfAlreadyInList,
+                                                                  const ChildProcessOptions& options)
+{
+    using State = PluginScanWorkerProcess::State;
+
+    struct Slot
+    {
+        std::unique_ptr<PluginScanWorkerProcess> process;
+        String file;
+        bool canLaunch = true;
+    };
+
+    const auto createWorker = PluginScanWorkerFactory::get();
+    WaitableEvent resultEvent;
+    std::vector<Slot> slots ((size_t) jmax (1, options.numProcesses));
+    auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
+    auto anyProcessLaunched = false;
+    auto exitRequested = false;
+
+    const auto takeNextFile = [&]() -> String
+    {
+        while (nextIndex.get() > 0)
+        {
+            auto file = filesOrIdentifiersToScan[--nextIndex];
+
+            if (file.isNotEmpty()
+                && ! list.getBlacklistedFiles().contains (file)
+                && ! (dontRescanIfAlreadyInList && list.isListingUpToDate (file, format)))
+            {
+                return file;
+            }
+        }
+
+        return {};
+    };
+
+    const auto isBusy = [] (const Slot& slot) { return slot.file.isNotEmpty(); };
+
+    for (;;)
+    {
+        if (options.shouldExit != nullptr && options.shouldExit())
+        {
+            exitRequested = true;
+            break;
+        }
+
+        // Give each idle process another plugin to scan
+        for (auto& slot : slots)
+        {
+            if (isBusy (slot) || ! slot.canLaunch)
+                continue;
+
+            if (slot.process == nullptr)
+            {
+                slot.process = createWorker (resultEvent);
+
+                if (! slot.process->launch (options.executable, options.commandLineUID))
+                {
+                    slot.process.reset();
+                    slot.canLaunch = false;
+                    continue;
+                }
+
+                anyProcessLaunched = true;
+            }
+
+            const auto file = takeNextFile();
+
+            if (file.isEmpty())
+                break;
+
+            // Add this plugin to the end of the dead-man's pedal list in case we crash...
+            crashedPlugins.removeString (file);
+            crashedPlugins.add (file);
+            setDeadMansPedalFile (crashedPlugins);
+
+            if (! slot.process->startScan (format.getName(), file))
+            {
+                // The worker couldn't be reached, which says nothing about the plugin. Put the
+                // plugin back at the front of the queue for another worker (or for scanNextFile()),
+                // and stop using this slot so that a broken executable can't keep us looping.
+                slot.process.reset();
+                slot.canLaunch = false;
+
+                crashedPlugins.removeString (file);
+                setDeadMansPedalFile (crashedPlugins);
+                ++nextIndex;
+                continue;
+            }
+
+            slot.file = file;
+        }
+
+        if (std::none_of (slots.begin(), slots.end(), isBusy))
+            break;
+
+        resultEvent.wait (50);
+
+        for (auto& slot : slots)
+        {
+            if (! isBusy (slot))
+                continue;
+
+            jassert (slot.process != nullptr);
+            const auto state = slot.process->getState();
+
+            if (state == State::scanning
+                && slot.process->getMillisecondsSinceStart() < (uint32) options.timeoutMs)
+            {
+                continue;
+            }
+
+            if (state == State::finished)
+            {
+                OwnedArray<PluginDescription> typesFound;
+                slot.process->getResults (typesFound);
+
+                for (auto* desc : typesFound)
+                    list.addType (*desc);
+
+                if (typesFound.isEmpty())
+                    failedFiles.add (slot.file);
+            }
+            else
+            {
+                // The plugin crashed or hung its worker, so get rid of the worker
+                slot.process.reset();
+                list.addToBlacklist (slot.file);
+            }
+
+            crashedPlugins.removeString (slot.file);
+            setDeadMansPedalFile (crashedPlugins);
+            slot.file = {};
+        }
+
+        updateProgress();
+    }
+
+    // Anything still being scanned was abandoned, so it can be scanned again later
+    for (auto& slot : slots)
+        if (isBusy (slot))
+            crashedPlugins.removeString (slot.file);
+
+    setDeadMansPedalFile (crashedPlugins);
+    updateProgress();
+
+    return anyProcessLaunched && (exitRequested || nextIndex.get() <= 0);
+}
+
+bool PluginDirectoryScanner::scanRemainingFilesInChildProcesses (bool dontRescanIfAlreadyInList)
+{
+    return scanRemainingFilesInChildProcesses (dontRescanIfAlreadyInList, ChildProcessOptions{});
+}
+
 void PluginDirectoryScanner::setDeadMansPedalFile (const StringArray& newContents)
 {
     if (deadMansPedalFile.getFullPathName().isNotEmpty())
@@ -145,4 +457,176 @@ void PluginDirectoryScanner::applyBlacklistingsFromDeadMansPedal (KnownPluginLis
         list.addToBlacklist (crashedPlugin);
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct PluginDirectoryScannerTests final : public UnitTest
+{
+    using ChildProcessOptions = PluginDirectoryScanner::ChildProcessOptions;
+    using State               = PluginScanWorkerProcess::State;
+
+    PluginDirectoryScannerTests()
+        : UnitTest ("PluginDirectoryScanner", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Plugins are not blacklisted when a worker can't be sent them");
+        {
+            StubFormat format;
+            KnownPluginList list;
+            PluginDirectoryScanner scanner (list, format, {}, false, {});
+            scanner.setFilesOrIdentifiersToScan ({ "a", "b", "c", "d" });
+
+            // The first worker launches, but can't be reached. The second one works.
+            auto numWorkers = 0;
+
+            const PluginScanWorkerFactory::ScopedReplacement workers ([&] (WaitableEvent& event)
+            {
+                return std::make_unique<StubWorker> (event, numWorkers++ == 0);
+            });
+
+            expect (scanner.scanRemainingFilesInChildProcesses (false, getOptions (2)));
+
+            expect (list.getBlacklistedFiles().isEmpty());
+            expectEquals (list.getNumTypes(), 4);
+            expect (scanner.getFailedFiles().isEmpty());
+        }
+
+        beginTest ("Files are left for scanNextFile() when no worker can be sent them");
+        {
+            StubFormat format;
+            KnownPluginList list;
+            PluginDirectoryScanner scanner (list, format, {}, false, {});
+            scanner.setFilesOrIdentifiersToScan ({ "a", "b", "c" });
+
+            const PluginScanWorkerFactory::ScopedReplacement workers ([] (WaitableEvent& event)
+            {
+                return std::make_unique<StubWorker> (event, true);
+            });
+
+            expect (! scanner.scanRemainingFilesInChildProcesses (false, getOptions (2)));
+
+            expect (list.getBlacklistedFiles().isEmpty());
+            expectEquals (list.getNumTypes(), 0);
+
+            String name;
+            while (scanner.scanNextFile (false, name)) {}
+
+            expectEquals (list.getNumTypes(), 3);
+        }
+
+        beginTest ("Plugins that crash or hang their worker are blacklisted");
+        {
+            StubFormat format;
+            KnownPluginList list;
+            PluginDirectoryScanner scanner (list, format, {}, false, {});
+            scanner.setFilesOrIdentifiersToScan ({ "a", "crash", "b", "hang", "c" });
+
+            auto options = getOptions (2);
+            options.timeoutMs = 100;
+
+            const PluginScanWorkerFactory::ScopedReplacement workers ([] (WaitableEvent& event)
+            {
+                return std::make_unique<StubWorker> (event, false);
+            });
+
+            expect (scanner.scanRemainingFilesInChildProcesses (false, options));
+
+            expect (list.getBlacklistedFiles() == StringArray { "crash", "hang" }
+                    || list.getBlacklistedFiles() == StringArray { "hang", "crash" });
+            expectEquals (list.getNumTypes(), 3);
+        }
+    }
+
+private:
+    static ChildProcessOptions getOptions (int numProcesses)
+    {
+        ChildProcessOptions options;
+        options.numProcesses = numProcesses;
+        return options;
+    }
+
+    static PluginDescription makeDescription (const String& fileOrIdentifier)
+    {
+        PluginDescription desc;
+        desc.name = fileOrIdentifier;
+        desc.fileOrIdentifier = fileOrIdentifier;
+        desc.pluginFormatName = StubFormat::name;
+        desc.uniqueId = (int) fileOrIdentifier.hashCode();
+        return desc;
+    }
+
+    /*  Scans in-process by returning a description named after each file. */
+    struct StubFormat final : public AudioPluginFormat
+    {
+        static constexpr auto name = "Stub";
+
+        String getName() const override                                               { return name; }
+        bool fileMightContainThisPluginType (const String&) override                  { return true; }
+        String getNameOfPluginFromIdentifier (const String& id) override              { return id; }
+        bool pluginNeedsRescanning (const PluginDescription&) override                { return false; }
+        bool doesPluginStillExist (const PluginDescription&) override                 { return true; }
+        bool canScanForPlugins() const override                                       { return true; }
+        bool isTrivialToScan() const override                                         { return false; }
+        StringArray searchPathsForPlugins (const FileSearchPath&, bool, bool) override { return {}; }
+        FileSearchPath getDefaultLocationsToSearch() override                         { return {}; }
+        bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const override { return false; }
+
+        void findAllTypesForFile (OwnedArray<PluginDescription>& results, const String& id) override
+        {
+            results.add (new PluginDescription (makeDescription (id)));
+        }
+
+        void createPluginInstance (const PluginDescription&, double, int, PluginCreationCallback callback) override
+        {
+            callback (nullptr, "Not supported");
+        }
+    };
+
+    /*  Finishes each scan immediately, except for the plugins named "crash" and "hang".
+        A worker that is unreachable launches successfully, but can't be sent a plugin.
+    */
+    struct StubWorker final : public PluginScanWorkerProcess
+    {
+        StubWorker (WaitableEvent& event, bool isUnreachable)
+            : resultEvent (event), unreachable (isUnreachable) {}
+
+        bool launch (const File&, const String&) override { return true; }
+
+        bool startScan (const String&, const String& fileOrIdentifier) override
+        {
+            if (unreachable)
+                return false;
+
+            file = fileOrIdentifier;
+            startTime = Time::getMillisecondCounter();
+            state = file == "hang"  ? State::scanning
+                  : file == "crash" ? State::failed
+                                    : State::finished;
+
+            resultEvent.signal();
+            return true;
+        }
+
+        State getState() const override                   { return state; }
+        uint32 getMillisecondsSinceStart() const override { return Time::getMillisecondCounter() - startTime; }
+
+        void getResults (OwnedArray<PluginDescription>& results) override
+        {
+            results.add (new PluginDescription (makeDescription (file)));
+        }
+
+        WaitableEvent& resultEvent;
+        const bool unreachable;
+        String file;
+        State state = State::finished;
+        uint32 startTime = 0;
+    };
+};
+
+static PluginDirectoryScannerTests pluginDirectoryScannerTests;
+
+#endif
+
 } // namespace juce
@@ -107,6 +107,60 @@ public:
     */
     bool skipNextFile();
 
+    //==============================================================================
+    /** Settings for scanRemainingFilesInChildProcesses(). */
+    struct ChildProcessOptions
+    {
+        /** The executable to launch for each worker. This must create a PluginScannerWorker
+            when it's started with the worker command line.
+        */
+        File executable = File::getSpecialLocation (File::currentExecutableFile);
+
+        /** The ID that's passed to PluginScannerWorker::initialiseFromCommandLine(). */
+        String commandLineUID = PluginScannerWorker::defaultCommandLineUID;
+
+        /** The largest number of plugins to scan at once, each in its own process. */
+        int numProcesses = SystemStats::getNumCpus();
+
+        /** If a plugin takes longer than this to scan, its process will be killed, and the
+            plugin will be added to the list's blacklist.
+        */
+        int timeoutMs = 60000;
+
+        /** An optional callback that will be called regularly during the scan. If it returns
+            true, the scan will be abandoned and the worker processes will be killed.
+        */
+        std::function<bool()> shouldExit;
+    };
+
+    /** Scans all of the remaining files at once, each in a separate child process, using
+        up to ChildProcessOptions::numProcesses processes at a time.
+
+        This blocks until the scan has finished, so it should be called on a background
+        thread. Don't call scanNextFile() while it's running.
+
+        Plugins that crash or time out only take down their own worker process, and are
+        added to the list's blacklist. While the scan runs, the dead-man's-pedal file holds
+        all of the plugins that are currently being scanned, so that if this process
+        crashes, the next scan will try them last.
+
+        If a worker can't be launched, or can't be sent a plugin to scan, the plugin isn't
+        blacklisted. Instead, it's returned to the queue, and that worker isn't used again.
+
+        dontRescanIfAlreadyInList has the same meaning as in scanNextFile(). Returns false
+        if the worker processes couldn't scan all of the files, in which case the files
+        that haven't been scanned can still be scanned with scanNextFile().
+
+        @see PluginScannerWorker
+    */
+    bool scanRemainingFilesInChildProcesses (bool dontRescanIfAlreadyInList,
+                                             const ChildProcessOptions& options);
+
+    /** Scans all of the remaining files in child processes, using the default
+        ChildProcessOptions.
+    */
+    bool scanRemainingFilesInChildProcesses (bool dontRescanIfAlreadyInList);
+
     /** Returns the description of the plugin that will be scanned during the next
         call to scanNextFile().
 
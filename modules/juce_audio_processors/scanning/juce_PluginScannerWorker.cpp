@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+PluginScannerWorker::PluginScannerWorker()
+    : PluginScannerWorker (std::invoke ([]
+      {
+          auto manager = std::make_unique<AudioPluginFormatManager>();
+          addDefaultFormatsToManager (*manager);
+          return manager;
+      }))
+{
+}
+
+PluginScannerWorker::PluginScannerWorker (std::unique_ptr<AudioPluginFormatManager> manager)
+    : formatManager (std::move (manager))
+{
+    jassert (formatManager != nullptr);
+}
+
+PluginScannerWorker::~PluginScannerWorker()
+{
+    cancelPendingUpdate();
+}
+
+bool PluginScannerWorker::initialiseFromCommandLine (const String& commandLine, const String& commandLineUID)
+{
+    return ChildProcessWorker::initialiseFromCommandLine (commandLine, commandLineUID);
+}
+
+void PluginScannerWorker::handleMessageFromCoordinator (const MemoryBlock& mb)
+{
+    if (mb.isEmpty())
+        return;
+
+    // Plugins are scanned on the message thread, so that this thread stays free to
+    // answer pings from the coordinator while a slow plugin is being loaded
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        pendingRequests.push (mb);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void PluginScannerWorker::handleConnectionLost()
+{
+    // The coordinator has either finished or given up on us. The message thread may be
+    // stuck inside a plugin, so there's no point trying to shut down cleanly.
+    Process::terminate();
+}
+
+void PluginScannerWorker::handleAsyncUpdate()
+{
+    for (;;)
+    {
+        MemoryBlock request;
+
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+
+            if (pendingRequests.empty())
+                return;
+
+            request = std::move (pendingRequests.front());
+            pendingRequests.pop();
+        }
+
+        MemoryInputStream stream (request, false);
+        const auto formatName = stream.readString();
+        const auto identifier = stream.readString();
+
+        OwnedArray<PluginDescription> results;
+
+        for (auto* format : formatManager->getFormats())
+            if (format->getName() == formatName)
+                format->findAllTypesForFile (results, identifier);
+
+        XmlElement xml ("LIST");
+
+        for (const auto* desc : results)
+            xml.addChildElement (desc->createXml().release());
+
+        const auto text = xml.toString (XmlElement::TextFormat().singleLine());
+        sendMessageToCoordinator ({ text.toRawUTF8(), text.getNumBytesAsUTF8() });
+    }
+}
+
+} // namespace juce
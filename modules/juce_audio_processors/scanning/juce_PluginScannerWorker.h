@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Runs inside a child process, and scans plugins on behalf of a
+    PluginDirectoryScanner in the parent process.
+
+    PluginDirectoryScanner::scanRemainingFilesInChildProcesses() launches several
+    copies of your app's executable with a special command line. Your app must check
+    for this command line as early as possible in its initialise() method, and if it's
+    found, act as a scanner instead of starting normally:
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        auto worker = std::make_unique<PluginScannerWorker>();
+
+        if (worker->initialiseFromCommandLine (commandLine))
+        {
+            scannerWorker = std::move (worker);
+            return;
+        }
+
+        // ...normal app startup
+    }
+    @endcode
+
+    The worker scans each plugin on the message thread, so the app's message loop
+    must be allowed to run. If the connection to the parent process is lost, for
+    example because a plugin took too long to scan, the worker process terminates
+    itself immediately.
+
+    @see PluginDirectoryScanner::scanRemainingFilesInChildProcesses
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScannerWorker  : private ChildProcessWorker,
+                                       private AsyncUpdater
+{
+public:
+    //==============================================================================
+    /** The default command line ID that's used to recognise a scanner process. */
+    static constexpr const char* defaultCommandLineUID = "juceScannerWorker";
+
+    /** Creates a worker that can scan all of the default plugin formats. */
+    PluginScannerWorker();
+
+    /** Creates a worker that can scan the formats in the given manager. */
+    explicit PluginScannerWorker (std::unique_ptr<AudioPluginFormatManager> formatManager);
+
+    /** Destructor. */
+    ~PluginScannerWorker() override;
+
+    //==============================================================================
+    /** Checks whether this process was launched as a scanner, and if so, connects to
+        the parent process.
+
+        Returns true if this process should act as a scanner, in which case the
+        PluginScannerWorker must be kept alive until the process exits.
+    */
+    bool initialiseFromCommandLine (const String& commandLine,
+                                    const String& commandLineUID = defaultCommandLineUID);
+
+private:
+    //==============================================================================
+    void handleMessageFromCoordinator (const MemoryBlock&) override;
+    void handleConnectionLost() override;
+    void handleAsyncUpdate() override;
+
+    std::unique_ptr<AudioPluginFormatManager> formatManager;
+    std::mutex mutex;
+    std::queue<MemoryBlock> pendingRequests;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScannerWorker)
+};
+
+} // namespace juce
@@ -0,0 +1,906 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  Starts the creation of each instance for a pool. Normally this happens asynchronously on
+    the message thread, but the tests can replace it while they construct their pools, as the
+    message thread doesn't run during the tests.
+*/
+struct AudioPluginInstancePoolCreator
+{
+    using Function = std::function<void (const PluginDescription&, double, int, AudioPluginFormat::PluginCreationCallback)>;
+
+    static Function get (AudioPluginFormatManager& manager)
+    {
+        if (auto& replacement = getReplacement(); replacement != nullptr)
+            return replacement;
+
+        return [&manager] (const PluginDescription& description,
+                           double sampleRate,
+                           int blockSize,
+                           AudioPluginFormat::PluginCreationCallback callback)
+        {
+            manager.createPluginInstanceAsync (description, sampleRate, blockSize, std::move (callback));
+        };
+    }
+
+    /*  Replaces the function for any pools that are created while this object exists. */
+    struct ScopedReplacement
+    {
+        explicit ScopedReplacement (Function f)
+            : previous (std::exchange (getReplacement(), std::move (f))) {}
+
+        ~ScopedReplacement()    { getReplacement() = std::move (previous); }
+
+        Function previous;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedReplacement)
+    };
+
+private:
+    static Function& getReplacement()
+    {
+        static Function replacement;
+        return replacement;
+    }
+};
+
+//==============================================================================
+class AudioPluginInstancePool::Pimpl : public std::enable_shared_from_this<Pimpl>
+{
+public:
+    using Options = AudioPluginInstancePool::Options;
+    using Instances = std::vector<std::unique_ptr<AudioPluginInstance>>;
+
+    Pimpl (AudioPluginFormatManager& manager, const Options& o)
+        : formatManager (manager), createInstanceAsync (AudioPluginInstancePoolCreator::get (manager)), options (o) {}
+
+    //==============================================================================
+    void setOptions (const Options& newOptions)
+    {
+        const ScopedLock sl (lock);
+        options = newOptions;
+    }
+
+    Options getOptions() const
+    {
+        const ScopedLock sl (lock);
+        return options;
+    }
+
+    void addPlugin (const PluginDescription& description)
+    {
+        const ScopedLock sl (lock);
+        auto& plugin = plugins[description.createIdentifierString()];
+        plugin.description = description;
+        plugin.wanted = true;
+        plugin.numFailures = 0;
+        plugin.lastUsed = ++useCounter;
+    }
+
+    bool hasCreationFailed (const PluginDescription& description) const
+    {
+        const ScopedLock sl (lock);
+        const auto iter = plugins.find (description.createIdentifierString());
+        return iter != plugins.end() && iter->second.numFailures > 0;
+    }
+
+    void retryFailedPlugins()
+    {
+        const ScopedLock sl (lock);
+
+        for (auto& [key, plugin] : plugins)
+            plugin.retryTime = Time::getMillisecondCounter();
+    }
+
+    Instances removePlugin (const PluginDescription& description)
+    {
+        const ScopedLock sl (lock);
+
+        const auto iter = plugins.find (description.createIdentifierString());
+
+        if (iter == plugins.end())
+            return {};
+
+        auto removed = takeAllInstances (iter->second);
+        iter->second.wanted = false;
+        eraseIfUnused (iter);
+        return removed;
+    }
+
+    Instances clear()
+    {
+        const ScopedLock sl (lock);
+        Instances removed;
+
+        for (auto iter = plugins.begin(); iter != plugins.end();)
+        {
+            for (auto& instance : takeAllInstances (iter->second))
+                removed.push_back (std::move (instance));
+
+            iter->second.wanted = false;
+            iter = iter->second.numPending == 0 ? plugins.erase (iter) : std::next (iter);
+        }
+
+        return removed;
+    }
+
+    std::unique_ptr<AudioPluginInstance> takeInstance (const PluginDescription& description)
+    {
+        const ScopedLock sl (lock);
+
+        const auto iter = plugins.find (description.createIdentifierString());
+
+        if (iter == plugins.end())
+            return {};
+
+        auto& plugin = iter->second;
+        plugin.lastUsed = ++useCounter;
+
+        const auto entry = std::find_if (plugin.entries.begin(), plugin.entries.end(), [this] (const Entry& e)
+        {
+            return isPreparedWithCurrentOptions (e);
+        });
+
+        if (entry == plugin.entries.end())
+            return {};
+
+        auto instance = std::move (entry->instance);
+        plugin.entries.erase (entry);
+        return instance;
+    }
+
+    //==============================================================================
+    int getNumReadyInstances (const PluginDescription& description) const
+    {
+        const ScopedLock sl (lock);
+
+        const auto iter = plugins.find (description.createIdentifierString());
+
+        if (iter == plugins.end())
+            return 0;
+
+        return (int) std::count_if (iter->second.entries.begin(), iter->second.entries.end(), [this] (const Entry& e)
+        {
+            return isPreparedWithCurrentOptions (e);
+        });
+    }
+
+    int getTotalNumInstances() const
+    {
+        const ScopedLock sl (lock);
+        return getNumInstances();
+    }
+
+    size_t getMemoryUsage() const
+    {
+        const ScopedLock sl (lock);
+        return getTotalMemoryUsage();
+    }
+
+    //==============================================================================
+    int useTimeSlice()
+    {
+        if (prepareNextInstance())
+            return 0;
+
+        Instances evicted;
+        std::optional<PluginDescription> toCreate;
+        Options currentOptions;
+
+        {
+            const ScopedLock sl (lock);
+            currentOptions = options;
+
+            while (isOverLimit (0, 0))
+                if (! evictLeastRecentlyUsed (evicted, std::numeric_limits<uint64>::max()))
+                    break;
+
+            if (auto* plugin = findPluginThatNeedsAnInstance())
+            {
+                while (isOverLimit (1, plugin->lastMemoryUsage))
+                    if (! evictLeastRecentlyUsed (evicted, plugin->lastUsed))
+                        break;
+
+                if (! isOverLimit (1, plugin->lastMemoryUsage))
+                {
+                    ++plugin->numPending;
+                    toCreate = plugin->description;
+                }
+            }
+        }
+
+        deleteOnMessageThread (std::move (evicted));
+
+        if (! toCreate.has_value())
+            return 100;
+
+        createInstanceAsync (*toCreate, currentOptions.sampleRate, currentOptions.blockSize,
+                             [weak = weak_from_this(), key = toCreate->createIdentifierString()]
+                             (std::unique_ptr<AudioPluginInstance> instance, const String&)
+        {
+            if (auto strong = weak.lock())
+                strong->creationFinished (key, std::move (instance));
+        });
+
+        return 10;
+    }
+
+    AudioPluginFormatManager& getFormatManager() const noexcept    { return formatManager; }
+
+    //==============================================================================
+    static void prepare (AudioPluginInstance& instance, double sampleRate, int blockSize)
+    {
+        instance.setRateAndBufferSizeDetails (sampleRate, blockSize);
+        instance.prepareToPlay (sampleRate, blockSize);
+    }
+
+    static void deleteOnMessageThread (Instances instances)
+    {
+        // Instances that aren't deleted here are destroyed when this function returns
+        if (instances.empty() || MessageManager::getInstance()->isThisTheMessageThread())
+            return;
+
+        auto shared = std::make_shared<Instances> (std::move (instances));
+        MessageManager::callAsync ([shared] { shared->clear(); });
+    }
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        std::unique_ptr<AudioPluginInstance> instance;
+        double sampleRate = 0.0;
+        int blockSize = 0;
+        size_t memoryUsage = 0;
+    };
+
+    struct Plugin
+    {
+        PluginDescription description;
+        std::vector<Entry> entries;
+        int numPending = 0;
+        uint64 lastUsed = 0;
+        size_t lastMemoryUsage = 0;
+        int numFailures = 0;
+        std::optional<uint32> retryTime;
+        bool wanted = true;
+    };
+
+    using PluginMap = std::map<String, Plugin>;
+
+    //==============================================================================
+    bool isPreparedWithCurrentOptions (const Entry& e) const
+    {
+        return e.instance != nullptr
+            && exactlyEqual (e.sampleRate, options.sampleRate)
+            && e.blockSize == options.blockSize;
+    }
+
+    int getNumInstances() const
+    {
+        auto total = 0;
+
+        for (const auto& [key, plugin] : plugins)
+            total += (int) plugin.entries.size() + plugin.numPending;
+
+        return total;
+    }
+
+    size_t getTotalMemoryUsage() const
+    {
+        size_t total = 0;
+
+        for (const auto& [key, plugin] : plugins)
+        {
+            total += (size_t) plugin.numPending * plugin.lastMemoryUsage;
+
+            for (const auto& entry : plugin.entries)
+                total += entry.memoryUsage;
+        }
+
+        return total;
+    }
+
+    bool isOverLimit (int extraInstances, size_t extraBytes) const
+    {
+        if (getNumInstances() + extraInstances > options.maxNumInstances)
+            return true;
+
+        return options.maxMemoryBytes > 0
+            && options.getMemoryUsage != nullptr
+            && getTotalMemoryUsage() + extraBytes > options.maxMemoryBytes;
+    }
+
+    static bool isWaitingToRetry (const Plugin& plugin)
+    {
+        if (plugin.numFailures == 0)
+            return false;
+
+        // The counter wraps, so compare the difference
+        return ! plugin.retryTime.has_value()
+            || (int32) (Time::getMillisecondCounter() - *plugin.retryTime) < 0;
+    }
+
+    std::optional<uint32> getRetryTime (int numFailures) const
+    {
+        if (options.retryDelayMs < 0)
+            return {};
+
+        constexpr int64 maxDelayMs = 10 * 60 * 1000;
+        const auto delayMs = jmin (maxDelayMs, (int64) options.retryDelayMs << jmin (numFailures - 1, 16));
+        return Time::getMillisecondCounter() + (uint32) delayMs;
+    }
+
+    Plugin* findPluginThatNeedsAnInstance()
+    {
+        Plugin* best = nullptr;
+
+        for (auto& [key, plugin] : plugins)
+        {
+            if (plugin.wanted
+                && ! isWaitingToRetry (plugin)
+                && (int) plugin.entries.size() + plugin.numPending < options.numInstancesPerPlugin
+                && (best == nullptr || plugin.lastUsed > best->lastUsed))
+            {
+                best = &plugin;
+            }
+        }
+
+        return best;
+    }
+
+    /*  Removes one instance of the least recently used plugin that was used before the given
+        time, and returns false if there isn't one.
+    */
+    bool evictLeastRecentlyUsed (Instances& evicted, uint64 usedBefore)
+    {
+        Plugin* victim = nullptr;
+
+        for (auto& [key, plugin] : plugins)
+            if (! plugin.entries.empty()
+                && plugin.lastUsed < usedBefore
+                && (victim == nullptr || plugin.lastUsed < victim->lastUsed))
+                victim = &plugin;
+
+        if (victim == nullptr)
+            return false;
+
+        evicted.push_back (std::move (victim->entries.back().instance));
+        victim->entries.pop_back();
+        return true;
+    }
+
+    static Instances takeAllInstances (Plugin& plugin)
+    {
+        Instances result;
+
+        for (auto& entry : plugin.entries)
+            result.push_back (std::move (entry.instance));
+
+        plugin.entries.clear();
+        return result;
+    }
+
+    void eraseIfUnused (PluginMap::iterator iter)
+    {
+        if (! iter->second.wanted && iter->second.numPending == 0 && iter->second.entries.empty())
+            plugins.erase (iter);
+    }
+
+    //==============================================================================
+    /*  Prepares one instance that is unprepared or was prepared with old settings.
+        The instance is taken out of the pool while it's being prepared, so that the
+        lock isn't held while the plugin does its work.
+    */
+    bool prepareNextInstance()
+    {
+        std::unique_ptr<AudioPluginInstance> instance;
+        String key;
+        Options currentOptions;
+        auto wasPrepared = false;
+
+        {
+            const ScopedLock sl (lock);
+            currentOptions = options;
+
+            for (auto& [pluginKey, plugin] : plugins)
+            {
+                const auto entry = std::find_if (plugin.entries.begin(), plugin.entries.end(), [this] (const Entry& e)
+                {
+                    return ! isPreparedWithCurrentOptions (e);
+                });
+
+                if (entry != plugin.entries.end())
+                {
+                    instance = std::move (entry->instance);
+                    wasPrepared = entry->sampleRate > 0.0;
+                    plugin.entries.erase (entry);
+                    key = pluginKey;
+                    ++plugin.numPending;
+                    break;
+                }
+            }
+        }
+
+        if (instance == nullptr)
+            return false;
+
+        if (wasPrepared)
+            instance->releaseResources();
+
+        prepare (*instance, currentOptions.sampleRate, currentOptions.blockSize);
+
+        const auto memoryUsage = currentOptions.getMemoryUsage != nullptr ? currentOptions.getMemoryUsage (*instance)
+                                                                          : (size_t) 0;
+
+        Instances unwanted;
+
+        {
+            const ScopedLock sl (lock);
+
+            const auto iter = plugins.find (key);
+            jassert (iter != plugins.end());
+
+            auto& plugin = iter->second;
+            --plugin.numPending;
+            plugin.lastMemoryUsage = memoryUsage;
+
+            if (plugin.wanted)
+                plugin.entries.push_back ({ std::move (instance), currentOptions.sampleRate, currentOptions.blockSize, memoryUsage });
+            else
+                unwanted.push_back (std::move (instance));
+
+            eraseIfUnused (iter);
+        }
+
+        deleteOnMessageThread (std::move (unwanted));
+        return true;
+    }
+
+    /*  Called on the message thread when an instance has been created. */
+    void creationFinished (const String& key, std::unique_ptr<AudioPluginInstance> instance)
+    {
+        const ScopedLock sl (lock);
+
+        const auto iter = plugins.find (key);
+
+        if (iter == plugins.end())
+            return;
+
+        auto& plugin = iter->second;
+        --plugin.numPending;
+
+        if (instance == nullptr)
+        {
+            ++plugin.numFailures;
+            plugin.retryTime = getRetryTime (plugin.numFailures);
+        }
+        else
+        {
+            plugin.numFailures = 0;
+
+            if (plugin.wanted)
+                plugin.entries.push_back ({ std::move (instance) });
+        }
+
+        eraseIfUnused (iter);
+    }
+
+    //==============================================================================
+    AudioPluginFormatManager& formatManager;
+    const AudioPluginInstancePoolCreator::Function createInstanceAsync;
+    CriticalSection lock;
+    Options options;
+    PluginMap plugins;
+    uint64 useCounter = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
+};
+
+//==============================================================================
+AudioPluginInstancePool::AudioPluginInstancePool (AudioPluginFormatManager& manager, TimeSliceThread& t)
+    : AudioPluginInstancePool (manager, t, Options{})
+{
+}
+
+AudioPluginInstancePool::AudioPluginInstancePool (AudioPluginFormatManager& manager, TimeSliceThread& t,
+                                                  const Options& options)
+    : pimpl (std::make_shared<Pimpl> (manager, options)),
+      thread (t)
+{
+    thread.addTimeSliceClient (this);
+}
+
+AudioPluginInstancePool::~AudioPluginInstancePool()
+{
+    thread.removeTimeSliceClient (this);
+}
+
+void AudioPluginInstancePool::setOptions (const Options& newOptions)
+{
+    pimpl->setOptions (newOptions);
+    thread.moveToFrontOfQueue (this);
+}
+
+AudioPluginInstancePool::Options AudioPluginInstancePool::getOptions() const
+{
+    return pimpl->getOptions();
+}
+
+void AudioPluginInstancePool::addPlugin (const PluginDescription& description)
+{
+    pimpl->addPlugin (description);
+    thread.moveToFrontOfQueue (this);
+}
+
+void AudioPluginInstancePool::removePlugin (const PluginDescription& description)
+{
+    Pimpl::deleteOnMessageThread (pimpl->removePlugin (description));
+}
+
+void AudioPluginInstancePool::clear()
+{
+    Pimpl::deleteOnMessageThread (pimpl->clear());
+}
+
+bool AudioPluginInstancePool::hasCreationFailed (const PluginDescription& description) const
+{
+    return pimpl->hasCreationFailed (description);
+}
+
+void AudioPluginInstancePool::retryFailedPlugins()
+{
+    pimpl->retryFailedPlugins();
+    thread.moveToFrontOfQueue (this);
+}
+
+std::unique_ptr<AudioPluginInstance> AudioPluginInstancePool::takeInstance (const PluginDescription& description)
+{
+    auto instance = pimpl->takeInstance (description);
+    thread.moveToFrontOfQueue (this);
+    return instance;
+}
+
+std::unique_ptr<AudioPluginInstance> AudioPluginInstancePool::createInstance (const PluginDescription& description,
+                                                                              String& errorMessage)
+{
+    addPlugin (description);
+
+    if (auto instance = takeInstance (description))
+        return instance;
+
+    const auto options = getOptions();
+    auto instance = pimpl->getFormatManager().createPluginInstance (description, options.sampleRate, options.blockSize, errorMessage);
+
+    if (instance != nullptr)
+        Pimpl::prepare (*instance, options.sampleRate, options.blockSize);
+
+    return instance;
+}
+
+int AudioPluginInstancePool::getNumReadyInstances (const PluginDescription& description) const
+{
+    return pimpl->getNumReadyInstances (description);
+}
+
+int AudioPluginInstancePool::getTotalNumInstances() const
+{
+    return pimpl->getTotalNumInstances();
+}
+
+size_t AudioPluginInstancePool::getMemoryUsage() const
+{
+    return pimpl->getMemoryUsage();
+}
+
+int AudioPluginInstancePool::useTimeSlice()
+{
+    return pimpl->useTimeSlice();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AudioPluginInstancePoolTests final : public UnitTest
+{
+    AudioPluginInstancePoolTests()
+        : UnitTest ("AudioPluginInstancePool", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Instances are created and prepared in the background, and replaced when taken");
+        {
+            Options options;
+            options.sampleRate = 48000.0;
+            options.numInstancesPerPlugin = 2;
+            Fixture f (options);
+
+            const auto a = makeDescription ("a");
+            f.pool.addPlugin (a);
+            expect (waitFor ([&] { return f.pool.getNumReadyInstances (a) == 2; }));
+
+            auto instance = f.pool.takeInstance (a);
+            expect (instance != nullptr);
+            expect (exactlyEqual (getPreparedSampleRate (*instance), 48000.0));
+            expect (waitFor ([&] { return f.pool.getNumReadyInstances (a) == 2; }));
+            expectEquals (f.pool.getTotalNumInstances(), 2);
+
+            f.pool.removePlugin (a);
+            expectEquals (f.pool.getTotalNumInstances(), 0);
+            expect (f.pool.takeInstance (a) == nullptr);
+        }
+
+        beginTest ("Changing the options prepares the instances again");
+        {
+            Fixture f ({});
+
+            const auto a = makeDescription ("a");
+            f.pool.addPlugin (a);
+            expect (waitFor ([&] { return f.pool.getNumReadyInstances (a) == 1; }));
+
+            auto options = f.pool.getOptions();
+            options.sampleRate = 96000.0;
+            f.pool.setOptions (options);
+
+            expect (waitFor ([&] { return f.pool.getNumReadyInstances (a) == 1; }));
+            auto instance = f.pool.takeInstance (a);
+            expect (instance != nullptr && exactlyEqual (getPreparedSampleRate (*instance), 96000.0));
+            expectEquals (f.format.getNumCreated(), 1);
+        }
+
+        beginTest ("The least recently used plugins are evicted when the pool is full");
+        {
+            Options options;
+            options.maxNumInstances = 2;
+            Fixture f (options);
+
+            const auto a = makeDescription ("a"), b = makeDescription ("b"), c = makeDescription ("c");
+
+            for (const auto& desc : { a, b, c })
+            {
+                f.pool.addPlugin (desc);
+                expect (waitFor ([&] { return f.pool.getNumReadyInstances (desc) == 1; }));
+            }
+
+            expect (waitFor ([&] { return f.pool.getTotalNumInstances() == 2; }));
+            expectEquals (f.pool.getNumReadyInstances (a), 0);
+            expectEquals (f.pool.getNumReadyInstances (b), 1);
+        }
+
+        beginTest ("The memory limit is respected");
+        {
+            Options options;
+            options.maxMemoryBytes = 250;
+            options.getMemoryUsage = [] (AudioPluginInstance&) { return (size_t) 100; };
+            Fixture f (options);
+
+            const auto a = makeDescription ("a"), b = makeDescription ("b"), c = makeDescription ("c");
+
+            for (const auto& desc : { a, b, c })
+            {
+                f.pool.addPlugin (desc);
+                expect (waitFor ([&] { return f.pool.getNumReadyInstances (desc) == 1; }));
+            }
+
+            expect (waitFor ([&] { return f.pool.getMemoryUsage() <= 250; }));
+            expectEquals (f.pool.getNumReadyInstances (a), 0);
+        }
+
+        beginTest ("Plugins that fail to load are tried again after a delay");
+        {
+            Options options;
+            options.retryDelayMs = 10;
+            Fixture f (options);
+            f.format.setNumFailures (2);
+
+            const auto a = makeDescription ("a");
+            f.pool.addPlugin (a);
+
+            expect (waitFor ([&] { return f.pool.getNumReadyInstances (a) == 1; }));
+            expect (! f.pool.hasCreationFailed (a));
+            expectEquals (f.format.getNumAttempts(), 3);
+        }
+
+        beginTest ("Plugins that fail to load can be retried on request");
+        {
+            Options options;
+            options.retryDelayMs = -1;
+            Fixture f (options);
+            f.format.setNumFailures (1);
+
+            const auto a = makeDescription ("a");
+            f.pool.addPlugin (a);
+
+            expect (waitFor ([&] { return f.pool.hasCreationFailed (a); }));
+            Thread::sleep (200);
+            expectEquals (f.format.getNumAttempts(), 1);
+
+            f.pool.retryFailedPlugins();
+            expect (waitFor ([&] { return f.pool.getNumReadyInstances (a) == 1; }));
+            expect (! f.pool.hasCreationFailed (a));
+        }
+
+        beginTest ("createInstance returns a prepared instance when none is ready");
+        {
+            Options options;
+            options.blockSize = 64;
+            Fixture f (options, false);
+
+            const auto a = makeDescription ("a");
+            String error;
+            auto instance = f.pool.createInstance (a, error);
+
+            expect (instance != nullptr);
+            expectEquals (instance->getBlockSize(), 64);
+            expect (exactlyEqual (getPreparedSampleRate (*instance), options.sampleRate));
+
+            // The plugin was added, so an instance will be ready next time
+            f.thread.startThread();
+            expect (waitFor ([&] { return f.pool.getNumReadyInstances (a) == 1; }));
+        }
+    }
+
+private:
+    using Options = AudioPluginInstancePool::Options;
+
+    static PluginDescription makeDescription (const String& name)
+    {
+        PluginDescription desc;
+        desc.name = name;
+        desc.fileOrIdentifier = name;
+        desc.pluginFormatName = StubFormat::name;
+        desc.uniqueId = (int) name.hashCode();
+        return desc;
+    }
+
+    template <typename Condition>
+    static bool waitFor (Condition&& condition)
+    {
+        for (const auto end = Time::getMillisecondCounter() + 5000; Time::getMillisecondCounter() < end; Thread::sleep (1))
+            if (condition())
+                return true;
+
+        return condition();
+    }
+
+    struct StubInstance final : public AudioPluginInstance
+    {
+        explicit StubInstance (const PluginDescription& d) : description (d) {}
+
+        void fillInPluginDescription (PluginDescription& d) const override   { d = description; }
+        const String getName() const override                                { return description.name; }
+        void prepareToPlay (double sampleRate, int) override                 { preparedSampleRate = sampleRate; }
+        void releaseResources() override                                     { preparedSampleRate = 0.0; }
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override        {}
+        using AudioPluginInstance::processBlock;
+        double getTailLengthSeconds() const override                         { return 0.0; }
+        bool acceptsMidi() const override                                    { return false; }
+        bool producesMidi() const override                                   { return false; }
+        AudioProcessorEditor* createEditor() override                        { return nullptr; }
+        bool hasEditor() const override                                      { return false; }
+        int getNumPrograms() override                                        { return 1; }
+        int getCurrentProgram() override                                     { return 0; }
+        void setCurrentProgram (int) override                                {}
+        const String getProgramName (int) override                           { return {}; }
+        void changeProgramName (int, const String&) override                 {}
+        void getStateInformation (MemoryBlock&) override                     {}
+        void setStateInformation (const void*, int) override                 {}
+
+        PluginDescription description;
+        double preparedSampleRate = 0.0;
+    };
+
+    static double getPreparedSampleRate (AudioPluginInstance& instance)
+    {
+        return dynamic_cast<StubInstance&> (instance).preparedSampleRate;
+    }
+
+    /*  Creates StubInstances on the calling thread. The first few attempts can be made to fail. */
+    struct StubFormat final : public AudioPluginFormat
+    {
+        static constexpr auto name = "Stub";
+
+        String getName() const override                                               { return name; }
+        void findAllTypesForFile (OwnedArray<PluginDescription>&, const String&) override {}
+        bool fileMightContainThisPluginType (const String&) override                  { return true; }
+        String getNameOfPluginFromIdentifier (const String& id) override              { return id; }
+        bool pluginNeedsRescanning (const PluginDescription&) override                { return false; }
+        bool doesPluginStillExist (const PluginDescription&) override                 { return true; }
+        bool canScanForPlugins() const override                                       { return false; }
+        bool isTrivialToScan() const override                                         { return true; }
+        StringArray searchPathsForPlugins (const FileSearchPath&, bool, bool) override { return {}; }
+        FileSearchPath getDefaultLocationsToSearch() override                         { return {}; }
+        bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const override { return false; }
+
+        void createPluginInstance (const PluginDescription& desc, double, int, PluginCreationCallback callback) override
+        {
+            ++numAttempts;
+
+            if (numFailuresRemaining > 0)
+            {
+                --numFailuresRemaining;
+                callback (nullptr, "Failed on purpose");
+                return;
+            }
+
+            ++numCreated;
+            callback (std::make_unique<StubInstance> (desc), {});
+        }
+
+        void setNumFailures (int n)     { numFailuresRemaining = n; }
+        int getNumAttempts() const      { return numAttempts; }
+        int getNumCreated() const       { return numCreated; }
+
+    private:
+        std::atomic<int> numFailuresRemaining { 0 }, numAttempts { 0 }, numCreated { 0 };
+    };
+
+    /*  A pool whose instances are created straight away on its own thread, rather than
+        asynchronously on the message thread, which isn't running during the tests.
+    */
+    struct Fixture
+    {
+        explicit Fixture (const Options& options, bool startThread = true)
+            : format (*new StubFormat),
+              pool (manager, thread, options)
+        {
+            manager.addFormat (std::unique_ptr<AudioPluginFormat> (&format));
+
+            if (startThread)
+                thread.startThread();
+        }
+
+        AudioPluginFormatManager manager;
+        StubFormat& format;
+        TimeSliceThread thread { "Pool test thread" };
+
+        AudioPluginInstancePoolCreator::ScopedReplacement creator { [this] (const PluginDescription& desc, double rate,
+                                                                            int size, auto callback)
+        {
+            format.createPluginInstance (desc, rate, size, std::move (callback));
+        } };
+
+        AudioPluginInstancePool pool;
+    };
+};
+
+static AudioPluginInstancePoolTests audioPluginInstancePoolTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Keeps instances of frequently-used plugins created and prepared in advance, so that
+    they can be handed out without waiting for the plugin to load.
+
+    Creating a plugin with AudioPluginFormatManager::createPluginInstance() loads its
+    module and instantiates it, which can take a long time. A pool uses a TimeSliceThread
+    to create instances of the plugins that have been added to it, and to call
+    prepareToPlay() on them with the sample rate and block size given in its Options.
+    Keeping an instance in the pool also keeps the plugin's module loaded.
+
+    @code
+    AudioPluginInstancePool pool (formatManager, backgroundThread);
+    pool.addPlugin (description);
+
+    // later...
+    String error;
+    auto instance = pool.createInstance (description, error);
+    @endcode
+
+    The instances themselves are created on the message thread, using
+    AudioPluginFormatManager::createPluginInstanceAsync(), so the message thread must
+    be running for the pool to be filled.
+
+    The number of instances and the amount of memory that they use can be limited.
+    When the pool is full, instances of the plugins that were used least recently are
+    destroyed to make room for those that were used more recently.
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioPluginInstancePool  : private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Settings for the pool. */
+    struct Options
+    {
+        /** The sample rate with which to prepare each instance. */
+        double sampleRate = 44100.0;
+
+        /** The block size with which to prepare each instance. */
+        int blockSize = 512;
+
+        /** The number of instances to keep ready for each plugin that has been added. */
+        int numInstancesPerPlugin = 1;
+
+        /** The largest number of instances that the pool will hold at once. */
+        int maxNumInstances = 16;
+
+        /** The largest amount of memory that the pool's instances may use, or 0 for no limit.
+            This has no effect unless getMemoryUsage is set.
+        */
+        size_t maxMemoryBytes = 0;
+
+        /** Returns an estimate of the memory used by an instance. This will be called on the
+            pool's thread once the instance has been prepared.
+        */
+        std::function<size_t (AudioPluginInstance&)> getMemoryUsage;
+
+        /** How long to wait before trying again to create an instance of a plugin that failed
+            to load. The delay doubles with each further failure, up to ten minutes. If this is
+            negative, the pool won't try again until retryFailedPlugins() or addPlugin() is called.
+        */
+        int retryDelayMs = 10000;
+    };
+
+    //==============================================================================
+    /** Creates a pool that will use the given thread to create and prepare instances.
+
+        The thread must be started by the caller, and both the format manager and the
+        thread must outlive the pool.
+    */
+    AudioPluginInstancePool (AudioPluginFormatManager& formatManager, TimeSliceThread& thread);
+
+    /** Creates a pool with the given options. */
+    AudioPluginInstancePool (AudioPluginFormatManager& formatManager, TimeSliceThread& thread,
+                             const Options& options);
+
+    /** Destructor. This destroys any instances that are still in the pool. */
+    ~AudioPluginInstancePool() override;
+
+    //==============================================================================
+    /** Changes the pool's settings.
+
+        If the sample rate or block size have changed, instances in the pool will be
+        prepared again, and if the limits have been reduced, instances will be destroyed.
+    */
+    void setOptions (const Options& newOptions);
+
+    /** Returns the pool's current settings. */
+    Options getOptions() const;
+
+    //==============================================================================
+    /** Starts keeping instances of a plugin ready. */
+    void addPlugin (const PluginDescription& description);
+
+    /** Stops keeping instances of a plugin ready, and destroys any that are in the pool. */
+    void removePlugin (const PluginDescription& description);
+
+    /** Removes all of the plugins, and destroys all of the instances in the pool. */
+    void clear();
+
+    /** Returns true if the last attempt to create an instance of a plugin failed. */
+    bool hasCreationFailed (const PluginDescription& description) const;
+
+    /** Tries again straight away to create instances of any plugins that failed to load,
+        instead of waiting for Options::retryDelayMs to elapse.
+    */
+    void retryFailedPlugins();
+
+    //==============================================================================
+    /** Takes a prepared instance of a plugin from the pool, if one is ready.
+
+        This never blocks, and returns nullptr if there isn't an instance ready. Another
+        instance will be created in the background to replace the one that was taken.
+    */
+    std::unique_ptr<AudioPluginInstance> takeInstance (const PluginDescription& description);
+
+    /** Returns a prepared instance of a plugin, taking it from the pool if possible.
+
+        If the pool doesn't have an instance ready, one is created on the calling thread
+        with AudioPluginFormatManager::createPluginInstance() and prepared, which has the
+        same restrictions as calling that function directly. Either way, the plugin is
+        added to the pool, so that an instance will be ready next time.
+    */
+    std::unique_ptr<AudioPluginInstance> createInstance (const PluginDescription& description,
+                                                         String& errorMessage);
+
+    //==============================================================================
+    /** Returns the number of instances of a plugin that are ready to be taken. */
+    int getNumReadyInstances (const PluginDescription& description) const;
+
+    /** Returns the number of instances that the pool holds or is in the process of
+        creating.
+    */
+    int getTotalNumInstances() const;
+
+    /** Returns the estimated memory used by the instances in the pool. */
+    size_t getMemoryUsage() const;
+
+private:
+    //==============================================================================
+    int useTimeSlice() override;
+
+    class Pimpl;
+    std::shared_ptr<Pimpl> pimpl;
+    TimeSliceThread& thread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPluginInstancePool)
+};
+
+} // namespace juce
@@ -52,10 +52,12 @@
 #include <juce_audio_processors_headless/utilities/juce_VST3ClientExtensions.cpp>
 #include <juce_audio_processors_headless/processors/juce_AudioProcessorParameter.cpp>
 #include <juce_audio_processors_headless/processors/juce_AudioProcessorParameterGroup.cpp>
+#include <juce_audio_processors_headless/processors/juce_AudioProcessorParameterEventQueue.cpp>
 #include <juce_audio_processors_headless/processors/juce_AudioProcessor.cpp>
 #include <juce_audio_processors_headless/processors/juce_PluginDescription.cpp>
 #include <juce_audio_processors_headless/processors/juce_AudioPluginInstance.cpp>
 #include <juce_audio_processors_headless/processors/juce_AudioProcessorGraph.cpp>
+#include <juce_audio_processors_headless/processors/juce_AudioProcessorOfflineRenderer.cpp>
 #include <juce_audio_processors_headless/format/juce_AudioPluginFormat.cpp>
 #include <juce_audio_processors_headless/utilities/juce_AudioProcessorParameterWithID.cpp>
 #include <juce_audio_processors_headless/utilities/juce_RangedAudioParameter.cpp>
@@ -71,3 +73,4 @@
 #include <juce_audio_processors_headless/format_types/juce_VSTPluginFormatHeadless.cpp>
 #include <juce_audio_processors_headless/format_types/juce_ARAHosting.cpp>
 #include <juce_audio_processors_headless/format/juce_AudioPluginFormatManager.cpp>
+#include <juce_audio_processors_headless/format/juce_AudioPluginInstancePool.cpp>
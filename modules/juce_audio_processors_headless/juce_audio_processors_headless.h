@@ -66,6 +66,14 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_events/juce_events.h>
 
+#if JUCE_MODULE_AVAILABLE_juce_data_structures
+ #include <juce_data_structures/juce_data_structures.h>
+#endif
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_formats
+ #include <juce_audio_formats/juce_audio_formats.h>
+#endif
+
 //==============================================================================
 /** Config: JUCE_PLUGINHOST_VST
     Enables the VST audio plugin hosting classes. You will need to have the VST2 SDK files in your header search paths. You can obtain the VST2 SDK files from on older version of the VST3 SDK.
@@ -146,10 +154,12 @@
 #include <juce_audio_processors_headless/processors/juce_AudioProcessorParameter.h>
 #include <juce_audio_processors_headless/processors/juce_HostedAudioProcessorParameter.h>
 #include <juce_audio_processors_headless/processors/juce_AudioProcessorParameterGroup.h>
+#include <juce_audio_processors_headless/processors/juce_AudioProcessorParameterEventQueue.h>
 #include <juce_audio_processors_headless/processors/juce_AudioProcessor.h>
 #include <juce_audio_processors_headless/processors/juce_PluginDescription.h>
 #include <juce_audio_processors_headless/processors/juce_AudioPluginInstance.h>
 #include <juce_audio_processors_headless/processors/juce_AudioProcessorGraph.h>
+#include <juce_audio_processors_headless/processors/juce_AudioProcessorOfflineRenderer.h>
 #include <juce_audio_processors_headless/format/juce_AudioPluginFormat.h>
 #include <juce_audio_processors_headless/utilities/juce_AudioProcessorParameterWithID.h>
 #include <juce_audio_processors_headless/utilities/juce_RangedAudioParameter.h>
@@ -166,3 +176,4 @@
 #include <juce_audio_processors_headless/format_types/juce_VSTPluginFormatHeadless.h>
 #include <juce_audio_processors_headless/format_types/juce_ARAHosting.h>
 #include <juce_audio_processors_headless/format/juce_AudioPluginFormatManager.h>
+#include <juce_audio_processors_headless/format/juce_AudioPluginInstancePool.h>
@@ -989,6 +989,34 @@ void AudioProcessor::setCurrentProgramStateInformation (const void* data, int si
     setStateInformation (data, sizeInBytes);
 }
 
+void AudioProcessor::writeStateInformation (OutputStream& destStream)
+{
+    MemoryBlock state;
+    getStateInformation (state);
+    destStream.write (state.getData(), state.getSize());
+}
+
+void AudioProcessor::readStateInformation (InputStream& sourceStream)
+{
+    // Avoid copying the state if it's already in memory
+    if (auto* memoryStream = dynamic_cast<MemoryInputStream*> (&sourceStream))
+    {
+        const auto position = (size_t) jlimit ((int64) 0, (int64) memoryStream->getDataSize(), memoryStream->getPosition());
+        const auto numBytes = memoryStream->getDataSize() - position;
+
+        // setStateInformation() can't be given more than 2GB at once
+        jassert (numBytes <= (size_t) std::numeric_limits<int>::max());
+
+        memoryStream->setPosition ((int64) memoryStream->getDataSize());
+        setStateInformation (addBytesToPointer (memoryStream->getData(), position), (int) numBytes);
+        return;
+    }
+
+    MemoryBlock state;
+    sourceStream.readIntoMemoryBlock (state);
+    setStateInformation (state.getData(), (int) state.getSize());
+}
+
 //==============================================================================
 void AudioProcessor::updateTrackProperties (const AudioProcessor::TrackProperties&)    {}
 
@@ -996,6 +1024,9 @@ void AudioProcessor::updateTrackProperties (const AudioProcessor::TrackPropertie
 // magic number to identify memory blocks that we've stored as XML
 const uint32 magicXmlNumber = 0x21324356;
 
+// magic number to identify streams that we've stored as binary ValueTrees
+const uint32 magicValueTreeNumber = 0x21324357;
+
 void AudioProcessor::copyXmlToBinary (const XmlElement& xml, juce::MemoryBlock& destData)
 {
     {
@@ -1030,6 +1061,38 @@ std::unique_ptr<XmlElement> AudioProcessor::getXmlFromBinary (const void* data,
     return {};
 }
 
+#if JUCE_MODULE_AVAILABLE_juce_data_structures
+void AudioProcessor::writeValueTreeToStream (const ValueTree& tree, OutputStream& destStream)
+{
+    destStream.writeInt ((int) magicValueTreeNumber);
+    tree.writeToStream (destStream);
+}
+
+ValueTree AudioProcessor::readValueTreeFromStream (InputStream& sourceStream)
+{
+    const auto magic = (uint32) sourceStream.readInt();
+
+    if (magic == magicValueTreeNumber)
+        return ValueTree::readFromStream (sourceStream);
+
+    if (magic == magicXmlNumber)
+    {
+        const auto stringLength = sourceStream.readInt();
+
+        if (stringLength > 0)
+        {
+            MemoryBlock text;
+            sourceStream.readIntoMemoryBlock (text, stringLength);
+
+            if (auto xml = parseXML (text.toString()))
+                return ValueTree::fromXml (*xml);
+        }
+    }
+
+    return {};
+}
+#endif
+
 bool AudioProcessor::canApplyBusCountChange (bool isInput, bool isAdding,
                                              AudioProcessor::BusProperties& outProperties)
 {
@@ -1521,6 +1584,9 @@ void AudioProcessor::ParameterChangeForwarder::parameterValueChanged (int index,
     if (owner == nullptr)
         return;
 
+    if (owner->parameterEventQueue.isEnabled() && ! AudioProcessorParameterEventQueue::ScopedIgnoreNotifiedChanges::isActive())
+        owner->parameterEventQueue.push ({ index, 0, value });
+
     for (int i = owner->listeners.size(); --i >= 0;)
         if (auto* l = owner->listeners[i])
             l->audioProcessorParameterChanged (owner, index, value);
@@ -1542,4 +1608,108 @@ void AudioProcessor::ParameterChangeForwarder::parameterGestureChanged (int inde
 
 JUCE_END_IGNORE_DEPRECATION_WARNINGS
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorStateTests final : public UnitTest
+{
+public:
+    AudioProcessorStateTests()
+        : UnitTest ("AudioProcessor state", UnitTestCategories::audioProcessors) {}
+
+    void runTest() override
+    {
+        beginTest ("the default stream functions use the MemoryBlock functions");
+        {
+            TestProcessor source, dest;
+            source.state.fillWith (0x55);
+
+            MemoryOutputStream out;
+            out.writeInt (1234);
+            source.writeStateInformation (out);
+
+            MemoryInputStream in (out.getData(), out.getDataSize(), false);
+            expectEquals (in.readInt(), 1234);
+            dest.readStateInformation (in);
+
+            expect (dest.state == source.state);
+            expect (in.isExhausted());
+
+            // The state should be read in place when the stream is in memory
+            expect (dest.lastStateData == addBytesToPointer (out.getData(), 4));
+
+            BufferedInputStream bufferedIn (new MemoryInputStream (out.getData(), out.getDataSize(), false), 16, true);
+            bufferedIn.skipNextBytes (4);
+            dest.readStateInformation (bufferedIn);
+
+            expect (dest.state == source.state);
+        }
+
+       #if JUCE_MODULE_AVAILABLE_juce_data_structures
+        beginTest ("ValueTrees can be stored as binary, and read back from binary or XML");
+        {
+            ValueTree tree ("state");
+            tree.setProperty ("gain", 0.5, nullptr);
+            tree.setProperty ("samples", var (MemoryBlock (1000, true)), nullptr);
+            tree.appendChild (ValueTree ("child", { { "name", "x" } }), nullptr);
+
+            MemoryOutputStream binary;
+            AudioProcessor::writeValueTreeToStream (tree, binary);
+
+            MemoryInputStream binaryIn (binary.getData(), binary.getDataSize(), false);
+            expect (AudioProcessor::readValueTreeFromStream (binaryIn).isEquivalentTo (tree));
+
+            ValueTree textTree ("state", { { "gain", 0.5 } });
+            MemoryBlock xml;
+            AudioProcessor::copyXmlToBinary (*textTree.createXml(), xml);
+
+            MemoryInputStream xmlIn (xml, false);
+            const auto fromXml = AudioProcessor::readValueTreeFromStream (xmlIn);
+            expect (fromXml.hasType ("state"));
+            expectEquals ((double) fromXml["gain"], 0.5);
+
+            MemoryInputStream junk ("not a state", 11, false);
+            expect (! AudioProcessor::readValueTreeFromStream (junk).isValid());
+        }
+       #endif
+    }
+
+private:
+    class TestProcessor final : public AudioProcessor
+    {
+    public:
+        const String getName() const override                         { return "Test"; }
+        double getTailLengthSeconds() const override                  { return 0.0; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return false; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return 0; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override {}
+        using AudioProcessor::processBlock;
+
+        void getStateInformation (MemoryBlock& destData) override     { destData = state; }
+
+        void setStateInformation (const void* data, int size) override
+        {
+            lastStateData = data;
+            state = MemoryBlock (data, (size_t) size);
+        }
+
+        MemoryBlock state { 100 };
+        const void* lastStateData = nullptr;
+    };
+};
+
+static AudioProcessorStateTests audioProcessorStateTests;
+
+#endif
+
 } // namespace juce
@@ -1198,6 +1198,16 @@ public:
     /** Returns a flat list of the parameters in the current tree. */
     const Array<AudioProcessorParameter*>& getParameters() const;
 
+    /** Returns the queue of timestamped parameter changes for this processor.
+
+        The queue is disabled until AudioProcessorParameterEventQueue::setCapacity() is
+        called. Once it's enabled, changes to the processor's parameters are added to it,
+        and can be removed in processBlock() in order to apply them at the correct sample.
+
+        @see AudioProcessorParameterEventQueue
+    */
+    AudioProcessorParameterEventQueue& getParameterEventQueue() noexcept    { return parameterEventQueue; }
+
     //==============================================================================
     /** Returns the number of preset programs the processor supports.
 
@@ -1295,6 +1305,33 @@ public:
     */
     virtual void setCurrentProgramStateInformation (const void* data, int sizeInBytes);
 
+    /** Writes the processor's state to a stream.
+
+        Hosts and plugin wrappers call this instead of getStateInformation() when they can
+        store the state without keeping all of it in memory, e.g. when saving a project to a
+        file. If your processor's state is large, override this method to write the state
+        in pieces, rather than building a copy of the whole thing in a MemoryBlock.
+
+        The default implementation calls getStateInformation() and writes the result to
+        the stream.
+
+        @see readStateInformation, writeValueTreeToStream
+    */
+    virtual void writeStateInformation (OutputStream& destStream);
+
+    /** Restores the processor's state from a stream created by writeStateInformation().
+
+        The state is everything from the stream's current position to its end. If you've
+        overridden writeStateInformation(), you should override this method too, and read
+        the state back in pieces.
+
+        The default implementation calls setStateInformation() with the contents of the
+        stream. If the stream is a MemoryInputStream, its data is used without being copied.
+
+        @see writeStateInformation, readValueTreeFromStream
+    */
+    virtual void readStateInformation (InputStream& sourceStream);
+
     /** This method is called when the total number of input or output channels is changed. */
     virtual void numChannelsChanged();
 
@@ -1502,6 +1539,30 @@ public:
     */
     static std::unique_ptr<XmlElement> getXmlFromBinary (const void* data, int sizeInBytes);
 
+   #if JUCE_MODULE_AVAILABLE_juce_data_structures || DOXYGEN
+    /** Helper function that writes a ValueTree to a stream in a compact binary form.
+
+        Use this in your processor's writeStateInformation() or getStateInformation()
+        method if you want to store its state as a ValueTree. This is much smaller and
+        faster to read than converting the tree to XML with copyXmlToBinary(), especially
+        when the tree contains large binary properties.
+
+        Then use readValueTreeFromStream() to reverse this operation. Requires the
+        juce_data_structures module.
+    */
+    static void writeValueTreeToStream (const ValueTree& tree, OutputStream& destStream);
+
+    /** Reads a ValueTree that was written with writeValueTreeToStream().
+
+        This can also read XML that was stored with copyXmlToBinary(), so that state saved
+        by older versions of a processor can still be loaded. This might return an invalid
+        ValueTree if the data is unsuitable or corrupted.
+
+        Requires the juce_data_structures module.
+    */
+    static ValueTree readValueTreeFromStream (InputStream& sourceStream);
+   #endif
+
     /** @internal */
     static void JUCE_CALLTYPE setTypeOfNextNewPlugin (WrapperType);
 
@@ -1755,6 +1816,7 @@ private:
     Array<AudioProcessorParameter*> flatParameterList;
 
     ParameterChangeForwarder parameterListener { this };
+    AudioProcessorParameterEventQueue parameterEventQueue;
 
     AudioProcessorParameter* getParamChecked (int) const;
 
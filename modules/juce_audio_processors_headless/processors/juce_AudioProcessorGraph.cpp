@@ -165,25 +165,43 @@ public:
             return false;
 
         sourcesForDestination[c.destination].insert (c.source);
+        destinationsForSource[c.source].insert (c.destination);
         jassert (isConnected (c));
+        version = getNextVersion();
         return true;
     }
 
     bool removeConnection (const Connection& c)
     {
-        const auto iter = sourcesForDestination.find (c.destination);
-        return iter != sourcesForDestination.cend() && iter->second.erase (c.source) == 1;
+        if (! isConnected (c))
+            return false;
+
+        eraseFromMap (sourcesForDestination, c.destination, c.source);
+        eraseFromMap (destinationsForSource, c.source, c.destination);
+        version = getNextVersion();
+        return true;
     }
 
     bool removeIllegalConnections (const Nodes& n)
     {
         auto anyRemoved = false;
 
-        for (auto& dest : sourcesForDestination)
+        for (auto dest = sourcesForDestination.begin(); dest != sourcesForDestination.end();)
+        {
+            const auto initialSize = dest->second.size();
+            dest->second = removeIllegalConnections (n, std::move (dest->second), dest->first);
+            anyRemoved |= (dest->second.size() != initialSize);
+
+            if (dest->second.empty())
+                dest = sourcesForDestination.erase (dest);
+            else
+                ++dest;
+        }
+
+        if (anyRemoved)
         {
-            const auto initialSize = dest.second.size();
-            dest.second = removeIllegalConnections (n, std::move (dest.second), dest.first);
-            anyRemoved |= (dest.second.size() != initialSize);
+            destinationsForSource = reverse (sourcesForDestination);
+            version = getNextVersion();
         }
 
         return anyRemoved;
@@ -193,15 +211,28 @@ public:
     {
         const auto matchingDestinations = getMatchingDestinations (n);
         auto result = matchingDestinations.first != matchingDestinations.second;
+
+        for (auto it = matchingDestinations.first; it != matchingDestinations.second; ++it)
+            for (const auto& source : it->second)
+                eraseFromMap (destinationsForSource, source, it->first);
+
         sourcesForDestination.erase (matchingDestinations.first, matchingDestinations.second);
 
-        for (auto& pair : sourcesForDestination)
+        const auto matchingSources = getMatchingRange (destinationsForSource, n);
+
+        for (auto it = matchingSources.first; it != matchingSources.second; ++it)
         {
-            const auto range = equalRange (pair.second, n);
-            result |= range.first != range.second;
-            pair.second.erase (range.first, range.second);
+            result |= ! it->second.empty();
+
+            for (const auto& destination : it->second)
+                eraseFromMap (sourcesForDestination, destination, it->first);
         }
 
+        destinationsForSource.erase (matchingSources.first, matchingSources.second);
+
+        if (result)
+            version = getNextVersion();
+
         return result;
     }
 
@@ -267,6 +298,19 @@ public:
         return result;
     }
 
+    std::set<NodeID> getDestinationNodesForSource (NodeID sourceID) const
+    {
+        const auto matchingSources = getMatchingRange (destinationsForSource, sourceID);
+
+        std::set<NodeID> result;
+        std::for_each (matchingSources.first, matchingSources.second, [&] (const auto& pair)
+        {
+            for (const auto& destination : pair.second)
+                result.insert (destination.nodeID);
+        });
+        return result;
+    }
+
     std::set<NodeAndChannel> getSourcesForDestination (const NodeAndChannel& p) const
     {
         const auto iter = sourcesForDestination.find (p);
@@ -294,41 +338,39 @@ public:
     bool operator== (const Connections& other) const { return sourcesForDestination == other.sourcesForDestination; }
     bool operator!= (const Connections& other) const { return sourcesForDestination != other.sourcesForDestination; }
 
+    /*  Returns a number that changes whenever the connections change. Copies share the version
+        of their source, but no two different sets of connections will ever have the same
+        version, so this can be compared instead of the connections themselves.
+    */
+    uint64 getVersion() const noexcept { return version; }
+
     class DestinationsForSources
     {
     public:
-        explicit DestinationsForSources (Map m) : map (std::move (m)) {}
+        explicit DestinationsForSources (const Map& m) : map (m) {}
 
-        bool isSourceConnectedToDestinationNodeIgnoringChannel (const NodeAndChannel& source, NodeID dest, int channel) const
+        /*  Returns true if the callback returns true for any input channel that is connected
+            to the given output.
+        */
+        template <typename Callback>
+        bool anyDestinationOf (const NodeAndChannel& source, Callback&& callback) const
         {
             if (const auto destIter = map.find (source); destIter != map.cend())
-            {
-                const auto [begin, end] = equalRange (destIter->second, dest);
-                return std::any_of (begin, end, [&] (const NodeAndChannel& nodeAndChannel)
-                {
-                    return nodeAndChannel != NodeAndChannel { dest, channel };
-                });
-            }
+                return std::any_of (destIter->second.begin(), destIter->second.end(), callback);
 
             return false;
         }
 
     private:
-        Map map;
+        const Map& map;
     };
 
-    /*  Reverses the graph, to allow fast lookup by source.
-        This is expensive, don't call this more than necessary!
+    /*  Allows fast lookup by source.
+        The returned object refers to this Connections instance, so it must not outlive it.
     */
     auto getDestinationsForSources() const
     {
-        Map destinationsForSources;
-
-        for (const auto& [destination, sources] : sourcesForDestination)
-            for (const auto& source : sources)
-                destinationsForSources[source].insert (destination);
-
-        return DestinationsForSources (std::move (destinationsForSources));
+        return DestinationsForSources (destinationsForSource);
     }
 
 private:
@@ -371,10 +413,241 @@ private:
 
     std::pair<Map::const_iterator, Map::const_iterator> getMatchingDestinations (NodeID destID) const
     {
-        return std::equal_range (sourcesForDestination.cbegin(), sourcesForDestination.cend(), destID, ImplicitNode::compare);
+        return getMatchingRange (sourcesForDestination, destID);
+    }
+
+    /*  Finds all the entries for the given node using the map's own lookup, which is much
+        faster than std::equal_range for large maps, as the map's iterators aren't random-access.
+    */
+    static std::pair<Map::const_iterator, Map::const_iterator> getMatchingRange (const Map& map, NodeID nodeID)
+    {
+        return { map.lower_bound ({ nodeID, std::numeric_limits<int>::lowest() }),
+                 map.upper_bound ({ nodeID, std::numeric_limits<int>::max() }) };
     }
 
-    Map sourcesForDestination;
+    static void eraseFromMap (Map& map, const NodeAndChannel& key, const NodeAndChannel& value)
+    {
+        if (const auto iter = map.find (key); iter != map.end())
+        {
+            iter->second.erase (value);
+
+            if (iter->second.empty())
+                map.erase (iter);
+        }
+    }
+
+    static Map reverse (const Map& map)
+    {
+        Map result;
+
+        for (const auto& [key, values] : map)
+            for (const auto& value : values)
+                result[value].insert (key);
+
+        return result;
+    }
+
+    static uint64 getNextVersion() noexcept
+    {
+        static std::atomic<uint64> lastVersion { 0 };
+        return ++lastVersion;
+    }
+
+    // The reversed map is kept up-to-date on every change, so that lookups by source don't
+    // require a full pass over the connections when the render sequence is rebuilt
+    Map sourcesForDestination, destinationsForSource;
+    uint64 version = getNextVersion();
+};
+
+//==============================================================================
+/*  Maintains the order in which the graph's nodes will be rendered, such that every node comes
+    after all of the nodes that feed into it, except where connections form a feedback loop.
+
+    The order is updated incrementally as the graph changes, so that rebuilding the render
+    sequence of a large graph doesn't need to sort all of the nodes again. Removing nodes or
+    connections can't invalidate the order, new nodes are appended, and new connections are
+    handled using the Pearce-Kelly algorithm, which only reorders the nodes that lie between
+    the two ends of the new connection. If a connection forms a feedback loop, all of the nodes
+    are sorted again once the loop is broken.
+*/
+class RenderOrder
+{
+public:
+    using NodeID = AudioProcessorGraph::NodeID;
+
+    const std::vector<NodeID>& getOrder() const { return order; }
+
+    /*  True if the connections form a feedback loop. While this is the case, the order can't be
+        relied upon.
+    */
+    bool containsFeedback() const { return feedback; }
+
+    void addNode (NodeID nodeID)
+    {
+        positions[nodeID] = order.size();
+        order.push_back (nodeID);
+    }
+
+    void removeNode (NodeID nodeID)
+    {
+        const auto iter = positions.find (nodeID);
+
+        if (iter == positions.end())
+            return;
+
+        const auto position = iter->second;
+        positions.erase (iter);
+        order.erase (order.begin() + (ptrdiff_t) position);
+
+        for (auto i = position; i < order.size(); ++i)
+            positions[order[i]] = i;
+    }
+
+    void clear()
+    {
+        order.clear();
+        positions.clear();
+        feedback = false;
+    }
+
+    /*  Call after removing one or more connections or nodes.
+        If the order contained feedback and the loop has now been broken, all of the nodes are
+        sorted again, so that the order can be maintained incrementally from then on.
+    */
+    void connectionsRemoved (const Connections& c)
+    {
+        if (! feedback)
+            return;
+
+        std::map<NodeID, size_t> numPendingSources;
+        std::vector<NodeID> sorted;
+        sorted.reserve (order.size());
+
+        for (const auto& nodeID : order)
+        {
+            const auto numSources = c.getSourceNodesForDestination (nodeID).size();
+            numPendingSources[nodeID] = numSources;
+
+            if (numSources == 0)
+                sorted.push_back (nodeID);
+        }
+
+        for (size_t i = 0; i < sorted.size(); ++i)
+            for (const auto& destination : c.getDestinationNodesForSource (sorted[i]))
+                if (--numPendingSources[destination] == 0)
+                    sorted.push_back (destination);
+
+        if (sorted.size() != order.size())
+            return; // there's still a feedback loop
+
+        order = std::move (sorted);
+
+        for (size_t i = 0; i < order.size(); ++i)
+            positions[order[i]] = i;
+
+        feedback = false;
+    }
+
+    /*  Call after adding a connection from source to destination. */
+    void addConnection (const Connections& c, NodeID source, NodeID destination)
+    {
+        const auto lowerBound = getPosition (destination);
+        const auto upperBound = getPosition (source);
+
+        if (upperBound < lowerBound)
+            return; // the order is still valid
+
+        // Find the nodes in the affected region that depend on the destination...
+        std::vector<NodeID> forward;
+
+        if (! collectReachable (destination, lowerBound, upperBound, forward, [&] (NodeID n) { return c.getDestinationNodesForSource (n); }))
+        {
+            // the new connection creates a feedback loop, so there's no valid order
+            feedback = true;
+            return;
+        }
+
+        // ...and the nodes in the affected region that the source depends on
+        std::vector<NodeID> backward;
+        collectReachable (source, lowerBound, upperBound, backward, [&] (NodeID n) { return c.getSourceNodesForDestination (n); });
+
+        const auto byPosition = [this] (NodeID a, NodeID b) { return getPosition (a) < getPosition (b); };
+        std::sort (forward.begin(),  forward.end(),  byPosition);
+        std::sort (backward.begin(), backward.end(), byPosition);
+
+        // Reuse the positions of all affected nodes, placing the source's ancestors first
+        std::vector<size_t> freedPositions;
+
+        for (const auto& list : { backward, forward })
+            for (const auto& n : list)
+                freedPositions.push_back (getPosition (n));
+
+        std::sort (freedPositions.begin(), freedPositions.end());
+
+        auto position = freedPositions.begin();
+
+        for (const auto& list : { backward, forward })
+        {
+            for (const auto& n : list)
+            {
+                order[*position] = n;
+                positions[n] = *position;
+                ++position;
+            }
+        }
+    }
+
+private:
+    size_t getPosition (NodeID nodeID) const
+    {
+        const auto iter = positions.find (nodeID);
+        jassert (iter != positions.end());
+        return iter->second;
+    }
+
+    /*  Does a depth-first search from start, visiting only nodes within the given range of
+        positions. Returns false if the search reaches the node at the far end of the range.
+    */
+    template <typename GetNeighbours>
+    bool collectReachable (NodeID start,
+                           size_t lowerBound,
+                           size_t upperBound,
+                           std::vector<NodeID>& visited,
+                           GetNeighbours&& getNeighbours) const
+    {
+        const auto startPosition = getPosition (start);
+        const auto endPosition = startPosition == lowerBound ? upperBound : lowerBound;
+
+        std::set<NodeID> seen { start };
+        std::vector<NodeID> stack { start };
+
+        while (! stack.empty())
+        {
+            const auto n = stack.back();
+            stack.pop_back();
+            visited.push_back (n);
+
+            for (const auto& neighbour : getNeighbours (n))
+            {
+                const auto position = getPosition (neighbour);
+
+                if (position < lowerBound || upperBound < position)
+                    continue;
+
+                if (position == endPosition)
+                    return false;
+
+                if (seen.insert (neighbour).second)
+                    stack.push_back (neighbour);
+            }
+        }
+
+        return true;
+    }
+
+    std::vector<NodeID> order;
+    std::map<NodeID, size_t> positions;
+    bool feedback = false;
 };
 
 //==============================================================================
@@ -473,38 +746,506 @@ public:
 
                 preparedNodes.insert (node->nodeID);
 
-                auto* nodeProcessor = node->getProcessor();
-                const auto precision = nodeProcessor->supportsDoublePrecisionProcessing()
-                                     ? current->precision
-                                     : AudioProcessor::singlePrecision;
+                auto* nodeProcessor = node->getProcessor();
+                const auto precision = nodeProcessor->supportsDoublePrecisionProcessing()
+                                     ? current->precision
+                                     : AudioProcessor::singlePrecision;
+
+                nodeProcessor->setProcessingPrecision (precision);
+                nodeProcessor->setRateAndBufferSizeDetails (current->sampleRate, current->blockSize);
+                nodeProcessor->prepareToPlay               (current->sampleRate, current->blockSize);
+            }
+        }
+
+        return current;
+    }
+
+    /*  Call from the main thread to indicate that a node has been removed from the graph.
+    */
+    void removeNode (const NodeID n)
+    {
+        preparedNodes.erase (n);
+    }
+
+    /*  Call from the main thread to indicate that all nodes have been removed from the graph.
+    */
+    void clear()
+    {
+        preparedNodes.clear();
+    }
+
+private:
+    std::mutex mutex;
+    std::set<NodeID> preparedNodes;
+    std::optional<PrepareSettings> current, next;
+};
+
+//==============================================================================
+/*  The dependencies between the groups of ops that make up a render sequence.
+
+    Each task is a contiguous run of ops in the serial render sequence, ending with a single
+    NodeOp. A task depends on every earlier task that writes a buffer it reads or writes, and
+    every earlier task that reads a buffer it writes. Running tasks in any order that respects
+    these dependencies therefore produces exactly the same output as the serial sequence.
+
+    All storage is allocated on the main thread, when the sequence is built. Running a block
+    doesn't allocate or lock.
+*/
+class GraphTaskSchedule
+{
+public:
+    /*  Identifies something that an op may read or write while processing. */
+    struct Resource
+    {
+        enum class Kind { audioBuffer, midiBuffer, audioOutput, midiOutput };
+
+        Kind kind;
+        int index;
+
+        auto tie() const { return std::tie (kind, index); }
+        bool operator< (const Resource& other) const { return tie() < other.tie(); }
+    };
+
+    struct Access
+    {
+        Resource resource;
+        bool isWrite;
+    };
+
+    /*  Call from the main thread only. Records the resources used by the next op. */
+    void addOp (std::vector<Access> accesses, bool endsTask)
+    {
+        currentAccesses.insert (currentAccesses.end(), accesses.begin(), accesses.end());
+        ++numOps;
+
+        if (endsTask)
+            finishTask();
+    }
+
+    /*  Call from the main thread only, once all ops have been added. */
+    void finalise()
+    {
+        if (numOps != (tasks.empty() ? 0 : tasks.back().endOp))
+            finishTask();
+
+        currentAccesses = {};
+        lastWriters = {};
+        readersSinceWrite = {};
+
+        pendingDependencies = std::vector<std::atomic<int>> (tasks.size());
+        readyTasks = std::vector<std::atomic<int>> (tasks.size());
+    }
+
+    size_t getNumTasks() const { return tasks.size(); }
+
+    /*  Call from the audio thread only, before any thread calls runTasks(). */
+    void resetForNextBlock()
+    {
+        numCompleted = 0;
+        readyRead = 0;
+        readyWrite = 0;
+
+        for (auto& t : readyTasks)
+            t.store (-1, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < tasks.size(); ++i)
+            pendingDependencies[i].store (tasks[i].numDependencies, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < tasks.size(); ++i)
+            if (tasks[i].numDependencies == 0)
+                pushReadyTask ((int) i);
+    }
+
+    /*  May be called from several threads at once.
+        runOps will be called with the range of op indices for each task that this thread picks up.
+        Returns once all tasks in the current block have completed.
+    */
+    template <typename RunOps>
+    void runTasks (RunOps&& runOps)
+    {
+        const auto numTasks = (int) tasks.size();
+
+        RealtimeThreadPool::Backoff backoff;
+
+        while (numCompleted.load() < numTasks)
+        {
+            const auto taskIndex = popReadyTask();
+
+            if (taskIndex < 0)
+            {
+                // Another thread is still running a task that the remaining ones depend on
+                backoff.pause();
+                continue;
+            }
+
+            backoff = {};
+
+            const auto& task = tasks[(size_t) taskIndex];
+            runOps (task.beginOp, task.endOp);
+
+            for (const auto successor : task.successors)
+                if (pendingDependencies[(size_t) successor].fetch_sub (1) == 1)
+                    pushReadyTask (successor);
+
+            ++numCompleted;
+        }
+    }
+
+private:
+    struct Task
+    {
+        size_t beginOp = 0, endOp = 0;
+        std::vector<int> successors;
+        int numDependencies = 0;
+    };
+
+    void finishTask()
+    {
+        const auto taskIndex = (int) tasks.size();
+        const auto beginOp = tasks.empty() ? size_t{} : tasks.back().endOp;
+        tasks.push_back ({ beginOp, numOps, {}, 0 });
+
+        std::set<int> dependencies;
+
+        for (const auto& access : currentAccesses)
+        {
+            if (const auto writer = lastWriters.find (access.resource); writer != lastWriters.end())
+                dependencies.insert (writer->second);
+
+            if (access.isWrite)
+            {
+                auto& readers = readersSinceWrite[access.resource];
+                dependencies.insert (readers.begin(), readers.end());
+            }
+        }
+
+        for (const auto& access : currentAccesses)
+        {
+            if (access.isWrite)
+            {
+                lastWriters[access.resource] = taskIndex;
+                readersSinceWrite[access.resource].clear();
+            }
+        }
+
+        for (const auto& access : currentAccesses)
+            if (! access.isWrite)
+                readersSinceWrite[access.resource].insert (taskIndex);
+
+        dependencies.erase (taskIndex);
+
+        for (const auto dependency : dependencies)
+            tasks[(size_t) dependency].successors.push_back (taskIndex);
+
+        tasks.back().numDependencies = (int) dependencies.size();
+        currentAccesses.clear();
+    }
+
+    void pushReadyTask (int taskIndex)
+    {
+        // Each task becomes ready exactly once per block, so there's always a free slot
+        readyTasks[(size_t) readyWrite++].store (taskIndex);
+    }
+
+    int popReadyTask()
+    {
+        auto index = readyRead.load();
+
+        while (index < readyWrite.load())
+        {
+            if (readyRead.compare_exchange_weak (index, index + 1))
+            {
+                auto& slot = readyTasks[(size_t) index];
+                int result;
+
+                // The slot has been claimed by a writer, but the writer may not have stored
+                // the task index yet
+                while ((result = slot.load()) < 0) {}
+
+                return result;
+            }
+        }
+
+        return -1;
+    }
+
+    std::vector<Task> tasks;
+    size_t numOps = 0;
+
+    std::vector<Access> currentAccesses;
+    std::map<Resource, int> lastWriters;
+    std::map<Resource, std::set<int>> readersSinceWrite;
+
+    std::vector<std::atomic<int>> pendingDependencies, readyTasks;
+    std::atomic<int> numCompleted { 0 }, readyRead { 0 }, readyWrite { 0 };
+};
+
+//==============================================================================
+/*  Collects per-node timing statistics.
+
+    Each node has a Slot, which is updated on the audio thread (and any render threads) using
+    only atomic operations. Slots are created on the main thread while building a render
+    sequence. Each render sequence shares ownership of the slots that it uses, so the profiler
+    may drop the slots of removed nodes while an older sequence is still being rendered.
+*/
+class GraphNodeProfiler
+{
+public:
+    using NodeID      = AudioProcessorGraph::NodeID;
+    using NodeProfile = AudioProcessorGraph::NodeProfile;
+
+    class Slot
+    {
+    public:
+        Slot() { reset(); }
+
+        /*  Call from the main thread only. */
+        void setSampleRate (double sampleRate)
+        {
+            ticksPerSample = sampleRate > 0.0 ? (double) Time::getHighResolutionTicksPerSecond() / sampleRate : 0.0;
+        }
+
+        /*  May be called from any thread. */
+        void addMeasurement (int64 ticks, int numSamples) noexcept
+        {
+            ++numBlocks;
+            totalTicks += ticks;
+            totalSamples += numSamples;
+
+            for (auto current = minTicks.load(); ticks < current && ! minTicks.compare_exchange_weak (current, ticks);) {}
+            for (auto current = maxTicks.load(); ticks > current && ! maxTicks.compare_exchange_weak (current, ticks);) {}
+
+            ++histogram[(size_t) getBucketForTicks (ticks)];
+
+            if ((double) ticks > ticksPerSample.load() * numSamples)
+                ++numOverruns;
+        }
+
+        void reset() noexcept
+        {
+            numBlocks = 0;
+            totalTicks = 0;
+            totalSamples = 0;
+            numOverruns = 0;
+            minTicks = std::numeric_limits<int64>::max();
+            maxTicks = 0;
+
+            for (auto& bucket : histogram)
+                bucket = 0;
+        }
+
+        std::optional<NodeProfile> getProfile() const
+        {
+            const auto blocks = numBlocks.load();
+
+            if (blocks == 0)
+                return {};
+
+            NodeProfile result;
+            result.numBlocks = blocks;
+            result.minMilliseconds  = ticksToMs (minTicks);
+            result.meanMilliseconds = ticksToMs (totalTicks) / (double) blocks;
+            result.maxMilliseconds  = ticksToMs (maxTicks);
+            result.percentile50Milliseconds = getPercentile (0.5);
+            result.percentile90Milliseconds = getPercentile (0.9);
+            result.percentile99Milliseconds = getPercentile (0.99);
+            result.numOverruns = numOverruns;
+
+            if (const auto audioTicks = ticksPerSample.load() * (double) totalSamples.load(); audioTicks > 0.0)
+                result.loadAsProportion = jlimit (0.0, 1.0, (double) totalTicks.load() / audioTicks);
+
+            return result;
+        }
+
+    private:
+        // Buckets are a quarter of an octave wide, starting at one microsecond
+        static constexpr auto numBuckets = 96;
+        static constexpr auto bucketsPerOctave = 4.0;
+
+        static double ticksToMs (int64 ticks)
+        {
+            return Time::highResolutionTicksToSeconds (ticks) * 1000.0;
+        }
+
+        static int getBucketForTicks (int64 ticks)
+        {
+            const auto microseconds = Time::highResolutionTicksToSeconds (ticks) * 1.0e6;
+            return jlimit (0, numBuckets - 1, (int) (bucketsPerOctave * std::log2 (1.0 + microseconds)));
+        }
+
+        double getPercentile (double proportion) const
+        {
+            const auto total = std::accumulate (histogram.begin(), histogram.end(), (int64) 0, [] (auto acc, const auto& bucket)
+            {
+                return acc + bucket.load();
+            });
+
+            const auto target = (int64) std::ceil ((double) total * proportion);
+            int64 count = 0;
+
+            for (size_t i = 0; i < histogram.size(); ++i)
+            {
+                count += histogram[i].load();
+
+                // Report the upper edge of the bucket
+                if (count >= target)
+                    return (std::exp2 ((double) (i + 1) / bucketsPerOctave) - 1.0) / 1000.0;
+            }
+
+            return ticksToMs (maxTicks);
+        }
+
+        std::atomic<int64> numBlocks, totalTicks, totalSamples, numOverruns, minTicks, maxTicks;
+        std::atomic<double> ticksPerSample { 0.0 };
+        std::array<std::atomic<int64>, numBuckets> histogram;
+    };
+
+    /*  Call from the main thread only. */
+    std::shared_ptr<Slot> getSlot (NodeID nodeID, double sampleRate)
+    {
+        auto& slot = slots[nodeID];
+
+        if (slot == nullptr)
+            slot = std::make_shared<Slot>();
+
+        slot->setSampleRate (sampleRate);
+        return slot;
+    }
+
+    /*  Call from the main thread only.
+        Drops the slots of nodes that are no longer in the graph.
+    */
+    void removeUnusedSlots (const Nodes& nodes)
+    {
+        for (auto it = slots.begin(); it != slots.end();)
+        {
+            if (nodes.getNodeForId (it->first) == nullptr)
+                it = slots.erase (it);
+            else
+                ++it;
+        }
+    }
+
+    /*  Call from the main thread only. */
+    std::map<NodeID, NodeProfile> getProfiles (const Nodes& nodes) const
+    {
+        std::map<NodeID, NodeProfile> result;
+
+        for (const auto& [nodeID, slot] : slots)
+            if (nodes.getNodeForId (nodeID) != nullptr)
+                if (const auto profile = slot->getProfile())
+                    result.emplace (nodeID, *profile);
+
+        return result;
+    }
+
+    /*  Call from the main thread only. */
+    void reset()
+    {
+        for (auto& pair : slots)
+            pair.second->reset();
+    }
+
+private:
+    std::map<NodeID, std::shared_ptr<Slot>> slots;
+};
+
+//==============================================================================
+/*  Reassigns the buffers used by a render sequence, so that fewer buffers are needed.
+
+    Each value written to a buffer is live from the op that writes it until the last op that
+    reads it. Because the ops always run in the same order, these live ranges are intervals.
+    The ranges are packed greedily in order of their first op, each taking the lowest-numbered
+    buffer that is free. This is optimal for the given order of ops and the in-place choices
+    made when the sequence was built, but a different order could need fewer buffers.
+
+    Buffer zero is always left in place, as it holds the read-only silence shared by all ops.
+*/
+class GraphBufferAllocator
+{
+public:
+    enum class Usage
+    {
+        read,       // the op only reads the buffer
+        overwrite,  // the op ignores and replaces the buffer's contents
+        modify      // the op reads the buffer and then writes to it
+    };
+
+    /*  Call for each buffer used by each op, in the order in which the ops will be processed.
+        Returns false if the buffer is read before anything writes to it, in which case the
+        sequence must keep its original buffers.
+    */
+    bool addUse (size_t opIndex, int buffer, Usage usage)
+    {
+        if (buffer == 0)
+        {
+            uses.push_back (-1);
+            return true;
+        }
+
+        if (usage == Usage::overwrite)
+        {
+            currentRange[buffer] = (int) ranges.size();
+            ranges.push_back ({ opIndex, opIndex });
+        }
+
+        const auto iter = currentRange.find (buffer);
+
+        if (iter == currentRange.end())
+            return false;
+
+        const auto current = iter->second;
+        ranges[(size_t) current].lastOp = opIndex;
+        uses.push_back (current);
+        return true;
+    }
+
+    /*  Call once all uses have been added. Returns the number of buffers needed. */
+    int allocate()
+    {
+        // Ranges were created in the order of their first op, so they can be allocated in order
+        std::priority_queue<std::pair<size_t, int>, std::vector<std::pair<size_t, int>>, std::greater<>> active;
+        std::set<int> freeBuffers;
+        int numBuffers = 1;
+
+        for (auto& range : ranges)
+        {
+            for (; ! active.empty() && active.top().first < range.firstOp; active.pop())
+                freeBuffers.insert (active.top().second);
 
-                nodeProcessor->setProcessingPrecision (precision);
-                nodeProcessor->setRateAndBufferSizeDetails (current->sampleRate, current->blockSize);
-                nodeProcessor->prepareToPlay               (current->sampleRate, current->blockSize);
+            if (freeBuffers.empty())
+            {
+                range.buffer = numBuffers++;
+            }
+            else
+            {
+                range.buffer = *freeBuffers.begin();
+                freeBuffers.erase (freeBuffers.begin());
             }
+
+            active.emplace (range.lastOp, range.buffer);
         }
 
-        return current;
+        return numBuffers;
     }
 
-    /*  Call from the main thread to indicate that a node has been removed from the graph.
-    */
-    void removeNode (const NodeID n)
+    /*  Returns the new buffer for each use, in the order in which they were added. */
+    int getBufferForUse (size_t useIndex) const
     {
-        preparedNodes.erase (n);
+        const auto range = uses[useIndex];
+        return range < 0 ? 0 : ranges[(size_t) range].buffer;
     }
 
-    /*  Call from the main thread to indicate that all nodes have been removed from the graph.
-    */
-    void clear()
+private:
+    struct Range
     {
-        preparedNodes.clear();
-    }
+        size_t firstOp = 0, lastOp = 0;
+        int buffer = 0;
+    };
 
-private:
-    std::mutex mutex;
-    std::set<NodeID> preparedNodes;
-    std::optional<PrepareSettings> current, next;
+    std::vector<Range> ranges;
+    std::vector<int> uses;
+    std::map<int, int> currentRange;
 };
 
 //==============================================================================
@@ -512,6 +1253,10 @@ template <typename FloatType>
 struct GraphRenderSequence
 {
     using Node = AudioProcessorGraph::Node;
+    using Access = GraphTaskSchedule::Access;
+    using Resource = GraphTaskSchedule::Resource;
+    using Usage = GraphBufferAllocator::Usage;
+    using BufferVisitor = std::function<void (Resource::Kind, int& index, Usage)>;
 
     struct GlobalIO
     {
@@ -526,9 +1271,13 @@ struct GraphRenderSequence
         GlobalIO globalIO;
         AudioPlayHead* audioPlayHead;
         int numSamples;
+        AudioBuffer<float>& precisionConversionBuffer;
     };
 
-    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead)
+    void perform (AudioBuffer<FloatType>& buffer,
+                  MidiBuffer& midiMessages,
+                  AudioPlayHead* audioPlayHead,
+                  RealtimeThreadPool* threadPool)
     {
         auto numSamples = buffer.getNumSamples();
         auto maxSamples = renderingBuffer.getNumSamples();
@@ -547,7 +1296,7 @@ struct GraphRenderSequence
 
                 // Splitting up the buffer like this will cause the play head and host time to be
                 // invalid for all but the first chunk...
-                perform (audioChunk, midiChunk, audioPlayHead);
+                perform (audioChunk, midiChunk, audioPlayHead, threadPool);
 
                 chunkStartSample += maxSamples;
             }
@@ -565,10 +1314,14 @@ struct GraphRenderSequence
                                       midiMessages,
                                       currentMidiOutputBuffer },
                                     audioPlayHead,
-                                    numSamples };
+                                    numSamples,
+                                    *precisionConversionBuffer };
 
-            for (const auto& op : renderOps)
-                op->process (context);
+            if (threadPool != nullptr && canProcessInParallel())
+                processInParallel (context, *threadPool);
+            else
+                for (const auto& op : renderOps)
+                    op->process (context);
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
@@ -596,11 +1349,16 @@ struct GraphRenderSequence
                 FloatVectorOperations::clear (channelBuffer, c.numSamples);
             }
 
+            void visitBuffers (const BufferVisitor& visit) override
+            {
+                visit (Resource::Kind::audioBuffer, index, Usage::overwrite);
+            }
+
             FloatType* channelBuffer = nullptr;
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addOp (std::make_unique<ClearOp> (index));
     }
 
     void addCopyChannelOp (int srcIndex, int dstIndex)
@@ -620,12 +1378,18 @@ struct GraphRenderSequence
                 FloatVectorOperations::copy (toBuffer, fromBuffer, c.numSamples);
             }
 
+            void visitBuffers (const BufferVisitor& visit) override
+            {
+                visit (Resource::Kind::audioBuffer, from, Usage::read);
+                visit (Resource::Kind::audioBuffer, to, Usage::overwrite);
+            }
+
             FloatType* fromBuffer = nullptr;
             FloatType* toBuffer = nullptr;
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<CopyOp> (srcIndex, dstIndex));
     }
 
     void addAddChannelOp (int srcIndex, int dstIndex)
@@ -645,12 +1409,18 @@ struct GraphRenderSequence
                 FloatVectorOperations::add (toBuffer, fromBuffer, c.numSamples);
             }
 
+            void visitBuffers (const BufferVisitor& visit) override
+            {
+                visit (Resource::Kind::audioBuffer, from, Usage::read);
+                visit (Resource::Kind::audioBuffer, to, Usage::modify);
+            }
+
             FloatType* fromBuffer = nullptr;
             FloatType* toBuffer = nullptr;
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<AddOp> (srcIndex, dstIndex));
     }
 
     JUCE_END_IGNORE_WARNINGS_MSVC
@@ -671,11 +1441,16 @@ struct GraphRenderSequence
                 channelBuffer->clear();
             }
 
+            void visitBuffers (const BufferVisitor& visit) override
+            {
+                visit (Resource::Kind::midiBuffer, index, Usage::overwrite);
+            }
+
             MidiBuffer* channelBuffer = nullptr;
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addOp (std::make_unique<ClearOp> (index));
     }
 
     void addCopyMidiBufferOp (int srcIndex, int dstIndex)
@@ -695,12 +1470,18 @@ struct GraphRenderSequence
                 *toBuffer = *fromBuffer;
             }
 
+            void visitBuffers (const BufferVisitor& visit) override
+            {
+                visit (Resource::Kind::midiBuffer, from, Usage::read);
+                visit (Resource::Kind::midiBuffer, to, Usage::overwrite);
+            }
+
             MidiBuffer* fromBuffer = nullptr;
             MidiBuffer* toBuffer = nullptr;
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<CopyOp> (srcIndex, dstIndex));
     }
 
     void addAddMidiBufferOp (int srcIndex, int dstIndex)
@@ -720,12 +1501,18 @@ struct GraphRenderSequence
                 toBuffer->addEvents (*fromBuffer, 0, c.numSamples, 0);
             }
 
+            void visitBuffers (const BufferVisitor& visit) override
+            {
+                visit (Resource::Kind::midiBuffer, from, Usage::read);
+                visit (Resource::Kind::midiBuffer, to, Usage::modify);
+            }
+
             MidiBuffer* fromBuffer = nullptr;
             MidiBuffer* toBuffer = nullptr;
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<AddOp> (srcIndex, dstIndex));
     }
 
     void addDelayChannelOp (int chan, int delaySize)
@@ -758,13 +1545,23 @@ struct GraphRenderSequence
                 }
             }
 
+            void visitBuffers (const BufferVisitor& visit) override
+            {
+                visit (Resource::Kind::audioBuffer, channel, Usage::modify);
+            }
+
+            size_t getDelayLineBytes() const override
+            {
+                return buffer.size() * sizeof (FloatType);
+            }
+
             std::vector<FloatType> buffer;
             FloatType* channelBuffer = nullptr;
-            const int channel;
+            int channel;
             int readIndex = 0, writeIndex;
         };
 
-        renderOps.push_back (std::make_unique<DelayChannelOp> (chan, delaySize));
+        addOp (std::make_unique<DelayChannelOp> (chan, delaySize));
     }
 
     void addProcessOp (const Node::Ptr& node,
@@ -792,32 +1589,106 @@ struct GraphRenderSequence
                 }
             }
 
-            return std::make_unique<ProcessOp> (node,
-                                                audioChannelsUsed,
-                                                totalNumChans,
-                                                midiBuffer,
-                                                *precisionConversionBuffer);
+            return std::make_unique<ProcessOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
         }();
 
-        renderOps.push_back (std::move (op));
+        nodeOps.push_back (op.get());
+        addOp (std::move (op));
+    }
+
+    /*  Call from the main thread only, before the sequence is passed to the audio thread. */
+    void setProfiler (GraphNodeProfiler* profiler, double sampleRate)
+    {
+        profileSlots.clear();
+
+        for (auto* op : nodeOps)
+        {
+            if (profiler != nullptr)
+                op->profile = profileSlots.emplace_back (profiler->getSlot (op->node->nodeID, sampleRate)).get();
+            else
+                op->profile = nullptr;
+        }
+    }
+
+    /*  Call from the main thread only, once all ops have been added.
+        Reassigns the ops' buffers so that fewer buffers are needed.
+    */
+    void minimiseBuffers()
+    {
+        GraphBufferAllocator audioAllocator, midiAllocator;
+
+        const auto getAllocator = [&] (Resource::Kind kind) -> auto&
+        {
+            return kind == Resource::Kind::audioBuffer ? audioAllocator : midiAllocator;
+        };
+
+        for (size_t i = 0; i < renderOps.size(); ++i)
+        {
+            auto canReassign = true;
+
+            renderOps[i]->visitBuffers ([&] (Resource::Kind kind, int& index, Usage usage)
+            {
+                canReassign = getAllocator (kind).addUse (i, index, usage) && canReassign;
+            });
+
+            // Some buffer is read before it has been written, so keep the original assignment
+            if (! canReassign)
+                return;
+        }
+
+        numBuffersNeeded     = audioAllocator.allocate();
+        numMidiBuffersNeeded = midiAllocator .allocate();
+
+        size_t numAudioUses = 0, numMidiUses = 0;
+
+        for (auto& op : renderOps)
+        {
+            op->visitBuffers ([&] (Resource::Kind kind, int& index, Usage)
+            {
+                index = kind == Resource::Kind::audioBuffer ? audioAllocator.getBufferForUse (numAudioUses++)
+                                                            : midiAllocator .getBufferForUse (numMidiUses++);
+            });
+        }
     }
 
-    void prepareBuffers (int blockSize)
+    void prepareBuffers (int blockSize, int numWorkerThreads)
     {
         renderingBuffer.setSize (numBuffersNeeded + 1, blockSize);
         renderingBuffer.clear();
         currentAudioOutputBuffer.setSize (numBuffersNeeded + 1, blockSize);
         currentAudioOutputBuffer.clear();
 
-        precisionConversionBuffer->setSize (numBuffersNeeded, blockSize);
+        // Nodes that only support single precision copy their channels into a conversion buffer.
+        // Each worker thread needs its own conversion buffer, as nodes that require precision
+        // conversion may be processed concurrently
+        workerConversionBuffers.clear();
+        workerConversionBuffers.resize ((size_t) numWorkerThreads);
+
+        if constexpr (std::is_same_v<FloatType, double>)
+        {
+            const auto maxNodeChannels = std::accumulate (nodeOps.begin(), nodeOps.end(), 0, [] (auto acc, const auto* op)
+            {
+                return jmax (acc, op->getNumAudioChannels());
+            });
+
+            precisionConversionBuffer->setSize (maxNodeChannels, blockSize);
+
+            for (auto& b : workerConversionBuffers)
+                b.setSize (maxNodeChannels, blockSize);
+        }
+
+        schedule = std::make_unique<GraphTaskSchedule>();
+
+        for (const auto& op : renderOps)
+            schedule->addOp (getAccesses (*op), op->isNodeOp());
+
+        schedule->finalise();
 
         currentMidiOutputBuffer.clear();
 
         midiBuffers.clearQuick();
         midiBuffers.resize (numMidiBuffersNeeded);
 
-        const int defaultMIDIBufferSize = 512;
-
         midiChunk.ensureSize (defaultMIDIBufferSize);
 
         for (auto&& m : midiBuffers)
@@ -827,6 +1698,30 @@ struct GraphRenderSequence
             op->prepare (renderingBuffer.getArrayOfWritePointers(), midiBuffers.data());
     }
 
+    /*  Call after prepareBuffers(). */
+    AudioProcessorGraph::BufferUsage getBufferUsage() const
+    {
+        AudioProcessorGraph::BufferUsage result;
+        result.numAudioBuffers = numBuffersNeeded;
+        result.numMidiBuffers = numMidiBuffersNeeded;
+
+        result.audioBytes = std::accumulate (workerConversionBuffers.begin(),
+                                             workerConversionBuffers.end(),
+                                             getNumBytes (renderingBuffer)
+                                                + getNumBytes (currentAudioOutputBuffer)
+                                                + getNumBytes (*precisionConversionBuffer),
+                                             [] (auto acc, const auto& b) { return acc + getNumBytes (b); });
+
+        result.midiBytes = (size_t) midiBuffers.size() * (size_t) defaultMIDIBufferSize;
+
+        result.delayLineBytes = std::accumulate (renderOps.begin(), renderOps.end(), (size_t) 0, [] (auto acc, const auto& op)
+        {
+            return acc + op->getDelayLineBytes();
+        });
+
+        return result;
+    }
+
     int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
 
     AudioBuffer<FloatType> renderingBuffer, currentAudioOutputBuffer;
@@ -838,11 +1733,100 @@ struct GraphRenderSequence
 
 private:
     //==============================================================================
+    static constexpr int defaultMIDIBufferSize = 512;
+
     struct RenderOp
     {
         virtual ~RenderOp() = default;
         virtual void prepare (FloatType* const*, MidiBuffer*) = 0;
         virtual void process (const Context&) = 0;
+
+        /*  Calls the visitor with the index of each audio and MIDI buffer that this op uses.
+            The visitor may change the indices, as long as this happens before prepare().
+        */
+        virtual void visitBuffers (const BufferVisitor&) = 0;
+
+        virtual void addGlobalAccesses (std::vector<Access>&) const {}
+        virtual bool isNodeOp() const { return false; }
+        virtual size_t getDelayLineBytes() const { return 0; }
+    };
+
+    static std::vector<Access> getAccesses (RenderOp& op)
+    {
+        std::vector<Access> result;
+
+        op.visitBuffers ([&] (Resource::Kind kind, int& index, Usage usage)
+        {
+            result.push_back ({ { kind, index }, usage != Usage::read });
+        });
+
+        op.addGlobalAccesses (result);
+        return result;
+    }
+
+    template <typename Value>
+    static size_t getNumBytes (const AudioBuffer<Value>& buffer)
+    {
+        return (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples() * sizeof (Value);
+    }
+
+    void addOp (std::unique_ptr<RenderOp> op)
+    {
+        renderOps.push_back (std::move (op));
+    }
+
+    //==============================================================================
+    bool canProcessInParallel() const
+    {
+        return schedule->getNumTasks() > 1 && ! workerConversionBuffers.empty();
+    }
+
+    void processInParallel (const Context& context, RealtimeThreadPool& threadPool)
+    {
+        parallelJob->sequence = this;
+        parallelJob->context = &context;
+        parallelJob->denormalsDisabled = FloatVectorOperations::areDenormalsDisabled();
+
+        schedule->resetForNextBlock();
+        threadPool.beginJob (*parallelJob);
+        parallelJob->help (0);
+        threadPool.endJob (*parallelJob);
+    }
+
+    /*  Runs the tasks of the current block on the audio thread (threadIndex 0) and on the
+        worker threads.
+    */
+    struct ParallelJob final : public RealtimeThreadPool::Job
+    {
+        void help (int threadIndex) override
+        {
+            // The pool may be shared, and have more workers than this graph is allowed to use
+            if (threadIndex > (int) sequence->workerConversionBuffers.size())
+                return;
+
+            // The workers must treat denormals in the same way as the audio thread, otherwise
+            // the output could differ from the serial render sequence
+            const auto wereDenormalsDisabled = FloatVectorOperations::areDenormalsDisabled();
+            FloatVectorOperations::disableDenormalisedNumberSupport (denormalsDisabled);
+
+            const Context threadContext { context->globalIO,
+                                          context->audioPlayHead,
+                                          context->numSamples,
+                                          threadIndex == 0 ? context->precisionConversionBuffer
+                                                           : sequence->workerConversionBuffers[(size_t) threadIndex - 1] };
+
+            sequence->schedule->runTasks ([&] (size_t beginOp, size_t endOp)
+            {
+                for (auto i = beginOp; i < endOp; ++i)
+                    sequence->renderOps[i]->process (threadContext);
+            });
+
+            FloatVectorOperations::disableDenormalisedNumberSupport (wereDenormalsDisabled);
+        }
+
+        GraphRenderSequence* sequence = nullptr;
+        const Context* context = nullptr;
+        bool denormalsDisabled = false;
     };
 
     struct NodeOp : public RenderOp
@@ -855,7 +1839,8 @@ private:
               processor (*n->getProcessor()),
               audioChannelsToUse (audioChannelsUsed),
               audioChannels ((size_t) jmax (1, totalNumChans), nullptr),
-              midiBufferToUse (midiBufferIndex)
+              midiBufferToUse (midiBufferIndex),
+              usesMidi (processor.acceptsMidi() || processor.producesMidi())
         {
             while (audioChannelsToUse.size() < (int) audioChannels.size())
                 audioChannelsToUse.add (0);
@@ -869,20 +1854,64 @@ private:
             midiBuffer = buffers + midiBufferToUse;
         }
 
-        void process (const Context& c) final
+        void visitBuffers (const BufferVisitor& visit) final
         {
-            processor.setPlayHead (c.audioPlayHead);
+            // Channels that the processor doesn't output may be shared with other nodes, so
+            // processors are only allowed to read from them. Channels that the processor only
+            // outputs aren't cleared before processing.
+            const auto numIns  = processor.getTotalNumInputChannels();
+            const auto numOuts = processor.getTotalNumOutputChannels();
+
+            for (auto i = 0; i < getNumAudioChannels(); ++i)
+            {
+                const auto usage = numOuts <= i ? Usage::read
+                                 : numIns  <= i ? Usage::overwrite
+                                                : Usage::modify;
+
+                visit (Resource::Kind::audioBuffer, audioChannelsToUse.getReference (i), usage);
+            }
+
+            visit (Resource::Kind::midiBuffer, midiBufferToUse, getMidiUsage());
+        }
+
+        bool isNodeOp() const final { return true; }
+
+        virtual Usage getMidiUsage() const
+        {
+            // Processors that don't use MIDI are given a scratch buffer, which is cleared before processing
+            return usesMidi ? Usage::modify : Usage::overwrite;
+        }
+
+        int getNumAudioChannels() const
+        {
+            if (processor.getTotalNumInputChannels() == 0 && processor.getTotalNumOutputChannels() == 0)
+                return 0;
 
-            auto numAudioChannels = [this]
+            return (int) audioChannels.size();
+        }
+
+        void process (const Context& c) final
+        {
+            if (profile == nullptr)
             {
-                if (const auto* proc = node->getProcessor())
-                    if (proc->getTotalNumInputChannels() == 0 && proc->getTotalNumOutputChannels() == 0)
-                        return 0;
+                processUntimed (c);
+                return;
+            }
+
+            const auto start = Time::getHighResolutionTicks();
+            processUntimed (c);
+            profile->addMeasurement (Time::getHighResolutionTicks() - start, c.numSamples);
+        }
 
-                return (int) audioChannels.size();
-            }();
+        void processUntimed (const Context& c)
+        {
+            processor.setPlayHead (c.audioPlayHead);
 
-            AudioBuffer<FloatType> buffer { audioChannels.data(), numAudioChannels, c.numSamples };
+            AudioBuffer<FloatType> buffer { audioChannels.data(), getNumAudioChannels(), c.numSamples };
+
+            // The scratch buffer may still hold events left behind by another node
+            if (! usesMidi)
+                midiBuffer->clear();
 
             if (processor.isSuspended())
             {
@@ -891,39 +1920,34 @@ private:
             else
             {
                 const auto bypass = node->isBypassed() && processor.getBypassParameter() == nullptr;
-                processWithBuffer (c.globalIO, bypass, buffer, *midiBuffer);
+                processWithBuffer (c, bypass, buffer, *midiBuffer);
             }
         }
 
-        virtual void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) = 0;
+        virtual void processWithBuffer (const Context&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) = 0;
 
         const Node::Ptr node;
         AudioProcessor& processor;
         MidiBuffer* midiBuffer = nullptr;
+        GraphNodeProfiler::Slot* profile = nullptr;
 
         Array<int> audioChannelsToUse;
         std::vector<FloatType*> audioChannels;
-        const int midiBufferToUse;
+        int midiBufferToUse;
+        bool usesMidi;
     };
 
     struct ProcessOp final : public NodeOp
     {
-        ProcessOp (const Node::Ptr& n,
-                   const Array<int>& audioChannelsUsed,
-                   int totalNumChans,
-                   int midiBufferIndex,
-                   AudioBuffer<float>& tempBuffer)
-            : NodeOp (n, audioChannelsUsed, totalNumChans, midiBufferIndex),
-              temporaryBuffer (tempBuffer)
-        {}
+        using NodeOp::NodeOp;
 
-        void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        void processWithBuffer (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
         {
             const ScopedLock lock { this->processor.getCallbackLock() };
-            callProcess (bypass, audio, midi);
+            callProcess (bypass, audio, midi, c.precisionConversionBuffer);
         }
 
-        void callProcess (bool bypass, AudioBuffer<float>& buffer, MidiBuffer& midi)
+        void callProcess (bool bypass, AudioBuffer<float>& buffer, MidiBuffer& midi, AudioBuffer<float>&)
         {
             if (this->processor.isUsingDoublePrecision())
             {
@@ -942,7 +1966,7 @@ private:
             }
         }
 
-        void callProcess (bool bypass, AudioBuffer<double>& buffer, MidiBuffer& midi)
+        void callProcess (bool bypass, AudioBuffer<double>& buffer, MidiBuffer& midi, AudioBuffer<float>& temporaryBuffer)
         {
             if (this->processor.isUsingDoublePrecision())
             {
@@ -966,18 +1990,16 @@ private:
             else
                 p.processBlock (audio, midi);
         }
-
-        AudioBuffer<float>& temporaryBuffer;
     };
 
     struct MidiInOp final : public NodeOp
     {
         using NodeOp::NodeOp;
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        void processWithBuffer (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
         {
             if (! bypass)
-                midi.addEvents (g.midiIn, 0, audio.getNumSamples(), 0);
+                midi.addEvents (c.globalIO.midiIn, 0, audio.getNumSamples(), 0);
         }
     };
 
@@ -985,10 +2007,17 @@ private:
     {
         using NodeOp::NodeOp;
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
+        Usage getMidiUsage() const final { return Usage::read; }
+
+        void addGlobalAccesses (std::vector<Access>& accesses) const final
+        {
+            accesses.push_back ({ { Resource::Kind::midiOutput, 0 }, true });
+        }
+
+        void processWithBuffer (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) final
         {
             if (! bypass)
-                g.midiOut.addEvents (midi, 0, audio.getNumSamples(), 0);
+                c.globalIO.midiOut.addEvents (midi, 0, audio.getNumSamples(), 0);
         }
     };
 
@@ -996,11 +2025,13 @@ private:
     {
         using NodeOp::NodeOp;
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
+        void processWithBuffer (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
         {
             if (bypass)
                 return;
 
+            const auto& g = c.globalIO;
+
             for (int i = jmin (g.audioIn.getNumChannels(), audio.getNumChannels()); --i >= 0;)
                 audio.copyFrom (i, 0, g.audioIn, i, 0, audio.getNumSamples());
         }
@@ -1010,19 +2041,37 @@ private:
     {
         using NodeOp::NodeOp;
 
-        void processWithBuffer (const GlobalIO& g, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
+        void addGlobalAccesses (std::vector<Access>& accesses) const final
+        {
+            accesses.push_back ({ { Resource::Kind::audioOutput, 0 }, true });
+        }
+
+        void processWithBuffer (const Context& c, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer&) final
         {
             if (bypass)
                 return;
 
+            const auto& g = c.globalIO;
+
             for (int i = jmin (g.audioOut.getNumChannels(), audio.getNumChannels()); --i >= 0;)
                 g.audioOut.addFrom (i, 0, audio, i, 0, audio.getNumSamples());
         }
     };
 
     std::vector<std::unique_ptr<RenderOp>> renderOps;
+    std::vector<NodeOp*> nodeOps;
+
+    // Keeps the profiler slots used by the node ops alive for as long as this sequence exists
+    std::vector<std::shared_ptr<GraphNodeProfiler::Slot>> profileSlots;
 
     std::unique_ptr<AudioBuffer<float>> precisionConversionBuffer = std::make_unique<AudioBuffer<float>>();
+    std::vector<AudioBuffer<float>> workerConversionBuffers;
+
+    // GraphTaskSchedule and ParallelJob hold atomics, so they're heap-allocated to keep the
+    // sequence movable. The schedule is built in prepareBuffers(), once the buffer assignments
+    // are final.
+    std::unique_ptr<GraphTaskSchedule> schedule = std::make_unique<GraphTaskSchedule>();
+    std::unique_ptr<ParallelJob> parallelJob = std::make_unique<ParallelJob>();
 };
 
 //==============================================================================
@@ -1047,16 +2096,24 @@ public:
     static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
 
     template <typename FloatType>
-    static SequenceAndLatency build (const Nodes& n, const Connections& c)
+    static SequenceAndLatency build (const Nodes& n,
+                                     const Connections& c,
+                                     const RenderOrder& o,
+                                     AudioProcessorGraph::BufferAllocation allocation)
     {
         GraphRenderSequence<FloatType> sequence;
-        const RenderSequenceBuilder builder (n, c, sequence);
+        const RenderSequenceBuilder builder (n, c, o, allocation, sequence);
+
+        if (allocation == AudioProcessorGraph::BufferAllocation::minimal)
+            sequence.minimiseBuffers();
+
         return { std::move (sequence), builder.totalLatency };
     }
 
 private:
     //==============================================================================
     const Array<Node*> orderedNodes;
+    std::unordered_map<uint32, int> renderingIndices;
 
     struct AssignedBuffer
     {
@@ -1126,8 +2183,126 @@ private:
         }
     }
 
-    Array<Node*> createOrderedNodeList (const Nodes& n, const Connections& c)
+    /*  Reorders an acyclic list of nodes so that fewer buffers are in use at once, by always
+        rendering next the ready node that frees the most buffers and occupies the fewest.
+        Finding the best possible order is NP-hard in general, so this is a heuristic. Where
+        nodes are equally good, their original order is kept.
+    */
+    static Array<Node*> reorderToReduceLiveBuffers (const Array<Node*>& nodes, const Connections& c)
+    {
+        struct NodeInfo
+        {
+            std::set<NodeAndChannel> inputs;    // the output channels of other nodes that this node reads
+            std::vector<size_t> dependents;
+            int numOutputsUsed = 0, numPendingSources = 0;
+        };
+
+        std::map<NodeID, size_t> indices;
+
+        for (int i = 0; i < nodes.size(); ++i)
+            indices.emplace (nodes.getUnchecked (i)->nodeID, (size_t) i);
+
+        std::vector<NodeInfo> info ((size_t) nodes.size());
+        std::map<NodeAndChannel, int> numPendingConsumers;
+
+        for (size_t i = 0; i < info.size(); ++i)
+        {
+            const auto nodeID = nodes.getUnchecked ((int) i)->nodeID;
+            const auto numIns = nodes.getUnchecked ((int) i)->getProcessor()->getTotalNumInputChannels();
+
+            for (auto channel = 0; channel <= numIns; ++channel)
+                for (const auto& source : c.getSourcesForDestination ({ nodeID, channel == numIns ? midiChannelIndex : channel }))
+                    info[i].inputs.insert (source);
+
+            for (const auto& source : info[i].inputs)
+                ++numPendingConsumers[source];
+
+            for (const auto& sourceID : c.getSourceNodesForDestination (nodeID))
+            {
+                if (const auto iter = indices.find (sourceID); iter != indices.end())
+                {
+                    info[iter->second].dependents.push_back (i);
+                    ++info[i].numPendingSources;
+                }
+            }
+        }
+
+        for (const auto& pair : numPendingConsumers)
+            if (const auto iter = indices.find (pair.first.nodeID); iter != indices.end())
+                ++info[iter->second].numOutputsUsed;
+
+        const auto getScore = [&] (size_t i)
+        {
+            const auto numFreed = std::count_if (info[i].inputs.begin(), info[i].inputs.end(), [&] (const auto& source)
+            {
+                return numPendingConsumers[source] == 1;
+            });
+
+            return (int) numFreed - info[i].numOutputsUsed;
+        };
+
+        std::vector<size_t> ready;
+
+        for (size_t i = 0; i < info.size(); ++i)
+            if (info[i].numPendingSources == 0)
+                ready.push_back (i);
+
+        Array<Node*> result;
+
+        while (! ready.empty())
+        {
+            auto best = ready.begin();
+            auto bestScore = getScore (*best);
+
+            for (auto it = std::next (ready.begin()); it != ready.end(); ++it)
+            {
+                const auto score = getScore (*it);
+
+                if (score > bestScore || (score == bestScore && *it < *best))
+                {
+                    best = it;
+                    bestScore = score;
+                }
+            }
+
+            const auto chosen = *best;
+            ready.erase (best);
+            result.add (nodes.getUnchecked ((int) chosen));
+
+            for (const auto& source : info[chosen].inputs)
+                --numPendingConsumers[source];
+
+            for (const auto dependent : info[chosen].dependents)
+                if (--info[dependent].numPendingSources == 0)
+                    ready.push_back (dependent);
+        }
+
+        jassert (result.size() == nodes.size());
+        return result;
+    }
+
+    Array<Node*> createOrderedNodeList (const Nodes& n,
+                                        const Connections& c,
+                                        const RenderOrder& o,
+                                        AudioProcessorGraph::BufferAllocation allocation)
     {
+        if (! o.containsFeedback())
+        {
+            Array<Node*> result;
+
+            for (const auto& nodeID : o.getOrder())
+                result.add (n.getNodeForId (nodeID));
+
+            jassert (result.size() == n.getNodes().size());
+
+            if (allocation == AudioProcessorGraph::BufferAllocation::minimal)
+                return reorderToReduceLiveBuffers (result, c);
+
+            return result;
+        }
+
+        // The maintained order can't resolve feedback loops, so fall back to sorting all of the nodes
+
         Array<Node*> result;
 
         std::map<NodeID, std::set<NodeID>> nodeParents;
@@ -1501,31 +2676,37 @@ private:
                 b.setFree();
     }
 
+    int getRenderingIndex (NodeID nodeID) const
+    {
+        const auto iter = renderingIndices.find (nodeID.uid);
+        return iter != renderingIndices.end() ? iter->second : -1;
+    }
+
     bool isBufferNeededLater (const Connections::DestinationsForSources& c,
                               const int stepIndexToSearchFrom,
                               const int inputChannelOfIndexToIgnore,
                               const NodeAndChannel output) const
     {
-        if (orderedNodes.size() <= stepIndexToSearchFrom)
-            return false;
-
-        if (c.isSourceConnectedToDestinationNodeIgnoringChannel (output,
-                                                                 orderedNodes.getUnchecked (stepIndexToSearchFrom)->nodeID,
-                                                                 inputChannelOfIndexToIgnore))
-        {
-            return true;
-        }
-
-        return std::any_of (orderedNodes.begin() + stepIndexToSearchFrom + 1, orderedNodes.end(), [&] (const auto* node)
+        // Only visit the destinations of this output, rather than every remaining node
+        return c.anyDestinationOf (output, [&] (const NodeAndChannel& destination)
         {
-            return c.isSourceConnectedToDestinationNodeIgnoringChannel (output, node->nodeID, -1);
+            const auto index = getRenderingIndex (destination.nodeID);
+            return stepIndexToSearchFrom < index
+                || (index == stepIndexToSearchFrom && destination.channelIndex != inputChannelOfIndexToIgnore);
         });
     }
 
     template <typename RenderSequence>
-    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence)
-        : orderedNodes (createOrderedNodeList (n, c))
+    RenderSequenceBuilder (const Nodes& n,
+                           const Connections& c,
+                           const RenderOrder& o,
+                           AudioProcessorGraph::BufferAllocation allocation,
+                           RenderSequence& sequence)
+        : orderedNodes (createOrderedNodeList (n, c, o, allocation))
     {
+        for (int i = 0; i < orderedNodes.size(); ++i)
+            renderingIndices.emplace (orderedNodes.getUnchecked (i)->nodeID.uid, i);
+
         audioBuffers.add (AssignedBuffer::createReadOnlyEmpty()); // first buffer is read-only zeros
         midiBuffers .add (AssignedBuffer::createReadOnlyEmpty());
 
@@ -1555,10 +2736,21 @@ class RenderSequence
 public:
     using AudioGraphIOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
 
-    RenderSequence (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : RenderSequence (s, s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
-                                ? RenderSequenceBuilder::build<float>  (n, c)
-                                : RenderSequenceBuilder::build<double> (n, c))
+    RenderSequence (const PrepareSettings s,
+                    const Nodes& n,
+                    const Connections& c,
+                    const RenderOrder& o,
+                    AudioProcessorGraph::BufferAllocation allocation,
+                    std::shared_ptr<RealtimeThreadPool> pool,
+                    int numWorkers,
+                    std::shared_ptr<GraphNodeProfiler> nodeProfiler)
+        : RenderSequence (s,
+                          s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
+                              ? RenderSequenceBuilder::build<float>  (n, c, o, allocation)
+                              : RenderSequenceBuilder::build<double> (n, c, o, allocation),
+                          std::move (pool),
+                          numWorkers,
+                          std::move (nodeProfiler))
     {
     }
 
@@ -1566,7 +2758,7 @@ public:
     void process (AudioBuffer<FloatType>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
     {
         if (auto* s = std::get_if<GraphRenderSequence<FloatType>> (&sequence.sequence))
-            s->perform (audio, midi, playHead);
+            s->perform (audio, midi, playHead, threadPool.get());
         else
             jassertfalse; // Not prepared for this audio format!
     }
@@ -1574,6 +2766,13 @@ public:
     int getLatencySamples() const { return sequence.latencySamples; }
     PrepareSettings getSettings() const { return settings; }
 
+    AudioProcessorGraph::BufferUsage getBufferUsage() const
+    {
+        AudioProcessorGraph::BufferUsage result;
+        visitRenderSequence (*this, [&] (const auto& seq) { result = seq.getBufferUsage(); });
+        return result;
+    }
+
 private:
     template <typename This, typename Callback>
     static void visitRenderSequence (This& t, Callback&& callback)
@@ -1583,14 +2782,27 @@ private:
         jassertfalse;
     }
 
-    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built)
-        : settings (s), sequence (std::move (built))
+    RenderSequence (const PrepareSettings s,
+                    SequenceAndLatency&& built,
+                    std::shared_ptr<RealtimeThreadPool> pool,
+                    int numWorkers,
+                    std::shared_ptr<GraphNodeProfiler> nodeProfiler)
+        : settings (s), sequence (std::move (built)), threadPool (std::move (pool)), profiler (std::move (nodeProfiler))
     {
-        visitRenderSequence (*this, [&] (auto& seq) { seq.prepareBuffers (settings.blockSize); });
+        visitRenderSequence (*this, [&] (auto& seq)
+        {
+            seq.prepareBuffers (settings.blockSize, numWorkers);
+            seq.setProfiler (profiler.get(), settings.sampleRate);
+        });
     }
 
     PrepareSettings settings;
     SequenceAndLatency sequence;
+
+    // The sequence keeps its thread pool and profiler alive, so that they can't be destroyed
+    // while the audio thread is still using them
+    std::shared_ptr<RealtimeThreadPool> threadPool;
+    std::shared_ptr<GraphNodeProfiler> profiler;
 };
 
 //==============================================================================
@@ -1619,11 +2831,23 @@ public:
 */
 class RenderSequenceSignature
 {
-    auto tie() const { return std::tie (settings, connections, nodes); }
+    auto tie() const { return std::tie (settings, connectionsVersion, nodes, allocation, threadPool, numWorkers, profiler); }
 
 public:
-    RenderSequenceSignature (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : settings (s), connections (c), nodes (getNodeMap (n)) {}
+    RenderSequenceSignature (const PrepareSettings s,
+                             const Nodes& n,
+                             const Connections& c,
+                             AudioProcessorGraph::BufferAllocation bufferAllocation,
+                             const RealtimeThreadPool* pool,
+                             int numWorkersToUse,
+                             const GraphNodeProfiler* nodeProfiler)
+        : settings (s),
+          connectionsVersion (c.getVersion()),
+          nodes (getNodeMap (n)),
+          allocation (bufferAllocation),
+          threadPool (pool),
+          numWorkers (numWorkersToUse),
+          profiler (nodeProfiler) {}
 
     bool operator== (const RenderSequenceSignature& other) const { return tie() == other.tie(); }
     bool operator!= (const RenderSequenceSignature& other) const { return tie() != other.tie(); }
@@ -1648,8 +2872,12 @@ private:
     }
 
     PrepareSettings settings;
-    Connections connections;
+    uint64 connectionsVersion = 0;
     NodeMap nodes;
+    AudioProcessorGraph::BufferAllocation allocation;
+    const RealtimeThreadPool* threadPool = nullptr;
+    int numWorkers = 0;
+    const GraphNodeProfiler* profiler = nullptr;
 };
 
 //==============================================================================
@@ -1725,6 +2953,7 @@ public:
 
         nodes = Nodes{};
         connections = Connections{};
+        renderOrder.clear();
         nodeStates.clear();
         topologyChanged (updateKind);
     }
@@ -1754,6 +2983,7 @@ public:
         if (lastNodeID < idToUse)
             lastNodeID = idToUse;
 
+        renderOrder.addNode (idToUse);
         setParentGraph (added->getProcessor());
 
         topologyChanged (updateKind);
@@ -1764,6 +2994,8 @@ public:
     {
         connections.disconnectNode (nodeID);
         auto result = nodes.removeNode (nodeID);
+        renderOrder.removeNode (nodeID);
+        renderOrder.connectionsRemoved (connections);
         nodeStates.removeNode (nodeID);
         topologyChanged (updateKind);
         return result;
@@ -1805,6 +3037,7 @@ public:
             return false;
 
         jassert (isConnected (c));
+        renderOrder.addConnection (connections, c.source.nodeID, c.destination.nodeID);
         topologyChanged (updateKind);
         return true;
     }
@@ -1814,6 +3047,7 @@ public:
         if (! connections.removeConnection (c))
             return false;
 
+        renderOrder.connectionsRemoved (connections);
         topologyChanged (updateKind);
         return true;
     }
@@ -1823,6 +3057,7 @@ public:
         if (! connections.disconnectNode (nodeID))
             return false;
 
+        renderOrder.connectionsRemoved (connections);
         topologyChanged (updateKind);
         return true;
     }
@@ -1835,6 +3070,7 @@ public:
     bool removeIllegalConnections (UpdateKind updateKind)
     {
         const auto result = connections.removeIllegalConnections (nodes);
+        renderOrder.connectionsRemoved (connections);
         topologyChanged (updateKind);
         return result;
     }
@@ -1877,6 +3113,74 @@ public:
             n->getProcessor()->setNonRealtime (isProcessingNonRealtime);
     }
 
+    void setNumRenderThreads (int numWorkerThreads)
+    {
+        numWorkerThreads = jmax (0, numWorkerThreads);
+
+        if (numWorkerThreads == numRenderThreads)
+            return;
+
+        numRenderThreads = numWorkerThreads;
+        renderThreadPool = numRenderThreads > 0 ? RealtimeThreadPool::getSharedInstance() : nullptr;
+        rebuild (RebuildKind::syncIfMainThread);
+    }
+
+    int getNumRenderThreads() const
+    {
+        return numRenderThreads;
+    }
+
+    int getNumUsableRenderThreads() const
+    {
+        return renderThreadPool != nullptr ? jmin (numRenderThreads, renderThreadPool->getNumWorkers()) : 0;
+    }
+
+    void setNodeProfilingEnabled (bool shouldProfile)
+    {
+        if (shouldProfile == isNodeProfilingEnabled())
+            return;
+
+        // The profiler is retained while disabled, so that its statistics can still be read
+        profilingEnabled = shouldProfile;
+
+        if (profilingEnabled && nodeProfiler == nullptr)
+            nodeProfiler = std::make_shared<GraphNodeProfiler>();
+
+        rebuild (RebuildKind::syncIfMainThread);
+    }
+
+    bool isNodeProfilingEnabled() const
+    {
+        return profilingEnabled;
+    }
+
+    std::map<NodeID, NodeProfile> getNodeProfiles() const
+    {
+        return nodeProfiler != nullptr ? nodeProfiler->getProfiles (nodes) : std::map<NodeID, NodeProfile>{};
+    }
+
+    void resetNodeProfiles()
+    {
+        if (nodeProfiler != nullptr)
+            nodeProfiler->reset();
+    }
+
+    void setBufferAllocation (BufferAllocation newAllocation)
+    {
+        if (std::exchange (bufferAllocation, newAllocation) != newAllocation)
+            rebuild (RebuildKind::syncIfMainThread);
+    }
+
+    BufferAllocation getBufferAllocation() const
+    {
+        return bufferAllocation;
+    }
+
+    BufferUsage getBufferUsage() const
+    {
+        return bufferUsage;
+    }
+
     template <typename Value>
     void processBlock (AudioBuffer<Value>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
     {
@@ -1982,18 +3286,37 @@ private:
             for (const auto node : nodes.getNodes())
                 setParentGraph (node->getProcessor());
 
-            const RenderSequenceSignature newSignature (*newSettings, nodes, connections);
+            if (nodeProfiler != nullptr)
+                nodeProfiler->removeUnusedSlots (nodes);
+
+            const auto activeProfiler = profilingEnabled ? nodeProfiler : nullptr;
+            const RenderSequenceSignature newSignature (*newSettings,
+                                                        nodes,
+                                                        connections,
+                                                        bufferAllocation,
+                                                        renderThreadPool.get(),
+                                                        getNumUsableRenderThreads(),
+                                                        activeProfiler.get());
 
             if (std::exchange (lastBuiltSequence, newSignature) != newSignature)
             {
-                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections);
+                auto sequence = std::make_unique<RenderSequence> (*newSettings,
+                                                                  nodes,
+                                                                  connections,
+                                                                  renderOrder,
+                                                                  bufferAllocation,
+                                                                  renderThreadPool,
+                                                                  getNumUsableRenderThreads(),
+                                                                  activeProfiler);
                 owner->setLatencySamples (sequence->getLatencySamples());
+                bufferUsage = sequence->getBufferUsage();
                 renderSequenceExchange.set (std::move (sequence));
             }
         }
         else
         {
             lastBuiltSequence.reset();
+            bufferUsage = {};
             renderSequenceExchange.set (nullptr);
         }
     }
@@ -2001,8 +3324,15 @@ private:
     AudioProcessorGraph* owner = nullptr;
     Nodes nodes;
     Connections connections;
+    RenderOrder renderOrder;
     NodeStates nodeStates;
     RenderSequenceExchange renderSequenceExchange;
+    std::shared_ptr<RealtimeThreadPool> renderThreadPool;
+    int numRenderThreads = 0;
+    std::shared_ptr<GraphNodeProfiler> nodeProfiler;
+    bool profilingEnabled = false;
+    BufferAllocation bufferAllocation = BufferAllocation::greedy;
+    BufferUsage bufferUsage;
     NodeID lastNodeID;
     std::optional<RenderSequenceSignature> lastBuiltSequence;
     LockingAsyncUpdater updater { [this] { handleAsyncUpdate(); } };
@@ -2054,6 +3384,51 @@ void AudioProcessorGraph::setNonRealtime (bool isProcessingNonRealtime) noexcept
     pimpl->setNonRealtime (isProcessingNonRealtime);
 }
 
+void AudioProcessorGraph::setNumRenderThreads (int numWorkerThreads)
+{
+    pimpl->setNumRenderThreads (numWorkerThreads);
+}
+
+int AudioProcessorGraph::getNumRenderThreads() const noexcept
+{
+    return pimpl->getNumRenderThreads();
+}
+
+void AudioProcessorGraph::setNodeProfilingEnabled (bool shouldProfile)
+{
+    pimpl->setNodeProfilingEnabled (shouldProfile);
+}
+
+bool AudioProcessorGraph::isNodeProfilingEnabled() const noexcept
+{
+    return pimpl->isNodeProfilingEnabled();
+}
+
+std::map<AudioProcessorGraph::NodeID, AudioProcessorGraph::NodeProfile> AudioProcessorGraph::getNodeProfiles() const
+{
+    return pimpl->getNodeProfiles();
+}
+
+void AudioProcessorGraph::resetNodeProfiles()
+{
+    pimpl->resetNodeProfiles();
+}
+
+void AudioProcessorGraph::setBufferAllocation (BufferAllocation newAllocation)
+{
+    pimpl->setBufferAllocation (newAllocation);
+}
+
+AudioProcessorGraph::BufferAllocation AudioProcessorGraph::getBufferAllocation() const noexcept
+{
+    return pimpl->getBufferAllocation();
+}
+
+AudioProcessorGraph::BufferUsage AudioProcessorGraph::getBufferUsage() const
+{
+    return pimpl->getBufferUsage();
+}
+
 AudioProcessorGraph::Node::Ptr AudioProcessorGraph::removeNode (NodeID nodeID, UpdateKind updateKind)
 {
     return pimpl->removeNode (nodeID, updateKind);
@@ -2507,6 +3882,291 @@ public:
             // this graph, so we just want to make sure that we finish the test without timing out.
             logMessage ("render sequence built in " + String (duration) + " ms");
         }
+
+        beginTest ("nodes are rendered after their inputs regardless of the order in which they were added");
+        {
+            AudioProcessorGraph graph;
+            graph.setBusesLayout ({ { AudioChannelSet::stereo() }, { AudioChannelSet::mono() } });
+
+            // Add the nodes and connections from the output backwards, so that each new connection
+            // requires the render order to be updated
+            const auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::IODeviceType::audioOutputNode));
+            std::vector<AudioProcessorGraph::NodeID> chain { output->nodeID };
+
+            for (auto i = 0; i < 8; ++i)
+            {
+                const auto node = graph.addNode (BasicProcessor::make (BasicProcessor::getStereoInMonoOut(), MidiIn::no, MidiOut::no));
+                expect (graph.addConnection ({ { node->nodeID, 0 }, { chain.back(), 0 } }));
+                chain.push_back (node->nodeID);
+            }
+
+            const auto input = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::IODeviceType::audioInputNode));
+            expect (graph.addConnection ({ { input->nodeID, 0 }, { chain.back(), 0 } }));
+
+            constexpr auto blockSize = 128;
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> audio (2, blockSize);
+            audio.clear();
+            audio.setSample (0, 0, 1.0f);
+
+            MidiBuffer midi;
+            graph.processBlock (audio, midi);
+
+            for (auto i = 0; i < blockSize; ++i)
+                expect (exactlyEqual (audio.getSample (0, i), i == 0 ? 1.0f : 0.0f));
+        }
+
+        beginTest ("nodes are rendered after their inputs once a feedback loop has been removed");
+        {
+            AudioProcessorGraph graph;
+            graph.setBusesLayout ({ { AudioChannelSet::stereo() }, { AudioChannelSet::mono() } });
+
+            const auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::IODeviceType::audioOutputNode))->nodeID;
+            const auto r = graph.addNode (BasicProcessor::make (BasicProcessor::getStereoInMonoOut(), MidiIn::no, MidiOut::no))->nodeID;
+            const auto q = graph.addNode (BasicProcessor::make (BasicProcessor::getStereoInMonoOut(), MidiIn::no, MidiOut::no))->nodeID;
+            const auto p = graph.addNode (BasicProcessor::make (BasicProcessor::getStereoInMonoOut(), MidiIn::no, MidiOut::no))->nodeID;
+
+            expect (graph.addConnection ({ { r, 0 }, { output, 0 } }));
+            expect (graph.addConnection ({ { q, 0 }, { r, 0 } }));
+            expect (graph.addConnection ({ { p, 0 }, { q, 0 } }));
+
+            // Close a loop p -> q -> r -> p, and then break it by removing a different connection.
+            // This leaves the connection from r to p, which goes against the order p, q, r.
+            expect (graph.addConnection ({ { r, 0 }, { p, 1 } }));
+            expect (graph.removeConnection ({ { p, 0 }, { q, 0 } }));
+
+            const auto input = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::IODeviceType::audioInputNode))->nodeID;
+            expect (graph.addConnection ({ { input, 0 }, { q, 0 } }));
+            expect (graph.addConnection ({ { p, 0 }, { output, 0 } }));
+
+            constexpr auto blockSize = 128;
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> audio (2, blockSize);
+            audio.clear();
+            audio.setSample (0, 0, 1.0f);
+
+            MidiBuffer midi;
+            graph.processBlock (audio, midi);
+
+            // The impulse reaches the output both directly from r, and through p
+            for (auto i = 0; i < blockSize; ++i)
+                expect (exactlyEqual (audio.getSample (0, i), i == 0 ? 2.0f : 0.0f));
+        }
+
+        beginTest ("minimal buffer allocation produces the same output using fewer buffers");
+        {
+            using BufferAllocation = AudioProcessorGraph::BufferAllocation;
+
+            auto totalGreedyBuffers = 0, totalMinimalBuffers = 0;
+
+            for (const auto seed : { 1, 2, 3 })
+            {
+                AudioProcessorGraph::BufferUsage greedyUsage, minimalUsage;
+                const auto greedy  = renderRandomGraph (seed, BufferAllocation::greedy,  greedyUsage);
+                const auto minimal = renderRandomGraph (seed, BufferAllocation::minimal, minimalUsage);
+
+                expect (std::any_of (greedy.begin(), greedy.end(), [] (auto x) { return ! exactlyEqual (x, 0.0f); }));
+                expect (greedy == minimal);
+                expect (minimalUsage.numAudioBuffers <= greedyUsage.numAudioBuffers);
+                expect (minimalUsage.audioBytes <= greedyUsage.audioBytes);
+
+                totalGreedyBuffers  += greedyUsage.numAudioBuffers;
+                totalMinimalBuffers += minimalUsage.numAudioBuffers;
+            }
+
+            expect (totalMinimalBuffers < totalGreedyBuffers);
+        }
+
+        beginTest ("nodes that don't use MIDI never receive MIDI events from other nodes");
+        {
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+            for (const auto allocation : { AudioProcessorGraph::BufferAllocation::greedy, AudioProcessorGraph::BufferAllocation::minimal })
+            {
+                AudioProcessorGraph graph;
+                graph.setBufferAllocation (allocation);
+                graph.setBusesLayout ({ { AudioChannelSet::stereo() }, { AudioChannelSet::stereo() } });
+
+                const auto midiInput = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::midiInputNode))->nodeID;
+                const auto audioOutput = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+                auto midiNodeProcessor = BasicProcessor::make (BasicProcessor::getStereoProperties(), MidiIn::yes, MidiOut::yes);
+                auto& midiNode = *midiNodeProcessor;
+                const auto a = graph.addNode (std::move (midiNodeProcessor))->nodeID;
+
+                auto audioNodeProcessor = BasicProcessor::make (BasicProcessor::getStereoProperties(), MidiIn::no, MidiOut::no);
+                auto& audioNode = *audioNodeProcessor;
+                const auto b = graph.addNode (std::move (audioNodeProcessor))->nodeID;
+
+                // Nothing reads the MIDI produced by a, so its buffer is free to be reused by b
+                expect (graph.addConnection ({ { midiInput, AudioProcessorGraph::midiChannelIndex }, { a, AudioProcessorGraph::midiChannelIndex } }));
+                expect (graph.addConnection ({ { a, 0 }, { b, 0 } }));
+                expect (graph.addConnection ({ { b, 0 }, { audioOutput, 0 } }));
+
+                constexpr auto blockSize = 128;
+                graph.prepareToPlay (44100.0, blockSize);
+
+                AudioBuffer<float> audio (2, blockSize);
+                audio.clear();
+
+                MidiBuffer midi;
+                midi.addEvent (MidiMessage::noteOn (1, 60, 0.5f), 0);
+                graph.processBlock (audio, midi);
+
+                expect (midiNode.getNumMidiEventsReceived() == 1);
+                expect (audioNode.getNumMidiEventsReceived() == 0);
+            }
+        }
+
+        beginTest ("buffer usage is reported for the current render sequence");
+        {
+            AudioProcessorGraph graph;
+            const auto nodeA = graph.addNode (BasicProcessor::make (BasicProcessor::getStereoProperties(), MidiIn::yes, MidiOut::yes));
+            const auto nodeB = graph.addNode (BasicProcessor::make (BasicProcessor::getStereoProperties(), MidiIn::yes, MidiOut::yes));
+            const auto nodeC = graph.addNode (BasicProcessor::make (BasicProcessor::getStereoProperties(), MidiIn::yes, MidiOut::yes));
+            nodeA->getProcessor()->setLatencySamples (10);
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                expect (graph.addConnection ({ { nodeA->nodeID, channel }, { nodeC->nodeID, channel } }));
+                expect (graph.addConnection ({ { nodeB->nodeID, channel }, { nodeC->nodeID, channel } }));
+            }
+
+            expect (graph.getBufferUsage().getTotalBytes() == 0);
+
+            constexpr auto blockSize = 256;
+            graph.prepareToPlay (44100.0, blockSize);
+
+            const auto usage = graph.getBufferUsage();
+            expect (usage.numAudioBuffers > 0);
+            expect (usage.numMidiBuffers > 0);
+            expect (usage.audioBytes >= (size_t) usage.numAudioBuffers * blockSize * sizeof (float));
+            expect (usage.midiBytes > 0);
+            expect (usage.delayLineBytes >= 2 * 10 * sizeof (float));
+            expect (usage.getTotalBytes() == usage.audioBytes + usage.midiBytes + usage.delayLineBytes);
+
+            graph.releaseResources();
+            expect (graph.getBufferUsage().getTotalBytes() == 0);
+        }
+
+        beginTest ("parallel rendering produces the same output as serial rendering");
+        {
+            using BufferAllocation = AudioProcessorGraph::BufferAllocation;
+
+            for (const auto precision : { AudioProcessor::singlePrecision, AudioProcessor::doublePrecision })
+            {
+                const auto serial = renderBranchingGraph (0, precision, BufferAllocation::greedy);
+                expect (std::any_of (serial.begin(), serial.end(), [] (auto x) { return ! exactlyEqual (x, 0.0); }));
+
+                for (const auto allocation : { BufferAllocation::greedy, BufferAllocation::minimal })
+                {
+                    const auto parallel = renderBranchingGraph (3, precision, allocation);
+
+                    expect (serial.size() == parallel.size());
+                    expect (std::equal (serial.begin(), serial.end(), parallel.begin(), [] (auto a, auto b)
+                    {
+                        return exactlyEqual (a, b);
+                    }));
+                }
+            }
+        }
+
+        beginTest ("the number of render threads can be changed while the graph is prepared");
+        {
+            AudioProcessorGraph graph;
+            graph.prepareToPlay (44100.0, 512);
+
+            expect (graph.getNumRenderThreads() == 0);
+            graph.setNumRenderThreads (2);
+            expect (graph.getNumRenderThreads() == 2);
+            graph.setNumRenderThreads (-1);
+            expect (graph.getNumRenderThreads() == 0);
+        }
+
+        beginTest ("node profiling records statistics for each node only while enabled");
+        {
+            AudioProcessorGraph graph;
+            const auto nodeA = graph.addNode (BasicProcessor::make (BasicProcessor::getStereoProperties(), MidiIn::no, MidiOut::no))->nodeID;
+            const auto nodeB = graph.addNode (BasicProcessor::make (BasicProcessor::getStereoProperties(), MidiIn::no, MidiOut::no))->nodeID;
+            expect (graph.addConnection ({ { nodeA, 0 }, { nodeB, 0 } }));
+
+            constexpr auto blockSize = 128;
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> audio (2, blockSize);
+            MidiBuffer midi;
+
+            const auto processBlocks = [&] (int numBlocks)
+            {
+                for (auto i = 0; i < numBlocks; ++i)
+                {
+                    audio.clear();
+                    graph.processBlock (audio, midi);
+                }
+            };
+
+            processBlocks (4);
+            expect (! graph.isNodeProfilingEnabled());
+            expect (graph.getNodeProfiles().empty());
+
+            graph.setNodeProfilingEnabled (true);
+            expect (graph.isNodeProfilingEnabled());
+            processBlocks (10);
+
+            const auto profiles = graph.getNodeProfiles();
+            expect (profiles.size() == 2);
+
+            for (const auto& [nodeID, profile] : profiles)
+            {
+                expect (nodeID == nodeA || nodeID == nodeB);
+                expect (profile.numBlocks == 10);
+                expect (profile.minMilliseconds <= profile.meanMilliseconds);
+                expect (profile.meanMilliseconds <= profile.maxMilliseconds);
+                expect (profile.percentile50Milliseconds <= profile.percentile99Milliseconds);
+                expect (0.0 <= profile.loadAsProportion && profile.loadAsProportion <= 1.0);
+            }
+
+            graph.setNodeProfilingEnabled (false);
+            processBlocks (10);
+            expect (graph.getNodeProfiles().at (nodeA).numBlocks == 10);
+
+            graph.resetNodeProfiles();
+            expect (graph.getNodeProfiles().empty());
+
+            graph.removeNode (nodeB);
+            graph.setNodeProfilingEnabled (true);
+            processBlocks (3);
+            expect (graph.getNodeProfiles().size() == 1);
+            expect (graph.getNodeProfiles().at (nodeA).numBlocks == 3);
+        }
+
+        beginTest ("node profiles are discarded when their nodes are removed");
+        {
+            AudioProcessorGraph graph;
+            graph.setNodeProfilingEnabled (true);
+
+            constexpr auto blockSize = 128;
+            graph.prepareToPlay (44100.0, blockSize);
+
+            AudioBuffer<float> audio (2, blockSize);
+            MidiBuffer midi;
+            const AudioProcessorGraph::NodeID reusedID { 1000 };
+
+            for (auto numBlocks = 1; numBlocks <= 3; ++numBlocks)
+            {
+                graph.addNode (BasicProcessor::make (BasicProcessor::getStereoProperties(), MidiIn::no, MidiOut::no), reusedID);
+
+                for (auto i = 0; i < numBlocks; ++i)
+                    graph.processBlock (audio, midi);
+
+                // A node added with the ID of a removed node starts with a fresh profile
+                expect (graph.getNodeProfiles().at (reusedID).numBlocks == numBlocks);
+
+                graph.removeNode (reusedID);
+            }
+        }
     }
 
 private:
@@ -2539,17 +4199,19 @@ private:
         void reset() override                                         {}
         void setNonRealtime (bool) noexcept override                  {}
 
-        void processBlock (AudioBuffer<float>& audio, MidiBuffer&) override
+        void processBlock (AudioBuffer<float>& audio, MidiBuffer& midi) override
         {
             blockPrecision = singlePrecision;
+            numMidiEventsReceived = midi.getNumEvents();
 
             for (auto i = 1; i < audio.getNumChannels(); ++i)
                 audio.addFrom (0, 0, audio.getReadPointer (i), audio.getNumSamples());
         }
 
-        void processBlock (AudioBuffer<double>& audio, MidiBuffer&) override
+        void processBlock (AudioBuffer<double>& audio, MidiBuffer& midi) override
         {
             blockPrecision = doublePrecision;
+            numMidiEventsReceived = midi.getNumEvents();
 
             for (auto i = 1; i < audio.getNumChannels(); ++i)
                 audio.addFrom (0, 0, audio.getReadPointer (i), audio.getNumSamples());
@@ -2591,13 +4253,139 @@ private:
 
         bool isPrepared() const { return prepared; }
 
+        int getNumMidiEventsReceived() const { return numMidiEventsReceived; }
+
     private:
         MidiIn midiIn;
         MidiOut midiOut;
         ProcessingPrecision blockPrecision = ProcessingPrecision (-1); // initially invalid
+        int numMidiEventsReceived = 0;
         bool doublePrecisionSupported = true;
         bool prepared = false;
     };
+
+    /*  Renders a graph in which each node is fed by two randomly-chosen earlier nodes. */
+    std::vector<float> renderRandomGraph (int seed,
+                                          AudioProcessorGraph::BufferAllocation allocation,
+                                          AudioProcessorGraph::BufferUsage& usage)
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        AudioProcessorGraph graph;
+        graph.setBufferAllocation (allocation);
+        graph.setBusesLayout ({ { AudioChannelSet::stereo() }, { AudioChannelSet::stereo() } });
+
+        Random random (seed);
+        std::vector<AudioProcessorGraph::NodeID> nodeIDs { graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID };
+
+        for (auto i = 0; i < 24; ++i)
+        {
+            const auto properties = random.nextBool() ? BasicProcessor::getStereoProperties()
+                                                      : BasicProcessor::getStereoInMonoOut();
+            const auto nodeID = graph.addNode (BasicProcessor::make (properties, MidiIn::no, MidiOut::no))->nodeID;
+
+            for (auto channel = 0; channel < 2; ++channel)
+                graph.addConnection ({ { nodeIDs[(size_t) random.nextInt ((int) nodeIDs.size())], 0 }, { nodeID, channel } });
+
+            nodeIDs.push_back (nodeID);
+        }
+
+        const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+        expect (graph.addConnection ({ { nodeIDs.back(), 0 }, { output, 0 } }));
+        expect (graph.addConnection ({ { nodeIDs[nodeIDs.size() / 2], 0 }, { output, 1 } }));
+
+        constexpr auto blockSize = 64;
+        graph.prepareToPlay (44100.0, blockSize);
+        usage = graph.getBufferUsage();
+
+        AudioBuffer<float> audio (2, blockSize);
+        MidiBuffer midi;
+
+        for (auto channel = 0; channel < audio.getNumChannels(); ++channel)
+            for (auto i = 0; i < blockSize; ++i)
+                audio.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        graph.processBlock (audio, midi);
+
+        std::vector<float> result;
+
+        for (auto channel = 0; channel < audio.getNumChannels(); ++channel)
+            result.insert (result.end(), audio.getReadPointer (channel), audio.getReadPointer (channel) + blockSize);
+
+        return result;
+    }
+
+    /*  Renders a few blocks of noise through a graph with many independent branches of different
+        latencies, and returns the concatenated output samples.
+    */
+    std::vector<double> renderBranchingGraph (int numRenderThreads,
+                                              AudioProcessor::ProcessingPrecision precision,
+                                              AudioProcessorGraph::BufferAllocation allocation)
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        AudioProcessorGraph graph;
+        graph.setNumRenderThreads (numRenderThreads);
+        graph.setBufferAllocation (allocation);
+        graph.setProcessingPrecision (precision);
+        graph.setBusesLayout ({ { AudioChannelSet::stereo() }, { AudioChannelSet::stereo() } });
+
+        const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+        const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+        constexpr auto numBranches = 8;
+
+        for (auto branch = 0; branch < numBranches; ++branch)
+        {
+            auto first  = BasicProcessor::make (BasicProcessor::getStereoProperties(), MidiIn::no, MidiOut::no);
+            auto second = BasicProcessor::make (BasicProcessor::getStereoProperties(), MidiIn::no, MidiOut::no);
+
+            first->setLatencySamples (branch * 3);
+            second->setSupportsDoublePrecisionProcessing (branch % 2 == 0);
+
+            const auto firstID  = graph.addNode (std::move (first))->nodeID;
+            const auto secondID = graph.addNode (std::move (second))->nodeID;
+
+            for (auto channel = 0; channel < 2; ++channel)
+            {
+                expect (graph.addConnection ({ { input,    channel }, { firstID,  channel } }));
+                expect (graph.addConnection ({ { firstID,  channel }, { secondID, channel } }));
+                expect (graph.addConnection ({ { secondID, channel }, { output,   channel } }));
+            }
+        }
+
+        constexpr auto blockSize = 64;
+        graph.prepareToPlay (44100.0, blockSize);
+
+        Random random (0x1234);
+        std::vector<double> result;
+        MidiBuffer midi;
+
+        const auto renderBlocks = [&] (auto sampleType)
+        {
+            AudioBuffer<decltype (sampleType)> audio (2, blockSize);
+
+            for (auto block = 0; block < 16; ++block)
+            {
+                for (auto channel = 0; channel < audio.getNumChannels(); ++channel)
+                    for (auto i = 0; i < blockSize; ++i)
+                        audio.setSample (channel, i, (decltype (sampleType)) random.nextFloat() * 2 - 1);
+
+                graph.processBlock (audio, midi);
+
+                for (auto channel = 0; channel < audio.getNumChannels(); ++channel)
+                    for (auto i = 0; i < blockSize; ++i)
+                        result.push_back (audio.getSample (channel, i));
+            }
+        };
+
+        if (precision == AudioProcessor::singlePrecision)
+            renderBlocks (float{});
+        else
+            renderBlocks (double{});
+
+        return result;
+    }
 };
 
 static AudioProcessorGraphTests audioProcessorGraphTests;
@@ -351,6 +351,154 @@ public:
     */
     void rebuild();
 
+    /** Allows the graph to process independent branches on several threads at once.
+
+        By default, all nodes are processed one after another on the thread that calls
+        processBlock(). If numWorkerThreads is greater than zero, the graph will use up to that
+        many worker threads from RealtimeThreadPool::getSharedInstance(), and nodes that don't
+        depend on one another may then be processed concurrently on the worker threads and the
+        calling thread. The graph's output is identical in both modes. The shared pool has one
+        worker for each CPU other than the calling thread's, so on a machine with a single CPU,
+        everything is still processed on the calling thread.
+
+        The calling thread never waits on a lock or allocates in order to share work with the
+        workers, so this is only worthwhile for graphs with enough independent nodes to keep
+        several cores busy.
+
+        Pass zero to return to processing everything on the calling thread. This should be
+        called on the message thread.
+
+        @see getNumRenderThreads
+    */
+    void setNumRenderThreads (int numWorkerThreads);
+
+    /** Returns the number of worker threads set with setNumRenderThreads().
+
+        Fewer workers may actually be used, if the shared pool doesn't have that many.
+    */
+    int getNumRenderThreads() const noexcept;
+
+    //==============================================================================
+    /** Timing statistics for a single node, collected while node profiling is enabled.
+
+        Times cover only the node's own processBlock() call, and not the copying and mixing
+        of its inputs. The load values compare the time spent in the node with the duration
+        of the audio that it processed, in the same way as AudioProcessLoadMeasurer.
+
+        @see setNodeProfilingEnabled, getNodeProfiles
+    */
+    struct NodeProfile
+    {
+        /** The number of blocks that were measured. */
+        int64 numBlocks = 0;
+
+        /** The shortest, average, and longest time spent processing a single block. */
+        double minMilliseconds = 0.0, meanMilliseconds = 0.0, maxMilliseconds = 0.0;
+
+        /** Estimates of the median, 90th and 99th percentile processing times.
+
+            These are read from a histogram with quarter-octave resolution, so they're
+            accurate to within about 20%.
+        */
+        double percentile50Milliseconds = 0.0, percentile90Milliseconds = 0.0, percentile99Milliseconds = 0.0;
+
+        /** The total time spent in this node as a proportion of the duration of the audio
+            that it processed, 0 to 1.0.
+        */
+        double loadAsProportion = 0.0;
+
+        /** The number of blocks where this node alone took longer than the duration of the
+            audio that it processed.
+        */
+        int64 numOverruns = 0;
+    };
+
+    /** Enables or disables timing of each node's processing.
+
+        When disabled (the default), the graph doesn't read any clocks while processing. When
+        enabled, each node's processing time is recorded on the audio thread without locking or
+        allocating, and can be read from the message thread with getNodeProfiles().
+
+        Enabling profiling doesn't reset the collected statistics; use resetNodeProfiles() to
+        do that. This should be called on the message thread.
+    */
+    void setNodeProfilingEnabled (bool shouldProfile);
+
+    /** Returns true if node profiling has been enabled with setNodeProfilingEnabled(). */
+    bool isNodeProfilingEnabled() const noexcept;
+
+    /** Returns the timing statistics collected for each node that is currently in the graph
+        and that has processed at least one block since profiling was enabled.
+        This may be called on the message thread while the graph is processing.
+    */
+    std::map<NodeID, NodeProfile> getNodeProfiles() const;
+
+    /** Clears all of the statistics collected by node profiling. */
+    void resetNodeProfiles();
+
+    //==============================================================================
+    /** The strategies that the graph can use to assign intermediate buffers to nodes.
+
+        @see setBufferAllocation
+    */
+    enum class BufferAllocation
+    {
+        /** Buffers are assigned one node at a time while the render sequence is built.
+            This is the quickest to build, and leaves the most freedom for parallel rendering.
+        */
+        greedy,
+
+        /** After the render sequence has been built, its buffers are reassigned based on
+            exactly when each one is written and read. Each value is packed into the first
+            buffer that is free for its whole lifetime, which normally needs far fewer buffers
+            than greedy allocation, although it isn't guaranteed to find the smallest possible
+            number. This reduces the graph's memory footprint, but sharing buffers between
+            more nodes may leave fewer nodes that can be processed in parallel.
+        */
+        minimal
+    };
+
+    /** Sets the strategy used to assign intermediate buffers to nodes.
+        This should be called on the message thread.
+        @see getBufferUsage
+    */
+    void setBufferAllocation (BufferAllocation newAllocation);
+
+    /** Returns the strategy set with setBufferAllocation(). The default is greedy. */
+    BufferAllocation getBufferAllocation() const noexcept;
+
+    /** Describes the memory used by the graph's current render sequence.
+        @see getBufferUsage
+    */
+    struct BufferUsage
+    {
+        /** The number of single-channel audio buffers that are shared between nodes. */
+        int numAudioBuffers = 0;
+
+        /** The number of MIDI buffers that are shared between nodes. */
+        int numMidiBuffers = 0;
+
+        /** The size in bytes of the shared audio buffers, including any buffers that are
+            used to convert between single and double precision.
+        */
+        size_t audioBytes = 0;
+
+        /** The space in bytes that has been reserved for events in the shared MIDI buffers. */
+        size_t midiBytes = 0;
+
+        /** The size in bytes of the delay lines that compensate for the latency of nodes. */
+        size_t delayLineBytes = 0;
+
+        /** Returns the total of all the byte counts. */
+        size_t getTotalBytes() const noexcept     { return audioBytes + midiBytes + delayLineBytes; }
+    };
+
+    /** Returns a description of the memory used by the graph's current render sequence.
+        If the graph isn't prepared, all of the values will be zero.
+        This should be called on the message thread.
+    */
+    BufferUsage getBufferUsage() const;
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -0,0 +1,479 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  Reports the position of the render to the processor, as if it were playing from the start. */
+class OfflineRenderPlayHead final : public AudioPlayHead
+{
+public:
+    explicit OfflineRenderPlayHead (double sampleRateIn) : sampleRate (sampleRateIn) {}
+
+    void setPosition (int64 newPosition) noexcept { position = newPosition; }
+
+    Optional<PositionInfo> getPosition() const override
+    {
+        PositionInfo info;
+        info.setTimeInSamples (position);
+        info.setTimeInSeconds ((double) position / sampleRate);
+        info.setIsPlaying (true);
+        return info;
+    }
+
+private:
+    double sampleRate = 0.0;
+    int64 position = 0;
+};
+
+/*  Processes one block in the processor's chosen precision. */
+class OfflineRenderBlockProcessor
+{
+public:
+    OfflineRenderBlockProcessor (AudioProcessor& p, int numChannels, int blockSize)
+        : processor (p)
+    {
+        if (processor.isUsingDoublePrecision())
+            doubleBuffer.setSize (numChannels, blockSize);
+    }
+
+    void process (AudioBuffer<float>& buffer, MidiBuffer& midi)
+    {
+        const ScopedLock sl (processor.getCallbackLock());
+
+        if (processor.isSuspended())
+        {
+            buffer.clear();
+            return;
+        }
+
+        if (processor.isUsingDoublePrecision())
+        {
+            doubleBuffer.makeCopyOf (buffer, true);
+            processor.processBlock (doubleBuffer, midi);
+            buffer.makeCopyOf (doubleBuffer, true);
+        }
+        else
+        {
+            processor.processBlock (buffer, midi);
+        }
+    }
+
+private:
+    AudioProcessor& processor;
+    AudioBuffer<double> doubleBuffer;
+};
+
+Result AudioProcessorOfflineRenderer::render (AudioProcessor& processor, const Options& options, const Destination& destination)
+{
+    if (options.sampleRate <= 0.0 || options.blockSize <= 0 || options.lengthInSamples < 0)
+        return Result::fail ("Invalid render options");
+
+    const auto useDouble = options.precision == AudioProcessor::doublePrecision
+                        && processor.supportsDoublePrecisionProcessing();
+
+    const auto wasNonRealtime = processor.isNonRealtime();
+    processor.setNonRealtime (true);
+    processor.setRateAndBufferSizeDetails (options.sampleRate, options.blockSize);
+    processor.setProcessingPrecision (useDouble ? AudioProcessor::doublePrecision
+                                                : AudioProcessor::singlePrecision);
+    processor.prepareToPlay (options.sampleRate, options.blockSize);
+
+    const auto numIns  = processor.getTotalNumInputChannels();
+    const auto numOuts = processor.getTotalNumOutputChannels();
+
+    const auto tailSeconds = options.includeTail ? processor.getTailLengthSeconds() : 0.0;
+    const auto tailSamples = std::isfinite (tailSeconds) ? jmax ((int64) 0, (int64) std::ceil (tailSeconds * options.sampleRate))
+                                                         : (int64) 0;
+    const auto latency = options.compensateForLatency ? (int64) jmax (0, processor.getLatencySamples()) : (int64) 0;
+
+    const auto numSamplesToWrite = options.lengthInSamples + tailSamples;
+    const auto numSamplesToProcess = numSamplesToWrite + latency;
+
+    AudioBuffer<float> buffer (jmax (numIns, numOuts), options.blockSize);
+    MidiBuffer midi;
+    std::vector<const float*> outputChannels ((size_t) numOuts);
+
+    OfflineRenderBlockProcessor blockProcessor (processor, buffer.getNumChannels(), options.blockSize);
+    OfflineRenderPlayHead playHead (options.sampleRate);
+
+    const auto previousPlayHead = processor.getPlayHead();
+
+    if (previousPlayHead == nullptr)
+        processor.setPlayHead (&playHead);
+
+    auto result = Result::ok();
+
+    const auto shouldContinue = [&] (int64 position)
+    {
+        return options.progressCallback == nullptr
+            || options.progressCallback ((double) position / (double) numSamplesToProcess);
+    };
+
+    for (int64 position = 0; position < numSamplesToProcess;)
+    {
+        const auto numSamples = (int) jmin ((int64) options.blockSize, numSamplesToProcess - position);
+
+        buffer.setSize (buffer.getNumChannels(), numSamples, false, false, true);
+        buffer.clear();
+        midi.clear();
+
+        if (options.source != nullptr)
+        {
+            AudioBuffer<float> inputs (buffer.getArrayOfWritePointers(), numIns, numSamples);
+            options.source (inputs, midi, position);
+        }
+
+        playHead.setPosition (position);
+        blockProcessor.process (buffer, midi);
+
+        // Discard the output that precedes the processor's latency
+        const auto numToSkip = (int) jlimit ((int64) 0, (int64) numSamples, latency - position);
+
+        if (const auto numToWrite = numSamples - numToSkip; numToWrite > 0 && numOuts > 0)
+        {
+            for (size_t i = 0; i < outputChannels.size(); ++i)
+                outputChannels[i] = buffer.getReadPointer ((int) i, numToSkip);
+
+            const auto startTime = Time::getMillisecondCounter();
+
+            while (! destination (outputChannels.data(), numToWrite))
+            {
+                if (! shouldContinue (position))
+                {
+                    result = Result::fail ("The render was stopped before it finished");
+                    break;
+                }
+
+                if (options.destinationTimeoutMs >= 0
+                    && Time::getMillisecondCounter() - startTime > (uint32) options.destinationTimeoutMs)
+                {
+                    result = Result::fail ("The destination stopped accepting audio");
+                    break;
+                }
+
+                Thread::sleep (1);
+            }
+
+            if (result.failed())
+                break;
+        }
+
+        position += numSamples;
+
+        if (! shouldContinue (position))
+        {
+            result = Result::fail ("The render was stopped before it finished");
+            break;
+        }
+    }
+
+    if (previousPlayHead == nullptr)
+        processor.setPlayHead (nullptr);
+
+    processor.releaseResources();
+    processor.setNonRealtime (wasNonRealtime);
+    return result;
+}
+
+#if JUCE_MODULE_AVAILABLE_juce_audio_formats
+Result AudioProcessorOfflineRenderer::render (AudioProcessor& processor, const Options& options, AudioFormatWriter::ThreadedWriter& writer)
+{
+    if (options.blockSize > writer.getMaxNumSamplesPerWrite())
+        return Result::fail ("The block size is larger than the writer's buffer");
+
+    return render (processor, options, [&writer] (const float* const* data, int numSamples)
+    {
+        return writer.write (data, numSamples);
+    });
+}
+#endif
+
+std::vector<Result> AudioProcessorOfflineRenderer::renderConcurrently (const std::vector<Job>& jobs, int numThreads)
+{
+    std::vector<Result> results (jobs.size(), Result::ok());
+
+    if (jobs.empty())
+        return results;
+
+    class RenderJob final : public ThreadPoolJob
+    {
+    public:
+        RenderJob (const Job& j, Result& r)
+            : ThreadPoolJob ("Offline render"), job (j), result (r) {}
+
+        JobStatus runJob() override
+        {
+            if (job.processor == nullptr)
+                result = Result::fail ("No processor was supplied");
+            else
+                result = render (*job.processor, job.options, job.destination);
+
+            return jobHasFinished;
+        }
+
+    private:
+        const Job& job;
+        Result& result;
+    };
+
+    ThreadPool pool (ThreadPoolOptions{}.withThreadName ("Offline render")
+                                        .withNumberOfThreads (jlimit (1, (int) jobs.size(), numThreads)));
+
+    std::vector<std::unique_ptr<RenderJob>> renderJobs;
+
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        // Each processor may only be rendered by one job at a time
+        jassert (std::none_of (jobs.begin(), jobs.begin() + (ptrdiff_t) i, [&] (const Job& other)
+        {
+            return other.processor == jobs[i].processor;
+        }));
+
+        renderJobs.push_back (std::make_unique<RenderJob> (jobs[i], results[i]));
+        pool.addJob (renderJobs.back().get(), false);
+    }
+
+    for (const auto& job : renderJobs)
+        pool.waitForJobToFinish (job.get(), -1);
+
+    return results;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorOfflineRendererTests final : public UnitTest
+{
+public:
+    AudioProcessorOfflineRendererTests()
+        : UnitTest ("AudioProcessorOfflineRenderer", UnitTestCategories::audioProcessors) {}
+
+    void runTest() override
+    {
+        beginTest ("the processor's output is rendered with latency compensation and tail");
+        {
+            RampProcessor processor;
+            processor.setLatencySamples (100);
+
+            AudioProcessorOfflineRenderer::Options options;
+            options.blockSize = 64;
+            options.lengthInSamples = 1000;
+            options.includeTail = true;
+
+            std::vector<float> rendered;
+            auto numRejected = 0;
+
+            const auto result = AudioProcessorOfflineRenderer::render (processor, options, [&] (const float* const* data, int numSamples)
+            {
+                // Simulate a destination that is sometimes full
+                if (numRejected++ % 3 == 0)
+                    return false;
+
+                expect (processor.isNonRealtime());
+                rendered.insert (rendered.end(), data[0], data[0] + numSamples);
+                return true;
+            });
+
+            expect (result.wasOk());
+            expect (! processor.isNonRealtime());
+            expect (! processor.prepared);
+
+            // The tail is 0.01 seconds at 44100 Hz
+            expectEquals ((int) rendered.size(), 1000 + 441);
+
+            for (size_t i = 0; i < rendered.size(); ++i)
+                expectEquals (rendered[i], (float) (i + 100));
+        }
+
+        beginTest ("input is passed to the processor, and the render can be stopped");
+        {
+            RampProcessor processor;
+
+            AudioProcessorOfflineRenderer::Options options;
+            options.blockSize = 100;
+            options.lengthInSamples = 1000;
+            options.source = [this] (AudioBuffer<float>& audio, MidiBuffer&, int64 startSample)
+            {
+                expect (audio.getNumChannels() == 2);
+                audio.setSample (1, 0, (float) startSample);
+            };
+
+            // The processor adds its input channels to the first output channel
+            std::vector<float> rendered;
+            options.progressCallback = [&] (double progress) { return progress < 0.5; };
+
+            const auto result = AudioProcessorOfflineRenderer::render (processor, options, [&] (const float* const* data, int numSamples)
+            {
+                rendered.insert (rendered.end(), data[0], data[0] + numSamples);
+                return true;
+            });
+
+            expect (result.failed());
+            expectEquals ((int) rendered.size(), 500);
+
+            for (size_t i = 0; i < rendered.size(); ++i)
+                expectEquals (rendered[i], (float) (i % 100 == 0 ? 2 * i : i));
+        }
+
+        beginTest ("a destination that never accepts a block can't stall the render");
+        {
+            RampProcessor processor;
+
+            AudioProcessorOfflineRenderer::Options options;
+            options.lengthInSamples = 1000;
+            options.destinationTimeoutMs = 20;
+
+            const auto rejectAll = [] (const float* const*, int) { return false; };
+            expect (AudioProcessorOfflineRenderer::render (processor, options, rejectAll).failed());
+            expect (! processor.prepared);
+
+            auto numRetries = 0;
+            options.destinationTimeoutMs = -1;
+            options.progressCallback = [&] (double progress)
+            {
+                expectEquals (progress, 0.0);
+                return ++numRetries < 10;
+            };
+
+            expect (AudioProcessorOfflineRenderer::render (processor, options, rejectAll).failed());
+            expectEquals (numRetries, 10);
+        }
+
+       #if JUCE_MODULE_AVAILABLE_juce_audio_formats
+        beginTest ("a ThreadedWriter is rejected if its buffer is smaller than a block");
+        {
+            RampProcessor processor;
+            TimeSliceThread thread ("Offline render test writer");
+            thread.startThread();
+
+            std::unique_ptr<OutputStream> stream = std::make_unique<MemoryOutputStream>();
+            auto fileWriter = WavAudioFormat().createWriterFor (stream, AudioFormatWriterOptions{}.withSampleRate (44100.0)
+                                                                                                 .withNumChannels (2)
+                                                                                                 .withBitsPerSample (16));
+            AudioFormatWriter::ThreadedWriter writer (fileWriter.release(), thread, 256);
+
+            AudioProcessorOfflineRenderer::Options options;
+            options.lengthInSamples = 1000;
+            options.blockSize = 256;
+            expect (AudioProcessorOfflineRenderer::render (processor, options, writer).failed());
+
+            options.blockSize = writer.getMaxNumSamplesPerWrite();
+            expect (AudioProcessorOfflineRenderer::render (processor, options, writer).wasOk());
+        }
+       #endif
+
+        beginTest ("several processors can be rendered concurrently");
+        {
+            constexpr auto numJobs = 6;
+            std::vector<std::unique_ptr<RampProcessor>> processors;
+            std::vector<std::vector<float>> outputs (numJobs);
+            std::vector<AudioProcessorOfflineRenderer::Job> jobs;
+
+            for (auto i = 0; i < numJobs; ++i)
+            {
+                processors.push_back (std::make_unique<RampProcessor>());
+
+                AudioProcessorOfflineRenderer::Job job;
+                job.processor = processors.back().get();
+                job.options.lengthInSamples = 10000 + i;
+                job.destination = [&output = outputs[(size_t) i]] (const float* const* data, int numSamples)
+                {
+                    output.insert (output.end(), data[0], data[0] + numSamples);
+                    return true;
+                };
+
+                jobs.push_back (std::move (job));
+            }
+
+            const auto results = AudioProcessorOfflineRenderer::renderConcurrently (jobs, 3);
+
+            expectEquals ((int) results.size(), numJobs);
+
+            for (auto i = 0; i < numJobs; ++i)
+            {
+                expect (results[(size_t) i].wasOk());
+                expectEquals ((int) outputs[(size_t) i].size(), 10000 + i);
+                expectEquals (outputs[(size_t) i].back(), (float) (10000 + i - 1));
+            }
+        }
+    }
+
+private:
+    /*  Outputs the sample position on the first channel, plus the sum of its inputs. */
+    class RampProcessor final : public AudioProcessor
+    {
+    public:
+        RampProcessor()
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::stereo())
+                                               .withOutput ("out", AudioChannelSet::stereo())) {}
+
+        const String getName() const override                         { return "Ramp"; }
+        double getTailLengthSeconds() const override                  { return 0.01; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return false; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return 0; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (MemoryBlock&) override              {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     { prepared = true; position = 0; }
+        void releaseResources() override                              { prepared = false; }
+
+        void processBlock (AudioBuffer<float>& audio, MidiBuffer&) override
+        {
+            for (auto i = 1; i < audio.getNumChannels(); ++i)
+                audio.addFrom (0, 0, audio, i, 0, audio.getNumSamples());
+
+            for (auto i = 0; i < audio.getNumSamples(); ++i)
+                audio.getWritePointer (0)[i] += (float) position++;
+        }
+
+        using AudioProcessor::processBlock;
+
+        bool prepared = false;
+        int64 position = 0;
+    };
+};
+
+static AudioProcessorOfflineRendererTests audioProcessorOfflineRendererTests;
+
+#endif
+
+} // namespace juce
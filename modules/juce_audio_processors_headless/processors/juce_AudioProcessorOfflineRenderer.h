@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders the output of an AudioProcessor (such as an AudioProcessorGraph) as quickly
+    as possible, without an audio device.
+
+    The processor is prepared, flagged as non-realtime with AudioProcessor::setNonRealtime(),
+    and then asked for blocks one after another on the calling thread. Each block of output
+    is passed to a Destination, which will usually forward it to an
+    AudioFormatWriter::ThreadedWriter, so that writing to disk happens on another thread.
+
+    @code
+    AudioFormatWriter::ThreadedWriter writer (fileWriter.release(), writerThread, 1 << 16);
+
+    AudioProcessorOfflineRenderer::Options options;
+    options.sampleRate = 48000.0;
+    options.lengthInSamples = 48000 * 60;
+
+    const auto result = AudioProcessorOfflineRenderer::render (graph, options, writer);
+    @endcode
+
+    Several independent processors can be rendered at once on different cores with
+    renderConcurrently().
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorOfflineRenderer
+{
+public:
+    //==============================================================================
+    /** Receives each block of rendered audio, with one pointer per output channel of the
+        processor.
+
+        This has the same form as AudioFormatWriter::ThreadedWriter::write(). If it returns
+        false, the data hasn't been accepted yet, so the renderer will wait briefly and then
+        offer the same block again. This allows a destination with a fixed-size buffer to
+        slow the renderer down to the speed at which the audio can be stored.
+
+        The renderer gives up if the same block is rejected for longer than
+        Options::destinationTimeoutMs.
+    */
+    using Destination = std::function<bool (const float* const* data, int numSamples)>;
+
+    /** Can be used to provide input audio and MIDI for each block.
+
+        The buffer holds one channel for each input channel of the processor, and will be
+        cleared before this is called. startSample is the position of the start of the block,
+        measured from the start of the render.
+    */
+    using Source = std::function<void (AudioBuffer<float>& audio, MidiBuffer& midi, int64 startSample)>;
+
+    /** Settings for a single render. */
+    struct Options
+    {
+        /** The sample rate at which to prepare the processor. */
+        double sampleRate = 44100.0;
+
+        /** The largest number of samples that will be passed to the processor at once. */
+        int blockSize = 512;
+
+        /** The number of samples to write to the Destination, not including any tail. */
+        int64 lengthInSamples = 0;
+
+        /** If true, the render will continue past lengthInSamples for the duration returned
+            by the processor's getTailLengthSeconds(), if that duration is finite.
+        */
+        bool includeTail = false;
+
+        /** If true, the number of samples reported by the processor's getLatencySamples()
+            will be discarded from the start of the output, so that the output lines up with
+            the input.
+        */
+        bool compensateForLatency = true;
+
+        /** If the processor supports double precision, this precision will be used to process
+            the audio. The output is always passed to the Destination in single precision.
+        */
+        AudioProcessor::ProcessingPrecision precision = AudioProcessor::singlePrecision;
+
+        /** An optional source of input audio and MIDI. If this isn't set, the processor will
+            receive silence and no MIDI.
+        */
+        Source source;
+
+        /** An optional callback that will be called after each block with the proportion of
+            the render that has been completed, from 0 to 1.0. Return false to stop rendering.
+
+            While the Destination isn't accepting a block, this will also be called each time
+            the renderer retries, with the progress so far.
+        */
+        std::function<bool (double progress)> progressCallback;
+
+        /** The longest time, in milliseconds, that the renderer will keep offering the same
+            block to a Destination that won't accept it. If this runs out, the render fails.
+            A negative value means that the renderer will wait indefinitely.
+        */
+        int destinationTimeoutMs = 10000;
+    };
+
+    //==============================================================================
+    /** Renders the output of a processor to a destination, on the calling thread.
+
+        The processor will be prepared with prepareToPlay() before rendering, and
+        releaseResources() will be called once the render has finished. The processor must
+        not be used elsewhere until this returns.
+
+        Returns an error if the options are invalid, the render was stopped by the
+        progressCallback, or the destination didn't accept a block within the timeout.
+    */
+    static Result render (AudioProcessor& processor, const Options& options, const Destination& destination);
+
+   #if JUCE_MODULE_AVAILABLE_juce_audio_formats || DOXYGEN
+    /** Renders the output of a processor to a ThreadedWriter, on the calling thread.
+
+        Whenever the writer's buffer is full, the renderer waits for the writer's thread to
+        catch up. The writer should have the same number of channels as the processor has
+        outputs. The options' blockSize must be no larger than the writer's
+        getMaxNumSamplesPerWrite(), otherwise no block could ever be accepted and an error is
+        returned. Requires the juce_audio_formats module.
+    */
+    static Result render (AudioProcessor& processor, const Options& options, AudioFormatWriter::ThreadedWriter& writer);
+   #endif
+
+    //==============================================================================
+    /** Describes a render that can be run alongside others by renderConcurrently(). */
+    struct Job
+    {
+        AudioProcessor* processor = nullptr;
+        Options options;
+        Destination destination;
+    };
+
+    /** Runs several renders at once, using up to numThreads threads.
+
+        Each job must use a different processor. Each destination will only be called from
+        the thread that is rendering its job, but different jobs will call their destinations
+        from different threads at the same time.
+
+        This blocks until all of the jobs have finished, and returns the result of each job,
+        in the same order as the jobs.
+    */
+    static std::vector<Result> renderConcurrently (const std::vector<Job>& jobs,
+                                                   int numThreads = SystemStats::getNumCpus());
+
+private:
+    AudioProcessorOfflineRenderer() = delete;
+};
+
+} // namespace juce
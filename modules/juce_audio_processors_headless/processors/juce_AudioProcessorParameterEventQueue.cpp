@@ -0,0 +1,382 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioProcessorParameterEventQueue::~AudioProcessorParameterEventQueue() = default;
+
+void AudioProcessorParameterEventQueue::setCapacity (int maxNumEvents)
+{
+    if (maxNumEvents <= 0)
+    {
+        cells.reset();
+        mask = 0;
+        capacity = 0;
+        pending = {};
+        current = {};
+    }
+    else
+    {
+        // The cells are indexed with a mask, so their number is rounded up to a power of two
+        const auto numCells = (size_t) nextPowerOfTwo (maxNumEvents);
+
+        cells = std::make_unique<Cell[]> (numCells);
+
+        for (size_t i = 0; i < numCells; ++i)
+            cells[i].sequence.store (i, std::memory_order_relaxed);
+
+        mask = numCells - 1;
+        capacity = (int) numCells;
+        pending.clear();
+        pending.reserve (numCells);
+        current.clear();
+        current.reserve (numCells);
+    }
+
+    writePosition.store (0);
+    readPosition = 0;
+}
+
+/*  Each cell's sequence number says whether it can be written or read next: a cell at
+    position p is free for writing when its sequence is p, and holds an event ready to be
+    read when its sequence is p + 1. Writers claim a position by incrementing writePosition,
+    so several threads can add events at once without locking.
+*/
+bool AudioProcessorParameterEventQueue::push (const Event& event) noexcept
+{
+    if (cells == nullptr)
+        return false;
+
+    auto position = writePosition.load (std::memory_order_relaxed);
+
+    for (;;)
+    {
+        auto& cell = cells[position & mask];
+        const auto sequence = cell.sequence.load (std::memory_order_acquire);
+        const auto difference = (std::ptrdiff_t) sequence - (std::ptrdiff_t) position;
+
+        if (difference == 0)
+        {
+            if (writePosition.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+            {
+                cell.event = event;
+                cell.sequence.store (position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false; // the queue is full
+        }
+        else
+        {
+            position = writePosition.load (std::memory_order_relaxed);
+        }
+    }
+}
+
+Span<const AudioProcessorParameterEventQueue::Event> AudioProcessorParameterEventQueue::popEventsForBlock (int numSamples) noexcept
+{
+    current.clear();
+
+    if (cells == nullptr)
+        return {};
+
+    // Move newly added events into the pending list, keeping it sorted by offset.
+    // The pending list has room for as many events as the queue, so this never allocates.
+    while (pending.size() < pending.capacity())
+    {
+        auto& cell = cells[readPosition & mask];
+
+        if (cell.sequence.load (std::memory_order_acquire) != readPosition + 1)
+            break;
+
+        auto event = cell.event;
+        cell.sequence.store (readPosition + mask + 1, std::memory_order_release);
+        ++readPosition;
+
+        event.sampleOffset = jmax (0, event.sampleOffset);
+        pending.push_back (event);
+
+        for (auto i = pending.size() - 1; i > 0 && pending[i - 1].sampleOffset > event.sampleOffset; --i)
+            std::swap (pending[i - 1], pending[i]);
+    }
+
+    const auto endOfBlock = std::find_if (pending.begin(), pending.end(), [numSamples] (const Event& e)
+    {
+        return e.sampleOffset >= numSamples;
+    });
+
+    current.insert (current.end(), pending.begin(), endOfBlock);
+    pending.erase (pending.begin(), endOfBlock);
+
+    for (auto& event : pending)
+        event.sampleOffset -= numSamples;
+
+    return current;
+}
+
+void AudioProcessorParameterEventQueue::clear() noexcept
+{
+    while (! popEventsForBlock (std::numeric_limits<int>::max()).empty())
+    {}
+
+    current.clear();
+}
+
+//==============================================================================
+static bool& areNotifiedChangesIgnoredOnThisThread() noexcept
+{
+    thread_local bool ignored = false;
+    return ignored;
+}
+
+AudioProcessorParameterEventQueue::ScopedIgnoreNotifiedChanges::ScopedIgnoreNotifiedChanges()
+    : wasActive (std::exchange (areNotifiedChangesIgnoredOnThisThread(), true))
+{
+}
+
+AudioProcessorParameterEventQueue::ScopedIgnoreNotifiedChanges::~ScopedIgnoreNotifiedChanges()
+{
+    areNotifiedChangesIgnoredOnThisThread() = wasActive;
+}
+
+bool AudioProcessorParameterEventQueue::ScopedIgnoreNotifiedChanges::isActive() noexcept
+{
+    return areNotifiedChangesIgnoredOnThisThread();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorParameterEventQueueTests final : public UnitTest
+{
+public:
+    AudioProcessorParameterEventQueueTests()
+        : UnitTest ("AudioProcessorParameterEventQueue", UnitTestCategories::audioProcessors) {}
+
+    void runTest() override
+    {
+        using Event = AudioProcessorParameterEventQueue::Event;
+
+        beginTest ("a disabled queue rejects events");
+        {
+            AudioProcessorParameterEventQueue queue;
+
+            expect (! queue.isEnabled());
+            expect (! queue.push ({ 0, 0, 1.0f }));
+            expect (queue.popEventsForBlock (64).empty());
+        }
+
+        beginTest ("events are sorted, and events after the block are kept for later blocks");
+        {
+            AudioProcessorParameterEventQueue queue;
+            queue.setCapacity (16);
+
+            expect (queue.push ({ 0, 100, 0.1f }));
+            expect (queue.push ({ 1, 10,  0.2f }));
+            expect (queue.push ({ 2, -5,  0.3f }));
+            expect (queue.push ({ 3, 10,  0.4f }));
+
+            const auto first = queue.popEventsForBlock (64);
+            expectEquals ((int) first.size(), 3);
+            expect (isEvent (first[0], 2, 0,  0.3f));
+            expect (isEvent (first[1], 1, 10, 0.2f));
+            expect (isEvent (first[2], 3, 10, 0.4f));
+
+            expect (queue.push ({ 4, 36, 0.5f }));
+
+            const auto second = queue.popEventsForBlock (64);
+            expectEquals ((int) second.size(), 2);
+            expect (isEvent (second[0], 0, 36, 0.1f));
+            expect (isEvent (second[1], 4, 36, 0.5f));
+
+            expect (queue.popEventsForBlock (64).empty());
+        }
+
+        beginTest ("a full queue rejects events until some are removed");
+        {
+            AudioProcessorParameterEventQueue queue;
+            queue.setCapacity (8);
+
+            for (auto i = 0; i < queue.getCapacity(); ++i)
+                expect (queue.push ({ i, 0, 0.0f }));
+
+            expect (! queue.push ({ 0, 0, 0.0f }));
+            expectEquals ((int) queue.popEventsForBlock (1).size(), queue.getCapacity());
+            expect (queue.push ({ 0, 0, 0.0f }));
+
+            queue.clear();
+            expect (queue.popEventsForBlock (1).empty());
+        }
+
+        beginTest ("a block is split at each event");
+        {
+            const std::vector<Event> events { { 0, 0, 0.0f }, { 1, 0, 0.0f }, { 2, 5, 0.0f }, { 3, 20, 0.0f } };
+
+            std::vector<std::tuple<int, int, int>> segments;
+
+            AudioProcessorParameterEventQueue::splitBlock (events, 32, [&] (int start, int num, Span<const Event> atStart)
+            {
+                segments.emplace_back (start, num, (int) atStart.size());
+            });
+
+            expect (segments == std::vector<std::tuple<int, int, int>> { { 0, 5, 2 }, { 5, 15, 1 }, { 20, 12, 1 } });
+
+            segments.clear();
+
+            AudioProcessorParameterEventQueue::splitBlock ({}, 32, [&] (int start, int num, Span<const Event> atStart)
+            {
+                segments.emplace_back (start, num, (int) atStart.size());
+            });
+
+            expect (segments == std::vector<std::tuple<int, int, int>> { { 0, 32, 0 } });
+        }
+
+        beginTest ("events can be added from several threads at once");
+        {
+            constexpr auto numThreads = 4;
+            constexpr auto numEventsPerThread = 5000;
+
+            AudioProcessorParameterEventQueue queue;
+            queue.setCapacity (256);
+
+            std::atomic<bool> start { false };
+            std::vector<std::thread> threads;
+
+            for (auto t = 0; t < numThreads; ++t)
+            {
+                threads.emplace_back ([&queue, &start, t]
+                {
+                    while (! start)
+                        std::this_thread::yield();
+
+                    for (auto i = 0; i < numEventsPerThread;)
+                    {
+                        if (queue.push ({ t, 0, (float) i }))
+                            ++i;
+                        else
+                            std::this_thread::yield();
+                    }
+                });
+            }
+
+            start = true;
+
+            std::vector<int> nextValue (numThreads, 0);
+            auto numReceived = 0;
+            auto inOrder = true;
+
+            while (numReceived < numThreads * numEventsPerThread)
+            {
+                for (const auto& event : queue.popEventsForBlock (64))
+                {
+                    inOrder &= (int) event.value == nextValue[(size_t) event.parameterIndex]++;
+                    ++numReceived;
+                }
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+
+            expect (inOrder);
+            expect (std::all_of (nextValue.begin(), nextValue.end(), [] (int n) { return n == numEventsPerThread; }));
+        }
+
+        beginTest ("parameter changes are added to the processor's queue once it is enabled");
+        {
+            TestProcessor processor;
+            auto* param = processor.getParameters()[1];
+            auto& queue = processor.getParameterEventQueue();
+
+            param->setValueNotifyingHost (0.25f);
+            expect (queue.popEventsForBlock (64).empty());
+
+            queue.setCapacity (32);
+
+            param->setValueNotifyingHost (0.5f);
+
+            {
+                const AudioProcessorParameterEventQueue::ScopedIgnoreNotifiedChanges ignore;
+                param->setValueNotifyingHost (0.75f);
+            }
+
+            const auto events = queue.popEventsForBlock (64);
+            expectEquals ((int) events.size(), 1);
+            expect (isEvent (events[0], 1, 0, 0.5f));
+        }
+    }
+
+private:
+    static bool isEvent (const AudioProcessorParameterEventQueue::Event& e, int index, int offset, float value)
+    {
+        return e.parameterIndex == index && e.sampleOffset == offset && exactlyEqual (e.value, value);
+    }
+
+    class TestProcessor final : public AudioProcessor
+    {
+    public:
+        TestProcessor()
+        {
+            addParameter (new AudioParameterFloat ("a", "A", 0.0f, 1.0f, 0.0f));
+            addParameter (new AudioParameterFloat ("b", "B", 0.0f, 1.0f, 0.0f));
+        }
+
+        const String getName() const override                         { return "Test"; }
+        double getTailLengthSeconds() const override                  { return 0.0; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return false; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return 0; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (MemoryBlock&) override              {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+        void processBlock (AudioBuffer<float>&, MidiBuffer&) override {}
+        using AudioProcessor::processBlock;
+    };
+};
+
+static AudioProcessorParameterEventQueueTests audioProcessorParameterEventQueueTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A lock-free queue of timestamped parameter changes, which allows an AudioProcessor
+    to apply parameter changes at the exact sample at which they happen.
+
+    Each AudioProcessor owns one of these queues, which can be retrieved with
+    AudioProcessor::getParameterEventQueue(). The queue is disabled until it has been
+    given a capacity with setCapacity(). Once it's enabled, every call to
+    AudioProcessorParameter::setValueNotifyingHost() on one of the processor's parameters
+    adds an event at the start of the next block, and plugin wrappers that receive
+    sample-accurate automation from the host will add an event for each automation point.
+
+    Events can be added from any number of threads, but must only be removed by the audio
+    thread, inside processBlock():
+
+    @code
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        auto& queue = getParameterEventQueue();
+
+        AudioProcessorParameterEventQueue::splitBlock (queue.popEventsForBlock (buffer.getNumSamples()),
+                                                       buffer.getNumSamples(),
+                                                       [&] (int start, int num, auto eventsAtStart)
+        {
+            for (const auto& event : eventsAtStart)
+                if (event.parameterIndex == gainIndex)
+                    gain = event.value;
+
+            buffer.applyGain (start, num, gain);
+        });
+    }
+    @endcode
+
+    Adding and removing events never allocates or blocks, so this can be used instead of
+    keeping an atomic copy of each parameter value for the audio thread.
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorParameterEventQueue
+{
+public:
+    //==============================================================================
+    /** A single parameter change. */
+    struct Event
+    {
+        /** The index of the parameter, as returned by AudioProcessorParameter::getParameterIndex(). */
+        int parameterIndex = -1;
+
+        /** The position of the change, relative to the start of the next block to be processed. */
+        int sampleOffset = 0;
+
+        /** The new normalised value of the parameter, in the range 0 to 1. */
+        float value = 0.0f;
+    };
+
+    //==============================================================================
+    /** Creates a disabled queue. */
+    AudioProcessorParameterEventQueue() = default;
+
+    /** Destructor. */
+    ~AudioProcessorParameterEventQueue();
+
+    //==============================================================================
+    /** Allocates space for at least the given number of events, discarding any events in the
+        queue.
+
+        A capacity of 0 disables the queue. This allocates, and must not be called while
+        events are being added or removed; the best time to call it is in the processor's
+        constructor or before it is prepared.
+    */
+    void setCapacity (int maxNumEvents);
+
+    /** Returns the number of events that the queue can hold. */
+    int getCapacity() const noexcept                    { return capacity; }
+
+    /** Returns true if the queue has been given a capacity. */
+    bool isEnabled() const noexcept                     { return capacity > 0; }
+
+    //==============================================================================
+    /** Adds an event to the queue.
+
+        This may be called from any thread. It won't allocate or block, and returns false if
+        the queue is disabled or full.
+    */
+    bool push (const Event& event) noexcept;
+
+    /** Removes the events that fall inside the next block, and returns them sorted by their
+        sample offset. Events at the same offset are kept in the order in which they were added.
+
+        Events with offsets beyond the end of the block are kept back for the following
+        blocks, with their offsets adjusted accordingly. Events with negative offsets are
+        moved to the start of the block.
+
+        This must only be called by the audio thread. The returned events remain valid until
+        the next call to this function.
+    */
+    Span<const Event> popEventsForBlock (int numSamples) noexcept;
+
+    /** Discards all events, including any that were kept back for later blocks.
+
+        This must only be called by the audio thread, or while no events are being removed.
+    */
+    void clear() noexcept;
+
+    //==============================================================================
+    /** Divides a block into segments that start at each sample offset where there's an event.
+
+        The callback is called with the start and length of each segment, and the events that
+        occur at the start of that segment, in the form (int startSample, int numSamples,
+        Span<const Event> eventsAtStart). Every sample of the block is covered exactly once,
+        and the events passed in must be sorted by offset, as returned by popEventsForBlock().
+
+        This doesn't allocate, and can be used on the audio thread.
+    */
+    template <typename Callback>
+    static void splitBlock (Span<const Event> events, int numSamples, Callback&& callback)
+    {
+        auto it = events.begin();
+
+        for (auto start = 0; start < numSamples;)
+        {
+            const auto firstAtStart = it;
+
+            while (it != events.end() && it->sampleOffset <= start)
+                ++it;
+
+            const auto end = it != events.end() ? jmin (it->sampleOffset, numSamples) : numSamples;
+            callback (start, end - start, Span<const Event> (firstAtStart, (size_t) (it - firstAtStart)));
+            start = end;
+        }
+    }
+
+    //==============================================================================
+    /** While one of these exists, changes made by setValueNotifyingHost() on the current thread
+        won't be added to the processor's queue.
+
+        Plugin wrappers use this when they add sample-accurate host automation to the queue
+        themselves, and still need to update the parameter's current value.
+    */
+    struct JUCE_API  ScopedIgnoreNotifiedChanges
+    {
+        ScopedIgnoreNotifiedChanges();
+        ~ScopedIgnoreNotifiedChanges();
+
+        /** Returns true if changes on the current thread are being ignored. */
+        static bool isActive() noexcept;
+
+    private:
+        bool wasActive;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedIgnoreNotifiedChanges)
+    };
+
+private:
+    //==============================================================================
+    struct Cell
+    {
+        std::atomic<size_t> sequence { 0 };
+        Event event;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    int capacity = 0;
+    std::atomic<size_t> writePosition { 0 };
+    size_t readPosition = 0;
+
+    std::vector<Event> pending, current;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorParameterEventQueue)
+};
+
+} // namespace juce
@@ -147,6 +147,27 @@ void AudioProcessorPlayer::resizeChannels()
                                    actualProcessorChannels.outs);
     channels.resize ((size_t) maxChannels);
     tempBuffer.setSize (maxChannels, blockSize);
+
+    // Everything that the audio callback uses is allocated up front, so that the callback
+    // itself never needs to allocate
+    offsetInputs.reserve ((size_t) deviceChannels.ins);
+    offsetOutputs.reserve ((size_t) deviceChannels.outs);
+    conversionBuffer.setSize (isDoublePrecision ? maxChannels : 0, isDoublePrecision ? getProcessingBlockSize() : 0);
+    incomingMidi.ensureSize (midiBufferBytesToReserve);
+
+    for (auto& buffer : fixedBlockBuffers)
+    {
+        buffer.setSize (fixedBlockSize > 0 ? maxChannels : 0, fixedBlockSize);
+        buffer.clear();
+    }
+
+    fixedBlockOutputIndex = 0;
+    fixedBlockPosition = 0;
+}
+
+int AudioProcessorPlayer::getProcessingBlockSize() const noexcept
+{
+    return fixedBlockSize > 0 ? fixedBlockSize : blockSize;
 }
 
 void AudioProcessorPlayer::setProcessor (AudioProcessor* const processorToPlay)
@@ -165,19 +186,19 @@ void AudioProcessorPlayer::setProcessor (AudioProcessor* const processorToPlay)
         actualProcessorChannels  = findMostSuitableLayout (*processorToPlay);
 
         if (processorToPlay->isMidiEffect())
-            processorToPlay->setRateAndBufferSizeDetails (sampleRate, blockSize);
+            processorToPlay->setRateAndBufferSizeDetails (sampleRate, getProcessingBlockSize());
         else
             processorToPlay->setPlayConfigDetails (actualProcessorChannels.ins,
                                                    actualProcessorChannels.outs,
                                                    sampleRate,
-                                                   blockSize);
+                                                   getProcessingBlockSize());
 
         auto supportsDouble = processorToPlay->supportsDoublePrecisionProcessing() && isDoublePrecision;
 
         processorToPlay->setProcessingPrecision (supportsDouble ? AudioProcessor::doublePrecision
                                                                 : AudioProcessor::singlePrecision);
 
-        processorToPlay->prepareToPlay (sampleRate, blockSize);
+        processorToPlay->prepareToPlay (sampleRate, getProcessingBlockSize());
     }
 
     AudioProcessor* oldOne = nullptr;
@@ -208,10 +229,35 @@ void AudioProcessorPlayer::setDoublePrecisionProcessing (bool doublePrecision)
             processor->setProcessingPrecision (supportsDouble ? AudioProcessor::doublePrecision
                                                               : AudioProcessor::singlePrecision);
 
-            processor->prepareToPlay (sampleRate, blockSize);
+            processor->prepareToPlay (sampleRate, getProcessingBlockSize());
         }
 
         isDoublePrecision = doublePrecision;
+        resizeChannels();
+    }
+}
+
+void AudioProcessorPlayer::setFixedBlockSize (int numSamples)
+{
+    const ScopedLock sl (lock);
+
+    numSamples = jmax (0, numSamples);
+
+    if (numSamples == fixedBlockSize)
+        return;
+
+    fixedBlockSize = numSamples;
+
+    // If the device is running, the processor needs to be prepared again with the new block size
+    if (processor != nullptr && sampleRate > 0 && blockSize > 0)
+    {
+        auto* oldProcessor = processor;
+        setProcessor (nullptr);
+        setProcessor (oldProcessor);
+    }
+    else
+    {
+        resizeChannels();
     }
 }
 
@@ -239,11 +285,46 @@ void AudioProcessorPlayer::audioDeviceIOCallbackWithContext (const float* const*
     // These should have been prepared by audioDeviceAboutToStart()...
     jassert (sampleRate > 0 && blockSize > 0);
 
-    incomingMidi.clear();
-    messageCollector.removeNextBlockOfMessages (incomingMidi, numSamples);
+    // Some devices deliver more samples than they said they would, so anything larger
+    // than the prepared block size is split up rather than overflowing the temp buffer
+    const auto maxChunkSize = jmax (1, tempBuffer.getNumSamples());
+
+    for (int start = 0; start < numSamples;)
+    {
+        const auto numThisTime = jmin (numSamples - start, maxChunkSize);
+
+        const auto hostTimeNs = context.hostTimeNs != nullptr
+                              ? makeOptional (*context.hostTimeNs + (uint64_t) ((double) start * 1.0e9 / sampleRate))
+                              : nullopt;
+
+        offsetInputs.resize ((size_t) numInputChannels);
+        offsetOutputs.resize ((size_t) numOutputChannels);
+
+        for (int i = 0; i < numInputChannels; ++i)
+            offsetInputs[(size_t) i] = inputChannelData[i] + start;
+
+        for (int i = 0; i < numOutputChannels; ++i)
+            offsetOutputs[(size_t) i] = outputChannelData[i] + start;
 
-    initialiseIoBuffers ({ inputChannelData,  (size_t) numInputChannels },
-                         { outputChannelData, (size_t) numOutputChannels },
+        const Span<const float* const> ins { offsetInputs.data(), offsetInputs.size() };
+        const Span<float* const> outs { offsetOutputs.data(), offsetOutputs.size() };
+
+        if (fixedBlockSize > 0)
+            processFixedBlocks (ins, outs, numThisTime, hostTimeNs);
+        else
+            processDeviceBlock (ins, outs, numThisTime, hostTimeNs);
+
+        start += numThisTime;
+    }
+}
+
+void AudioProcessorPlayer::processDeviceBlock (Span<const float* const> ins,
+                                               Span<float* const> outs,
+                                               int numSamples,
+                                               Optional<uint64_t> hostTimeNs)
+{
+    initialiseIoBuffers (ins,
+                         outs,
                          numSamples,
                          (size_t) actualProcessorChannels.ins,
                          (size_t) actualProcessorChannels.outs,
@@ -253,92 +334,150 @@ void AudioProcessorPlayer::audioDeviceIOCallbackWithContext (const float* const*
     const auto totalNumChannels = jmax (actualProcessorChannels.ins, actualProcessorChannels.outs);
     AudioBuffer<float> buffer (channels.data(), (int) totalNumChannels, numSamples);
 
-    if (processor != nullptr)
+    if (! processBuffer (buffer, hostTimeNs))
+        for (auto* out : outs)
+            FloatVectorOperations::clear (out, numSamples);
+}
+
+/*  Collects the device's input in one buffer until a whole block has arrived, and then
+    processes it in place. While the next block is being collected, the previous block's
+    output is played from the other buffer, so the output is always exactly one block late.
+*/
+void AudioProcessorPlayer::processFixedBlocks (Span<const float* const> ins,
+                                               Span<float* const> outs,
+                                               int numSamples,
+                                               Optional<uint64_t> hostTimeNs)
+{
+    // Route the device inputs to the processor's channels, as they would be for a direct call
+    initialiseIoBuffers (ins,
+                         {},
+                         numSamples,
+                         (size_t) actualProcessorChannels.ins,
+                         (size_t) actualProcessorChannels.outs,
+                         tempBuffer,
+                         channels);
+
+    const auto totalNumChannels = jmax (actualProcessorChannels.ins, actualProcessorChannels.outs);
+    const auto numOutsToCopy = jmin ((size_t) totalNumChannels, outs.size());
+
+    for (int position = 0; position < numSamples;)
     {
-        const ScopedLock sl2 (processor->getCallbackLock());
+        auto& input  = fixedBlockBuffers[1 - fixedBlockOutputIndex];
+        auto& output = fixedBlockBuffers[fixedBlockOutputIndex];
+        const auto numThisTime = jmin (numSamples - position, fixedBlockSize - fixedBlockPosition);
 
-        if (std::exchange (currentWorkgroup, currentDevice->getWorkgroup()) != currentDevice->getWorkgroup())
-            processor->audioWorkgroupContextChanged (currentWorkgroup);
+        for (int i = 0; i < totalNumChannels; ++i)
+            input.copyFrom (i, fixedBlockPosition, channels[(size_t) i] + position, numThisTime);
 
-        class PlayHead final : private AudioPlayHead
+        for (size_t i = 0; i < numOutsToCopy; ++i)
+            FloatVectorOperations::copy (outs[i] + position, output.getReadPointer ((int) i, fixedBlockPosition), numThisTime);
+
+        for (size_t i = numOutsToCopy; i < outs.size(); ++i)
+            FloatVectorOperations::clear (outs[i] + position, numThisTime);
+
+        position += numThisTime;
+        fixedBlockPosition += numThisTime;
+
+        if (fixedBlockPosition == fixedBlockSize)
         {
-        public:
-            PlayHead (AudioProcessor& proc,
-                      Optional<uint64_t> hostTimeIn,
-                      uint64_t sampleCountIn,
-                      double sampleRateIn)
-                : processor (proc),
-                  hostTimeNs (hostTimeIn),
-                  sampleCount (sampleCountIn),
-                  seconds ((double) sampleCountIn / sampleRateIn)
-            {
-                if (useThisPlayhead)
-                    processor.setPlayHead (this);
-            }
+            AudioBuffer<float> block (input.getArrayOfWritePointers(), totalNumChannels, fixedBlockSize);
 
-            ~PlayHead() override
-            {
-                if (useThisPlayhead)
-                    processor.setPlayHead (nullptr);
-            }
+            if (! processBuffer (block, hostTimeNs))
+                block.clear();
 
-        private:
-            Optional<PositionInfo> getPosition() const override
-            {
-                PositionInfo info;
-                info.setHostTimeNs (hostTimeNs);
-                info.setTimeInSamples ((int64_t) sampleCount);
-                info.setTimeInSeconds (seconds);
-                return info;
-            }
+            fixedBlockOutputIndex = 1 - fixedBlockOutputIndex;
+            fixedBlockPosition = 0;
+        }
+    }
+}
+
+bool AudioProcessorPlayer::processBuffer (AudioBuffer<float>& buffer, Optional<uint64_t> hostTimeNs)
+{
+    const auto numSamples = buffer.getNumSamples();
+
+    incomingMidi.clear();
+    messageCollector.removeNextBlockOfMessages (incomingMidi, numSamples);
 
-            AudioProcessor& processor;
-            Optional<uint64_t> hostTimeNs;
-            uint64_t sampleCount;
-            double seconds;
-            bool useThisPlayhead = processor.getPlayHead() == nullptr;
-        };
+    if (processor == nullptr)
+        return false;
 
-        PlayHead playHead { *processor,
-                            context.hostTimeNs != nullptr ? makeOptional (*context.hostTimeNs) : nullopt,
-                            sampleCount,
-                            sampleRate };
+    const ScopedLock sl2 (processor->getCallbackLock());
 
-        sampleCount += (uint64_t) numSamples;
+    if (std::exchange (currentWorkgroup, currentDevice->getWorkgroup()) != currentDevice->getWorkgroup())
+        processor->audioWorkgroupContextChanged (currentWorkgroup);
 
-        if (! processor->isSuspended())
+    class PlayHead final : private AudioPlayHead
+    {
+    public:
+        PlayHead (AudioProcessor& proc,
+                  Optional<uint64_t> hostTimeIn,
+                  uint64_t sampleCountIn,
+                  double sampleRateIn)
+            : processor (proc),
+              hostTimeNs (hostTimeIn),
+              sampleCount (sampleCountIn),
+              seconds ((double) sampleCountIn / sampleRateIn)
         {
-            if (processor->isUsingDoublePrecision())
-            {
-                conversionBuffer.makeCopyOf (buffer, true);
-                processor->processBlock (conversionBuffer, incomingMidi);
-                buffer.makeCopyOf (conversionBuffer, true);
-            }
-            else
-            {
-                processor->processBlock (buffer, incomingMidi);
-            }
+            if (useThisPlayhead)
+                processor.setPlayHead (this);
+        }
 
-            if (midiOutput != nullptr)
-            {
-                if (midiOutput->isBackgroundThreadRunning())
-                {
-                    midiOutput->sendBlockOfMessages (incomingMidi,
-                                                     Time::getMillisecondCounterHiRes(),
-                                                     sampleRate);
-                }
-                else
-                {
-                    midiOutput->sendBlockOfMessagesNow (incomingMidi);
-                }
-            }
+        ~PlayHead() override
+        {
+            if (useThisPlayhead)
+                processor.setPlayHead (nullptr);
+        }
 
-            return;
+    private:
+        Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo info;
+            info.setHostTimeNs (hostTimeNs);
+            info.setTimeInSamples ((int64_t) sampleCount);
+            info.setTimeInSeconds (seconds);
+            return info;
         }
+
+        AudioProcessor& processor;
+        Optional<uint64_t> hostTimeNs;
+        uint64_t sampleCount;
+        double seconds;
+        bool useThisPlayhead = processor.getPlayHead() == nullptr;
+    };
+
+    PlayHead playHead { *processor, hostTimeNs, sampleCount, sampleRate };
+
+    sampleCount += (uint64_t) numSamples;
+
+    if (processor->isSuspended())
+        return false;
+
+    if (processor->isUsingDoublePrecision())
+    {
+        conversionBuffer.makeCopyOf (buffer, true);
+        processor->processBlock (conversionBuffer, incomingMidi);
+        buffer.makeCopyOf (conversionBuffer, true);
+    }
+    else
+    {
+        processor->processBlock (buffer, incomingMidi);
     }
 
-    for (int i = 0; i < numOutputChannels; ++i)
-        FloatVectorOperations::clear (outputChannelData[i], numSamples);
+    if (midiOutput != nullptr)
+    {
+        if (midiOutput->isBackgroundThreadRunning())
+        {
+            midiOutput->sendBlockOfMessages (incomingMidi,
+                                             Time::getMillisecondCounterHiRes(),
+                                             sampleRate);
+        }
+        else
+        {
+            midiOutput->sendBlockOfMessagesNow (incomingMidi);
+        }
+    }
+
+    return true;
 }
 
 void AudioProcessorPlayer::audioDeviceAboutToStart (AudioIODevice* const device)
@@ -431,6 +570,30 @@ struct AudioProcessorPlayerTests final : public UnitTest
                     runTest (systemLayout, processorLayout);
             }
         }
+
+        beginTest ("Blocks larger than the device's buffer size are split up");
+        {
+            DelayProcessor processor;
+            const auto output = runPlayer (processor, 0, { 100, 300, 64 });
+
+            expect (std::all_of (processor.blockSizes.begin(), processor.blockSizes.end(), [] (int n) { return 0 < n && n <= deviceBlockSize; }));
+            expectEquals (std::accumulate (processor.blockSizes.begin(), processor.blockSizes.end(), 0), 464);
+            expect (isDelayedRamp (output, 0));
+        }
+
+        beginTest ("A fixed block size is passed to the processor, and delays the output by one block");
+        {
+            DelayProcessor processor;
+            AudioProcessorPlayer player;
+            player.setFixedBlockSize (48);
+            expectEquals (player.getLatencySamples(), 48);
+
+            const auto output = runPlayer (processor, 48, { 100, 7, 300, 1, 53, 128 });
+
+            expect (! processor.blockSizes.empty());
+            expect (std::all_of (processor.blockSizes.begin(), processor.blockSizes.end(), [] (int n) { return n == 48; }));
+            expect (isDelayedRamp (output, 48));
+        }
     }
 
     void runTest (Layout systemLayout, Layout processorLayout)
@@ -473,6 +636,98 @@ struct AudioProcessorPlayerTests final : public UnitTest
         }
     }
 
+    static constexpr auto deviceBlockSize = 128;
+
+    /*  Passes a ramp through the player in blocks of the given sizes, and returns the output. */
+    static std::vector<float> runPlayer (AudioProcessor& processor, int fixedBlockSize, const std::vector<int>& blockSizes)
+    {
+        FakeDevice device;
+        AudioProcessorPlayer player;
+        player.setFixedBlockSize (fixedBlockSize);
+        player.audioDeviceAboutToStart (&device);
+        player.setProcessor (&processor);
+
+        std::vector<float> result;
+        float nextValue = 1.0f;
+
+        for (auto numSamples : blockSizes)
+        {
+            std::vector<float> in ((size_t) numSamples), out ((size_t) numSamples);
+            std::iota (in.begin(), in.end(), nextValue);
+            nextValue += (float) numSamples;
+
+            const float* ins[] { in.data() };
+            float* outs[] { out.data() };
+            player.audioDeviceIOCallbackWithContext (ins, 1, outs, 1, numSamples, {});
+            result.insert (result.end(), out.begin(), out.end());
+        }
+
+        player.setProcessor (nullptr);
+        player.audioDeviceStopped();
+        return result;
+    }
+
+    static bool isDelayedRamp (const std::vector<float>& output, int delay)
+    {
+        for (const auto [index, sample] : enumerate (output, int{}))
+            if (! exactlyEqual (sample, index < delay ? 0.0f : (float) (index - delay + 1)))
+                return false;
+
+        return true;
+    }
+
+    struct DelayProcessor final : public AudioProcessor
+    {
+        DelayProcessor()
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::mono())
+                                               .withOutput ("out", AudioChannelSet::mono())) {}
+
+        const String getName() const override                         { return "Test"; }
+        double getTailLengthSeconds() const override                  { return 0.0; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return false; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return 0; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (MemoryBlock&) override              {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override { blockSizes.push_back (buffer.getNumSamples()); }
+        using AudioProcessor::processBlock;
+
+        std::vector<int> blockSizes;
+    };
+
+    struct FakeDevice final : public AudioIODevice
+    {
+        FakeDevice() : AudioIODevice ("fake", "fake") {}
+
+        StringArray getOutputChannelNames() override                  { return { "out" }; }
+        StringArray getInputChannelNames() override                   { return { "in" }; }
+        Array<double> getAvailableSampleRates() override              { return { 44100.0 }; }
+        Array<int> getAvailableBufferSizes() override                 { return { deviceBlockSize }; }
+        int getDefaultBufferSize() override                           { return deviceBlockSize; }
+        String open (const BigInteger&, const BigInteger&, double, int) override { return {}; }
+        void close() override                                         {}
+        bool isOpen() override                                        { return true; }
+        void start (AudioIODeviceCallback*) override                  {}
+        void stop() override                                          {}
+        bool isPlaying() override                                     { return true; }
+        String getLastError() override                                { return {}; }
+        int getCurrentBufferSizeSamples() override                    { return deviceBlockSize; }
+        double getCurrentSampleRate() override                        { return 44100.0; }
+        int getCurrentBitDepth() override                             { return 32; }
+        BigInteger getActiveOutputChannels() const override           { return 1; }
+        BigInteger getActiveInputChannels() const override            { return 1; }
+        int getOutputLatencyInSamples() override                      { return 0; }
+        int getInputLatencyInSamples() override                       { return 0; }
+    };
+
     static AudioBuffer<float> getTestBuffer (int numChannels, int numSamples)
     {
         AudioBuffer<float> result (numChannels, numSamples);
@@ -46,6 +46,10 @@ namespace juce
     input to send both streams through the processor. To set a MidiOutput for the processor,
     use the setMidiOutput() method.
 
+    Once the device has started, the player doesn't allocate any memory in its audio
+    callback, as long as the processor doesn't, and the amount of incoming MIDI in each
+    block stays within a few kilobytes.
+
     @see AudioProcessor, AudioProcessorGraph
 
     @tags{Audio}
@@ -99,6 +103,24 @@ public:
     */
     inline bool getDoublePrecisionProcessing() { return isDoublePrecision; }
 
+    /** Makes the player always pass blocks of the same size to the processor.
+
+        Some audio devices deliver blocks whose sizes vary from one callback to the next.
+        When a fixed block size is set, the player collects the incoming audio in a FIFO,
+        and only calls the processor once a whole block is available. This delays the
+        output by the block size, which is reported by getLatencySamples().
+
+        Pass 0 to turn this off, in which case the processor is called with whatever
+        block size the device delivers.
+    */
+    void setFixedBlockSize (int numSamples);
+
+    /** Returns the block size set with setFixedBlockSize(), or 0 if it's turned off. */
+    int getFixedBlockSize() const noexcept                          { return fixedBlockSize; }
+
+    /** Returns the latency that the player adds on top of the processor's own latency. */
+    int getLatencySamples() const noexcept                          { return fixedBlockSize; }
+
     //==============================================================================
     /** @internal */
     void audioDeviceIOCallbackWithContext (const float* const*, int, float* const*, int, int, const AudioIODeviceCallbackContext&) override;
@@ -130,6 +152,13 @@ private:
     //==============================================================================
     NumChannels findMostSuitableLayout (const AudioProcessor&) const;
     void resizeChannels();
+    int getProcessingBlockSize() const noexcept;
+
+    void processDeviceBlock (Span<const float* const>, Span<float* const>, int, Optional<uint64_t>);
+    void processFixedBlocks (Span<const float* const>, Span<float* const>, int, Optional<uint64_t>);
+    bool processBuffer (AudioBuffer<float>&, Optional<uint64_t>);
+
+    static constexpr size_t midiBufferBytesToReserve = 4096;
 
     //==============================================================================
     AudioProcessor* processor = nullptr;
@@ -142,6 +171,11 @@ private:
     std::vector<float*> channels;
     AudioBuffer<float> tempBuffer;
     AudioBuffer<double> conversionBuffer;
+    std::vector<const float*> offsetInputs;
+    std::vector<float*> offsetOutputs;
+
+    int fixedBlockSize = 0, fixedBlockPosition = 0, fixedBlockOutputIndex = 0;
+    AudioBuffer<float> fixedBlockBuffers[2];
 
     MidiBuffer incomingMidi;
     MidiMessageCollector messageCollector;
@@ -108,6 +108,7 @@
  #else
   #error "SIMD register support not implemented for this platform"
  #endif
+ #include "widgets/juce_SIMDSineVoiceBank.cpp"
 #endif
 
 #if JUCE_UNIT_TESTS
@@ -116,6 +117,7 @@
 
  #if JUCE_USE_SIMD
   #include "containers/juce_SIMDRegister_test.cpp"
+  #include "widgets/juce_SIMDSineVoiceBank_test.cpp"
  #endif
 
  #include "containers/juce_AudioBlock_test.cpp"
@@ -302,3 +302,7 @@ namespace util
 #include "widgets/juce_Limiter.h"
 #include "widgets/juce_Phaser.h"
 #include "widgets/juce_Chorus.h"
+
+#if JUCE_USE_SIMD
+ #include "widgets/juce_SIMDSineVoiceBank.h"
+#endif
@@ -0,0 +1,415 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+SIMDSineOscillatorBank::SIMDSineOscillatorBank (int numOscillatorsToUse)
+    : numOscillators (numOscillatorsToUse),
+      numGroups ((numOscillatorsToUse + numLanes - 1) / numLanes),
+      paddedSize (numGroups * numLanes),
+      active ((size_t) numOscillatorsToUse, false),
+      numActiveInGroup ((size_t) numGroups, 0)
+{
+    jassert (numOscillators > 0);
+
+    stateStorage.calloc ((size_t) (numFields * paddedSize + numLanes));
+    state = Register::getNextSIMDAlignedPtr (stateStorage.get());
+
+    // Padding oscillators never start, but are kept at a valid phase so that they can
+    // be processed alongside the others
+    FloatVectorOperations::fill (getField (real), 1.0f, paddedSize);
+    FloatVectorOperations::fill (getField (cosDelta), 1.0f, paddedSize);
+
+    prepare (sampleRate, 512);
+}
+
+void SIMDSineOscillatorBank::prepare (double newSampleRate, int maximumBlockSize)
+{
+    jassert (newSampleRate > 0 && maximumBlockSize > 0);
+
+    sampleRate = newSampleRate;
+    maxChunkSize = maximumBlockSize;
+
+    scratchStorage.malloc ((size_t) ((maxChunkSize + 1) * numLanes));
+    accumulators = Register::getNextSIMDAlignedPtr (scratchStorage.get());
+
+    updateEnvelopeSteps();
+
+    for (int i = 0; i < numOscillators; ++i)
+        stop (i);
+}
+
+void SIMDSineOscillatorBank::setAttackAndRelease (float newAttackSeconds, float newReleaseSeconds) noexcept
+{
+    jassert (newAttackSeconds >= 0.0f && newReleaseSeconds >= 0.0f);
+
+    attackSeconds = newAttackSeconds;
+    releaseSeconds = newReleaseSeconds;
+    updateEnvelopeSteps();
+}
+
+void SIMDSineOscillatorBank::updateEnvelopeSteps() noexcept
+{
+    auto getStep = [this] (float seconds)
+    {
+        const auto numSamples = seconds * (float) sampleRate;
+        return numSamples > 1.0f ? 1.0f / numSamples : 1.0f;
+    };
+
+    attackStep = getStep (attackSeconds);
+    releaseStep = getStep (releaseSeconds);
+}
+
+//==============================================================================
+void SIMDSineOscillatorBank::start (int index, float frequencyHz, float gain) noexcept
+{
+    jassert (isPositiveAndBelow (index, numOscillators));
+
+    getField (real)[index] = 1.0f;
+    getField (imag)[index] = 0.0f;
+    getField (envelopes)[index] = 0.0f;
+    setEnvelopeStep (index, attackStep);
+    setFrequency (index, frequencyHz);
+    setGain (index, gain);
+
+    if (! active[(size_t) index])
+    {
+        active[(size_t) index] = true;
+        ++numActiveInGroup[(size_t) (index / numLanes)];
+    }
+}
+
+void SIMDSineOscillatorBank::setFrequency (int index, float frequencyHz) noexcept
+{
+    jassert (isPositiveAndBelow (index, numOscillators));
+
+    const auto delta = MathConstants<double>::twoPi * frequencyHz / sampleRate;
+    getField (cosDelta)[index] = (float) std::cos (delta);
+    getField (sinDelta)[index] = (float) std::sin (delta);
+}
+
+void SIMDSineOscillatorBank::setGain (int index, float gain) noexcept
+{
+    jassert (isPositiveAndBelow (index, numOscillators));
+    getField (gains)[index] = gain;
+}
+
+void SIMDSineOscillatorBank::release (int index) noexcept
+{
+    jassert (isPositiveAndBelow (index, numOscillators));
+
+    if (active[(size_t) index])
+        setEnvelopeStep (index, -releaseStep);
+}
+
+void SIMDSineOscillatorBank::stop (int index) noexcept
+{
+    jassert (isPositiveAndBelow (index, numOscillators));
+
+    getField (envelopes)[index] = 0.0f;
+    setEnvelopeStep (index, 0.0f);
+
+    if (active[(size_t) index])
+    {
+        active[(size_t) index] = false;
+        --numActiveInGroup[(size_t) (index / numLanes)];
+    }
+}
+
+void SIMDSineOscillatorBank::setEnvelopeStep (int index, float step) noexcept
+{
+    getField (envelopeSteps)[index] = step;
+}
+
+//==============================================================================
+void SIMDSineOscillatorBank::process (float* output, int numSamples) noexcept
+{
+    while (numSamples > 0)
+    {
+        const auto numThisTime = jmin (numSamples, maxChunkSize);
+        processChunk (output, numThisTime);
+        output += numThisTime;
+        numSamples -= numThisTime;
+    }
+}
+
+void SIMDSineOscillatorBank::processChunk (float* output, int numSamples) noexcept
+{
+    // Each sample has a register of accumulators, one per lane, so that the groups can
+    // be added without any horizontal operations until the very end
+    FloatVectorOperations::clear (accumulators, numSamples * numLanes);
+
+    const auto zero = Register::expand (0.0f);
+    const auto one = Register::expand (1.0f);
+
+    for (int group = 0; group < numGroups; ++group)
+    {
+        if (numActiveInGroup[(size_t) group] == 0)
+            continue;
+
+        const auto offset = (size_t) (group * numLanes);
+        auto* re = getField (real) + offset;
+        auto* im = getField (imag) + offset;
+        auto* env = getField (envelopes) + offset;
+
+        auto x = Register::fromRawArray (re);
+        auto y = Register::fromRawArray (im);
+        auto e = Register::fromRawArray (env);
+        const auto c = Register::fromRawArray (getField (cosDelta) + offset);
+        const auto s = Register::fromRawArray (getField (sinDelta) + offset);
+        const auto g = Register::fromRawArray (getField (gains) + offset);
+        const auto step = Register::fromRawArray (getField (envelopeSteps) + offset);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto* acc = accumulators + i * numLanes;
+            (Register::fromRawArray (acc) + y * e * g).copyToRawArray (acc);
+
+            const auto newX = x * c - y * s;
+            y = x * s + y * c;
+            x = newX;
+
+            e = Register::min (Register::max (e + step, zero), one);
+        }
+
+        // The rotation slowly drifts away from the unit circle, so pull it back once
+        // per chunk with a step of Newton's method for 1 / sqrt (x^2 + y^2)
+        const auto correction = Register::expand (1.5f) - Register::expand (0.5f) * (x * x + y * y);
+        (x * correction).copyToRawArray (re);
+        (y * correction).copyToRawArray (im);
+        e.copyToRawArray (env);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const auto index = group * numLanes + lane;
+
+            if (index < numOscillators && active[(size_t) index]
+                 && env[lane] <= 0.0f && getField (envelopeSteps)[index] < 0.0f)
+                stop (index);
+        }
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+        output[i] = Register::fromRawArray (accumulators + i * numLanes).sum();
+}
+
+//==============================================================================
+namespace
+{
+    constexpr int voiceBankChunkSize = 256;
+
+    template <typename FloatType>
+    void renderOscillatorBank (SIMDSineOscillatorBank& oscillators, float* monoBuffer,
+                               AudioBuffer<FloatType>& outputBuffer, int startSample, int numSamples)
+    {
+        while (numSamples > 0)
+        {
+            const auto numThisTime = jmin (numSamples, voiceBankChunkSize);
+            oscillators.process (monoBuffer, numThisTime);
+
+            for (int ch = 0; ch < outputBuffer.getNumChannels(); ++ch)
+            {
+                auto* out = outputBuffer.getWritePointer (ch, startSample);
+
+                if constexpr (std::is_same_v<FloatType, float>)
+                {
+                    FloatVectorOperations::add (out, monoBuffer, numThisTime);
+                }
+                else
+                {
+                    for (int i = 0; i < numThisTime; ++i)
+                        out[i] += (double) monoBuffer[i];
+                }
+            }
+
+            startSample += numThisTime;
+            numSamples -= numThisTime;
+        }
+    }
+}
+
+//==============================================================================
+SIMDSineVoiceBank::SIMDSineVoiceBank (int numVoicesToUse)
+    : SynthesiserVoiceBank (numVoicesToUse),
+      oscillators (numVoicesToUse),
+      noteFrequencies ((size_t) numVoicesToUse, 0.0f),
+      pitchWheelPositions ((size_t) numVoicesToUse, 0x2000),
+      monoBuffer ((size_t) voiceBankChunkSize)
+{
+    oscillators.prepare (getSampleRate(), voiceBankChunkSize);
+}
+
+void SIMDSineVoiceBank::setAttackAndRelease (float attackSeconds, float releaseSeconds) noexcept
+{
+    oscillators.setAttackAndRelease (attackSeconds, releaseSeconds);
+}
+
+bool SIMDSineVoiceBank::canPlaySound (SynthesiserSound*)
+{
+    return true;
+}
+
+float SIMDSineVoiceBank::getFrequency (int voiceIndex) const noexcept
+{
+    const auto semitones = 2.0f * (float) (pitchWheelPositions[(size_t) voiceIndex] - 0x2000) / (float) 0x2000;
+    return noteFrequencies[(size_t) voiceIndex] * std::exp2 (semitones / 12.0f);
+}
+
+void SIMDSineVoiceBank::startNote (int voiceIndex, int midiNoteNumber, float velocity,
+                                   SynthesiserSound*, int currentPitchWheelPosition)
+{
+    noteFrequencies[(size_t) voiceIndex] = (float) MidiMessage::getMidiNoteInHertz (midiNoteNumber);
+    pitchWheelPositions[(size_t) voiceIndex] = currentPitchWheelPosition;
+    oscillators.start (voiceIndex, getFrequency (voiceIndex), velocity);
+}
+
+void SIMDSineVoiceBank::stopNote (int voiceIndex, float, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        oscillators.release (voiceIndex);
+    }
+    else
+    {
+        oscillators.stop (voiceIndex);
+        clearCurrentNote (voiceIndex);
+    }
+}
+
+void SIMDSineVoiceBank::pitchWheelMoved (int voiceIndex, int newPitchWheelValue)
+{
+    pitchWheelPositions[(size_t) voiceIndex] = newPitchWheelValue;
+    oscillators.setFrequency (voiceIndex, getFrequency (voiceIndex));
+}
+
+void SIMDSineVoiceBank::controllerMoved (int, int, int) {}
+
+void SIMDSineVoiceBank::setCurrentPlaybackSampleRate (double newRate)
+{
+    SynthesiserVoiceBank::setCurrentPlaybackSampleRate (newRate);
+
+    // A Synthesiser passes on a rate of zero if a bank is added before its rate is set
+    if (newRate > 0.0)
+        oscillators.prepare (newRate, voiceBankChunkSize);
+}
+
+template <typename FloatType>
+void SIMDSineVoiceBank::render (AudioBuffer<FloatType>& outputBuffer, int startSample, int numSamples)
+{
+    renderOscillatorBank (oscillators, monoBuffer.get(), outputBuffer, startSample, numSamples);
+
+    for (int i = 0; i < getNumVoices(); ++i)
+        if (isVoiceActive (i) && ! oscillators.isActive (i))
+            clearCurrentNote (i);
+}
+
+void SIMDSineVoiceBank::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    render (outputBuffer, startSample, numSamples);
+}
+
+void SIMDSineVoiceBank::renderNextBlock (AudioBuffer<double>& outputBuffer, int startSample, int numSamples)
+{
+    render (outputBuffer, startSample, numSamples);
+}
+
+//==============================================================================
+SIMDSineMPEVoiceBank::SIMDSineMPEVoiceBank (int numVoicesToUse)
+    : MPESynthesiserVoiceBank (numVoicesToUse),
+      oscillators (numVoicesToUse),
+      monoBuffer ((size_t) voiceBankChunkSize)
+{
+    oscillators.prepare (44100.0, voiceBankChunkSize);
+}
+
+void SIMDSineMPEVoiceBank::setAttackAndRelease (float attackSeconds, float releaseSeconds) noexcept
+{
+    oscillators.setAttackAndRelease (attackSeconds, releaseSeconds);
+}
+
+void SIMDSineMPEVoiceBank::noteStarted (int voiceIndex)
+{
+    const auto note = getCurrentlyPlayingNote (voiceIndex);
+    oscillators.start (voiceIndex, (float) note.getFrequencyInHertz(), note.noteOnVelocity.asUnsignedFloat());
+}
+
+void SIMDSineMPEVoiceBank::noteStopped (int voiceIndex, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        oscillators.release (voiceIndex);
+    }
+    else
+    {
+        oscillators.stop (voiceIndex);
+        clearCurrentNote (voiceIndex);
+    }
+}
+
+void SIMDSineMPEVoiceBank::notePitchbendChanged (int voiceIndex)
+{
+    oscillators.setFrequency (voiceIndex, (float) getCurrentlyPlayingNote (voiceIndex).getFrequencyInHertz());
+}
+
+void SIMDSineMPEVoiceBank::setCurrentSampleRate (double newRate)
+{
+    MPESynthesiserVoiceBank::setCurrentSampleRate (newRate);
+
+    if (newRate > 0.0)
+        oscillators.prepare (newRate, voiceBankChunkSize);
+}
+
+template <typename FloatType>
+void SIMDSineMPEVoiceBank::render (AudioBuffer<FloatType>& outputBuffer, int startSample, int numSamples)
+{
+    renderOscillatorBank (oscillators, monoBuffer.get(), outputBuffer, startSample, numSamples);
+
+    for (int i = 0; i < getNumVoices(); ++i)
+        if (isActive (i) && ! oscillators.isActive (i))
+            clearCurrentNote (i);
+}
+
+void SIMDSineMPEVoiceBank::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    render (outputBuffer, startSample, numSamples);
+}
+
+void SIMDSineMPEVoiceBank::renderNextBlock (AudioBuffer<double>& outputBuffer, int startSample, int numSamples)
+{
+    render (outputBuffer, startSample, numSamples);
+}
+
+} // namespace juce::dsp
@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+/**
+    A bank of sine oscillators with linear attack/release envelopes, which are all
+    rendered together using SIMDRegister lanes.
+
+    The state of the oscillators is stored in a structure-of-arrays layout, with each
+    group of SIMDRegister<float>::size() oscillators processed at once. Groups in which
+    no oscillator is active are skipped.
+
+    This is the engine behind SIMDSineVoiceBank and SIMDSineMPEVoiceBank, and can also
+    be used to write other voice banks.
+
+    @see SIMDSineVoiceBank, SIMDSineMPEVoiceBank
+
+    @tags{DSP}
+*/
+class JUCE_API  SIMDSineOscillatorBank
+{
+public:
+    //==============================================================================
+    /** Creates a bank with the given number of oscillators. */
+    explicit SIMDSineOscillatorBank (int numOscillators);
+
+    //==============================================================================
+    /** Prepares the bank for playback, and stops all of the oscillators.
+
+        Blocks longer than maximumBlockSize can still be processed, they will just be
+        rendered in several chunks. The attack and release times are kept, and converted
+        to the new sample rate.
+    */
+    void prepare (double sampleRate, int maximumBlockSize);
+
+    /** Sets the attack and release times used by oscillators that are started or
+        released after this call.
+    */
+    void setAttackAndRelease (float attackSeconds, float releaseSeconds) noexcept;
+
+    /** Returns the number of oscillators in the bank. */
+    int getNumOscillators() const noexcept                  { return numOscillators; }
+
+    //==============================================================================
+    /** Starts one of the oscillators from a phase of zero, at the start of its attack. */
+    void start (int index, float frequencyHz, float gain) noexcept;
+
+    /** Changes the frequency of one of the oscillators without resetting its phase. */
+    void setFrequency (int index, float frequencyHz) noexcept;
+
+    /** Changes the gain of one of the oscillators. */
+    void setGain (int index, float gain) noexcept;
+
+    /** Starts the release of one of the oscillators. It becomes inactive once its
+        envelope reaches zero.
+    */
+    void release (int index) noexcept;
+
+    /** Stops one of the oscillators immediately. */
+    void stop (int index) noexcept;
+
+    /** Returns true if one of the oscillators is producing sound. */
+    bool isActive (int index) const noexcept                { return active[(size_t) index]; }
+
+    //==============================================================================
+    /** Replaces the contents of the output with the sum of all the oscillators. */
+    void process (float* output, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    using Register = SIMDRegister<float>;
+    static constexpr int numLanes = (int) Register::SIMDNumElements;
+
+    enum Field { real, imag, cosDelta, sinDelta, gains, envelopes, envelopeSteps, numFields };
+
+    float* getField (Field f) noexcept                      { return state + (size_t) f * (size_t) paddedSize; }
+
+    void processChunk (float* output, int numSamples) noexcept;
+    void setEnvelopeStep (int index, float step) noexcept;
+    void updateEnvelopeSteps() noexcept;
+
+    const int numOscillators, numGroups, paddedSize;
+    HeapBlock<float> stateStorage, scratchStorage;
+    float* state = nullptr;
+    float* accumulators = nullptr;
+    std::vector<bool> active;
+    std::vector<int> numActiveInGroup;
+
+    double sampleRate = 44100.0;
+    int maxChunkSize = 0;
+    float attackSeconds = 0.0f, releaseSeconds = 0.0f, attackStep = 1.0f, releaseStep = 1.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SIMDSineOscillatorBank)
+};
+
+//==============================================================================
+/**
+    A SynthesiserVoiceBank that plays sine waves, rendering all of its voices together
+    with a SIMDSineOscillatorBank.
+
+    The voices can play any sound, follow the pitch wheel with a range of two semitones,
+    and use the note velocity as their gain.
+
+    @see SynthesiserVoiceBank, Synthesiser::addVoiceBank
+
+    @tags{DSP}
+*/
+class JUCE_API  SIMDSineVoiceBank  : public SynthesiserVoiceBank
+{
+public:
+    /** Creates a bank with the given number of voices. */
+    explicit SIMDSineVoiceBank (int numVoices);
+
+    /** Sets the attack and release times of the notes. */
+    void setAttackAndRelease (float attackSeconds, float releaseSeconds) noexcept;
+
+    //==============================================================================
+    /** @internal */
+    bool canPlaySound (SynthesiserSound*) override;
+    /** @internal */
+    void startNote (int, int, float, SynthesiserSound*, int) override;
+    /** @internal */
+    void stopNote (int, float, bool) override;
+    /** @internal */
+    void pitchWheelMoved (int, int) override;
+    /** @internal */
+    void controllerMoved (int, int, int) override;
+    /** @internal */
+    void renderNextBlock (AudioBuffer<float>&, int, int) override;
+    /** @internal */
+    void renderNextBlock (AudioBuffer<double>&, int, int) override;
+    /** @internal */
+    void setCurrentPlaybackSampleRate (double) override;
+
+private:
+    //==============================================================================
+    template <typename FloatType>
+    void render (AudioBuffer<FloatType>&, int, int);
+
+    float getFrequency (int voiceIndex) const noexcept;
+
+    SIMDSineOscillatorBank oscillators;
+    std::vector<float> noteFrequencies;
+    std::vector<int> pitchWheelPositions;
+    HeapBlock<float> monoBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SIMDSineVoiceBank)
+};
+
+//==============================================================================
+/**
+    An MPESynthesiserVoiceBank that plays sine waves, rendering all of its voices
+    together with a SIMDSineOscillatorBank.
+
+    The voices follow the pitchbend of their notes, and use the note-on velocity as
+    their gain.
+
+    @see MPESynthesiserVoiceBank, MPESynthesiser::addVoiceBank
+
+    @tags{DSP}
+*/
+class JUCE_API  SIMDSineMPEVoiceBank  : public MPESynthesiserVoiceBank
+{
+public:
+    /** Creates a bank with the given number of voices. */
+    explicit SIMDSineMPEVoiceBank (int numVoices);
+
+    /** Sets the attack and release times of the notes. */
+    void setAttackAndRelease (float attackSeconds, float releaseSeconds) noexcept;
+
+    //==============================================================================
+    /** @internal */
+    void noteStarted (int) override;
+    /** @internal */
+    void noteStopped (int, bool) override;
+    /** @internal */
+    void notePressureChanged (int) override {}
+    /** @internal */
+    void notePitchbendChanged (int) override;
+    /** @internal */
+    void noteTimbreChanged (int) override {}
+    /** @internal */
+    void noteKeyStateChanged (int) override {}
+    /** @internal */
+    void renderNextBlock (AudioBuffer<float>&, int, int) override;
+    /** @internal */
+    void renderNextBlock (AudioBuffer<double>&, int, int) override;
+    /** @internal */
+    void setCurrentSampleRate (double) override;
+
+private:
+    //==============================================================================
+    template <typename FloatType>
+    void render (AudioBuffer<FloatType>&, int, int);
+
+    SIMDSineOscillatorBank oscillators;
+    HeapBlock<float> monoBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SIMDSineMPEVoiceBank)
+};
+
+} // namespace juce::dsp
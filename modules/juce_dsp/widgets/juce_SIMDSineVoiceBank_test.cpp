@@ -0,0 +1,374 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class SIMDSineVoiceBankTests final : public UnitTest
+{
+public:
+    SIMDSineVoiceBankTests()
+        : UnitTest ("SIMD Sine Voice Bank", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Oscillators match a scalar reference");
+        {
+            constexpr int numOscillators = 11;
+            constexpr int numSamples = 3000, releasePosition = 1000;
+            constexpr float attack = 0.002f, release = 0.005f;
+
+            SIMDSineOscillatorBank bank (numOscillators);
+            bank.prepare (sampleRate, 128);
+            bank.setAttackAndRelease (attack, release);
+
+            std::vector<Reference> references;
+
+            for (int i = 0; i < numOscillators; ++i)
+            {
+                const auto frequency = 100.0f + 317.0f * (float) i;
+                const auto gain = 0.1f + 0.05f * (float) i;
+                bank.start (i, frequency, gain);
+                references.emplace_back (frequency, gain, attack, release);
+            }
+
+            std::vector<float> output (numSamples);
+            bank.process (output.data(), releasePosition);
+
+            for (int i = 0; i < numOscillators; i += 2)
+                bank.release (i);
+
+            bank.process (output.data() + releasePosition, numSamples - releasePosition);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                if (i == releasePosition)
+                    for (int j = 0; j < numOscillators; j += 2)
+                        references[(size_t) j].release();
+
+                double expected = 0.0;
+
+                for (auto& r : references)
+                    expected += r.getNextSample();
+
+                expectWithinAbsoluteError (output[(size_t) i], (float) expected, 1.0e-3f);
+            }
+
+            for (int i = 0; i < numOscillators; ++i)
+                expect (bank.isActive (i) == (i % 2 != 0));
+        }
+
+        beginTest ("Synthesiser renders a voice bank like the equivalent voices");
+        {
+            Synthesiser legacySynth, bankSynth;
+
+            for (auto* synth : { &legacySynth, &bankSynth })
+            {
+                synth->addSound (new TestSound());
+                synth->setCurrentPlaybackSampleRate (sampleRate);
+            }
+
+            for (int i = 0; i < 8; ++i)
+                legacySynth.addVoice (new ReferenceVoice (0.01f, 0.02f));
+
+            auto* bank = new SIMDSineVoiceBank (8);
+            bank->setAttackAndRelease (0.01f, 0.02f);
+            bankSynth.addVoiceBank (bank);
+
+            expectEquals (bankSynth.getNumVoices(), 8);
+            expect (bankSynth.getVoiceBank (0) == bank);
+
+            MidiBuffer midi;
+
+            for (int i = 0; i < 10; ++i)
+                midi.addEvent (MidiMessage::noteOn (1, 48 + 5 * i, (uint8) (40 + 8 * i)), 37 * i);
+
+            for (int i = 0; i < 10; i += 3)
+                midi.addEvent (MidiMessage::noteOff (1, 48 + 5 * i), 600 + 11 * i);
+
+            midi.addEvent (MidiMessage::pitchWheel (1, 12000), 900);
+
+            AudioBuffer<float> legacyOutput (2, 4096), bankOutput (2, 4096);
+            legacyOutput.clear();
+            bankOutput.clear();
+
+            for (int start = 0; start < 4096; start += 512)
+            {
+                MidiBuffer blockMidi;
+                blockMidi.addEvents (midi, start, 512, -start);
+
+                AudioBuffer<float> legacyBlock (legacyOutput.getArrayOfWritePointers(), 2, start, 512);
+                AudioBuffer<float> bankBlock (bankOutput.getArrayOfWritePointers(), 2, start, 512);
+                legacySynth.renderNextBlock (legacyBlock, blockMidi, 0, 512);
+                bankSynth.renderNextBlock (bankBlock, blockMidi, 0, 512);
+            }
+
+            expectGreaterThan (bankOutput.getMagnitude (0, 4096), 0.1f);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < 4096; ++i)
+                    expectWithinAbsoluteError (bankOutput.getSample (ch, i), legacyOutput.getSample (ch, i), 2.0e-3f);
+
+            int numActive = 0;
+
+            for (int i = 0; i < bankSynth.getNumVoices(); ++i)
+            {
+                expect (bankSynth.getVoice (i)->isVoiceActive() == legacySynth.getVoice (i)->isVoiceActive());
+                numActive += bankSynth.getVoice (i)->isVoiceActive() ? 1 : 0;
+            }
+
+            // Two of the notes were stolen, and four have been released for long enough to finish
+            expectEquals (numActive, 4);
+
+            bankSynth.clearVoices();
+            expectEquals (bankSynth.getNumVoiceBanks(), 0);
+        }
+
+        beginTest ("Voice banks added before the sample rate is set follow the new rate");
+        {
+            constexpr auto newSampleRate = 48000.0;
+            Synthesiser legacySynth, bankSynth;
+
+            legacySynth.addVoice (new ReferenceVoice (0.01f, 0.02f));
+
+            auto* bank = new SIMDSineVoiceBank (1);
+            bank->setAttackAndRelease (0.01f, 0.02f);
+            bankSynth.addVoiceBank (bank);
+
+            for (auto* synth : { &legacySynth, &bankSynth })
+            {
+                synth->addSound (new TestSound());
+                synth->setCurrentPlaybackSampleRate (newSampleRate);
+            }
+
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 69, (uint8) 100), 0);
+            midi.addEvent (MidiMessage::noteOff (1, 69), 1500);
+
+            AudioBuffer<float> legacyOutput (1, 4096), bankOutput (1, 4096);
+            legacyOutput.clear();
+            bankOutput.clear();
+            legacySynth.renderNextBlock (legacyOutput, midi, 0, 4096);
+            bankSynth.renderNextBlock (bankOutput, midi, 0, 4096);
+
+            expectGreaterThan (bankOutput.getMagnitude (0, 4096), 0.1f);
+
+            for (int i = 0; i < 4096; ++i)
+                expectWithinAbsoluteError (bankOutput.getSample (0, i), legacyOutput.getSample (0, i), 2.0e-3f);
+
+            expect (! bankSynth.getVoice (0)->isVoiceActive());
+            expect (! legacySynth.getVoice (0)->isVoiceActive());
+        }
+
+        beginTest ("Voice banks render alongside voices, in double precision too");
+        {
+            Synthesiser synth;
+            synth.addSound (new TestSound());
+            synth.setCurrentPlaybackSampleRate (sampleRate);
+            synth.addVoiceBank (new SIMDSineVoiceBank (2));
+            synth.addVoice (new ReferenceVoice (0.0f, 0.0f));
+
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), 0);
+            midi.addEvent (MidiMessage::noteOn (1, 64, (uint8) 100), 0);
+            midi.addEvent (MidiMessage::noteOn (1, 67, (uint8) 100), 0);
+
+            AudioBuffer<double> output (1, 1024);
+            output.clear();
+            synth.renderNextBlock (output, midi, 0, 1024);
+
+            for (int i = 0; i < synth.getNumVoices(); ++i)
+                expect (synth.getVoice (i)->isVoiceActive());
+
+            expectGreaterThan (output.getMagnitude (0, 1024), 0.5);
+
+            synth.renderNextBlock (output, MidiBuffer(), 0, 1024);
+            MidiBuffer allOff;
+            allOff.addEvent (MidiMessage::allNotesOff (1), 0);
+            synth.renderNextBlock (output, allOff, 0, 1024);
+
+            for (int i = 0; i < synth.getNumVoices(); ++i)
+                expect (! synth.getVoice (i)->isVoiceActive());
+        }
+
+        beginTest ("MPESynthesiser drives a voice bank");
+        {
+            MPESynthesiser synth;
+            synth.setCurrentPlaybackSampleRate (sampleRate);
+
+            auto* bank = new SIMDSineMPEVoiceBank (4);
+            bank->setAttackAndRelease (0.001f, 0.005f);
+            synth.addVoiceBank (bank);
+            expectEquals (synth.getNumVoices(), 4);
+
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 69, (uint8) 127), 0);
+            midi.addEvent (MidiMessage::noteOn (1, 72, (uint8) 127), 100);
+
+            AudioBuffer<float> output (1, 1024);
+            output.clear();
+            synth.renderNextBlock (output, midi, 0, 1024);
+
+            expect (bank->isActive (0) && bank->isActive (1) && ! bank->isActive (2));
+            expectEquals ((int) bank->getCurrentlyPlayingNote (0).initialNote, 69);
+            expectWithinAbsoluteError (output.getMagnitude (0, 0, 100), 1.0f, 0.01f);
+
+            midi.clear();
+            midi.addEvent (MidiMessage::noteOff (1, 69), 0);
+            midi.addEvent (MidiMessage::noteOff (1, 72), 0);
+            output.clear();
+            synth.renderNextBlock (output, midi, 0, 1024);
+
+            expect (! bank->isActive (0) && ! bank->isActive (1));
+            expectEquals (output.getMagnitude (0, 512, 512), 0.0f);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+
+    //==============================================================================
+    struct Reference
+    {
+        Reference (float frequency, float g, float attack, float releaseTime, double rate = sampleRate)
+            : delta (MathConstants<double>::twoPi * frequency / rate),
+              gain (g),
+              envelopeStep (getStep (attack, rate)),
+              releaseStep (getStep (releaseTime, rate))
+        {}
+
+        static double getStep (float seconds, double rate)
+        {
+            const auto numSamples = (double) seconds * rate;
+            return numSamples > 1.0 ? 1.0 / numSamples : 1.0;
+        }
+
+        void release()      { envelopeStep = -releaseStep; }
+
+        double getNextSample()
+        {
+            const auto result = std::sin (phase) * envelope * gain;
+            phase += delta;
+            envelope = jlimit (0.0, 1.0, envelope + envelopeStep);
+            return result;
+        }
+
+        double phase = 0.0, delta, gain, envelope = 0.0, envelopeStep, releaseStep;
+    };
+
+    struct TestSound final : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    // A scalar voice that should sound the same as a voice of SIMDSineVoiceBank
+    class ReferenceVoice final : public SynthesiserVoice
+    {
+    public:
+        ReferenceVoice (float attackSeconds, float releaseSeconds)
+            : attack (attackSeconds), releaseTime (releaseSeconds) {}
+
+        bool canPlaySound (SynthesiserSound*) override    { return true; }
+
+        void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override
+        {
+            frequency = MidiMessage::getMidiNoteInHertz (midiNoteNumber);
+            reference.emplace ((float) frequency, velocity, attack, releaseTime, getSampleRate());
+            pitchWheelMoved (pitchWheel);
+        }
+
+        void stopNote (float, bool allowTailOff) override
+        {
+            if (allowTailOff)
+            {
+                reference->release();
+            }
+            else
+            {
+                reference.reset();
+                clearCurrentNote();
+            }
+        }
+
+        void pitchWheelMoved (int newValue) override
+        {
+            const auto semitones = 2.0 * (newValue - 0x2000) / (double) 0x2000;
+            reference->delta = MathConstants<double>::twoPi * frequency * std::exp2 (semitones / 12.0) / getSampleRate();
+        }
+
+        void controllerMoved (int, int) override {}
+
+        void renderNextBlock (AudioBuffer<float>& output, int startSample, int numSamples) override
+        {
+            render (output, startSample, numSamples);
+        }
+
+        void renderNextBlock (AudioBuffer<double>& output, int startSample, int numSamples) override
+        {
+            render (output, startSample, numSamples);
+        }
+
+    private:
+        template <typename FloatType>
+        void render (AudioBuffer<FloatType>& output, int startSample, int numSamples)
+        {
+            if (! reference.has_value())
+                return;
+
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                const auto sample = (FloatType) reference->getNextSample();
+
+                for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                    output.addSample (ch, i, sample);
+            }
+
+            if (reference->envelope <= 0.0 && reference->envelopeStep < 0.0)
+            {
+                reference.reset();
+                clearCurrentNote();
+            }
+        }
+
+        float attack, releaseTime;
+        double frequency = 0.0;
+        std::optional<Reference> reference;
+    };
+};
+
+static SIMDSineVoiceBankTests simdSineVoiceBankTests;
+
+} // namespace juce::dsp